@@ -0,0 +1,47 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+/**
+ * Per-battle source of every gameplay roll (accuracy, effect application, initiative).
+ * Owned by the battle rather than global, so a battle replays exactly from its seed and
+ * concurrent simulations never share generator state.
+ */
+class KBS_API FBattleRandomStream
+{
+public:
+	// Full generator state; restoring it replays every draw made after it was taken
+	struct FCheckpoint
+	{
+		FRandomStream Stream;
+		uint32 Draws = 0;
+	};
+
+	FBattleRandomStream() : FBattleRandomStream(0) {}
+	explicit FBattleRandomStream(int32 InSeed);
+
+	void Seed(int32 InSeed);
+	// Picks a fresh seed for battles that did not ask for one; read it back with GetSeed to replay
+	void SeedRandomly();
+	int32 GetSeed() const { return Stream.GetInitialSeed(); }
+	uint32 GetDrawCount() const { return Draws; }
+
+	// [0, 1)
+	float FRand();
+	// Inclusive on both ends, like FMath::RandRange
+	int32 RandRange(int32 Min, int32 Max);
+
+	// Independent child stream whose seed is drawn from this one, so sibling forks differ
+	// but the whole tree is still determined by the root seed
+	FBattleRandomStream Fork();
+	// Child stream determined by this stream's seed and Salt alone; draws nothing, so a side consumer
+	// (AI search) can branch off without moving the rolls that follow
+	FBattleRandomStream Derive(uint32 Salt) const;
+
+	FCheckpoint Checkpoint() const { return { Stream, Draws }; }
+	void Restore(const FCheckpoint& InCheckpoint);
+
+private:
+	FRandomStream Stream;
+	uint32 Draws = 0;
+};
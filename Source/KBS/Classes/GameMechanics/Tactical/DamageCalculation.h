@@ -5,6 +5,10 @@
 class AUnit;
 class UWeapon;
 class UBattleEffect;
+class FBattleRandomStream;
+struct FUnitCoreStats;
+struct FUnitDefenseStats;
+struct FCombatDescriptorStats;
 enum class ETargetReach : uint8;
 
 /**
@@ -20,18 +24,40 @@ public:
 	static float CalculateEffectApplication(AUnit* Attacker, UBattleEffect* Effect, AUnit* Target);
 	static FDamageResult CalculateHeal(AUnit* Attacker, UCombatDescriptor* Descriptor, AUnit* Target);
 
+	// Stat-level rules behind the AUnit overloads; the headless simulator calls these directly
+	static float CalculateHitChance(const FUnitCoreStats& AttackerStats, const FCombatDescriptorStats& DescriptorStats);
+	static FDamageResult CalculateDamage(const FUnitCoreStats& AttackerStats, bool bAttackerOnFlank,
+	                                     const FCombatDescriptorStats& DescriptorStats, const FUnitCoreStats& TargetStats);
+	static FDamageResult CalculateHeal(const FCombatDescriptorStats& DescriptorStats, const FUnitDefenseStats& TargetDefense);
+	static float CalculateEffectApplication(const FUnitCoreStats& AttackerStats, EDamageSource EffectSource,
+	                                        const FUnitDefenseStats& TargetDefense);
+	// CalculateDamage for many targets of one attack: descriptor and attacker terms are read once, then source
+	// selection and the damage arithmetic run as two flat passes over the targets, through the same per-target
+	// code as CalculateDamage.
+	static void CalculateDamageBatch(const FUnitCoreStats& AttackerStats, bool bAttackerOnFlank,
+	                                 const FCombatDescriptorStats& DescriptorStats,
+	                                 TConstArrayView<const FUnitCoreStats*> Targets, TArrayView<FDamageResult> OutResults);
+	// Whether a descriptor with this reach can hit a live unit at Distance with the given affiliation
+	static bool CanReachTarget(ETargetReach Reach, bool bIsFriendly, int32 Distance);
+
 	// Descriptor selection
 	static UCombatDescriptor* SelectMaxReachDescriptor(AUnit* Unit, bool bAutoAttackOnly = false);
 	static UCombatDescriptor* SelectSpellDescriptor(AUnit* Unit);
 	static UWeapon* SelectWeaponForTarget(AUnit* Attacker, AUnit* Target, bool bAutoAttackOnly = false);
+	// Preference order used by SelectMaxReachDescriptor; higher reaches more targets
+	static int32 GetReachScore(ETargetReach Reach);
 
 	// Spell scaling: sets embedded descriptor's base damage from spell descriptor's modified damage
 	static void ApplySpellScaling(UCombatDescriptor* EmbeddedDescriptor, UCombatDescriptor* SpellDescriptor, float Multiplier, int32 FlatBonus);
 
 	// Combat resolution
 	static FPreviewHitResult PreviewDamage(AUnit* Attacker, UCombatDescriptor* Descriptor, AUnit* Target);
+	// Effects live on descriptor objects, so the stat-level preview leaves EffectApplicationProbability at 0
+	static FPreviewHitResult PreviewDamage(const FUnitCoreStats& AttackerStats, bool bAttackerOnFlank,
+	                                       const FCombatDescriptorStats& DescriptorStats, const FUnitCoreStats& TargetStats);
 
-	static bool PerformAccuracyRoll(float HitChance);
+	static bool PerformAccuracyRoll(FBattleRandomStream& Random, float HitChance);
 	static bool IsFriendlyReach(ETargetReach Reach);
-	static EDamageSource SelectBestDamageSource(const TSet<EDamageSource>& DamageSources, AUnit* Target);
+	static EDamageSource SelectBestDamageSource(FDamageSourceMask DamageSources, AUnit* Target);
+	static EDamageSource SelectBestDamageSource(FDamageSourceMask DamageSources, const FUnitDefenseStats& Defense);
 };
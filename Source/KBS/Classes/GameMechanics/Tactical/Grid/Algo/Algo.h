@@ -1,6 +1,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/GridCellTables.h"
 #include "GameMechanics/Units/Unit.h"
 
 namespace KbsAlgo
@@ -9,24 +10,17 @@ namespace KbsAlgo
 	TContainer<FTacCoordinates> CopyAdjacentIf(FTacCoordinates Origin, D* DataManager, P Predicate)
 	{
 		TContainer<FTacCoordinates> FoundCells;
-		for (const FIntPoint& Offset : FGridConstants::AllAdjacentOffsets)
+		GridBitboard::ForEachCell(GridCellTables::NeighborMask(Origin, false, true), [&](const FTacCoordinates& TargetCoords)
 		{
-			FTacCoordinates TargetCoords(Origin.Row + Offset.X, Origin.Col + Offset.Y, Origin.Layer);
-			if (!TargetCoords.IsValidCell())
-			{
-				continue;
-			}
 			AUnit* TargetUnit = DataManager->GetUnit(TargetCoords);
 			if (!TargetUnit)
-			{
-				continue;
-			}
+				return;
 			if (Predicate(TargetUnit))
 			{
 				checkf(!TargetUnit->IsDead(), TEXT("Dead unit found not in corpse stack!"));
 				FoundCells.Add(TargetUnit->GetGridMetadata().Coords);
 			}
-		}
+		});
 		return FoundCells;
 	}
 
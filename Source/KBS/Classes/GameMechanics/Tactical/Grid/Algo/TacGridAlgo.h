@@ -1,6 +1,8 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/TacCellSet.h"
+#include "GameplayTypes/GridCellTables.h"
 #include "GameMechanics/Units/Unit.h"
 #include "GameplayTypes/CombatTypes.h"
 
@@ -15,16 +17,19 @@ namespace KbsAlgo
 		template <>
 		struct TCollectionPolicy<TSet>
 		{
-			static TSet<FTacCoordinates> Convert(TSet<FTacCoordinates>&& InSet)
+			static TSet<FTacCoordinates> Convert(const FTacCellSet& InSet)
 			{
-				return MoveTemp(InSet);
+				TSet<FTacCoordinates> Result;
+				Result.Reserve(InSet.Num());
+				InSet.ForEach([&Result](const FTacCoordinates& Cell) { Result.Add(Cell); });
+				return Result;
 			}
 		};
 
 		template <>
 		struct TCollectionPolicy<TArray>
 		{
-			static TArray<FTacCoordinates> Convert(TSet<FTacCoordinates>&& InSet)
+			static TArray<FTacCoordinates> Convert(const FTacCellSet& InSet)
 			{
 				return InSet.Array();
 			}
@@ -32,45 +37,27 @@ namespace KbsAlgo
 		
 
 
-		template <typename D>
-		bool ForEachAdjacentFrom(FTacCoordinates Origin, D DataManager,
-		                         TFunctionRef<bool(AUnit*, const FTacCoordinates&)> Visitor,
-		                         bool bIsTakingFlank, const TArray<FIntPoint>& Offsets)
+		// Union of the in-layer neighbor masks of every cell the unit occupies, minus those cells
+		inline uint64 AdjacentMaskOf(const FUnitGridMetadata& Metadata, bool bIsTakingFlank, EAdjacencyMode Mode)
 		{
-			for (const FIntPoint& Offset : Offsets)
+			const bool bOrthogonalOnly = Mode == EAdjacencyMode::OrthogonalOnly;
+			uint64 Mask = GridCellTables::NeighborMask(Metadata.Coords, bOrthogonalOnly, bIsTakingFlank);
+			if (Metadata.HasExtraCell())
 			{
-				FTacCoordinates Coords(Origin.Row + Offset.X, Origin.Col + Offset.Y, Origin.Layer);
-				if (!Coords.IsValidCell()) continue;
-				if (!bIsTakingFlank && Coords.IsFlankCell()) continue;
-				if (Visitor(DataManager->GetUnit(Coords), Coords))
-					return true;
+				Mask |= GridCellTables::NeighborMask(Metadata.ExtraCell, bOrthogonalOnly, bIsTakingFlank);
+				Mask &= ~(GridBitboard::CellMask(Metadata.Coords) | GridBitboard::CellMask(Metadata.ExtraCell));
 			}
-			return false;
+			return Mask;
 		}
 
 		template <typename D>
 		bool ForEachInArea(D DataManager, FTacCoordinates CenterCell, const FAreaShape& AreaShape,
 		                   TFunctionRef<bool(AUnit*, const FTacCoordinates&)> Visitor)
 		{
-			auto CheckLayer = [&](ETacGridLayer Layer) -> bool
+			return GridBitboard::AnyCell(AreaShape.GetMask(CenterCell), [&](const FTacCoordinates& Coords)
 			{
-				for (const FIntPoint& RelativeOffset : AreaShape.RelativeCells)
-				{
-					FTacCoordinates Coords = CenterCell + RelativeOffset;
-					Coords.Layer = Layer;
-					if (Visitor(DataManager->GetUnit(Coords), Coords))
-						return true;
-				}
-				return false;
-			};
-			switch (AreaShape.ShapeLayering)
-			{
-			case EShapeLayering::AirArea: return CheckLayer(ETacGridLayer::Air);
-			case EShapeLayering::GroundArea: return CheckLayer(ETacGridLayer::Ground);
-			case EShapeLayering::BothLayerArea: return CheckLayer(ETacGridLayer::Ground) || CheckLayer(
-					ETacGridLayer::Air);
-			}
-			return false;
+				return Visitor(DataManager->GetUnit(Coords), Coords);
+			});
 		}
 	} // namespace Detail
 
@@ -85,7 +72,39 @@ namespace KbsAlgo
 		Algo::Copy(Units, Deduplicated);
 		return Deduplicated;
 	}
-	
+
+	// Multi-cell units occupy two bits; AddUnique keeps the result deduplicated without a TSet
+	template <typename D>
+	TArray<AUnit*> ExtractUnits(const FTacCellSet& Source, D DataManager)
+	{
+		TArray<AUnit*> Units;
+		Units.Reserve(Source.Num());
+		for (const FTacCoordinates& Cell : Source)
+			if (AUnit* Unit = DataManager->GetUnit(Cell))
+				Units.AddUnique(Unit);
+		return Units;
+	}
+
+	template <typename D>
+	FTacCellSet CollectAdjacentCellSetIf(AUnit* SourceUnit, D DataManager,
+	                                     TFunctionRef<bool(const AUnit*, const AUnit*, const FTacCoordinates&)> Predicate,
+	                                     bool bIsTakingFlank = false,
+	                                     EAdjacencyMode Mode = EAdjacencyMode::AllDirections)
+	{
+		FTacCellSet FoundCells;
+		const FUnitGridMetadata& Metadata = SourceUnit->GetGridMetadata();
+		if (!Metadata.IsValid())
+			return FoundCells;
+
+		GridBitboard::ForEachCell(Detail::AdjacentMaskOf(Metadata, bIsTakingFlank, Mode),
+			[&](const FTacCoordinates& Coords)
+			{
+				if (Predicate(SourceUnit, DataManager->GetUnit(Coords), Coords))
+					FoundCells.Add(Coords);
+			});
+		return FoundCells;
+	}
+
 	template <template<typename...> class TContainer, typename D>
 	TContainer<FTacCoordinates> CollectAdjacentCellsIf(AUnit* SourceUnit, D DataManager,
 	                                                   TFunctionRef<bool(
@@ -94,27 +113,8 @@ namespace KbsAlgo
 	                                                   bool bIsTakingFlank = false,
 	                                                   EAdjacencyMode Mode = EAdjacencyMode::AllDirections)
 	{
-		TSet<FTacCoordinates> FoundCells;
-		const FUnitGridMetadata& Metadata = SourceUnit->GetGridMetadata();
-		if (!Metadata.IsValid())
-			return Detail::TCollectionPolicy<TContainer>::Convert(MoveTemp(FoundCells));
-
-		const bool bIsMultiCell = Metadata.HasExtraCell();
-		const TArray<FIntPoint>& Offsets = (Mode == EAdjacencyMode::OrthogonalOnly)
-			? FGridConstants::OrthogonalOffsets : FGridConstants::AllAdjacentOffsets;
-
-		auto Visit = [&](AUnit* Occupant, const FTacCoordinates& Coords) -> bool
-		{
-			if (bIsMultiCell && (Coords == Metadata.Coords || Coords == Metadata.ExtraCell))
-				return false;
-			if (Predicate(SourceUnit, Occupant, Coords)) FoundCells.Add(Coords);
-			return false;
-		};
-
-		Detail::ForEachAdjacentFrom(Metadata.Coords, DataManager, Visit, bIsTakingFlank, Offsets);
-		if (bIsMultiCell)
-			Detail::ForEachAdjacentFrom(Metadata.ExtraCell, DataManager, Visit, bIsTakingFlank, Offsets);
-		return Detail::TCollectionPolicy<TContainer>::Convert(MoveTemp(FoundCells));
+		return Detail::TCollectionPolicy<TContainer>::Convert(
+			CollectAdjacentCellSetIf(SourceUnit, DataManager, Predicate, bIsTakingFlank, Mode));
 	}
 
 	template <typename D>
@@ -127,22 +127,11 @@ namespace KbsAlgo
 		if (!Metadata.IsValid())
 			return false;
 
-		const bool bIsMultiCell = Metadata.HasExtraCell();
-		const TArray<FIntPoint>& Offsets = (Mode == EAdjacencyMode::OrthogonalOnly)
-			? FGridConstants::OrthogonalOffsets : FGridConstants::AllAdjacentOffsets;
-
-		auto Visit = [&](AUnit* Occupant, const FTacCoordinates& Coords) -> bool
-		{
-			if (bIsMultiCell && (Coords == Metadata.Coords || Coords == Metadata.ExtraCell))
-				return false;
-			return Predicate(SourceUnit, Occupant, Coords);
-		};
-
-		if (Detail::ForEachAdjacentFrom(Metadata.Coords, DataManager, Visit, bIsTakingFlank, Offsets))
-			return true;
-		if (bIsMultiCell)
-			return Detail::ForEachAdjacentFrom(Metadata.ExtraCell, DataManager, Visit, bIsTakingFlank, Offsets);
-		return false;
+		return GridBitboard::AnyCell(Detail::AdjacentMaskOf(Metadata, bIsTakingFlank, Mode),
+			[&](const FTacCoordinates& Coords)
+			{
+				return Predicate(SourceUnit, DataManager->GetUnit(Coords), Coords);
+			});
 	}
 
 
@@ -158,36 +147,36 @@ namespace KbsAlgo
 		const FUnitGridMetadata& Metadata = SourceUnit->GetGridMetadata();
 		if (!Metadata.IsValid()) return false;
 
-		const TArray<FIntPoint>& Offsets = (Mode == EAdjacencyMode::OrthogonalOnly)
-			? FGridConstants::OrthogonalOffsets : FGridConstants::AllAdjacentOffsets;
-
-		auto IsAdjacentTo = [&](FTacCoordinates Origin) -> bool
-		{
-			return TargetCoord.Layer == Origin.Layer
-				&& Offsets.Contains(FIntPoint(TargetCoord.Row - Origin.Row, TargetCoord.Col - Origin.Col));
-		};
-
-		if (!IsAdjacentTo(Metadata.Coords) && (!Metadata.HasExtraCell() || !IsAdjacentTo(Metadata.ExtraCell)))
+		if (!(Detail::AdjacentMaskOf(Metadata, bIsTakingFlank, Mode) & GridBitboard::CellMask(TargetCoord)))
 			return false;
 
 		return Predicate(SourceUnit, DataManager->GetUnit(TargetCoord), TargetCoord);
 	}
 
 
-	template <template<typename...> class TContainer, typename D>
-	TContainer<FTacCoordinates> CollectCellsInArea(AUnit* SourceUnit, D DataManager,
-	                                               TFunctionRef<bool
-		                                               (const AUnit*, const AUnit*, const FTacCoordinates&)> Predicate,
-	                                               FTacCoordinates CenterCell, const FAreaShape& AreaShape)
+	template <typename D>
+	FTacCellSet CollectCellSetInArea(AUnit* SourceUnit, D DataManager,
+	                                 TFunctionRef<bool(const AUnit*, const AUnit*, const FTacCoordinates&)> Predicate,
+	                                 FTacCoordinates CenterCell, const FAreaShape& AreaShape)
 	{
-		TSet<FTacCoordinates> FoundCells;
+		FTacCellSet FoundCells;
 		Detail::ForEachInArea(DataManager, CenterCell, AreaShape,
 		                      [&](AUnit* Occupant, const FTacCoordinates& Coords) -> bool
 		                      {
 			                      if (Predicate(SourceUnit, Occupant, Coords)) FoundCells.Add(Coords);
 			                      return false;
 		                      });
-		return Detail::TCollectionPolicy<TContainer>::Convert(MoveTemp(FoundCells));
+		return FoundCells;
+	}
+
+	template <template<typename...> class TContainer, typename D>
+	TContainer<FTacCoordinates> CollectCellsInArea(AUnit* SourceUnit, D DataManager,
+	                                               TFunctionRef<bool
+		                                               (const AUnit*, const AUnit*, const FTacCoordinates&)> Predicate,
+	                                               FTacCoordinates CenterCell, const FAreaShape& AreaShape)
+	{
+		return Detail::TCollectionPolicy<TContainer>::Convert(
+			CollectCellSetInArea(SourceUnit, DataManager, Predicate, CenterCell, AreaShape));
 	}
 
 	template <typename D>
@@ -208,26 +197,8 @@ namespace KbsAlgo
 	                  TFunctionRef<bool(const AUnit*, const AUnit*, const FTacCoordinates&)> Predicate,
 	                  FTacCoordinates CenterCell, const FAreaShape& AreaShape)
 	{
-		auto IsInLayer = [&](ETacGridLayer Layer) -> bool
-		{
-			if (TargetCoord.Layer != Layer) return false;
-			for (const FIntPoint& RelOffset : AreaShape.RelativeCells)
-			{
-				FTacCoordinates Candidate = CenterCell + RelOffset;
-				Candidate.Layer = Layer;
-				if (Candidate == TargetCoord) return true;
-			}
-			return false;
-		};
-
-		bool bInArea = false;
-		switch (AreaShape.ShapeLayering)
-		{
-		case EShapeLayering::AirArea:       bInArea = IsInLayer(ETacGridLayer::Air); break;
-		case EShapeLayering::GroundArea:    bInArea = IsInLayer(ETacGridLayer::Ground); break;
-		case EShapeLayering::BothLayerArea: bInArea = IsInLayer(ETacGridLayer::Ground) || IsInLayer(ETacGridLayer::Air); break;
-		}
-		if (!bInArea) return false;
+		if (!TargetCoord.IsValidCell()) return false;
+		if (!(AreaShape.GetMask(CenterCell) & GridBitboard::CellMask(TargetCoord))) return false;
 		return Predicate(SourceUnit, DataManager->GetUnit(TargetCoord), TargetCoord);
 	}
 
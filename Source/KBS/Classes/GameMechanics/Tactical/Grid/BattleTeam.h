@@ -1,6 +1,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "UObject/ObjectKey.h"
 #include "GameplayTypes/TeamConstants.h"
 #include "BattleTeam.generated.h"
 class AUnit;
@@ -17,6 +18,13 @@ public:
 	ETeamSide GetTeamSide() const { return TeamSide; }
 	void SetTeamSide(ETeamSide Side) { TeamSide = Side; }
 	const TArray<TObjectPtr<AUnit>>& GetUnits() const { return Units; }
+	// Re-reads a member's alive/on-field state into the liveness counters; no-op for non-members.
+	// Death is picked up through OnUnitDied, field presence is pushed by UGridDataManager.
+	void RefreshUnitState(AUnit* Unit);
+	int32 GetAliveCount() const { return AliveCount; }
+	int32 GetOnFieldCount() const { return OnFieldCount; }
+	// Alive members not on the grid (fleeing, not yet placed)
+	int32 GetOffFieldCount() const { return AliveCount - AliveOnFieldCount; }
 	bool IsAnyUnitAlive() const;
 	bool IsAnyUnitOnField() const;
 	bool IsOtherUnitAlive(AUnit* Unit) const;
@@ -25,8 +33,26 @@ public:
 	bool CanContinueFight() const;
 	static ETeamSide ReverseTeamSide(ETeamSide Side);
 protected:
+	enum EMemberState : uint8
+	{
+		MemberAlive = 0x01,
+		MemberOnField = 0x02,
+	};
+	static uint8 ReadMemberState(const AUnit* Unit);
+	uint8 GetMemberState(const AUnit* Unit) const;
+	void ApplyMemberState(uint8 OldState, uint8 NewState);
+	// Debug builds only: compares the counters against a full scan of Units
+	void VerifyCounters() const;
+	UFUNCTION()
+	void HandleMemberDied(AUnit* Unit);
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Team")
 	ETeamSide TeamSide = ETeamSide::Attacker;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Team")
 	TArray<TObjectPtr<AUnit>> Units;
+	// Last state folded into the counters, per member
+	TMap<TObjectKey<AUnit>, uint8> MemberStates;
+	int32 AliveCount = 0;
+	int32 OnFieldCount = 0;
+	int32 AliveOnFieldCount = 0;
 };
@@ -0,0 +1,69 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameplayTypes/GridCoordinates.h"
+
+class AUnit;
+
+enum class EGridChangeKind : uint8
+{
+	Place,
+	Remove,
+	Swap,
+	CorpsePush,
+	CorpsePop,
+	OffField,
+	ReturnToField,
+	Orientation,
+};
+
+struct FGridChange
+{
+	// Grid version right after this change was applied
+	uint32 Version = 0;
+	EGridChangeKind Kind = EGridChangeKind::Place;
+	TWeakObjectPtr<AUnit> Unit;
+	// Swap partner; null for every other kind
+	TWeakObjectPtr<AUnit> OtherUnit;
+	// Primary cell: destination for Place/ReturnToField/Swap, source for Remove/OffField, stack cell for corpses
+	FTacCoordinates Coords;
+	// Every cell (GridBitboard layout) whose occupant, corpse stack or unit orientation changed
+	uint64 AffectedCells = 0;
+};
+
+// Fixed-size ring of the most recent grid changes. Version starts at 0 and increments once per
+// recorded change, so a consumer holding version N can pull exactly what happened since.
+class KBS_API FGridChangeJournal
+{
+public:
+	static constexpr int32 Capacity = 256;
+
+	uint32 GetVersion() const { return Version; }
+	// Oldest version a consumer may pass to GetChangesSince and still get a complete delta
+	uint32 GetOldestRecoverableVersion() const;
+
+	void Record(EGridChangeKind Kind, AUnit* Unit, const FTacCoordinates& Coords, uint64 AffectedCells,
+	            AUnit* OtherUnit = nullptr);
+	void Reset();
+
+	// Appends changes newer than SinceVersion in order. Returns false if some were already overwritten;
+	// the caller must then treat the whole grid as changed.
+	bool GetChangesSince(uint32 SinceVersion, TArray<FGridChange>& OutChanges) const;
+	// Union of AffectedCells newer than SinceVersion; every cell if the journal no longer covers it
+	uint64 GetAffectedCellsSince(uint32 SinceVersion) const;
+
+	// Composite operations (swap, off-field) record one entry and silence the primitives they call
+	struct FScopedSuppression
+	{
+		explicit FScopedSuppression(FGridChangeJournal& InJournal) : Journal(InJournal) { ++Journal.SuppressionDepth; }
+		~FScopedSuppression() { --Journal.SuppressionDepth; }
+	private:
+		FGridChangeJournal& Journal;
+	};
+
+private:
+	const FGridChange& EntryFor(uint32 InVersion) const { return Entries[(InVersion - 1) % Capacity]; }
+
+	TArray<FGridChange> Entries;
+	uint32 Version = 0;
+	int32 SuppressionDepth = 0;
+};
@@ -1,15 +1,15 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/TacCellSet.h"
+#include "GameplayTypes/GridBitboard.h"
+#include "GameMechanics/Tactical/Grid/Components/GridChangeJournal.h"
 #include "GameMechanics/Units/Unit.h"
 #include "GameMechanics/Tactical/Grid/Subsystems/Services/TacGridQueryPredicates.h"
 #include "GridDataManager.generated.h"
 
 class ATacBattleGrid;
 class UUnitDefinition;
-#if WITH_EDITOR
-class UTacGridEditorInitializer;
-#endif
 
 // Flags selecting which unit storage locations to include in a query.
 // OnField cells contain alive units by contract; Corpses contain dead units.
@@ -22,41 +22,49 @@ enum class EUnitQuerySource : uint8
 
 ENUM_CLASS_FLAGS(EUnitQuerySource)
 
+// Bitboards maintained alongside cell storage. Bit layout is described in GridBitboard.h.
+// Occupied/team masks include the extra cell of 2-cell units; CorpsePresent is ground layer only.
+enum class EGridOccupancyMask : uint8
+{
+	Occupied,
+	Attacker,
+	Defender,
+	Flank,
+	CorpsePresent,
+	Restricted,
+};
+
+// Corpses of one ground cell. Only the visible top lives inline; buried corpses are chained
+// through UGridDataManager's shared overflow pool, newest first.
 USTRUCT()
-struct FCorpseStack
+struct FCorpseCell
 {
 	GENERATED_BODY()
 	UPROPERTY()
-	TArray<TObjectPtr<AUnit>> Corpses;
-
-	void Push(AUnit* Unit, const FVector& WorldLocation);
-	AUnit* Pop();
-	AUnit* Top() const;
-	int32 Num() const { return Corpses.Num(); }
-	bool IsEmpty() const { return Corpses.IsEmpty(); }
-	const TArray<TObjectPtr<AUnit>>& GetAll() const { return Corpses; }
-
-private:
-	void SetCorpseVisibility(AUnit* Corpse, bool bVisible);
+	TObjectPtr<AUnit> Top;
+	// Total corpses in the cell, Top included
+	int32 Count = 0;
+	// Overflow pool index of the corpse directly beneath Top
+	int32 BuriedHead = INDEX_NONE;
 };
 
+// Units of one storage location and team, in arrival order. Each unit appears once, 2-cell units included.
 USTRUCT()
-struct FGridRow
+struct FUnitRoster
 {
 	GENERATED_BODY()
-	UPROPERTY(EditAnywhere)
-	TArray<TObjectPtr<AUnit>> Cells;
-	UPROPERTY(EditAnywhere)
-	TArray<FCorpseStack> CorpseStacks;
-
-	FGridRow()
-	{
-		Cells.Init(nullptr, FGridConstants::GridSize);
-		CorpseStacks.SetNum(FGridConstants::GridSize);
-	}
+	UPROPERTY()
+	TArray<TObjectPtr<AUnit>> Units;
 };
 
-
+USTRUCT()
+struct FCorpseOverflowEntry
+{
+	GENERATED_BODY()
+	UPROPERTY()
+	TObjectPtr<AUnit> Corpse;
+	int32 Next = INDEX_NONE;
+};
 
 UCLASS()
 class KBS_API UGridDataManager : public UObject
@@ -77,6 +85,8 @@ public:
 	AUnit* GetUnit(int32 Row, int32 Col, ETacGridLayer Layer) const;
 	bool RemoveUnit(int32 Row, int32 Col, ETacGridLayer Layer);
 	bool IsUnitOnFlank(const AUnit* Unit) const;
+	// Exchanges two on-field units' positions; restores both on failure. Journaled as a single Swap.
+	bool SwapUnits(AUnit* Unit1, FTacCoordinates Pos1, AUnit* Unit2, FTacCoordinates Pos2);
 
 	// Primitive: writes GridMetadata.Orientation only.
 	void SetUnitOrientation(AUnit* Unit, EUnitOrientation Orientation);
@@ -94,24 +104,70 @@ public:
 	ATacBattleGrid* GetGrid() const { return Grid; }
 
 	bool IsCellOccupied(FTacCoordinates Coords) const;
+
+	// Incremented on every journaled mutation; compare against a stored value to detect grid changes
+	uint32 GetGridVersion() const { return Journal.GetVersion(); }
+	const FGridChangeJournal& GetChangeJournal() const { return Journal; }
+	// Zobrist hash (BattleZobrist keys, salted by unit GUID) of which unit stands in which cell and which
+	// corpse tops each stack. Unlike the version it returns to an earlier value when the grid does.
+	uint64 GetOccupancyHash() const { return OccupancyHash; }
+	// Occupancy hash plus the health, status and effect keys of every unit the grid holds, on field,
+	// off field or as a corpse. The units XOR their own changes in (AUnit::BindLiveHash).
+	uint64 GetBattleHash() const { return OccupancyHash ^ *UnitStateHash; }
+	// GetBattleHash recomputed from scratch; the incremental one must always match it
+	uint64 ComputeBattleHash() const;
+	bool GetChangesSince(uint32 SinceVersion, TArray<FGridChange>& OutChanges) const
+	{
+		return Journal.GetChangesSince(SinceVersion, OutChanges);
+	}
+
+	// Bitboard queries: O(1) replacements for whole-grid predicate scans
+	uint64 GetOccupancyMask(EGridOccupancyMask Mask) const;
+	uint64 GetOccupancyMask(EGridOccupancyMask Mask, ETacGridLayer Layer) const;
+	uint64 GetTeamMask(ETeamSide Side) const;
+	// Valid, non-restricted cells of Layer with no unit in them
+	uint64 GetEmptyCellsMask(ETacGridLayer Layer) const;
+	int32 CountCells(EGridOccupancyMask Mask, ETacGridLayer Layer) const;
+	static void CellsFromMask(uint64 Mask, TArray<FTacCoordinates>& OutCells);
 	TArray<FTacCoordinates> GetValidPlacementCells(ETacGridLayer Layer) const;
 	// Iterates all cells in Layer; adds coords where Predicate returns true
+	void FilterCells(AUnit* SourceUnit, ETacGridLayer Layer, QueryPredicates::FCellFilterPredicate Predicate,
+	                 FTacCellSet& OutCells) const;
 	void FilterCells(AUnit* SourceUnit, ETacGridLayer Layer, QueryPredicates::FCellFilterPredicate Predicate,
 	                 TArray<FTacCoordinates>& OutCells) const;
 	bool TestCells(AUnit* SourceUnit, ETacGridLayer Layer, QueryPredicates::FCellFilterPredicate Predicate) const;
+	void FilterCorpseCells(AUnit* SourceUnit, QueryPredicates::FCorpseFilterPredicate Predicate, FTacCellSet& OutCells) const;
 	void FilterCorpseCells(AUnit* SourceUnit, QueryPredicates::FCorpseFilterPredicate Predicate, TArray<FTacCoordinates>& OutCells) const;
 	bool TestCorpseCells(AUnit* SourceUnit, QueryPredicates::FCorpseFilterPredicate Predicate) const;
+
+	// Compile-time dispatch variants: TPredicate is a TargetingPolicies struct (or any callable)
+	// and is inlined into the cell loop. The TFunction overloads above forward here.
+	template <typename TPredicate>
+	void FilterCellsWith(AUnit* SourceUnit, ETacGridLayer Layer, const TPredicate& Predicate, FTacCellSet& OutCells) const;
+	template <typename TPredicate>
+	bool TestCellsWith(AUnit* SourceUnit, ETacGridLayer Layer, const TPredicate& Predicate) const;
+	template <typename TPredicate>
+	void FilterCorpseCellsWith(const TPredicate& Predicate, FTacCellSet& OutCells) const;
+	template <typename TPredicate>
+	bool TestCorpseCellsWith(const TPredicate& Predicate) const;
 	
 	void PushCorpse(AUnit* Unit, FTacCoordinates Coords);
 	AUnit* GetTopCorpse(FTacCoordinates Coords) const;
 	AUnit* PopCorpse(FTacCoordinates Coords);
 	int32 CorpsesNum(FTacCoordinates Coords) const;
-	const TArray<TObjectPtr<AUnit>>& GetCorpseStack(FTacCoordinates Coords) const;
+	// Appends the cell's corpses top first
+	void GetCorpseStack(FTacCoordinates Coords, TArray<AUnit*>& OutCorpses) const;
 
 	TArray<AUnit*> GetUnitsInCells(const TArray<FTacCoordinates>& CellCoords, ETacGridLayer Layer) const;
 
 	// Collects units from the specified storage locations
 	TArray<AUnit*> GetUnits(EUnitQuerySource Sources) const;
+	// Non-owning view of one maintained roster; Source must be a single flag. Invalidated by grid mutations.
+	TArrayView<const TObjectPtr<AUnit>> GetRoster(EUnitQuerySource Source, ETeamSide Side) const;
+	int32 NumUnits(EUnitQuerySource Sources) const;
+	// Visits every unit in the specified storage locations without allocating. Func must not mutate the grid.
+	template <typename TFunc>
+	void ForEachUnit(EUnitQuerySource Sources, TFunc&& Func) const;
 	// Collects units from the specified storage locations, filtered by Predicate
 	TArray<AUnit*> GetUnits(EUnitQuerySource Sources, QueryPredicates::FCellFilterPredicate Predicate) const;
 
@@ -131,18 +187,34 @@ public:
 	TArray<AUnit*> GetOffFieldUnits() const;
 
 private:
-#if WITH_EDITOR
-	friend class UTacGridEditorInitializer;
-#endif
-	TArray<FGridRow>& GetLayer(ETacGridLayer Layer);
-	const TArray<FGridRow>& GetLayer(ETacGridLayer Layer) const;
+	void MarkCellOccupied(const FTacCoordinates& Coords, ETeamSide Team);
+	void MarkCellEmpty(const FTacCoordinates& Coords);
+	static uint64 UnitCellsMask(const FUnitGridMetadata& Metadata);
+	static uint64 CorpseTopKey(const AUnit* Corpse, const FTacCoordinates& Coords);
+	static void SetCorpseVisibility(AUnit* Corpse, bool bVisible);
+	int32 AllocateOverflowEntry(AUnit* Corpse, int32 Next);
+	void ReleaseOverflowEntry(int32 Index);
+	static int32 RosterIndex(EUnitQuerySource Source, ETeamSide Side);
+	void AddToRoster(EUnitQuerySource Source, AUnit* Unit, ETeamSide Side);
+	void RemoveFromRoster(EUnitQuerySource Source, AUnit* Unit, ETeamSide Side);
+	bool IsInAnyRoster(const AUnit* Unit) const;
+	// Pushes on-field transitions into the owning team's liveness counters
+	void RefreshTeamState(AUnit* Unit) const;
 
+	// [Layer][Row * GridSize + Col], indexed by FTacCoordinates::GetCellIndex(). 2-cell units appear in both cells.
+	UPROPERTY()
+	TArray<TObjectPtr<AUnit>> Cells;
+	// Ground layer only, same indexing as Cells
 	UPROPERTY()
-	TArray<FGridRow> GroundLayer;
+	TArray<FCorpseCell> CorpseCells;
 	UPROPERTY()
-	TArray<FGridRow> AirLayer;
+	TArray<FCorpseOverflowEntry> CorpseOverflow;
+	int32 FreeOverflowHead = INDEX_NONE;
 	UPROPERTY()
 	TMap<FGuid, TObjectPtr<AUnit>> OffFieldUnits;
+	// [Source][Team]: OnField, OffField, Corpses x Attacker, Defender. See RosterIndex.
+	UPROPERTY()
+	TArray<FUnitRoster> Rosters;
 	UPROPERTY()
 	TObjectPtr<ATacBattleGrid> Grid;
 	UPROPERTY()
@@ -151,4 +223,69 @@ private:
 	TObjectPtr<UBattleTeam> DefenderTeam;
 	bool bPlayerIsAttacker = false;
 	FVector GridWorldLocation;
+
+	// Occupancy bitboards; Flank and Restricted are static and live in GridBitboard
+	uint64 OccupiedMask = 0;
+	uint64 AttackerMask = 0;
+	uint64 DefenderMask = 0;
+	uint64 CorpseMask = 0;
+	uint64 OccupancyHash = 0;
+	// Shared with the bound units, so a unit outliving the grid writes into it harmlessly
+	TSharedRef<uint64> UnitStateHash = MakeShared<uint64>(0);
+
+	FGridChangeJournal Journal;
 };
+
+template <typename TFunc>
+void UGridDataManager::ForEachUnit(EUnitQuerySource Sources, TFunc&& Func) const
+{
+	for (const EUnitQuerySource Source : { EUnitQuerySource::OnField, EUnitQuerySource::OffField, EUnitQuerySource::Corpses })
+	{
+		if (!EnumHasAnyFlags(Sources, Source))
+			continue;
+		for (const ETeamSide Side : { ETeamSide::Attacker, ETeamSide::Defender })
+		{
+			for (AUnit* Unit : GetRoster(Source, Side))
+				Func(Unit);
+		}
+	}
+}
+
+template <typename TPredicate>
+void UGridDataManager::FilterCellsWith(AUnit* SourceUnit, ETacGridLayer Layer, const TPredicate& Predicate,
+                                       FTacCellSet& OutCells) const
+{
+	GridBitboard::ForEachCell(GridBitboard::ValidCellsMask & GridBitboard::LayerMask(Layer), [&](const FTacCoordinates& Coords)
+	{
+		if (Predicate(SourceUnit, GetUnit(Coords), Coords))
+			OutCells.Add(Coords);
+	});
+}
+
+template <typename TPredicate>
+bool UGridDataManager::TestCellsWith(AUnit* SourceUnit, ETacGridLayer Layer, const TPredicate& Predicate) const
+{
+	return GridBitboard::AnyCell(GridBitboard::ValidCellsMask & GridBitboard::LayerMask(Layer), [&](const FTacCoordinates& Coords)
+	{
+		return Predicate(SourceUnit, GetUnit(Coords), Coords);
+	});
+}
+
+template <typename TPredicate>
+void UGridDataManager::FilterCorpseCellsWith(const TPredicate& Predicate, FTacCellSet& OutCells) const
+{
+	GridBitboard::ForEachCell(GridBitboard::ValidCellsMask & GridBitboard::LayerMask(ETacGridLayer::Ground), [&](const FTacCoordinates& Coords)
+	{
+		if (Predicate(Coords, IsCellOccupied(Coords), GetTopCorpse(Coords), CorpsesNum(Coords)))
+			OutCells.Add(Coords);
+	});
+}
+
+template <typename TPredicate>
+bool UGridDataManager::TestCorpseCellsWith(const TPredicate& Predicate) const
+{
+	return GridBitboard::AnyCell(GridBitboard::ValidCellsMask & GridBitboard::LayerMask(ETacGridLayer::Ground), [&](const FTacCoordinates& Coords)
+	{
+		return Predicate(Coords, IsCellOccupied(Coords), GetTopCorpse(Coords), CorpsesNum(Coords));
+	});
+}
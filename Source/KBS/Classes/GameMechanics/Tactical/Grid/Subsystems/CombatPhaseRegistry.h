@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AUnit;
+struct FCombatContext;
+struct FHitInstance;
+struct FDamageResult;
+
+// Phases UTacCombatSubsystem runs per attack, in order
+enum class ECombatPhase : uint8
+{
+	// Once per attack (Hit null) for global and attacker listeners, then once per hit for target listeners
+	PreResolution,
+	// Accuracy roll and damage calculation; modifiers added here affect the roll
+	Calculation,
+	// Damage is about to be written to the target; modify the FDamageResult to absorb or amplify
+	ResultApplication,
+	// Only for descriptors with active side effects
+	SideEffectApplication,
+	EffectApplication,
+	Count,
+};
+
+enum class ECombatPhaseMask : uint8
+{
+	None = 0,
+	PreResolution = 1 << 0,
+	Calculation = 1 << 1,
+	ResultApplication = 1 << 2,
+	SideEffectApplication = 1 << 3,
+	EffectApplication = 1 << 4,
+	All = 0x1F,
+};
+ENUM_CLASS_FLAGS(ECombatPhaseMask)
+
+// Side of a hit a unit-scoped listener cares about
+enum class ECombatRole : uint8
+{
+	// Global listener, or a unit-scoped one was not involved
+	None = 0,
+	Attacker = 1 << 0,
+	Target = 1 << 1,
+	Either = Attacker | Target,
+};
+ENUM_CLASS_FLAGS(ECombatRole)
+
+struct FCombatPhaseEvent
+{
+	ECombatPhase Phase;
+	FCombatContext& Context;
+	// Null for the attack-level PreResolution dispatch
+	FHitInstance* Hit = nullptr;
+	// ResultApplication only
+	FDamageResult* Damage = nullptr;
+	// Which side of the hit the listener's unit is on; None for global listeners
+	ECombatRole Role = ECombatRole::None;
+};
+
+using FCombatPhaseCallback = void (*)(UObject* Listener, const FCombatPhaseEvent& Event);
+
+struct FCombatListenerHandle
+{
+	uint32 Id = 0;
+	bool IsValid() const { return Id != 0; }
+};
+
+// Native listeners for UTacCombatSubsystem's phases: a plain function pointer and a weakly held object,
+// filtered by phase bitmask and optionally by unit and role, kept sorted by priority (higher first,
+// ties in registration order). Replaces per-hit dynamic delegate broadcasts and AUnit's per-unit
+// mirrors, so an AoE attack only pays for listeners that actually match each hit.
+// Listeners may be added or removed from inside a callback; changes take effect after the dispatch.
+class KBS_API FCombatPhaseRegistry
+{
+public:
+	// Unit null: fires for every attack. Otherwise only when Unit is on one of the sides in Roles.
+	FCombatListenerHandle Add(UObject* Listener, FCombatPhaseCallback Callback, ECombatPhaseMask Phases,
+	                          int32 Priority = 0, const AUnit* Unit = nullptr, ECombatRole Roles = ECombatRole::Either);
+
+	// Method-pointer convenience: Add<UMyPassive, &UMyPassive::OnPhase>(this, ...)
+	template <typename TListener, void (TListener::*Method)(const FCombatPhaseEvent&)>
+	FCombatListenerHandle Add(TListener* Listener, ECombatPhaseMask Phases, int32 Priority = 0,
+	                          const AUnit* Unit = nullptr, ECombatRole Roles = ECombatRole::Either)
+	{
+		return Add(Listener, [](UObject* Object, const FCombatPhaseEvent& Event)
+		{
+			(static_cast<TListener*>(Object)->*Method)(Event);
+		}, Phases, Priority, Unit, Roles);
+	}
+
+	void Remove(FCombatListenerHandle& Handle);
+	void RemoveAll(const UObject* Listener);
+	void Reset();
+
+	// Runs Phase's listeners in priority order: global ones if bIncludeGlobal, unit-scoped ones when their
+	// unit is the attacker or Hit's target and that side is in both their Roles and the Roles passed here
+	void Dispatch(ECombatPhase Phase, FCombatContext& Context, FHitInstance* Hit, FDamageResult* Damage = nullptr,
+	              ECombatRole Roles = ECombatRole::Either, bool bIncludeGlobal = true);
+
+private:
+	struct FListener
+	{
+		uint32 Id = 0;
+		int32 Priority = 0;
+		TWeakObjectPtr<UObject> Object;
+		FCombatPhaseCallback Callback = nullptr;
+		const AUnit* Unit = nullptr;
+		ECombatRole Roles = ECombatRole::Either;
+	};
+
+	void Insert(ECombatPhase Phase, const FListener& Listener);
+	// Applies removals and additions deferred while a dispatch was running
+	void FlushDeferred();
+
+	TArray<FListener> Listeners[static_cast<int32>(ECombatPhase::Count)];
+	TArray<TPair<ECombatPhaseMask, FListener>> PendingAdds;
+	int32 DispatchDepth = 0;
+	bool bHasDeferredRemovals = false;
+	uint32 NextId = 1;
+};
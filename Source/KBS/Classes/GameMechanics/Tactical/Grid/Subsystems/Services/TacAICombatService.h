@@ -2,6 +2,10 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/AITypes.h"
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+#include "Async/Future.h"
+#include <atomic>
 #include "TacAICombatService.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogKBSAI, Log, All);
@@ -10,6 +14,7 @@ class AUnit;
 class UTacGridSubsystem;
 class UTacCombatSubsystem;
 class UUnitAbility;
+class FBattleSetup;
 
 USTRUCT()
 struct FAiDecision
@@ -23,6 +28,30 @@ struct FAiDecision
 	bool bHasDecision = false;
 };
 
+// A search decision running on a worker against its own FBattleSetup snapshot. Cancelling only asks the
+// search to stop early; the worker never touches UObjects, so an abandoned task is harmless. A cancelled
+// task still answers, but FinishThinking drops that answer.
+class KBS_API FAiThinkTask
+{
+public:
+	friend class UTacAICombatService;
+
+	FAiThinkTask() = default;
+	// InCancelFlag is the flag the worker producing InResult polls
+	FAiThinkTask(TFuture<FSimAction>&& InResult, TSharedRef<std::atomic<bool>> InCancelFlag);
+
+	bool IsValid() const { return Result.IsValid(); }
+	bool IsReady() const { return Result.IsValid() && Result.IsReady(); }
+	bool IsCancelled() const { return CancelFlag && CancelFlag->load(std::memory_order_relaxed); }
+	void Cancel();
+	// Blocks until the search has answered
+	void Wait() const;
+
+private:
+	TFuture<FSimAction> Result;
+	TSharedPtr<std::atomic<bool>> CancelFlag;
+};
+
 UCLASS()
 class KBS_API UTacAICombatService : public UObject
 {
@@ -30,17 +59,59 @@ class KBS_API UTacAICombatService : public UObject
 public:
 	void Initialize(UTacGridSubsystem* InGridSubsystem, UTacCombatSubsystem* InCombatSubsystem);
 	FAiDecision ThinkOverNextAction(AUnit* Unit) const;
+	// Starts a search-engine decision off the game thread; OnReady runs on the game thread once the task
+	// is ready (also after a cancel). Returns false, with nothing started, when the unit's team uses the
+	// heuristic or the battle could not be snapshotted: ThinkOverNextAction decides those in place.
+	bool StartThinking(AUnit* Unit, FAiThinkTask& OutTask, TFunction<void()> OnReady) const;
+	// Takes a ready task's answer and maps it onto the unit's live abilities, heuristics if it does not fit.
+	// No decision when the task was cancelled or the unit died or left the field while it searched.
+	FAiDecision FinishThinking(AUnit* Unit, FAiThinkTask& Task) const;
+
+	// Thinks ahead for PredictedUnit, due next in the turn order, on a snapshot of the battle as it
+	// stands now with the current turn ended. Meant for the time the current action's presentation
+	// plays; replaces any earlier speculation.
+	void StartSpeculating(AUnit* PredictedUnit, TFunction<void()> OnReady);
+	// Keeps Task, searching for PredictedUnit, as the speculation, stamped with the battle as it stands now
+	void Speculate(AUnit* PredictedUnit, FAiThinkTask&& Task);
+	// Hands over the speculative task (possibly still running) if it was for Unit and nothing its snapshot
+	// read has changed since: occupancy, statuses, stat modifiers or health. Otherwise discards it and
+	// returns false.
+	bool TakeSpeculation(AUnit* Unit, FAiThinkTask& OutTask);
+	void DiscardSpeculation();
+	// Per team, from UGridConfig; Heuristic when the grid has no config
+	EAIDecisionEngine GetDecisionEngine(ETeamSide Side) const;
 
 private:
+	// Searches a snapshot of the battle; false (heuristics take over) when the snapshot or its answer
+	// does not map back onto the unit's live abilities
+	bool TryDecideBySearch(AUnit* Unit, EAIDecisionEngine Engine, FAiDecision& OutDecision) const;
+	void LaunchSearch(TSharedRef<FBattleSetup> Snapshot, EAIDecisionEngine Engine, FAiThinkTask& OutTask,
+	                  TFunction<void()> OnReady) const;
+	bool CaptureSnapshot(FBattleSetup& OutSnapshot) const;
+	// Worker-safe: reads only the snapshot state and the values passed in
+	static FSimAction RunSearch(const FBattleState& Root, EAIDecisionEngine Engine, const FAISearchSettings& Settings,
+	                            int32 Seed, const std::atomic<bool>* Cancel);
+	bool TryMapSearchAction(AUnit* Unit, const FSimAction& Action, FAiDecision& OutDecision) const;
 	bool TryDecideAttack(AUnit* Unit, FAiDecision& OutDecision) const;
 	bool TryDecideMove(AUnit* Unit, FAiDecision& OutDecision) const;
 	void DecideWait(AUnit* Unit, FAiDecision& OutDecision) const;
 
-	// Returns move cell from ValidCells that minimizes distance to the nearest enemy
-	FTacCoordinates PickMoveTowardEnemy(AUnit* Unit, const TArray<FTacCoordinates>& MoveCells) const;
+	// Targeting results come in cell-set bit order. A closest-reach attack keeps the old first pick: the
+	// unit's neighbours in FGridConstants::AllAdjacentOffsets order, orthogonal before diagonal.
+	FTacCoordinates PickAttackCell(AUnit* Unit, const TArray<FTacCoordinates>& AttackCells) const;
+	// Returns the move cell scoring best on steps to the nearest enemy, expected incoming damage against
+	// the unit's health and healer cover, read from UTacThreatMapService
+	FTacCoordinates PickMoveCell(AUnit* Unit, const TArray<FTacCoordinates>& MoveCells) const;
 
 	UPROPERTY()
 	TObjectPtr<UTacGridSubsystem> GridSubsystem;
 	UPROPERTY()
 	TObjectPtr<UTacCombatSubsystem> CombatSubsystem;
+
+	FAiThinkTask Speculation;
+	TWeakObjectPtr<AUnit> SpeculatedUnit;
+	uint32 SpeculatedGridVersion = 0;
+	uint32 SpeculatedStatusSerial = 0;
+	uint32 SpeculatedStatSerial = 0;
+	uint32 SpeculatedHealthSerial = 0;
 };
@@ -1,8 +1,7 @@
 #pragma once
 #include "GameplayTypes/TargetingDescriptor.h"
-
-class AUnit;
-struct FTacCoordinates;
+#include "GameplayTypes/GridCoordinates.h"
+#include "GameMechanics/Units/Unit.h"
 
 namespace QueryPredicates
 {
@@ -12,6 +11,133 @@ namespace QueryPredicates
 						  int32 /* Num corpses */)> FCorpseFilterPredicate;
 }
 
+// Policy structs: same rules as the factories below, but usable as template arguments
+// (UGridDataManager::FilterCellsWith/TestCellsWith) so the per-cell call inlines.
+// The TFunction factories wrap these, so both paths share one definition.
+namespace TargetingPolicies
+{
+	struct FEmptyCell
+	{
+		bool operator()(const AUnit* SourceUnit, const AUnit* Occupant, const FTacCoordinates& Cell) const
+		{
+			return !Occupant;
+		}
+	};
+
+	struct FEmptyNotFlank
+	{
+		bool operator()(const AUnit* SourceUnit, const AUnit* Occupant, const FTacCoordinates& Cell) const
+		{
+			return !Occupant && !Cell.IsFlankCell();
+		}
+	};
+
+	// Multi-cell movers may swap with friendly 1-cell units; 1-cell movers need an empty cell
+	template <bool bIsMulticell>
+	struct TMove
+	{
+		bool operator()(const AUnit* SourceUnit, const AUnit* Occupant, const FTacCoordinates& Cell) const
+		{
+			if constexpr (bIsMulticell)
+			{
+				if (Occupant)
+				{
+					check(!Occupant->IsDead());
+					if (Occupant->GetGridMetadata().IsEnemy(SourceUnit->GetGridMetadata()))
+						return false;
+					if (Occupant->GetGridMetadata().IsMultiCell())
+						return false;
+				}
+				return true;
+			}
+			else
+			{
+				return !Occupant;
+			}
+		}
+	};
+
+	struct FAirMove
+	{
+		bool operator()(const AUnit* SourceUnit, const AUnit* Occupant, const FTacCoordinates& Cell) const
+		{
+			return !Occupant || !Occupant->GetGridMetadata().IsEnemy(SourceUnit->GetGridMetadata());
+		}
+	};
+
+	struct FAffiliation
+	{
+		ETargetAffiliation Filter;
+		bool bAllowEmpty;
+		bool bAllowFlank;
+		bool bAllowDelayed;
+
+		explicit FAffiliation(const FTargetingDescriptor& Desc)
+			: Filter(Desc.Affiliation)
+			, bAllowEmpty(Desc.bAllowEmpty)
+			, bAllowFlank(Desc.bAllowFlank)
+			, bAllowDelayed(Desc.Strategy != ETargetingStrategy::Closest)
+		{
+		}
+
+		bool operator()(const AUnit* SourceUnit, const AUnit* Occupant, const FTacCoordinates& Cell) const
+		{
+			if (Cell.IsFlankCell() && !bAllowFlank)
+				return false;
+			if (Occupant)
+			{
+				if (!bAllowDelayed && Occupant->GetStats().Status.IsFlankDelayed())
+					return false;
+				switch (Filter)
+				{
+				case ETargetAffiliation::Enemy:
+					return Occupant->GetGridMetadata().IsEnemy(SourceUnit->GetGridMetadata());
+				case ETargetAffiliation::Friendly:
+					return !Occupant->GetGridMetadata().IsEnemy(SourceUnit->GetGridMetadata());
+				case ETargetAffiliation::Any:
+				default:
+					return true;
+				}
+			}
+			return bAllowEmpty;
+		}
+	};
+
+	struct FCorpseAffiliation
+	{
+		const AUnit* SourceUnit;
+		ETargetAffiliation Filter;
+		bool bAllowBlocked;
+
+		FCorpseAffiliation(const AUnit* InSourceUnit, const FTargetingDescriptor& Desc)
+			: SourceUnit(InSourceUnit)
+			, Filter(Desc.Affiliation)
+			, bAllowBlocked(Desc.bAllowCoveredCorpse)
+		{
+		}
+
+		bool operator()(const FTacCoordinates& Coords, bool bIsBlocked, const AUnit* TopCorpse, int32 CorpseNum) const
+		{
+			if (bIsBlocked && !bAllowBlocked)
+				return false;
+			if (TopCorpse)
+			{
+				switch (Filter)
+				{
+				case ETargetAffiliation::Enemy:
+					return SourceUnit->GetGridMetadata().IsEnemy(TopCorpse->GetGridMetadata());
+				case ETargetAffiliation::Friendly:
+					return !SourceUnit->GetGridMetadata().IsEnemy(TopCorpse->GetGridMetadata());
+				case ETargetAffiliation::Any:
+				default:
+					return true;
+				}
+			}
+			return true;
+		}
+	};
+}
+
 
 namespace TargetingPredicates
 {
@@ -6,7 +6,9 @@
 #include "GameMechanics/Tactical/Grid/Components/GridDataManager.h"
 #include "GameMechanics/Tactical/Grid/Subsystems/Services/TacGridQueryPredicates.h"
 #include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/TacCellSet.h"
 #include "GameplayTypes/TargetingDescriptor.h"
+#include "UObject/ObjectKey.h"
 #include "TacGridTargetingService.generated.h"
 
 class AUnit;
@@ -16,6 +18,13 @@ enum class ETeamSide : uint8;
 
 enum class ETargetReach : uint8;
 
+struct FTargetingCacheStats
+{
+	uint32 Hits = 0;
+	uint32 Misses = 0;
+	// Times the whole cache was dropped because the grid version or unit statuses moved
+	uint32 Invalidations = 0;
+};
 
 UCLASS()
 class KBS_API UTacGridTargetingService : public UObject
@@ -27,6 +36,8 @@ public:
 	void Initialize(UGridDataManager* InDataManager);
 	
 	
+	FTacCellSet GetValidTargetCellSet(AUnit* Unit, FTargetingDescriptor Desc) const;
+	// TArray adapter over GetValidTargetCellSet for UI/AI callers
 	TArray<FTacCoordinates> GetValidTargetCells(AUnit* Unit, FTargetingDescriptor Desc) const;
 	TArray<AUnit*> GetValidTargetUnits(AUnit* Unit, FTargetingDescriptor Desc, bool bIncludeSelf = false) const;
 	FResolvedTargets ResolveTargetsFromClick(AUnit* SourceUnit, FTacCoordinates ClickedCell,
@@ -43,33 +54,58 @@ public:
 	bool HasValidTargetAtCell(AUnit* Source, FTacCoordinates TargetCell, ETargetReach Reach) const;
 	bool HasAnyValidTargets(AUnit* Source, ETargetReach Reach) const;
 
+	// Memoized GetValidTargetCellSet results, valid while grid version and unit status serial are unchanged
+	const FTargetingCacheStats& GetCacheStats() const { return CacheStats; }
+	void ResetCache();
+
 private:
+	struct FCacheKey
+	{
+		TObjectKey<AUnit> Unit;
+		FTargetingDescriptor Desc;
+
+		bool operator==(const FCacheKey& Other) const { return Unit == Other.Unit && Desc == Other.Desc; }
+		friend uint32 GetTypeHash(const FCacheKey& Key) { return HashCombine(GetTypeHash(Key.Unit), GetTypeHash(Key.Desc)); }
+	};
+
 	UPROPERTY()
 	TObjectPtr<UGridDataManager> DataManager;
-	TArray<FTacCoordinates> GetClosestEnemyCells(AUnit* Unit, const FTargetingDescriptor& Desc) const;
+
+	// Drops cached results if anything they depend on changed; returns the cached set or nullptr
+	const FTacCellSet* FindCachedCellSet(AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet ComputeValidTargetCellSet(AUnit* Unit, const FTargetingDescriptor& Desc) const;
+
+	mutable TMap<FCacheKey, FTacCellSet> TargetCache;
+	mutable uint32 CachedGridVersion = 0;
+	mutable uint32 CachedStatusSerial = 0;
+	mutable FTargetingCacheStats CacheStats;
+	FTacCellSet GetClosestEnemyCells(AUnit* Unit, const FTargetingDescriptor& Desc) const;
 	bool CanTargetClosestCell(AUnit* SourceUnit, const FTargetingDescriptor& Desc, FTacCoordinates Cell) const;
 	bool CanSelfTarget(AUnit* Source, FTacCoordinates Coord) const;
-	TArray<FTacCoordinates> GetCellsByAffiliation(AUnit* SourceUnit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetCellsByAffiliation(AUnit* SourceUnit, const FTargetingDescriptor& Desc) const;
 	bool TestMovementCell(AUnit* Unit, FTacCoordinates Cell, const FTargetingDescriptor& Desc) const;
-	TArray<FTacCoordinates> GetCorpseCellsByAffiliation(AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetCorpseCellsByAffiliation(AUnit* Unit, const FTargetingDescriptor& Desc) const;
 
 	// Movement — master + size helpers
-	TArray<FTacCoordinates> GetValidMovementCells (AUnit* Unit, const FTargetingDescriptor& Desc) const;
-	TArray<FTacCoordinates> GetSingleCellMoveCells(AUnit* Unit, const FTargetingDescriptor& Desc) const;
-	TArray<FTacCoordinates> GetMultiCellMoveCells (AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetValidMovementCells (AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetSingleCellMoveCells(AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetMultiCellMoveCells (AUnit* Unit, const FTargetingDescriptor& Desc) const;
 
 	// Movement — 6 leaf helpers (size × pattern), each resolves layer/predicate from Desc
-	TArray<FTacCoordinates> GetSingleCellOrthogonal(AUnit* Unit, const FTargetingDescriptor& Desc) const;
-	TArray<FTacCoordinates> GetSingleCellAnyToAny  (AUnit* Unit, const FTargetingDescriptor& Desc) const;
-	TArray<FTacCoordinates> GetSingleCellLinear    (AUnit* Unit, const FTargetingDescriptor& Desc) const;
-	TArray<FTacCoordinates> GetMultiCellOrthogonal (AUnit* Unit, const FTargetingDescriptor& Desc) const;
-	TArray<FTacCoordinates> GetMultiCellAnyToAny   (AUnit* Unit, const FTargetingDescriptor& Desc) const;
-	TArray<FTacCoordinates> GetMultiCellLinear     (AUnit* Unit, const FTargetingDescriptor& Desc) const;
-	TArray<FTacCoordinates> GetCellsInArea(AUnit* Unit, FTacCoordinates CenterCell,
-	                                       const FTargetingDescriptor& Desc, const FAreaShape& AreaShape) const;
+	FTacCellSet GetSingleCellOrthogonal(AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetSingleCellAnyToAny  (AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetSingleCellLinear    (AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetMultiCellOrthogonal (AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetMultiCellAnyToAny   (AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetMultiCellLinear     (AUnit* Unit, const FTargetingDescriptor& Desc) const;
+	FTacCellSet GetCellsInArea(AUnit* Unit, FTacCoordinates CenterCell,
+	                           const FTargetingDescriptor& Desc, const FAreaShape& AreaShape) const;
 	bool CheckUnitAndData(AUnit* Unit) const;
-	bool TestCell(AUnit* SourceUnit, FTacCoordinates Cell, QueryPredicates::FCellFilterPredicate Predicate) const;
-	bool TestCell(FTacCoordinates Cell, QueryPredicates::FCorpseFilterPredicate Predicate) const;
-	FResolvedTargets BuildTargetsFromCells(FTacCoordinates ClickedCell, const TArray<FTacCoordinates>& QueriedCells) const;
+	// TPredicate: TargetingPolicies cell / corpse policy; instantiated only in the .cpp
+	template <typename TPredicate>
+	bool TestCell(AUnit* SourceUnit, FTacCoordinates Cell, const TPredicate& Predicate) const;
+	template <typename TPredicate>
+	bool TestCell(FTacCoordinates Cell, const TPredicate& Predicate) const;
+	FResolvedTargets BuildTargetsFromCells(FTacCoordinates ClickedCell, const FTacCellSet& QueriedCells) const;
 	FResolvedTargets BuildTargetFromCell(FTacCoordinates ClickedCell, bool bHasPassedFilter) const;
 };
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/GridBitboard.h"
+#include "UObject/ObjectKey.h"
+#include "TacThreatMapService.generated.h"
+
+class AUnit;
+class UGridDataManager;
+struct FUnitCoreStats;
+enum class ETeamSide : uint8;
+
+// One cell of a team's influence map: what a unit of that team standing there would face
+struct FTacThreatCell
+{
+	// Expected damage of one attack from each enemy able to hit the cell, before the victim's defenses
+	float ExpectedDamage = 0.0f;
+	// Enemies that can hit the cell without moving
+	int32 Attackers = 0;
+	// Friendly healers that can heal the cell without moving
+	int32 Healers = 0;
+};
+
+// Per-team threat and influence maps over the 50 grid cells, for AI movement, danger overlays and
+// auto-positioning. Each on-field unit's influence (reach masks and expected damage of its auto-attack
+// weapons) is cached and only recomputed when the grid journal names the unit, it broadcasts a stat
+// change, a status change switches it between able and unable to act, or any stat modifier or base
+// moves (accuracy penalties and descriptor magnitude changes raise no unit event). An influence that
+// changed is subtracted from and re-added to the maps. Reads catch up on those changes first, so a
+// read is O(1) per cell.
+UCLASS()
+class KBS_API UTacThreatMapService : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Initialize(UGridDataManager* InDataManager);
+
+	// Map of Side: threats from its enemies, coverage from its own healers. Reads catch up on pending
+	// changes first, hence non-const.
+	FTacThreatCell GetThreat(ETeamSide Side, const FTacCoordinates& Cell);
+	float GetExpectedDamage(ETeamSide Side, const FTacCoordinates& Cell);
+	int32 GetAttackerCount(ETeamSide Side, const FTacCoordinates& Cell);
+	int32 GetHealerCount(ETeamSide Side, const FTacCoordinates& Cell);
+	// Cells (GridBitboard layout) where at least one enemy of Side can hit
+	uint64 GetThreatenedMask(ETeamSide Side);
+	// Drops every cached influence and recomputes the maps from the grid
+	void Rebuild();
+
+private:
+	// Expected damage is summed in fixed point so add/subtract cycles never drift
+	static constexpr int32 DamageScale = 100;
+
+	struct FUnitInfluence
+	{
+		TWeakObjectPtr<AUnit> Unit;
+		ETeamSide Team;
+		bool bCanAct = false;
+		// Cells next to the unit, hit by its melee and ranged weapons alike
+		uint64 CloseMask = 0;
+		// Cells only its ranged weapons reach
+		uint64 ReachMask = 0;
+		int32 CloseDamage = 0;
+		int32 ReachDamage = 0;
+		uint64 HealMask = 0;
+
+		bool HasSameEffect(const FUnitInfluence& Other) const
+		{
+			return Team == Other.Team && bCanAct == Other.bCanAct && CloseMask == Other.CloseMask
+				&& ReachMask == Other.ReachMask && CloseDamage == Other.CloseDamage
+				&& ReachDamage == Other.ReachDamage && HealMask == Other.HealMask;
+		}
+	};
+
+	struct FTeamMap
+	{
+		int32 ExpectedDamage[GridBitboard::NumCells] = {};
+		uint8 Attackers[GridBitboard::NumCells] = {};
+		uint8 Healers[GridBitboard::NumCells] = {};
+		uint64 ThreatenedMask = 0;
+	};
+
+	UFUNCTION()
+	void HandleUnitStatsModified(AUnit* Unit, FUnitCoreStats& Stats);
+
+	// Pulls grid changes, status and stat changes and stat notifications since the last read into the maps
+	void CatchUp();
+	// Recomputes a unit's influence; the maps are only touched if it changed
+	void UpdateUnit(AUnit* Unit);
+	void ComputeInfluence(AUnit* Unit, FUnitInfluence& OutInfluence) const;
+	// Adds (Sign 1) or removes (Sign -1) a unit's influence from the maps
+	void ApplyInfluence(const FUnitInfluence& Influence, int32 Sign);
+	// Catches up, then returns the map
+	const FTeamMap& GetMap(ETeamSide Side);
+
+	UPROPERTY()
+	TObjectPtr<UGridDataManager> DataManager;
+
+	FTeamMap Maps[2];
+	TMap<TObjectKey<AUnit>, FUnitInfluence> Influences;
+	TArray<TWeakObjectPtr<AUnit>, TInlineAllocator<8>> DirtyUnits;
+	uint32 CachedGridVersion = 0;
+	uint32 CachedStatusSerial = 0;
+	uint32 CachedStatSerial = 0;
+};
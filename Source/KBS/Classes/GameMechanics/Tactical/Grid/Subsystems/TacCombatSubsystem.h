@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "GameplayTypes/CombatTypes.h"
+#include "GameMechanics/Tactical/BattleRandomStream.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/CombatPhaseRegistry.h"
 #include "TacCategoryLogger.h"
 #include "TacCombatSubsystem.generated.h"
 
@@ -40,7 +42,19 @@ public:
 	UTacAbilityExecutorService* GetAbilityExecutorService() const { return AbilityExecutorService; }
 	UTacCombatStatisticsService* GetCombatStatisticsService() const { return CombatStatisticsService; }
 
+	// Every roll of the battle draws from this stream; seeded randomly on Initialize unless SeedBattle overrides it
+	FBattleRandomStream& GetRandomStream() { return RandomStream; }
+	// AI search seeds draw from here, derived from the battle seed, so thinking and speculation never
+	// move the battle's rolls
+	FBattleRandomStream& GetAIRandomStream() { return AIRandomStream; }
+	void SeedBattle(int32 Seed);
+	// Native phase hooks, priority ordered and filterable by unit and side; gameplay code binds here
+	FCombatPhaseRegistry& GetPhaseListeners() { return PhaseListeners; }
+
 	TArray<FCombatHitResult> ResolveAttack(AUnit* Attacker, TArray<AUnit*> Targets, UCombatDescriptor* Descriptor);
+	// Multi-target attacks take ResolveHitsBatched while enabled (the default); off, every hit runs the
+	// per-hit phases, the baseline the batched path is measured against
+	void SetBatchedResolution(bool bEnabled) { bBatchedResolution = bEnabled; }
 
 	TArray<FCombatHitResult> ResolveReactionAttack(AUnit* Attacker, TArray<AUnit*> Targets, UCombatDescriptor* Descriptor);
 	
@@ -50,7 +64,8 @@ public:
 	void ExecuteSideEffectApplicationPhase(FCombatContext& Context, FHitInstance& Hit, FCombatHitResult& Result);
 	void ExecuteEffectApplicationPhase(FCombatContext& Context, FHitInstance& Hit, FCombatHitResult& Result);
 
-	// Events
+	// Blueprint-facing events: broadcast after the native listeners of the same phase, and only
+	// touched at all while something is bound
 	UPROPERTY(BlueprintAssignable)
 	FOnPreResolutionPhase OnPreResolutionPhase;
 	UPROPERTY(BlueprintAssignable)
@@ -64,6 +79,13 @@ public:
 
 private:
 	TArray<FCombatHitResult> ResolveAttackInternal(FCombatContext& Context);
+	// Multi-target reaches: calculation hooks for every hit, each hit's chance read right after its own hooks,
+	// then accuracy rolls and damage for all surviving hits in flat loops, then application and its hooks hit
+	// by hit. Hit and attack cancellation match the per-hit path; accuracy rolls are drawn before any effect
+	// roll of the attack.
+	void ResolveHitsBatched(FCombatContext& Context, TArray<FCombatHitResult>& Results);
+	static constexpr int32 BatchResolutionMinHits = 2;
+	bool bBatchedResolution = true;
 	void LogResolutionStart(FCombatContext& Context);
 
 	UPROPERTY()
@@ -71,4 +93,7 @@ private:
 	UPROPERTY()
 	UTacCombatStatisticsService* CombatStatisticsService;
 	TUniquePtr<FTacCategoryLogger> CombatLogger;
+	FBattleRandomStream RandomStream;
+	FBattleRandomStream AIRandomStream;
+	FCombatPhaseRegistry PhaseListeners;
 };
@@ -11,10 +11,14 @@ DECLARE_LOG_CATEGORY_EXTERN(LogTacGrid, Log, All);
 class UGridDataManager;
 class UTacGridMovementService;
 class UTacGridTargetingService;
+class UTacThreatMapService;
 class AUnit;
 class UBattleTeam;
 class UUnitDefinition;
+class UGridConfig;
 enum class EHighlightType : uint8;
+enum class EUnitQuerySource : uint8;
+enum class ETeamSide : uint8;
 UCLASS()
 class KBS_API UTacGridSubsystem : public UWorldSubsystem
 {
@@ -25,6 +29,8 @@ public:
 
 	UTacGridMovementService* GetGridMovementService() { return GridMovementService; }
 	UTacGridTargetingService* GetGridTargetingService() { return GridTargetingService; }
+	// Per-team threat/influence maps; null before the grid registers
+	UTacThreatMapService* GetThreatMapService() const { return ThreatMapService; }
 	AUnit* SpawnSummonedUnit(TSubclassOf<AUnit> UnitClass, UUnitDefinition* Definition,
 	                         FTacCoordinates Cell, UBattleTeam* Team);
 
@@ -32,15 +38,18 @@ public:
 	void ClearHighlights(EHighlightType HighlightType);
 	void ClearAllHighlights();
 
-	TArray<AUnit*> GetActiveUnits();       // on-field alive
-	TArray<AUnit*> GetAllAliveUnits();     // on-field + off-field alive
-	TArray<AUnit*> GetAllUnits();          // everything
-	TArray<AUnit*> GetDeadUnits();
+	// Allocation-free enumeration over the data manager's maintained rosters: OnField is the alive
+	// units on the grid, OnField | OffField every alive unit, Corpses the dead
+	TArrayView<const TObjectPtr<AUnit>> GetUnitRoster(EUnitQuerySource Source, ETeamSide Side) const;
+	void ForEachUnit(EUnitQuerySource Sources, TFunctionRef<void(AUnit*)> Visitor) const;
 	UBattleTeam* GetAttackerTeam();
 	UBattleTeam* GetDefenderTeam();
 	UBattleTeam* GetPlayerTeam();
 	bool IsBothTeamsAnyUnitAlive();
 	UBattleTeam* GetWinnerTeam();
+	const UGridConfig* GetGridConfig() const;
+	// FGridChangeJournal version; 0 before the grid registers
+	uint32 GetGridVersion() const;
 
 	bool GetUnitCoordinates(const AUnit* Unit, FTacCoordinates& OutCoordinates) const;
 
@@ -60,6 +69,8 @@ private:
 	UPROPERTY()
 	TObjectPtr<UTacGridTargetingService> GridTargetingService;
 	UPROPERTY()
+	TObjectPtr<UTacThreatMapService> ThreatMapService;
+	UPROPERTY()
 	TObjectPtr<class UGridHighlightComponent> HighlightComponent;
 
 
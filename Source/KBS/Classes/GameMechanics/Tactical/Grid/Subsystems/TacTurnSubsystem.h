@@ -49,6 +49,11 @@ public:
 
 	// Battle control
 	void StartBattle();
+	// Headless batch runs: every unit is AI-driven and transitions chain through whole turns instead of
+	// stopping for input, until the battle ends or RoundLimit rounds have been played
+	void EnableInstantTransitions(int32 RoundLimit);
+	bool IsInstantTransitions() const { return bInstantTransitions; }
+	bool IsBattleOver() const;
 
 	// Turn order operations
 	void Wait();
@@ -66,11 +71,14 @@ public:
 	AUnit* GetCurrentUnit() const;
 	TArray<AUnit*> GetRemainingUnits(int32 TruncList = -1) const;
 	int32 GetUnitInitiative(AUnit* Unit) const;
+	const FRolledInitiative* FindUnitRolledInitiative(const AUnit* Unit) const;
 
 	UFUNCTION(BlueprintCallable)
 	void GridAvailable();
 	UFUNCTION(BlueprintCallable)
 	void OnPresentationComplete();
+	// Game thread, posted by UTacAICombatService when an off-thread decision is ready
+	void OnAIDecisionReady();
 
 private:
 	UFUNCTION()
@@ -79,7 +87,6 @@ private:
 	void InitializeStates();
 	void TransitionToState(ETurnState NextState);
 	void AttemptTransition();
-	void AttemptTransition(int32 Depth);
 
 	void ReloadTurnOrder();
 	void BroadcastRoundStart();
@@ -94,6 +101,8 @@ private:
 	TUniquePtr<FTacCategoryLogger> AILogger;
 	FTacTurnState* CurrentState = nullptr;
 	int32 CurrentRound = 0;
+	bool bInstantTransitions = false;
+	int32 InstantRoundLimit = 0;
 	UTacGridSubsystem* GridSubsystem = nullptr;
 	UPROPERTY()
 	TObjectPtr<UTacAICombatService> AICombatService;
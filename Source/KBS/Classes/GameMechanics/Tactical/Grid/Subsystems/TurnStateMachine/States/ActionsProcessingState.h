@@ -1,6 +1,7 @@
 #pragma once
 #include "TacTurnState.h"
 #include "GameplayTypes/GridCoordinates.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/Services/TacAICombatService.h"
 
 class UTacAbilityExecutorService;
 
@@ -13,6 +14,7 @@ public:
 	virtual void CellClicked(FTacCoordinates Cell) override;
 	virtual void AbilityClicked(UUnitAbility* Ability) override;
 	virtual void OnPresentationComplete() override;
+	virtual void OnAIDecisionReady() override;
 	virtual ETurnState NextState() override;
 
 	explicit FActionsProcessingState(UTacTurnSubsystem* Parent) : FTacTurnState(
@@ -23,7 +25,12 @@ private:
 	void CheckAbilitiesAndSetupTurn();
 	bool IsAIUnit(AUnit* Unit) const;
 	void HandleAITurn(AUnit* Unit);
+	void ExecuteAIDecision(AUnit* Unit, const FAiDecision& Decision);
+	// Puts the presentation time of the current action to use for the AI unit expected to act next
+	void SpeculateNextAITurn();
+	TFunction<void()> MakeAIReadyCallback() const;
 
 	UTacAbilityExecutorService* ExecutorService = nullptr;
 	bool bBattleEnded = false;
+	FAiThinkTask PendingThink;
 };
@@ -24,6 +24,7 @@ enum class ETurnProcessingSubstate : uint8
 	EFreeState, // can release state
 	EAwaitingPresentationState, // can release, but needs presentation to end
 	EAwaitingInputState, // can not proceed until input
+	EAwaitingAIState, // can not proceed until the off-thread AI decision arrives
 	EProcessingEndState
 };
 class AUnit;
@@ -44,6 +45,7 @@ public:
 	virtual void CellClicked(FTacCoordinates Cell) {}
 	virtual void AbilityClicked(UUnitAbility * Ability) {}
 	virtual void OnPresentationComplete() {}
+	virtual void OnAIDecisionReady() {}
 	void SetParentTurnSubsystem(UTacTurnSubsystem * Parent) { ParentTurnSubsystem = Parent; };
 	virtual ETurnProcessingSubstate CanReleaseState(){ return TurnProcessing; };
 	virtual ETurnState NextState() = 0;
@@ -4,6 +4,7 @@
 
 class AUnit;
 class UBattleTeam;
+class FBattleRandomStream;
 struct FRolledInitiative
 {
 	int32 Rolled;
@@ -11,13 +12,13 @@ struct FRolledInitiative
 	int32 WaitModifier;
 	FRolledInitiative(int32 Base);
 	FRolledInitiative();
-	int32 MakeRoll();
+	int32 MakeRoll(FBattleRandomStream& Random);
 	int32 GetCurrent() const;
 	void Wait();
 	bool CanWait() const;
 	void UpdateBasic(int32 Base);
 
-	static int32 RollInitiative();
+	static int32 RollInitiative(FBattleRandomStream& Random);
 	static bool BreakTie(AUnit* UnitA, AUnit* UnitB, UBattleTeam* AttackerTeam); 
 	static constexpr int32 LOWER_INITIATIVE_ROLL = -4;
 	static constexpr int32 UPPER_INITIATIVE_ROLL = 4;
@@ -29,10 +30,13 @@ class FTacTurnOrder
 {
 public:
 	FTacTurnOrder();
+	// Battle-owned stream every initiative roll draws from; must be set before the first Repopulate
+	void SetRandomStream(FBattleRandomStream& InRandom) { Random = &InRandom; }
 	AUnit* GetCurrentUnit();
 	// returns up to Trunc units from queue except current
 	TArray<AUnit*> GetRemainingUnits(int32 TruncList=-1) const;
 	int32 GetUnitInitiative(AUnit* Unit) const;
+	const FRolledInitiative* FindRolledInitiative(const AUnit* Unit) const;
 	// returns previous current unit, pops queue and replaces current unit
 	AUnit* Advance();
 	// Resorts queue by Unit ModifiedStats->Initiative
@@ -59,4 +63,5 @@ private:
 	TWeakObjectPtr<AUnit> CurrentUnit;
 	TMap<FGuid, FRolledInitiative> RolledInitiative;
 	TWeakObjectPtr<UBattleTeam> AttackerTeam;
+	FBattleRandomStream* Random = nullptr;
 };
@@ -5,6 +5,7 @@
 #include "GameMechanics/Units/UnitDefinition.h"
 #include "BattleTeam.h"
 #include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/AITypes.h"
 #include "Editor/TacGridEditorInitializer.h"
 #include "TacBattleGrid.generated.h"
 
@@ -35,6 +36,12 @@ public:
 	TObjectPtr<UMaterialInterface> FriendlyDecalMaterial;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teams")
 	ETeamSide PlayerTeamSide = ETeamSide::Attacker;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teams|AI")
+	EAIDecisionEngine AttackerAI = EAIDecisionEngine::Heuristic;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teams|AI")
+	EAIDecisionEngine DefenderAI = EAIDecisionEngine::Heuristic;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teams|AI")
+	FAISearchSettings SearchSettings;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Highlight|VFX", meta = (DisplayName = "Niagara Systems (indexed by EHighlightType)"))
 	TArray<TObjectPtr<class UNiagaraSystem>> HighlightNiagaraSystems;
@@ -92,6 +92,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Presentation")
 	bool IsBatchComplete(FBatchHandle BatchHandle) const;
 
+	// Headless runs: batches and operations are not tracked at all, so the subsystem is always idle
+	// and nothing ever waits on a montage or VFX that will not play
+	void SetInstantMode(bool bInInstantMode) { bInstantMode = bInInstantMode; }
+	bool IsInstantMode() const { return bInstantMode; }
+
 	// Events
 	UPROPERTY(BlueprintAssignable, Category = "Presentation")
 	FOnAllPresentationsComplete OnAllPresentationsComplete;
@@ -161,6 +166,7 @@ private:
 	// Sanity timer: fires once after 10s if a batch is still pending; resets on each completion
 	FTimerHandle SanityTimerHandle;
 	bool bSanityResolving = false;
+	bool bInstantMode = false;
 	void RefreshSanityTimer();
 	void StopSanityTimer();
 	void OnSanityTimerFired();
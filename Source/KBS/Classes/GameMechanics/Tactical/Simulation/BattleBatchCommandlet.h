@@ -0,0 +1,46 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GameMechanics/Tactical/Simulation/BattleMatchup.h"
+#include "GameMechanics/Tactical/Simulation/BattleSimulator.h"
+#include "BattleBatchCommandlet.generated.h"
+
+class UGridConfig;
+
+// Nightly balance runs: plays every matchup through the real UTacTurnSubsystem state machine in a bare
+// game world, with instant transitions and presentation disabled, and writes CSV and JSON summaries.
+//   UnrealEditor-Cmd KBS -run=BattleBatch -nullrhi (-Matchups=File.json | -Table=/Game/Path/DT_Matchups)
+//       [-GridConfig=/Game/Path/GridConfig] [-Runs=10] [-MaxRounds=50] [-Seed=0] [-Workers=N] [-Results=Path/Base]
+// A world is game-thread bound, so cores are used by splitting the runs across -Workers child processes
+// (physical core count by default) and merging their results.
+UCLASS()
+class KBS_API UBattleBatchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UBattleBatchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FBatchSettings
+	{
+		UGridConfig* DefaultGridConfig = nullptr;
+		int32 Runs = 10;
+		int32 MaxRounds = FBattleSimulator::DefaultMaxRounds;
+		int32 Seed = 0;
+	};
+
+	static bool LoadMatchups(const FString& Params, TArray<FBattleMatchup>& OutMatchups);
+	// Plays the runs whose batch-wide index falls on Shard; results keep the matchup order
+	static void RunShard(const TArray<FBattleMatchup>& Matchups, const FBatchSettings& Settings, int32 Shard,
+	                     int32 NumShards, TArray<FBattleMatchupResult>& OutResults);
+	static void RunBattle(const FBattleMatchup& Matchup, UGridConfig* GridConfig, const FBatchSettings& Settings,
+	                      int32 Seed, FBattleMatchupResult& Result);
+	static bool RunWorkers(int32 NumWorkers, const FString& ResultsBase, int32 NumMatchups,
+	                       TArray<FBattleMatchupResult>& OutResults);
+
+	static bool WriteJson(const FString& Path, const TArray<FBattleMatchupResult>& Results);
+	static bool ReadJson(const FString& Path, TArray<FBattleMatchupResult>& OutResults);
+	static bool WriteCsv(const FString& Path, const TArray<FBattleMatchupResult>& Results);
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BattleEstimateCommandlet.generated.h"
+
+// Estimates the outcome of the battle placed on a map's ATacBattleGrid:
+//   UnrealEditor-Cmd KBS -run=BattleEstimate -Map=/Game/Maps/Arena [-Runs=10000] [-Seed=N] [-MaxRounds=50]
+// Without -Seed a random one is picked and logged, so any estimate can be reproduced. Maps with a
+// placement FBattleSetup refuses, such as a unit the simulation cannot replay, are not estimated.
+UCLASS()
+class KBS_API UBattleEstimateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UBattleEstimateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameMechanics/Tactical/Simulation/BattleSimulator.h"
+#include <atomic>
+
+class FBattleTranspositionTable;
+
+struct FBattleExpectimaxParams
+{
+	// Unit turns below the root; searched by iterative deepening, so a short budget still answers
+	int32 MaxDepth = 4;
+	double TimeBudgetSeconds = 0.05;
+	// Forward pruning: only the best move cells by distance to the enemy are searched
+	int32 MaxMovesPerTurn = 4;
+	// Optional; once set the search stops, even inside the first iteration
+	const std::atomic<bool>* Cancel = nullptr;
+	// Optional and shareable between searches; each search uses a private table when null
+	FBattleTranspositionTable* Table = nullptr;
+};
+
+struct FBattleExpectimaxResult
+{
+	FSimAction Action;
+	// Deepest iteration that finished inside the budget; 0 when the answer is the default policy
+	int32 Depth = 0;
+	int64 Nodes = 0;
+	// Expected score of Action for the side that plays it, 0..1
+	double ExpectedScore = 0.0;
+};
+
+// Depth-limited expectiminimax over the upcoming turn order: the deciding unit's side maximizes, the
+// other side minimizes, and attacks with an accuracy roll become chance nodes weighted by
+// FPreviewHitResult::HitProbability. Alpha-beta runs through the chance nodes with Star1 bounds
+// (scores are confined to 0..1), and attacks are ordered by expected damage with kills first.
+// Decision nodes go through a transposition table, which also supplies the first move to try.
+// The turn order within a round is exact; initiative for later rounds is sampled from the state's
+// stream rather than enumerated.
+class KBS_API FBattleExpectimax
+{
+public:
+	// Root must be mid-turn, with the deciding unit as FBattleState::GetCurrentUnit
+	static FBattleExpectimaxResult Search(const FBattleState& Root, const FBattleExpectimaxParams& Params);
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "GameMechanics/Tactical/Grid/Editor/TacGridEditorInitializer.h"
+#include "BattleMatchup.generated.h"
+
+class UGridConfig;
+
+// One balance scenario: the placements UTacGridEditorInitializer spawns, on a given grid config.
+// Usable as a DataTable row or as an element of a JSON array.
+USTRUCT(BlueprintType)
+struct KBS_API FBattleMatchup : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	// Falls back to the DataTable row name when empty
+	UPROPERTY(EditAnywhere, Category = "Matchup")
+	FString Name;
+
+	UPROPERTY(EditAnywhere, Category = "Matchup")
+	TArray<FUnitPlacement> Placements;
+
+	// Falls back to the commandlet's -GridConfig when unset
+	UPROPERTY(EditAnywhere, Category = "Matchup")
+	TObjectPtr<UGridConfig> GridConfig = nullptr;
+
+	// 0 uses the commandlet's -Runs
+	UPROPERTY(EditAnywhere, Category = "Matchup", meta = (ClampMin = "0"))
+	int32 Runs = 0;
+};
+
+// Raw counts only, so results from separate worker processes merge by addition
+USTRUCT()
+struct KBS_API FBattleMatchupResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Name;
+
+	UPROPERTY()
+	int32 Runs = 0;
+
+	UPROPERTY()
+	int32 AttackerWins = 0;
+
+	UPROPERTY()
+	int32 DefenderWins = 0;
+
+	// Round limit reached or no winner
+	UPROPERTY()
+	int32 Unresolved = 0;
+
+	UPROPERTY()
+	int64 TotalRounds = 0;
+
+	UPROPERTY()
+	double Seconds = 0.0;
+
+	void Merge(const FBattleMatchupResult& Other);
+	double GetAttackerWinRate() const { return Runs > 0 ? static_cast<double>(AttackerWins) / Runs : 0.0; }
+	double GetAverageRounds() const { return Runs > 0 ? static_cast<double>(TotalRounds) / Runs : 0.0; }
+};
+
+// Pure steps of UBattleBatchCommandlet, kept apart from its world and file handling
+namespace BattleBatch
+{
+	// Reads a JSON array of matchups, naming unnamed ones MatchupN by position; false if it is not one
+	KBS_API bool ParseMatchups(const FString& Json, TArray<FBattleMatchup>& OutMatchups);
+	// Runs are dealt round-robin by their batch-wide index
+	inline bool IsInShard(int32 BatchIndex, int32 Shard, int32 NumShards) { return BatchIndex % NumShards == Shard; }
+	// Depends only on the batch seed, matchup and run, so a result never changes with the worker count
+	KBS_API int32 GetRunSeed(int32 BatchSeed, const FString& MatchupName, int32 Run);
+	// Adds one shard's results into OutResults by matchup position; false if the matchup counts differ
+	KBS_API bool MergeShard(const TArray<FBattleMatchupResult>& ShardResults, TArray<FBattleMatchupResult>& OutResults);
+	// Header row plus one row per matchup; names are quoted, with embedded quotes doubled
+	KBS_API FString ToCsv(const TArray<FBattleMatchupResult>& Results);
+}
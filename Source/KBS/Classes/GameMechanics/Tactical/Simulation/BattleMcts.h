@@ -0,0 +1,38 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameMechanics/Tactical/Simulation/BattleSimulator.h"
+#include <atomic>
+
+struct FBattleSearchParams
+{
+	// The search stops at whichever limit comes first; iterations are split across workers
+	int32 MaxIterations = 4000;
+	double TimeBudgetSeconds = 0.05;
+	// 0 uses every task graph worker
+	int32 NumWorkers = 0;
+	// Rollouts stop this many rounds past the root and score the position with EvaluatePosition
+	int32 RolloutRounds = 6;
+	double Exploration = 0.7;
+	int32 Seed = 0;
+	// Optional; once set the search stops as if the time budget ran out
+	const std::atomic<bool>* Cancel = nullptr;
+};
+
+struct FBattleSearchResult
+{
+	FSimAction Action;
+	int32 Iterations = 0;
+	// Mean score of Action for the side that plays it, 0..1
+	double ExpectedScore = 0.0;
+};
+
+// Monte Carlo Tree Search over the current unit's (action, cell) choices. Open-loop: tree nodes are
+// action sequences and every iteration replays them on a fresh copy of the root with its own rolls,
+// so chance outcomes are sampled rather than stored. Root-parallel: each worker grows its own tree
+// and the root statistics are summed, picking the most visited action.
+class KBS_API FBattleMcts
+{
+public:
+	// Root must be mid-turn, with the deciding unit as FBattleState::GetCurrentUnit
+	static FBattleSearchResult Search(const FBattleState& Root, const FBattleSearchParams& Params);
+};
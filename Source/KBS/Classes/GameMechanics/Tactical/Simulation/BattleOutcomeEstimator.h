@@ -0,0 +1,58 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameMechanics/Tactical/Simulation/BattleSimulator.h"
+
+// Sample mean with a two-sided confidence interval
+struct FSimEstimate
+{
+	double Mean = 0.0;
+	double Low = 0.0;
+	double High = 0.0;
+};
+
+struct FSimUnitEstimate
+{
+	FString Name;
+	ETeamSide Team = ETeamSide::Attacker;
+	FTacCoordinates StartCell;
+	FSimEstimate DamageDealt;
+	FSimEstimate DamageTaken;
+	double SurvivalRate = 0.0;
+};
+
+struct FBattleEstimate
+{
+	int32 Runs = 0;
+	int32 Seed = 0;
+	int32 Wins[2] = { 0, 0 };
+	// Round limit reached or both sides wiped
+	int32 Unresolved = 0;
+	// Wilson score interval, indexed by ETeamSide
+	FSimEstimate WinRate[2];
+	// Over decided battles only
+	FSimEstimate TurnsToFinish;
+	// Same order as FBattleState::GetUnits
+	TArray<FSimUnitEstimate> Units;
+	double WallSeconds = 0.0;
+
+	const FSimEstimate& GetWinRate(ETeamSide Side) const { return WinRate[static_cast<int32>(Side)]; }
+};
+
+struct FBattleEstimateParams
+{
+	int32 Runs = 1000;
+	// Root of every run's stream; the same seed gives the same estimate on any core count
+	int32 Seed = 0;
+	int32 MaxRounds = FBattleSimulator::DefaultMaxRounds;
+	// Normal quantile for the intervals; 1.96 is 95%
+	double ZScore = 1.96;
+};
+
+// Monte Carlo win-probability estimate: plays Runs copies of a battle to the end with the default
+// policy, spread over task graph workers, each copy on its own stream forked from Params.Seed
+class KBS_API FBattleOutcomeEstimator
+{
+public:
+	static FBattleEstimate Estimate(const FBattleState& Initial, const FBattleEstimateParams& Params);
+	static void LogEstimate(const FBattleEstimate& Estimate);
+};
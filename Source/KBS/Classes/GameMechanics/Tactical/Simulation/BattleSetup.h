@@ -0,0 +1,50 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+
+struct FUnitPlacement;
+class UTacGridSubsystem;
+class UTacTurnSubsystem;
+
+// Builds an FBattleState, either the opening one from the placements UTacGridEditorInitializer spawns or
+// a snapshot of a live battle, and owns the unit templates and effects that state (and every copy of it)
+// points into. Move-only for that reason. Units FSimUnitTemplate::FromDefinition refuses are never added,
+// so a matchup with one of them is refused rather than simulated without it.
+class KBS_API FBattleSetup
+{
+public:
+	FBattleSetup() = default;
+	FBattleSetup(FBattleSetup&&) = default;
+	FBattleSetup& operator=(FBattleSetup&&) = default;
+
+	// Returns false and logs when the placement has no definition, an invalid cell or an occupied one,
+	// or a unit the simulation cannot replay
+	bool AddPlacement(const FUnitPlacement& Placement);
+	// Returns how many placements were added
+	int32 AddPlacements(TConstArrayView<FUnitPlacement> Placements);
+	// Game thread only. Copies the on-field units with their current stats and this round's turn queue,
+	// current unit mid-turn. Must be called on an empty setup; false if there is no current unit to capture,
+	// or if an on-field unit or an effect on one is something the simulation cannot replay.
+	bool CaptureLive(const UTacGridSubsystem& GridSubsystem, const UTacTurnSubsystem& TurnSubsystem);
+	// CaptureLive, then ends the current turn and begins the next queued one, the way the state machine
+	// will once the current unit is done. False when the round has nobody left after the current unit.
+	bool CaptureLiveNextTurn(const UTacGridSubsystem& GridSubsystem, const UTacTurnSubsystem& TurnSubsystem);
+
+	const FBattleState& GetInitialState() const { return Initial; }
+	int32 GetNumUnits() const { return Initial.GetUnits().Num(); }
+
+private:
+	// Null when FromDefinition refuses the unit; refusals are remembered like templates
+	const FSimUnitTemplate* FindOrAddTemplate(const UUnitDefinition& Definition);
+	// Effect is the descriptor's shared one; null when FSimEffect::FromConfig refuses it
+	const FSimEffect* FindOrAddEffect(const UBattleEffect& Effect);
+
+	// Heap-allocated so template and effect addresses survive the setup being moved
+	TArray<TUniquePtr<FSimUnitTemplate>> Templates;
+	// INDEX_NONE for a refused definition
+	TMap<const UUnitDefinition*, int32> TemplateLookup;
+	// Effects live units already carry; the ones their weapons apply belong to the templates
+	TArray<TUniquePtr<FSimEffect>> Effects;
+	TMap<const UBattleEffect*, int32> EffectLookup;
+	FBattleState Initial;
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+
+struct FBattleSimResult
+{
+	// False when the round limit ran out before either side was wiped
+	bool bFinished = false;
+	bool bHasWinner = false;
+	ETeamSide Winner = ETeamSide::Attacker;
+	int32 Rounds = 0;
+	int32 Turns = 0;
+};
+
+// Runs an FBattleState to completion with every unit on the default AI policy
+class KBS_API FBattleSimulator
+{
+public:
+	static constexpr int32 DefaultMaxRounds = 50;
+
+	// Approximates UTacAICombatService::ThinkOverNextAction: first valid attack cell, else the move cell
+	// closest to any enemy (the live AI also weighs its threat maps), else wait; Skip when none of
+	// those is available
+	static FSimAction ChooseDefaultAction(const FBattleState& State, int32 UnitIndex);
+	// Every attack, move and wait the unit could try this turn; just Skip when it has none
+	static void GetCandidateActions(const FBattleState& State, int32 UnitIndex, TArray<FSimAction, TInlineAllocator<32>>& OutActions);
+	// Runs round/turn bookkeeping until a unit that can act holds the turn, and returns it.
+	// NoUnit once the battle is over or MaxRounds would be exceeded.
+	static int32 AdvanceToDecision(FBattleState& State, int32 MaxRounds = DefaultMaxRounds);
+	// Plays one full turn of the next unit in the queue, starting a new round when needed
+	static void StepTurn(FBattleState& State);
+	static FBattleSimResult Run(FBattleState& State, int32 MaxRounds = DefaultMaxRounds);
+	// Attacker's share of the position in [0, 1]: 1 or 0 once decided, otherwise by remaining health
+	static double EvaluatePosition(const FBattleState& State);
+};
@@ -0,0 +1,259 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameplayTypes/GridBitboard.h"
+#include "GameplayTypes/TeamConstants.h"
+#include "GameplayTypes/TargetingDescriptor.h"
+#include "GameplayTypes/CombatDescriptorTypes.h"
+#include "GameplayTypes/CombatTypes.h"
+#include "GameplayTypes/EffectTypes.h"
+#include "GameMechanics/Units/Stats/UnitStats.h"
+#include "GameMechanics/Units/Combat/CombatDescriptor.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffect.h"
+#include "GameMechanics/Tactical/BattleRandomStream.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TurnStateMachine/TacTurnOrder.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogKBSSim, Log, All);
+
+class UUnitDefinition;
+class UWeaponDataAsset;
+
+enum class ESimEffectKind : uint8
+{
+	DamageOverTime,
+	StatMod,
+};
+
+// Battle effect flattened from its config. Only the stock UTargetDOTBattleEffect and UStatModBattleEffect
+// are replayed, as per-unit state in FBattleState; any other class, subclasses of those two included, has
+// hooks the simulation cannot follow and FromConfig refuses it.
+struct KBS_API FSimEffect
+{
+	ESimEffectKind Kind = ESimEffectKind::DamageOverTime;
+	// Hash of the config the effect came from, so every copy of one effect keys the state hash alike
+	uint32 ConfigKey = 0;
+	EDamageSource DamageSource = EDamageSource::Physical;
+	bool bRequiresRoll = true;
+	int32 Duration = 1;
+	FName StackingId;
+	EEffectStackPolicy StackPolicy = EEffectStackPolicy::RefreshOld;
+	int32 MaxStacks = 1;
+	// DamageOverTime: dealt at the owner's turn end, ignoring armour and wards
+	float Magnitude = 0.0f;
+	// StatMod; 0 leaves the stat alone
+	int32 MaxHealthModifier = 0;
+	int32 InitiativeModifier = 0;
+	int32 AccuracyModifier = 0;
+	TArray<EDamageSource> ImmunitiesToGrant;
+	TArray<TPair<EDamageSource, int32>> ArmourModifiers;
+
+	// False when the class or its config is not one the simulation replays
+	static bool FromConfig(TSubclassOf<UBattleEffect> EffectClass, const UBattleEffectDataAsset* Config, FSimEffect& OutEffect);
+};
+
+// One application of an FSimEffect on a unit, the simulation's FActiveBattleEffect
+struct FSimActiveEffect
+{
+	const FSimEffect* Effect = nullptr;
+	int32 Duration = 0;
+	// Keys the armour and immunity modifiers of a StatMod, as FActiveBattleEffect::EffectId does
+	FGuid EffectId;
+	FAppliedStatModifiers StatModifiers;
+};
+
+// Weapon data flattened from UWeaponDataAsset the same way UCombatDescriptor::Initialize does it:
+// damage override applied, area shape compiled, effects converted to FSimEffect.
+struct KBS_API FSimWeapon
+{
+	FCombatDescriptorStats Stats;
+	EMagnitudePolicy MagnitudePolicy = EMagnitudePolicy::Damage;
+	FDescriptorSideEffects SideEffects;
+	TArray<FSimEffect> Effects;
+	// Same flag UCombatDescriptor::IsRequiringAccuracyRoll reports
+	bool bRequiresAccuracyRoll = false;
+	bool bUsableForAutoAttack = true;
+
+	// Returns false and logs when the weapon applies an effect FSimEffect::FromConfig refuses
+	static bool FromAsset(const UWeaponDataAsset& Asset, FSimWeapon& OutWeapon);
+};
+
+// Unit data flattened from UUnitDefinition. Built once per roster and shared read-only by every
+// battle that uses it, so a simulation never touches the asset after setup.
+struct KBS_API FSimUnitTemplate
+{
+	FString Name;
+	FUnitCoreStats BaseStats;
+	TArray<FSimWeapon> Weapons;
+	// Resolved like UAutoAttackAbility::GetTargeting; Strategy None when the unit has no attack
+	FTargetingDescriptor AttackTargeting;
+	FTargetingDescriptor GroundMoveTargeting;
+	FTargetingDescriptor AirMoveTargeting;
+	bool bHasMove = false;
+	bool bHasWait = false;
+	int32 FlankEntranceArrivalDelay = 3;
+	int32 FlankRearArrivalDelay = 3;
+
+	// Returns false and logs when the unit has anything the simulation cannot replay: a weapon FromAsset
+	// refuses, more than one cell, linear movement, passives or spells
+	static bool FromDefinition(const UUnitDefinition& Definition, FSimUnitTemplate& OutTemplate);
+	// Mirrors FDamageCalculation::SelectMaxReachDescriptor
+	const FSimWeapon* SelectMaxReachWeapon(bool bAutoAttackOnly) const;
+};
+
+struct KBS_API FSimUnit
+{
+	const FSimUnitTemplate* Template = nullptr;
+	FUnitCoreStats Stats;
+	FTacCoordinates Coords;
+	ETeamSide Team = ETeamSide::Attacker;
+	FRolledInitiative Initiative;
+	// Oldest first, as in UBattleEffectComponent; Effect points into a template's weapon or the setup
+	TArray<FSimActiveEffect, TInlineAllocator<2>> Effects;
+	// HP actually removed, not the raw damage roll
+	int32 DamageDealt = 0;
+	int32 DamageTaken = 0;
+	// Zobrist key of the hashed part of Stats, cached so a change can be XORed back out
+	uint64 StateKey = 0;
+
+	bool IsAlive() const { return !Stats.Status.IsDead(); }
+	bool IsOnFlank() const { return Coords.IsFlankCell(); }
+};
+
+enum class ESimActionKind : uint8
+{
+	Skip,
+	Attack,
+	Move,
+	Wait,
+};
+
+struct FSimAction
+{
+	ESimActionKind Kind = ESimActionKind::Skip;
+	FTacCoordinates Cell;
+
+	static FSimAction Skip() { return FSimAction(); }
+	static FSimAction Attack(const FTacCoordinates& Target) { return { ESimActionKind::Attack, Target }; }
+	static FSimAction Move(const FTacCoordinates& Target) { return { ESimActionKind::Move, Target }; }
+	static FSimAction Wait() { return { ESimActionKind::Wait, FTacCoordinates() }; }
+
+	bool operator==(const FSimAction& Other) const { return Kind == Other.Kind && Cell == Other.Cell; }
+};
+
+// How FBattleState::Apply resolves accuracy rolls. Forced outcomes let a search enumerate chance
+// nodes instead of sampling them; they apply to every target of the action alike. Effect application
+// rolls are not forced: they are always sampled from the state's stream.
+enum class ESimRollOutcome : uint8
+{
+	Roll,
+	Hit,
+	Miss,
+};
+
+// Pure-data battle: grid occupancy, per-unit stats and the turn queue, with no actors, components or
+// subsystems behind it. Copyable by value, so search AIs and batch runs can fork a position freely.
+// Rules replay UTacCombatSubsystem/UTacGridTargetingService/FTacTurnOrder for the default abilities;
+// every damage number comes from the stat-level FDamageCalculation overloads.
+class KBS_API FBattleState
+{
+public:
+	static constexpr int8 NoUnit = -1;
+
+	FBattleState();
+	explicit FBattleState(int32 Seed);
+
+	// Unit keeps a pointer to Template, which must outlive the state and every copy of it
+	int32 AddUnit(const FSimUnitTemplate& Template, ETeamSide Team, const FTacCoordinates& Coords);
+	// Mid-battle unit: current stats and this round's initiative instead of fresh ones. Effects are the
+	// ones already on it; Stats must already carry their modifiers, and each Effect must outlive the state
+	int32 AddUnit(const FSimUnitTemplate& Template, ETeamSide Team, const FTacCoordinates& Coords,
+	              const FUnitCoreStats& Stats, const FRolledInitiative& Initiative,
+	              TConstArrayView<FSimActiveEffect> Effects = {});
+	// Applies Effect to the unit with the stacking rules of UBattleEffectComponent::AddEffect; false when
+	// the stacking policy turned it away. Effect must outlive the state and every copy of it
+	bool AddEffect(int32 UnitIndex, const FSimEffect& Effect);
+	// Resumes a round in progress: Current is mid-turn and Remaining act after it, next first
+	// (the order FTacTurnOrder::GetRemainingUnits reports)
+	void SetTurn(int32 InRound, int32 Current, TConstArrayView<int32> Remaining);
+
+	// Round/turn flow, in the order FRoundStartState, FTurnStartState and FTurnEndState run it
+	void BeginRound();
+	// Pops the next unit and clears its defensive stance; NoUnit once the round is over
+	int32 BeginTurn();
+	void EndTurn();
+	bool IsRoundOver() const { return Queue.IsEmpty(); }
+
+	bool CanAct(int32 UnitIndex) const;
+	// Valid cells for the unit's default abilities, GridBitboard layout
+	uint64 GetAttackCells(int32 UnitIndex) const;
+	uint64 GetMoveCells(int32 UnitIndex) const;
+	bool CanWait(int32 UnitIndex) const;
+
+	// Executes Action for the current unit; returns false if it was not legal (state is then unchanged)
+	bool Apply(const FSimAction& Action, ESimRollOutcome Rolls = ESimRollOutcome::Roll);
+	// Current unit's default attack against the unit at Cell, from the stat-level
+	// FDamageCalculation::PreviewDamage. HitProbability is in percent like the live preview, and 100
+	// when the weapon skips the accuracy roll; all zero when Cell is not a valid attack target.
+	FPreviewHitResult PreviewAttack(const FTacCoordinates& Cell) const;
+
+	bool IsBattleOver() const { return AliveCount[0] == 0 || AliveCount[1] == 0; }
+	// False while both sides stand, and on a mutual wipe
+	bool GetWinner(ETeamSide& OutWinner) const;
+
+	int32 GetCurrentUnit() const { return CurrentUnit; }
+	int32 GetRound() const { return Round; }
+	int32 GetTurnsTaken() const { return TurnsTaken; }
+	int32 GetAliveCount(ETeamSide Side) const { return AliveCount[static_cast<int32>(Side)]; }
+	const TArray<FSimUnit>& GetUnits() const { return Units; }
+	const FSimUnit& GetUnit(int32 UnitIndex) const { return Units[UnitIndex]; }
+	int32 GetUnitAt(const FTacCoordinates& Coords) const { return Occupants[Coords.GetCellIndex()]; }
+	uint64 GetTeamMask(ETeamSide Side) const { return TeamMasks[static_cast<int32>(Side)]; }
+	uint64 GetOccupiedMask() const { return TeamMasks[0] | TeamMasks[1]; }
+	// Zobrist hash of the position: occupants, health, statuses, wards, effects, who has waited, the current unit
+	// and the queue order. Kept incrementally; round number, damage tallies, rolled initiative values and
+	// the random stream are not part of it, and as any 64-bit hash it can collide.
+	uint64 GetHash() const { return Hash; }
+	// Same hash rebuilt from scratch, to verify the incremental one
+	uint64 ComputeHash() const;
+	// Copies carry the stream along; reseed or Fork() it to make a copy diverge
+	FBattleRandomStream& GetRandomStream() { return Random; }
+	const FBattleRandomStream& GetRandomStream() const { return Random; }
+
+private:
+	uint64 GetAffiliationMask(const FSimUnit& Source, const FTargetingDescriptor& Desc) const;
+	// Mirrors FDamageCalculation::SelectWeaponForTarget with bAutoAttackOnly
+	const FSimWeapon* SelectWeaponForTarget(const FSimUnit& Attacker, const FSimUnit& Target) const;
+	bool ApplyAttack(const FTacCoordinates& Cell, ESimRollOutcome Rolls);
+	bool ApplyMove(const FTacCoordinates& Cell);
+	bool ApplyWait();
+	void ResolveHit(int32 AttackerIndex, const FSimWeapon& Weapon, int32 TargetIndex, ESimRollOutcome Rolls);
+	void PlaceUnit(int32 UnitIndex, const FTacCoordinates& Coords);
+	void RemoveFromGrid(int32 UnitIndex);
+	void KillUnit(int32 UnitIndex);
+	void ApplyEffect(int32 UnitIndex, const FSimEffect& Effect);
+	void RemoveEffectAt(int32 UnitIndex, int32 EffectIndex);
+	// Turn-end hooks of the unit's effects, as UBattleEffectComponent::OnOwnerTurnEnd runs them
+	void TickEffects(int32 UnitIndex);
+	void SortQueue();
+	void SetCurrentUnit(int8 UnitIndex);
+	// Recomputes the unit's StateKey after its stats changed and swaps it into Hash
+	void RehashUnit(int32 UnitIndex);
+	void RehashQueue();
+	uint64 ComputeUnitStateKey(int32 UnitIndex) const;
+	uint64 ComputeQueueHash() const;
+
+	TArray<FSimUnit> Units;
+	int8 Occupants[GridBitboard::NumCells];
+	uint64 TeamMasks[2] = { 0, 0 };
+	int32 AliveCount[2] = { 0, 0 };
+	// Ascending initiative; the last entry acts next, as in FTacTurnOrder
+	TArray<int8, TInlineAllocator<32>> Queue;
+	int8 CurrentUnit = NoUnit;
+	int32 Round = 0;
+	int32 TurnsTaken = 0;
+	// Numbers the EffectIds of effects applied in the simulation, so copies stay deterministic
+	uint32 NextEffectSerial = 0;
+	uint64 Hash = 0;
+	// Queue part of Hash, replaced wholesale whenever the queue is reordered
+	uint64 QueueHash = 0;
+	FBattleRandomStream Random;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+#include <atomic>
+
+enum class ETranspositionBound : uint8
+{
+	Exact,
+	// Value is at least the true score (search failed high)
+	Lower,
+	// Value is at most the true score (search failed low)
+	Upper,
+};
+
+struct FTranspositionEntry
+{
+	float Value = 0.0f;
+	int32 Depth = 0;
+	ETranspositionBound Bound = ETranspositionBound::Exact;
+	FSimAction BestAction;
+};
+
+// Bounded table of searched positions keyed by FBattleState::GetHash. Lock-free, so the workers of one
+// search (or several searches over the same battle) can share it: every slot keeps the key XORed with
+// the packed entry next to the entry itself, and a torn write just reads back as a miss.
+// A store replaces the slot unless it holds a deeper result for the same position.
+class KBS_API FBattleTranspositionTable
+{
+public:
+	explicit FBattleTranspositionTable(int32 CapacityLog2 = 16);
+
+	bool Probe(uint64 Key, FTranspositionEntry& OutEntry) const;
+	void Store(uint64 Key, const FTranspositionEntry& Entry);
+	void Clear();
+	int32 GetCapacity() const { return static_cast<int32>(IndexMask + 1); }
+
+private:
+	struct FSlot
+	{
+		std::atomic<uint64> Check{ 0 };
+		std::atomic<uint64> Data{ 0 };
+	};
+
+	static uint64 Pack(const FTranspositionEntry& Entry);
+	static FTranspositionEntry Unpack(uint64 Data);
+
+	TUniquePtr<FSlot[]> Slots;
+	uint64 IndexMask = 0;
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GameMechanics/Units/Abilities/UnitAbility.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/CombatPhaseRegistry.h"
+#include "GameMechanics/Units/Stats/BaseUnitStatTypes.h"
 #include "EvasiveStancePassive.generated.h"
 
 /**
@@ -8,8 +10,8 @@
  * by 20 (flat) during the calculation phase.
  *
  * Lifecycle per hit:
- *   Subscribe()             — binds to Owner->OnBeingTargetedInCalculation (non-dynamic)
- *   OnBeingTargeted()       — applies -20 flat modifier; registers with Hit.Interfere()
+ *   Subscribe()             — registers a Calculation-phase listener scoped to Owner as target
+ *   OnBeingTargeted()       — applies -20 flat modifier, keeping its handle; registers with Hit.Interfere()
  *   HitTriggerCleanup(Hit)  — removes the modifier (called by ~FHitInstance)
  *   Unsubscribe()           — unbinds on ability removal
  */
@@ -26,10 +28,11 @@ public:
 	virtual bool CanExecute() const override { return false; }
 
 private:
-	void OnBeingTargeted(FCombatContext& Context, FHitInstance& Hit);
+	void OnBeingTargeted(const FCombatPhaseEvent& Event);
 
 	static constexpr int32 AccuracyPenalty = -20;
 
-	// Stable per-instance ID used to add/remove the modifier on the attacker's Accuracy stat.
-	FGuid ModifierID;
+	// Penalty currently on the attacker's Accuracy; the owner is the target of at most one hit at a time.
+	FStatModifierHandle AppliedPenalty;
+	FCombatListenerHandle ListenerHandle;
 };
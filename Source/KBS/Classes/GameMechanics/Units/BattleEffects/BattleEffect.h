@@ -4,44 +4,93 @@
 #include "GameplayTypes/DamageTypes.h"
 #include "GameplayTypes/EffectTypes.h"
 #include "GameplayTypes/TargetingDescriptor.h"
+#include "GameMechanics/Units/Stats/BaseUnitStatTypes.h"
 #include "BattleEffectDataAsset.h"
 #include "BattleEffect.generated.h"
 class AUnit;
+class UBattleEffect;
 
 typedef TArray<TObjectPtr<UBattleEffect>> BattleEffectArray;
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEffectDurationChange, int32, NewDuration);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEffectRemoved, UBattleEffect*, Effect);
+// Stat modifiers one application of a stat-modifying effect added to its owner, one per stat it can
+// touch; invalid where the effect leaves the stat alone
+USTRUCT()
+struct FAppliedStatModifiers
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FStatModifierHandle MaxHealth;
+	UPROPERTY()
+	FStatModifierHandle Initiative;
+	UPROPERTY()
+	FStatModifierHandle Accuracy;
+};
 
+// One application of an effect on a unit. Effect is the descriptor's UBattleEffect, shared by every
+// application and never written to; all per-application state lives here, owned by UBattleEffectComponent.
+USTRUCT(BlueprintType)
+struct KBS_API FActiveBattleEffect
+{
+	GENERATED_BODY()
+
+	// Instance when the effect class keeps state of its own, otherwise the shared effect
+	UBattleEffect* GetEffect() const { return Instance ? Instance.Get() : Effect.Get(); }
+	UBattleEffectDataAsset* GetConfig() const;
+	bool IsExpired() const { return Duration <= 0; }
+
+	UPROPERTY(BlueprintReadOnly, Category = "Effect")
+	TObjectPtr<UBattleEffect> Effect;
+	// Per-application copy, only for classes whose RequiresInstance is true
+	UPROPERTY()
+	TObjectPtr<UBattleEffect> Instance;
+	UPROPERTY(BlueprintReadOnly, Category = "Effect")
+	TObjectPtr<AUnit> Owner;
+	UPROPERTY(BlueprintReadOnly, Category = "Effect")
+	TWeakObjectPtr<AUnit> Source;
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Effect")
+	FGuid EffectId;
+	UPROPERTY(BlueprintReadOnly, Category = "Effect")
+	int32 Duration = 0;
+	UPROPERTY()
+	FAppliedStatModifiers StatModifiers;
+};
+
+// Behaviour and configuration of an effect. Descriptors own one per configured effect; applying it
+// creates an FActiveBattleEffect rather than a new object, and every hook receives that state. Hooks on
+// shared effects must not write to the object itself - classes that need per-application members
+// override RequiresInstance and get a duplicate per application, as every effect used to.
 UCLASS(Abstract, Blueprintable)
 class KBS_API UBattleEffect : public UObject
 {
 	GENERATED_BODY()
 public:
 	virtual void Initialize(UBattleEffectDataAsset* InConfig);
-	void SetOwner(AUnit* InOwner) { Owner = InOwner; }
-	// Lifetime
+	// Fresh state for an application from Source; the component fills in the owner, and the instance if needed.
+	// Duration is the configured one; an applied instance re-reads it after PrepareForApply
+	FActiveBattleEffect CreateActive(AUnit* Source);
+	virtual bool RequiresInstance() const { return true; }
+	// Lifetime; PrepareForApply only runs on per-application instances
 	virtual void PrepareForApply(AUnit* Source, AUnit* Target) {}
-	virtual EReapplyDecision HandleReapply(UBattleEffect* NewEffect);
-	
+	virtual EReapplyDecision HandleReapply(const FActiveBattleEffect& Existing, const FActiveBattleEffect& Incoming);
+
 	// Triggers
-	virtual void OnApplied() {}
-	virtual void OnRemoved();
-	virtual void OnTurnStart() {}
-	virtual void OnTurnEnd() {}
-	virtual void OnUnitAttacked(AUnit* AttackingUnit) {}
-	virtual void OnUnitAttacks(AUnit* Target) {}
-	virtual void OnUnitMoved() {}
-	virtual void OnUnitDied() {}
-	
+	virtual void OnApplied(FActiveBattleEffect& Active) {}
+	virtual void OnRemoved(FActiveBattleEffect& Active) {}
+	virtual void OnTurnStart(FActiveBattleEffect& Active) {}
+	virtual void OnTurnEnd(FActiveBattleEffect& Active) {}
+	virtual void OnUnitAttacked(FActiveBattleEffect& Active, AUnit* AttackingUnit) {}
+	virtual void OnUnitAttacks(FActiveBattleEffect& Active, AUnit* Target) {}
+	virtual void OnUnitMoved(FActiveBattleEffect& Active) {}
+	virtual void OnUnitDied(FActiveBattleEffect& Active) {}
+
 	// Getters
 	FTargetingDescriptor GetEffectTargeting() const;
 	EDamageSource GetDamageSource() const;
 	FText GetEffectName() const { return Config->Name; }
-	int32 GetDuration() const { return Duration; }
+	// Duration an application starts with
+	int32 GetInitialDuration() const { return Duration; }
 	EEffectStackPolicy GetStackingPolicy() const { return Config->StackPolicy; }
-	void RefreshDuration(int32 InDuration) { Duration = FMath::Max(InDuration, Duration); }
-	bool IsExpired() const { return Duration <= 0; }
 	FName GetStackingId() const { return Config ? Config->StackingId : NAME_None; }
 	EEffectStackPolicy GetStackPolicy() const { return Config->StackPolicy; }
 	int32 GetStackLimit() const { return Config ? Config->MaxStacks : 0; }
@@ -49,26 +98,14 @@ public:
 	bool IsRequringRoll() const { return Config->bIsAccuracyDependent; }
 	bool IsDispellable() const { return Config->bIsDispellable; }
 	EEffectPolarity GetPolarity() const { return Config->Polarity; }
-	AUnit* GetOwner() const { return Owner; }
-	const FGuid& GetEffectId() const { return EffectId; }
 	bool HasTag(const FGameplayTag& Tag) const { return Config && Config->EffectTags.HasTag(Tag); }
 	bool HasAnyTag(const FGameplayTagContainer& Tags) const { return Config && Config->EffectTags.HasAny(Tags); }
-	
-	
-	UPROPERTY(BlueprintAssignable)
-	FOnEffectDurationChange OnDurationChange;
-	UPROPERTY(BlueprintAssignable)
-	FOnEffectRemoved OnEffectRemoved;
+
 protected:
-	void DecrementDuration() { if (Duration > 0) Duration--; BroadcastDurationChange(); }
-	void BroadcastDurationChange() const { OnDurationChange.Broadcast(Duration);}
-	virtual void NotifyOnTriggered();
+	static void DecrementDuration(FActiveBattleEffect& Active) { if (Active.Duration > 0) Active.Duration--; }
+	virtual void NotifyOnTriggered(const FActiveBattleEffect& Active);
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Effect")
 	TObjectPtr<UBattleEffectDataAsset> Config;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Effect")
 	int32 Duration = 0;
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Effect")
-	TObjectPtr<AUnit> Owner;
-	UPROPERTY(SaveGame)
-	FGuid EffectId;
 };
@@ -4,10 +4,17 @@
 #include "GameplayTypes/TacMovementTypes.h"
 #include "GameplayTags.h"
 #include "GameplayTypes/EffectTypes.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffect.h"
+#include "GameplayTypes/BattleZobrist.h"
 #include "BattleEffectComponent.generated.h"
-class UBattleEffect;
 class AUnit;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEffectDurationChange, const FGuid&, EffectId, int32, NewDuration);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEffectRemoved, const FGuid&, EffectId);
+
+// Owns the state of every effect applied to its unit as flat FActiveBattleEffect entries; the
+// UBattleEffect behind each entry is shared with the descriptor that applied it. Hooks run on a copy
+// of the entry, so they may add or remove effects (or kill the unit) without invalidating it.
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class KBS_API UBattleEffectComponent : public UActorComponent
 {
@@ -16,17 +23,24 @@ class KBS_API UBattleEffectComponent : public UActorComponent
 public:
 	UBattleEffectComponent();
 	virtual void BeginPlay() override;
-	bool AddEffect(UBattleEffect* Effect);
-	void RemoveEffect(UBattleEffect* Effect);
+	// Applies Effect from Source under its stacking policy; OutApplied receives the new entry's state
+	bool AddEffect(UBattleEffect* Effect, AUnit* Source, FActiveBattleEffect* OutApplied = nullptr);
 	void RemoveEffect(FName StackingId);
 	void RemoveEffect(const FGuid EffectId);
 	void ClearAllEffects();
-	const TArray<TObjectPtr<UBattleEffect>>& GetActiveEffects() const { return ActiveEffects; }
+	const TArray<FActiveBattleEffect>& GetActiveEffects() const { return ActiveEffects; }
+	const FActiveBattleEffect* FindEffect(const FGuid& EffectId) const;
+
+	// Zobrist key of the active effects and their durations, salted as FUnitHealth::GetHashKey
+	uint64 GetHashKey(uint32 Salt) const;
+	// Keeps the key XOR'd into Sink, updated whenever an entry is added, removed or changes duration
+	void BindLiveHash(const TSharedRef<uint64>& Sink, uint32 Salt) { LiveHash.Bind(Sink, Salt, GetHashKey(Salt)); }
+	void UnbindLiveHash() { LiveHash.Unbind(); }
 
 	// Quering
 	bool HasEffectWithTag(const FGameplayTag& Tag) const;
 	int32 CountEffectsWithTag(const FGameplayTag& Tag) const;
-	TArray<UBattleEffect*> GetEffectsMatching(
+	TArray<FGuid> GetEffectsMatching(
 		TOptional<FGameplayTag> Tag,
 		TOptional<EEffectPolarity> PolarityFilter = {},
 		TOptional<bool> DispellableFilter = {}) const;
@@ -35,11 +49,18 @@ public:
 		TOptional<FGameplayTag> TagFilter = {},
 		int32 MaxToRemove = MAX_int32);
 
+	UPROPERTY(BlueprintAssignable)
+	FOnEffectDurationChange OnEffectDurationChange;
+	UPROPERTY(BlueprintAssignable)
+	FOnEffectRemoved OnEffectRemoved;
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Effects")
-	TArray<TObjectPtr<UBattleEffect>> ActiveEffects;
+	TArray<FActiveBattleEffect> ActiveEffects;
 
 private:
+	BattleZobrist::FLiveBinding LiveHash;
+
 	AUnit* GetOwnerUnit() const;
 	UFUNCTION()
 	void OnOwnerTurnStart(AUnit* Unit);
@@ -53,11 +74,17 @@ private:
 	void OnOwnerMoved(AUnit* Unit, const FTacMovementVisualData& MovementData);
 	UFUNCTION()
 	void OnOwnerDied(AUnit* Unit);
-	
-	void BroadcastToEffects(TFunctionRef<void(UBattleEffect*)> Notify, bool bCheckExpiry = true);
-	UBattleEffect* FindByStackingId(FName StackingId) const;
+
+	using FEffectHook = TFunctionRef<void(UBattleEffect*, FActiveBattleEffect&)>;
+	void BroadcastToEffects(FEffectHook Notify, bool bCheckExpiry = true);
+	// Runs Notify on a copy of the entry, then writes it back (broadcasting a duration change) if it still exists
+	void RunHook(const FActiveBattleEffect& Entry, FEffectHook Notify);
+	int32 IndexOf(const FGuid& EffectId) const;
+	int32 FindByStackingId(FName StackingId) const;
 	int32 CountByStackingId(FName StackingId) const;
-	void ApplyEffect(UBattleEffect* Effect);
-	void ExecuteReapplyDecision(EReapplyDecision Decision,
-		UBattleEffect* OldEffect, UBattleEffect* NewEffect);
+	void ApplyEffect(FActiveBattleEffect& Active);
+	void RemoveAt(int32 Index);
+	void SetDuration(int32 Index, int32 NewDuration);
+	void ExecuteReapplyDecision(EReapplyDecision Decision, int32 OldIndex, FActiveBattleEffect& NewEffect);
+	void UpdateLiveHash();
 };
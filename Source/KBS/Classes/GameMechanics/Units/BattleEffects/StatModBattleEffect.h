@@ -5,30 +5,21 @@
 #include "GameplayTypes/DamageTypes.h"
 #include "StatModBattleEffect.generated.h"
 
+// Stateless: stat modifier handles live in the application's FActiveBattleEffect; armour and immunity
+// modifiers are keyed by its EffectId and removed by re-reading the immutable config
 UCLASS(Blueprintable)
 class KBS_API UStatModBattleEffect : public UBattleEffect
 {
 	GENERATED_BODY()
 public:
 	virtual void Initialize(UBattleEffectDataAsset* InConfig) override;
-	virtual void OnTurnEnd() override;
-	virtual void OnApplied() override;
-	virtual void OnRemoved() override;
-	virtual EReapplyDecision HandleReapply(UBattleEffect* NewEffect) override;
+	virtual bool RequiresInstance() const override { return false; }
+	virtual void OnTurnEnd(FActiveBattleEffect& Active) override;
+	virtual void OnApplied(FActiveBattleEffect& Active) override;
+	virtual void OnRemoved(FActiveBattleEffect& Active) override;
+	virtual EReapplyDecision HandleReapply(const FActiveBattleEffect& Existing, const FActiveBattleEffect& Incoming) override;
 protected:
 	UStatModBattleEffectDataAsset* GetStatModConfig() const { return Cast<UStatModBattleEffectDataAsset>(Config); }
-	void ApplyStatModifications();
-	void RemoveStatModifications();
-
-	// Cache applied modifications for exact removal
-	UPROPERTY()
-	int32 AppliedMaxHealthMod = 0;
-	UPROPERTY()
-	int32 AppliedInitiativeMod = 0;
-	UPROPERTY()
-	int32 AppliedAccuracyMod = 0;
-	UPROPERTY()
-	TArray<EDamageSource> AppliedImmunities;
-	UPROPERTY()
-	TMap<EDamageSource, int32> AppliedArmourMods;
+	void ApplyStatModifications(FActiveBattleEffect& Active) const;
+	void RemoveStatModifications(const FActiveBattleEffect& Active) const;
 };
@@ -9,10 +9,11 @@ class KBS_API UTargetDOTBattleEffect : public UBattleEffect
 	GENERATED_BODY()
 public:
 	virtual void Initialize(UBattleEffectDataAsset* InConfig) override;
-	virtual void OnTurnEnd() override;
-	virtual void OnApplied() override;
-	virtual void OnRemoved() override;
-	virtual EReapplyDecision HandleReapply(UBattleEffect* NewEffect) override;
+	virtual bool RequiresInstance() const override { return false; }
+	virtual void OnTurnEnd(FActiveBattleEffect& Active) override;
+	virtual void OnApplied(FActiveBattleEffect& Active) override;
+	virtual void OnRemoved(FActiveBattleEffect& Active) override;
+	virtual EReapplyDecision HandleReapply(const FActiveBattleEffect& Existing, const FActiveBattleEffect& Incoming) override;
 protected:
 	UDOTBattleEffectDataAsset* GetDOTConfig() const { return Cast<UDOTBattleEffectDataAsset>(Config); }
 };
@@ -39,9 +39,10 @@ public:
 
 	
 	// Add enchantments/buffs to descriptor stats (e.g., Stats.BaseMagnitude.AddFlatModifier(...))
-	void ModifyMagnitude(int32 Magnitude, FGuid ModificatorGuid, bool bIsFlat);
-	void RemoveMagnitudeModifier(int32 Magnitude, FGuid ModificatorGuid, bool bIsFlat);
-	void ModifySource(const TSet<EDamageSource>& Sources, FGuid ModificatorGuid);
+	// Returns an invalid handle when the descriptor is immutable
+	FStatModifierHandle ModifyMagnitude(int32 Magnitude, bool bIsFlat);
+	void RemoveMagnitudeModifier(FStatModifierHandle Handle);
+	void ModifySource(FDamageSourceMask Sources, FGuid ModificatorGuid);
 	void RemoveSourceModifier(FGuid ModificatorGuid);
 
 	bool IsMutable() const;
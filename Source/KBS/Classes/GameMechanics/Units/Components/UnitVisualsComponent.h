@@ -5,6 +5,7 @@
 #include "GameplayTypes/GridCoordinates.h"
 #include "GameplayTypes/TacMovementTypes.h"
 #include "GameplayTagContainer.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffect.h"
 #include "UnitVisualsComponent.generated.h"
 class UUnitVisualDefinition;
 class UUnitAnimationSet;
@@ -13,7 +14,7 @@ class UStaticMesh;
 class UAnimMontage;
 class UNiagaraSystem;
 class UNiagaraComponent;
-class UBattleEffect;
+class UBattleEffectDataAsset;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMontageCompleted, UAnimMontage*, Montage);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnRotationCompleted);
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnMontageCompletedNative, UAnimMontage*);
@@ -47,7 +48,7 @@ public:
 	// Resolves a montage by tag with parent-tag fallback (e.g. Animation.Attack.Slash -> Animation.Attack)
 	UAnimMontage* ResolveAnimation(FGameplayTag Tag) const;
 	FBatchHandle PlayAttackSequence(class AUnit* OwnerUnit, class AUnit* Target, FGameplayTag AnimTag);
-	void ShowBattleEffect(UBattleEffect* Effect);
+	void ShowBattleEffect(const UBattleEffectDataAsset* EffectConfig);
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	UPROPERTY(BlueprintAssignable, Category = "Animation")
 	FOnMontageCompleted OnMontageCompleted;
@@ -70,7 +71,7 @@ private:
 	UFUNCTION() void HandleMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 	UFUNCTION() void OnOwnerDied(AUnit* Unit);
 	UFUNCTION() void OnOwnerDamaged(AUnit* Victim, AUnit* Attacker);
-	UFUNCTION() void OnOwnerEffectTriggered(AUnit* OwnerUnit, UBattleEffect* Effect);
+	UFUNCTION() void OnOwnerEffectTriggered(AUnit* OwnerUnit, const FActiveBattleEffect& Effect);
 	UFUNCTION() void OnOwnerMoved(AUnit* Unit, const FTacMovementVisualData& MovementData);
 	UFUNCTION() void OnOwnerFieldPresenceChanged(AUnit* Unit, bool bIsOnField);
 	void OnOwnerOrientationChanged(EUnitOrientation NewOrientation);
@@ -3,38 +3,64 @@
 #include "GameplayTypes/DamageTypes.h"
 #include "BaseUnitStatTypes.generated.h"
 
-// Stat modifier used by modifiable stats
+// Compact reference to one modifier on one stat, returned when the modifier is added.
+// Only meaningful for the stat that issued it; removing with a stale handle does nothing.
 USTRUCT(BlueprintType)
-struct FInt32StatModifier
+struct FStatModifierHandle
 {
 	GENERATED_BODY()
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	FGuid EffectId;
+	bool IsValid() const { return Serial != 0; }
+	void Invalidate() { Index = 0; Serial = 0; }
+	bool operator==(const FStatModifierHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	int32 Amount = 0;
+	UPROPERTY()
+	uint16 Index = 0;
+
+	UPROPERTY()
+	uint16 Serial = 0;
+};
 
-	FInt32StatModifier() = default;
-	FInt32StatModifier(const FGuid InEffectId, const int32 InAmount) : EffectId(InEffectId), Amount(InAmount) {}
+// Modifiers on an int32 stat kept as running totals: flats are summed, multipliers are summed percents
+// (+10 and +20 give x1.3). Add and remove are O(1) through the handle, and the value is one expression.
+struct KBS_API FStatModifierAggregate
+{
+	FStatModifierHandle Add(int32 Amount, bool bIsMultiplier);
+	// Returns false if the handle does not name a live modifier on this stat
+	bool Remove(FStatModifierHandle Handle);
+	void Reset();
+	int32 Apply(int32 Base) const { return FMath::RoundToInt((Base + FlatSum) * (1.0f + MultiplierSum / 100.0f)); }
+	int32 Num() const { return Slots.Num(); }
+
+	// Bumped by every modifier change and base change on any stat, so caches of derived values notice
+	// changes that raise no unit event. Counted per thread, as FUnitStatusContainer::GetChangeSerial.
+	static uint32 GetChangeSerial();
+	static void MarkChanged();
 
-	bool operator==(const FInt32StatModifier& Other) const
+private:
+	struct FSlot
 	{
-		return EffectId == Other.EffectId && Amount == Other.Amount;
-	}
+		int32 Amount = 0;
+		uint16 Serial = 0;
+		bool bIsMultiplier = false;
+	};
+
+	TSparseArray<FSlot> Slots;
+	int32 FlatSum = 0;
+	int32 MultiplierSum = 0;
+	uint16 NextSerial = 1;
 };
 
 // Percentage stat (0-100)
 USTRUCT(BlueprintType)
-struct FUnitStatPercent
+struct KBS_API FUnitStatPercent
 {
 	GENERATED_BODY()
 
 	// === Public API ===
-	void AddFlatModifier(const FGuid& EffectId, int32 Amount);
-	void RemoveFlatModifier(const FGuid& EffectId, int32 Amount);
-	void AddMultiplier(const FGuid& EffectId, int32 Amount);
-	void RemoveMultiplier(const FGuid& EffectId, int32 Amount);
+	FStatModifierHandle AddFlatModifier(int32 Amount);
+	FStatModifierHandle AddMultiplier(int32 Amount);
+	void RemoveModifier(FStatModifierHandle Handle);
 
 	int32 GetValue() const;
 	int32 GetBase() const { return Base; }
@@ -49,36 +75,30 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat", meta = (AllowPrivateAccess = "true"))
 	int32 Base = 0;
 
-	UPROPERTY()
+	// Modifiers are runtime-only and invisible to reflection, so the cached value is too: a serialized or
+	// reflection-duplicated stat comes back dirty with its base alone, never with a value that no
+	// longer matches its modifiers
 	mutable int32 Modified = 0;
 
-	UPROPERTY()
-	TArray<FInt32StatModifier> FlatModifiers;
+	FStatModifierAggregate Modifiers;
 
-	UPROPERTY()
-	TArray<FInt32StatModifier> StatMultipliers;
-
-	UPROPERTY()
 	mutable bool bIsDirty = false;
 
 	// === Internal Methods ===
 	bool IsDirty() const;
 	void Recalc() const;
-	int32 CalcFlatModifiers() const;
-	float CalcStatMultipliers() const;
 };
 
 // Positive stat (min=0, no max)
 USTRUCT(BlueprintType)
-struct FUnitStatPositive
+struct KBS_API FUnitStatPositive
 {
 	GENERATED_BODY()
 
 	// === Public API ===
-	void AddFlatModifier(const FGuid& EffectId, int32 Amount);
-	void RemoveFlatModifier(const FGuid& EffectId, int32 Amount);
-	void AddMultiplier(const FGuid& EffectId, int32 Amount);
-	void RemoveMultiplier(const FGuid& EffectId, int32 Amount);
+	FStatModifierHandle AddFlatModifier(int32 Amount);
+	FStatModifierHandle AddMultiplier(int32 Amount);
+	void RemoveModifier(FStatModifierHandle Handle);
 
 	int32 GetValue() const;
 	int32 GetBase() const { return Base; }
@@ -93,23 +113,18 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat", meta = (AllowPrivateAccess = "true"))
 	int32 Base = 0;
 
-	UPROPERTY()
+	// Modifiers are runtime-only and invisible to reflection, so the cached value is too: a serialized or
+	// reflection-duplicated stat comes back dirty with its base alone, never with a value that no
+	// longer matches its modifiers
 	mutable int32 Modified = 0;
 
-	UPROPERTY()
-	TArray<FInt32StatModifier> FlatModifiers;
+	FStatModifierAggregate Modifiers;
 
-	UPROPERTY()
-	TArray<FInt32StatModifier> StatMultipliers;
-
-	UPROPERTY()
 	mutable bool bIsDirty = false;
 
 	// === Internal Methods ===
 	bool IsDirty() const;
 	void Recalc() const;
-	int32 CalcFlatModifiers() const;
-	float CalcStatMultipliers() const;
 };
 
 // Immutable stat - set once at initialization, never modified (prevents balance-breaking modifications)
@@ -176,10 +191,10 @@ struct FDamageSourceSetModifier
 	FGuid EffectId;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	TSet<EDamageSource> Sources;
+	FDamageSourceMask Sources;
 
 	FDamageSourceSetModifier() = default;
-	FDamageSourceSetModifier(const FGuid InEffectId, const TSet<EDamageSource>& InSources)
+	FDamageSourceSetModifier(const FGuid InEffectId, FDamageSourceMask InSources)
 		: EffectId(InEffectId), Sources(InSources) {}
 
 	bool operator==(const FDamageSourceSetModifier& Other) const
@@ -189,16 +204,17 @@ struct FDamageSourceSetModifier
 };
 
 // DamageSource set stat - modifiers can only add sources, never remove from base
+// Base stays a TSet for authoring; the resolved value is a mask, rebuilt from it on first read after load
 USTRUCT(BlueprintType)
-struct FDamageSourceSetStat
+struct KBS_API FDamageSourceSetStat
 {
 	GENERATED_BODY()
 
 	// === Public API ===
-	void AddModifier(const FGuid& EffectId, const TSet<EDamageSource>& Sources);
+	void AddModifier(const FGuid& EffectId, FDamageSourceMask Sources);
 	void RemoveModifier(const FGuid& EffectId);
 
-	const TSet<EDamageSource>& GetValue() const;
+	FDamageSourceMask GetValue() const;
 	const TSet<EDamageSource>& GetBase() const { return Base; }
 	void SetBase(const TSet<EDamageSource>& NewBase);
 	void InitFromBase(const TSet<EDamageSource>& InBase);
@@ -211,13 +227,11 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat", meta = (AllowPrivateAccess = "true"))
 	TSet<EDamageSource> Base;
 
-	UPROPERTY()
-	mutable TSet<EDamageSource> Modified;
-
 	UPROPERTY()
 	TArray<FDamageSourceSetModifier> Modifiers;
 
-	UPROPERTY()
+	// Cache, deliberately not serialized so loaded stats always rebuild it
+	mutable FDamageSourceMask Modified;
 	mutable bool bIsDirty = false;
 
 	// === Internal Methods ===
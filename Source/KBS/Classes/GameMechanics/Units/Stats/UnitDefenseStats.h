@@ -31,7 +31,7 @@ struct FUnitImmunityModifier
 };
 
 USTRUCT(BlueprintType)
-struct FUnitImmunities
+struct KBS_API FUnitImmunities
 {
 	GENERATED_BODY()
 
@@ -39,6 +39,7 @@ struct FUnitImmunities
 	void AddModifier(const FGuid& Id, EDamageSource Source, bool bIsGranting = true);
 	void RemoveModifier(const FGuid& Id, EDamageSource Source, bool bIsGranting = true);
 	bool IsImmuneTo(EDamageSource Source) const;
+	FDamageSourceMask GetValue() const;
 	const TSet<EDamageSource>& GetBase() const { return BaseImmunities; }
 	void InitFromBase(const FUnitImmunities& Template);
 
@@ -50,23 +51,21 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Defense", meta = (AllowPrivateAccess = "true"))
 	TSet<EDamageSource> BaseImmunities;
 
-	UPROPERTY()
-	mutable TSet<EDamageSource> ModifiedImmunities;
-
 	UPROPERTY()
 	TArray<FUnitImmunityModifier> ModifyingEffects;
 
-	UPROPERTY()
+	// Resolved immunities; not serialized, rebuilt from the authored set when first queried
+	mutable FDamageSourceMask ModifiedImmunities;
 	mutable bool bIsDirty = false;
 
 	// === Internal Methods ===
 	void Recalc() const;
-	TSet<EDamageSource> CalcAdditions() const;
-	TSet<EDamageSource> CalcSubtractions() const;
+	FDamageSourceMask CalcAdditions() const;
+	FDamageSourceMask CalcSubtractions() const;
 };
 
 USTRUCT(BlueprintType)
-struct FUnitWards
+struct KBS_API FUnitWards
 {
 	GENERATED_BODY()
 
@@ -75,13 +74,13 @@ struct FUnitWards
 	bool HasWardFor(EDamageSource Source) const;
 	bool UseWard(EDamageSource Source);
 	void InitFromBase(const FUnitWards& Template);
-	const TSet<EDamageSource>& GetWards() const { return Wards; }
+	FDamageSourceMask GetWards() const { return Wards; }
 
 	FUnitWards() = default;
-	explicit FUnitWards(TSet<EDamageSource> Source);
+	explicit FUnitWards(FDamageSourceMask Source);
 
 	UPROPERTY()
-	TSet<EDamageSource> Wards;
+	FDamageSourceMask Wards;
 };
 
 USTRUCT(BlueprintType)
@@ -109,7 +108,7 @@ struct FUnitArmourModifier
 };
 
 USTRUCT(BlueprintType)
-struct FUnitArmour
+struct KBS_API FUnitArmour
 {
 	GENERATED_BODY()
 
@@ -162,7 +161,7 @@ private:
 
 // Defense stats aggregator
 USTRUCT(BlueprintType)
-struct FUnitDefenseStats
+struct KBS_API FUnitDefenseStats
 {
 	GENERATED_BODY()
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Defense")
@@ -1,21 +1,22 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GameMechanics/Units/Stats/BaseUnitStatTypes.h"
+#include "GameplayTypes/BattleZobrist.h"
 #include "UnitHealth.generated.h"
 
 // Health wrapper - encapsulates current/max relationship
 USTRUCT(BlueprintType)
-struct FUnitHealth
+struct KBS_API FUnitHealth
 {
 	GENERATED_BODY()
 
 	// === Public API ===
 	// Max HP modification
 	void SetMaxBase(int32 NewBase, bool bShouldHeal = true);
-	void AddMaxModifier(const FGuid& EffectId, int32 Amount, bool bShouldHeal = true);
-	void AddMaxMultiplier(const FGuid& EffectId, int32 Amount, bool bShouldHeal = true);
-	void RemoveMaxModifier(const FGuid& EffectId, int32 Amount);
-	void RemoveMaxMultiplier(const FGuid& EffectId, int32 Amount);
+	FStatModifierHandle AddMaxModifier(int32 Amount, bool bShouldHeal = true);
+	FStatModifierHandle AddMaxMultiplier(int32 Amount, bool bShouldHeal = true);
+	// Removes a flat modifier or multiplier added by either call above
+	void RemoveMaxModifier(FStatModifierHandle Handle);
 
 	// Current HP modification
 	void SetCurrent(int32 NewCurrent);
@@ -27,6 +28,14 @@ struct FUnitHealth
 	int32 GetCurrent() const { return Current; }
 	bool IsDead() const { return Current <= 0; }
 	float GetHealthPercent() const;
+	// Bumped by every change to current HP on any unit; max HP goes through FStatModifierAggregate's
+	// serial. Counted per thread, as FUnitStatusContainer::GetChangeSerial.
+	static uint32 GetChangeSerial();
+	// Zobrist key of current HP; the live grid salts it with the unit GUID, FBattleState with the index
+	uint64 GetHashKey(uint32 Salt) const;
+	// Keeps the key XOR'd into Sink, updated on every change to current HP, until unbound
+	void BindLiveHash(const TSharedRef<uint64>& Sink, uint32 Salt) { LiveHash.Bind(Sink, Salt, GetHashKey(Salt)); }
+	void UnbindLiveHash() { LiveHash.Unbind(); }
 
 	// Init from template
 	void InitFromBase(const FUnitHealth& Template);
@@ -42,6 +51,9 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Health", meta = (AllowPrivateAccess = "true"))
 	int32 Current = 0;
 
+	BattleZobrist::FLiveBinding LiveHash;
+
 	// === Internal Methods ===
 	void ClampCurrent();
+	void MarkChanged();
 };
@@ -7,7 +7,7 @@
 #include "UnitStats.generated.h"
 
 USTRUCT(BlueprintType)
-struct FUnitCoreStats
+struct KBS_API FUnitCoreStats
 {
 	GENERATED_BODY()
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Core")
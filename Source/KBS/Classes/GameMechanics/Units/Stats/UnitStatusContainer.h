@@ -1,5 +1,6 @@
 #pragma once
 #include "CoreMinimal.h"
+#include "GameplayTypes/BattleZobrist.h"
 #include "UnitStatusContainer.generated.h"
 
 UENUM(BlueprintType)
@@ -16,7 +17,7 @@ enum class EUnitStatus : uint8
 };
 
 USTRUCT(BlueprintType)
-struct FUnitStatusContainer
+struct KBS_API FUnitStatusContainer
 {
 	GENERATED_BODY()
 
@@ -24,16 +25,18 @@ struct FUnitStatusContainer
 
 	// Returns true if status was newly activated (went from 0 modifiers to 1, or bool flipped)
 	bool AddStatus(EUnitStatus Status, const FGuid& EffectId);
-	void SetFleeing() {bFleeing = true;}
-	void SetChanneling() {bChanneling = true;}
-	void SetDefending() {bDefending = true;}
-	void SetDead() {bDead = true;}
-	void SetFlankDelay(int32 Turns) { FlankDelay = FMath::Max(0, Turns); }
-	void TickFlankDelay()           { if (FlankDelay > 0) --FlankDelay; }
-	void BlockTurn(FGuid const& EffectId) { TurnBlockedModifiers.Add(EffectId); }
-	void Pin(FGuid const& EffectId) { PinnedModifiers.Add(EffectId); }
-	void Silence(FGuid const& EffectId) { SilencedModifiers.Add(EffectId); }
-	void Disorient(FGuid const& EffectId) { DisorientedModifiers.Add(EffectId); }
+	void SetFleeing() {bFleeing = true; MarkChanged();}
+	void SetChanneling() {bChanneling = true; MarkChanged();}
+	void SetDefending() {bDefending = true; MarkChanged();}
+	void SetDead() {bDead = true; MarkChanged();}
+	// Revival raises no unit event: the caller places the unit back, and PlaceUnit refreshes its team
+	void ClearDead() {bDead = false; MarkChanged();}
+	void SetFlankDelay(int32 Turns) { FlankDelay = FMath::Max(0, Turns); MarkChanged(); }
+	void TickFlankDelay()           { if (FlankDelay > 0) { --FlankDelay; MarkChanged(); } }
+	void BlockTurn(FGuid const& EffectId) { TurnBlockedModifiers.Add(EffectId); MarkChanged(); }
+	void Pin(FGuid const& EffectId) { PinnedModifiers.Add(EffectId); MarkChanged(); }
+	void Silence(FGuid const& EffectId) { SilencedModifiers.Add(EffectId); MarkChanged(); }
+	void Disorient(FGuid const& EffectId) { DisorientedModifiers.Add(EffectId); MarkChanged(); }
 
 	// Returns true if status was fully deactivated
 	bool RemoveStatus(EUnitStatus Status, const FGuid& EffectId);
@@ -56,6 +59,18 @@ struct FUnitStatusContainer
 	bool HasReplacementBehavior() const { return bFleeing || bChanneling; }
 
 	bool IsStatusActive(EUnitStatus Status) const;
+	// One bit per active EUnitStatus, Dead included
+	int32 GetStatusBits() const;
+
+	// Bumped by every mutation on any unit's container; caches compare it to detect status changes.
+	// Counted per thread: live units only change on the game thread, and simulations running on
+	// worker threads must neither race on nor invalidate the game thread's caches.
+	static uint32 GetChangeSerial();
+	// Zobrist key of the active statuses and flank delay, salted as FUnitHealth::GetHashKey
+	uint64 GetHashKey(uint32 Salt) const;
+	// Keeps the key XOR'd into Sink, updated on every mutation, until unbound
+	void BindLiveHash(const TSharedRef<uint64>& Sink, uint32 Salt) { LiveHash.Bind(Sink, Salt, GetHashKey(Salt)); }
+	void UnbindLiveHash() { LiveHash.Unbind(); }
 
 private:
 	// === Internal State ===
@@ -89,4 +104,9 @@ private:
 
 	UPROPERTY()
 	bool bDead = false;
+
+	BattleZobrist::FLiveBinding LiveHash;
+
+	// Call after the mutation, so the live hash sees the new state
+	void MarkChanged();
 };
@@ -8,6 +8,7 @@
 #include "GameMechanics/Tactical/Grid/BattleTeam.h"
 #include "GameplayTypes/CombatTypes.h"
 #include "GameplayTypes/TacMovementTypes.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffect.h"
 #include "Unit.generated.h"
 
 class UUnitAbility;
@@ -39,9 +40,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitFieldPresenceChange, AUnit*,
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitHealthChanged, AUnit*, Unit, int32, NewHealth);
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitEffectApplied, AUnit*, Unit, UBattleEffect*, AppliedEffect);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitEffectApplied, AUnit*, Unit, const FActiveBattleEffect&, AppliedEffect);
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitEffectTriggered, AUnit*, Owner, UBattleEffect*, Effect);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitEffectTriggered, AUnit*, Owner, const FActiveBattleEffect&, Effect);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitAbilityUsed, AUnit*, Unit, UUnitAbility*, Ability);
 
@@ -49,24 +50,6 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitStatusChanged, AUnit*, Unit,
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitStatsModified, AUnit*, Unit, FUnitCoreStats&, Stats);
 
-/**
- * Unit-level mirrors of UTacCombatSubsystem phase broadcasts.
- *
- * Subsystem emits one global signal per phase; these are re-broadcast per unit
- * (attacker and target separately) so abilities only need to bind to their owner
- * without filtering.
- *
- * Existing coarse signals (OnUnitAttacked / OnUnitAttacks) are NOT replaced —
- * they carry no context structs and remain for lightweight observers (UI, visuals).
- *
- * Phase order per hit:
- *   1. PreAttack  — cancellation window, before accuracy roll
- *   2. Calculation — accuracy roll + damage calc; modifier HERE affects the roll
- *   3. DamageApply — damage is written to target; modify FDamageResult to absorb/amplify
- *   4. EffectApplication — battle effects applied; cancel or add effects here
- */
-DECLARE_MULTICAST_DELEGATE_TwoParams(FOnUnitCombatResolutionHook, FCombatContext&, FHitInstance&);
-DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnUnitCombatResultHook, FCombatContext&, FHitInstance&, FDamageResult&);
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnUnitOrientationChanged, EUnitOrientation);
 
 UCLASS(meta=(ScriptName="TacUnit"))
@@ -120,29 +103,7 @@ public:
 	// Subscribe only — broadcast exclusively via NotifyOrientationChanged() (DataManager-owned).
 	FOnUnitOrientationChanged OnOrientationChanged;
 
-	// --- Combat Phase Events (unit-scoped mirrors of UTacCombatSubsystem signals) ---
-	// Each signal fires only when THIS unit is the attacker or target of the relevant hit.
-	// Bind here instead of the subsystem to avoid per-hit owner checks.
-
-	/** Phase 1 — attacker side: fired before accuracy roll; context-level (whole attack). */
-	FOnUnitCombatResolutionHook OnStartingCombatResolution;
-	/** Phase 1 — target side: fired before accuracy roll; per-hit. */
-	FOnUnitCombatResolutionHook OnCombatResolutionCaptured;
-
-	/** Phase 2 — attacker side: fired during accuracy/damage calculation; modify attacker stats here. */
-	FOnUnitCombatResolutionHook OnResolutionCalculating;
-	/** Phase 2 — target side: fired during accuracy/damage calculation; modify attacker stats here. */
-	FOnUnitCombatResolutionHook OnBeingTargetedInCalculation;
-
-	/** Phase 3 — attacker side: fired when damage result is being applied. */
-	FOnUnitCombatResultHook OnCombatResolutionResultApplication;
-	/** Phase 3 — target side: fired when damage result is being applied; modify FDamageResult to absorb. */
-	FOnUnitCombatResultHook OnCombatResolutionResultApplied;
-
-	/** Phase 4 — attacker side: fired during effect application. */
-	FOnUnitCombatResolutionHook OnCombatResolutionEffectApplication;
-	/** Phase 4 — target side: fired during effect application; cancel or modify effects here. */
-	FOnUnitCombatResolutionHook OnCombatResolutionEffectApplied;
+	// Per-hit combat phase hooks: register with UTacCombatSubsystem::GetPhaseListeners, scoped to this unit
 
 	// --- Incoming Event Handlers ---
 	virtual void NotifyActorOnClicked(FKey ButtonPressed = EKeys::LeftMouseButton) override;
@@ -162,16 +123,10 @@ public:
 	void HandleHit(const FDamageResult& Result, AUnit* Attacker, bool Emits = true);
 	void ChangeUnitHP(int32 Delta, bool Emits = true);
 	void ConsumeWard(EDamageSource Source, bool Emits = true);
-	bool ApplyEffect(UBattleEffect* Effect, bool Emits = true);
-	void NotifyEffectTriggered(UBattleEffect* Effect);
+	bool ApplyEffect(UBattleEffect* Effect, AUnit* Source, bool Emits = true);
+	void NotifyEffectTriggered(const FActiveBattleEffect& Effect);
 	void HandleDeath(bool Emits = true);
 
-	// --- Combat resolution phasing
-	void EnterCombatResolutionPhase(FCombatContext& Context, FHitInstance& Hit, bool IsTarget);
-	void EnterCombatCalculationPhase(FCombatContext& Context, FHitInstance& Hit, bool IsTarget);
-	void EnterCombatResultApplyPhase(FCombatContext& Context, FHitInstance& Hit, FDamageResult& DamageResult,
-	                                 bool IsTarget);
-	void EnterCombatEffectApplicationPhase(FCombatContext& Context, FHitInstance& Hit, bool IsTarget);
 
 	// --- Queries ---
 	FString GetLogName() const;
@@ -205,6 +160,12 @@ public:
 	bool IsDead() const { return BaseStats.Status.IsDead(); }
 	bool CanAct() const { return BaseStats.Status.CanAct(); }
 
+	// Zobrist key of health, statuses and effects, salted with the unit GUID
+	uint64 GetStateHashKey() const;
+	// Keeps that key XOR'd into Sink as it changes; UGridDataManager binds every unit it holds
+	void BindLiveHash(const TSharedRef<uint64>& Sink);
+	void UnbindLiveHash();
+
 	// --- Components ---
 	UFUNCTION(BlueprintPure, Category = "Components")
 	UAbilityInventoryComponent* GetAbilityInventory() const { return AbilityInventory; }
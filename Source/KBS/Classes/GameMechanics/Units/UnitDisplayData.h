@@ -59,7 +59,7 @@ struct KBS_API FUnitTurnQueueDisplay
 	bool BelongsToAttackerTeam = false;
 };
 
-class UBattleEffect;
+struct FActiveBattleEffect;
 enum class EDamageSource : uint8;
 enum class ETargetReach : uint8;
 enum class ETeamSide : uint8;
@@ -73,7 +73,7 @@ FString DamageSourceToString(EDamageSource Source);
 FString TargetReachToString(ETargetReach Reach);
 FCombatDescriptorDisplayData ConvertWeapon(UWeapon* Weapon);
 
-TArray<FString> ConvertActiveEffects(const TArray<TObjectPtr<UBattleEffect>>& Effects);
+TArray<FString> ConvertActiveEffects(const TArray<FActiveBattleEffect>& Effects);
 FString ConvertArmourMap(const FUnitArmour& ArmourMap);
 TArray<FString> ConvertImmunityMap(const FUnitImmunities& ImmunityMap);
 TArray<FString> ConvertWardMap(const FUnitWards& WardMap);
@@ -83,7 +83,7 @@ FUnitDisplayData BuildUnitDisplayData(
 	float CurrentHealth,
 	const FUnitCoreStats& Stats,
 	UTexture2D* PortraitTexture,
-	const TArray<TObjectPtr<UBattleEffect>>& ActiveEffects,
+	const TArray<FActiveBattleEffect>& ActiveEffects,
 	const TArray<TObjectPtr<UWeapon>>& Weapons,
 	ETeamSide TeamSide
 );
@@ -0,0 +1,36 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "AITypes.generated.h"
+
+UENUM(BlueprintType)
+enum class EAIDecisionEngine : uint8
+{
+	Heuristic UMETA(DisplayName = "Heuristic"),
+	MonteCarloTreeSearch UMETA(DisplayName = "Monte Carlo Tree Search"),
+	Expectimax UMETA(DisplayName = "Expectimax")
+};
+
+USTRUCT(BlueprintType)
+struct FAISearchSettings
+{
+	GENERATED_BODY()
+
+	// Per decision; the search stops at whichever of time or iterations runs out first
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI", meta = (ClampMin = "1"))
+	float TimeBudgetMs = 50.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI", meta = (ClampMin = "1"))
+	int32 MaxIterations = 4000;
+
+	// How far past the current round a rollout plays before scoring the position
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI", meta = (ClampMin = "1"))
+	int32 RolloutRounds = 6;
+
+	// Expectimax: unit turns looked ahead, deepened iteratively until time runs out
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI", meta = (ClampMin = "1", ClampMax = "8"))
+	int32 SearchDepth = 4;
+
+	// Expectimax: move cells kept per turn after ordering; attacks and wait are always searched
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI", meta = (ClampMin = "1"))
+	int32 MaxMovesPerTurn = 4;
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameplayTypes/GridCoordinates.h"
+
+// Zobrist keys for battle positions. A key is mixed from (feature, unit salt, value) on the fly rather
+// than looked up in a random table, so any unit identity works as a salt: the live grid salts with the
+// unit GUID, FBattleState with the unit index. XOR a key in when its feature appears and out when it goes.
+namespace BattleZobrist
+{
+	enum class EFeature : uint8
+	{
+		Occupant,
+		CorpseTop,
+		Health,
+		Status,
+		FlankDelay,
+		CurrentUnit,
+		QueueSlot,
+		Wards,
+		Waited,
+		RoundsLeft,
+		Effect,
+	};
+
+	// SplitMix64 finalizer
+	constexpr uint64 Mix(uint64 Value)
+	{
+		Value += 0x9E3779B97F4A7C15ull;
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+		return Value ^ (Value >> 31);
+	}
+
+	// Value keeps its low 24 bits, plenty for cell indices, health and queue slots
+	constexpr uint64 Key(EFeature Feature, uint32 Salt, int32 Value)
+	{
+		return Mix((uint64(Feature) << 56) | (uint64(Salt) << 24) | (uint64(uint32(Value)) & 0xFFFFFF));
+	}
+
+	inline uint64 OccupantKey(uint32 Salt, const FTacCoordinates& Cell)
+	{
+		return Key(EFeature::Occupant, Salt, Cell.GetCellIndex());
+	}
+
+	inline uint32 UnitSalt(const FGuid& UnitID)
+	{
+		return GetTypeHash(UnitID);
+	}
+
+	// Ties one live unit's hashed state to a shared hash: the owner hands over its recomputed key after
+	// every change and the difference is XOR'd into the sink. Copies start unbound, so the stats
+	// FBattleState copies out of live units never write into the live hash; assignment keeps the
+	// target's own binding.
+	class FLiveBinding
+	{
+	public:
+		FLiveBinding() = default;
+		FLiveBinding(const FLiveBinding&) {}
+		FLiveBinding& operator=(const FLiveBinding&) { return *this; }
+		~FLiveBinding() { Unbind(); }
+
+		bool IsBound() const { return Sink.IsValid(); }
+		uint32 GetSalt() const { return Salt; }
+
+		void Bind(const TSharedRef<uint64>& InSink, uint32 InSalt, uint64 InKey)
+		{
+			Unbind();
+			Sink = InSink;
+			Salt = InSalt;
+			Key = InKey;
+			*Sink ^= Key;
+		}
+
+		void Unbind()
+		{
+			if (Sink.IsValid())
+				*Sink ^= Key;
+			Sink.Reset();
+			Key = 0;
+		}
+
+		void Update(uint64 NewKey)
+		{
+			if (!Sink.IsValid())
+				return;
+			*Sink ^= Key ^ NewKey;
+			Key = NewKey;
+		}
+
+	private:
+		TSharedPtr<uint64> Sink;
+		uint32 Salt = 0;
+		uint64 Key = 0;
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "CoreMinimal.h"
+#include "GameplayTypes/GridCoordinates.h"
 #include "DamageTypes.generated.h"
 UENUM(BlueprintType)
 enum class EDamageSource : uint8
@@ -14,6 +15,86 @@ enum class EDamageSource : uint8
 	Death UMETA(DisplayName = "Death"),
 	Mind UMETA(DisplayName = "Mind")
 };
+
+// Set of damage sources, one bit per EDamageSource value. Value type: no hashing or heap storage,
+// iteration in enum order. Authoring data keeps TSet<EDamageSource> and converts when read.
+USTRUCT(BlueprintType)
+struct KBS_API FDamageSourceMask
+{
+	GENERATED_BODY()
+
+	FDamageSourceMask() = default;
+	FDamageSourceMask(std::initializer_list<EDamageSource> Sources)
+	{
+		for (EDamageSource Source : Sources)
+			Add(Source);
+	}
+	explicit FDamageSourceMask(const TSet<EDamageSource>& Sources)
+	{
+		for (EDamageSource Source : Sources)
+			Add(Source);
+	}
+	static FDamageSourceMask FromBits(uint16 InBits)
+	{
+		FDamageSourceMask Result;
+		Result.Bits = InBits;
+		return Result;
+	}
+
+	static constexpr uint16 Bit(EDamageSource Source) { return static_cast<uint16>(1u << static_cast<uint8>(Source)); }
+
+	void Add(EDamageSource Source) { Bits |= Bit(Source); }
+	void Remove(EDamageSource Source) { Bits &= ~Bit(Source); }
+	bool Contains(EDamageSource Source) const { return (Bits & Bit(Source)) != 0; }
+	int32 Num() const { return static_cast<int32>(FMath::CountBits(Bits)); }
+	bool IsEmpty() const { return Bits == 0; }
+	void Reset() { Bits = 0; }
+	uint16 GetBits() const { return Bits; }
+	// Lowest source in enum order, None when empty
+	EDamageSource First() const
+	{
+		return Bits ? static_cast<EDamageSource>(FMath::CountTrailingZeros(static_cast<uint32>(Bits))) : EDamageSource::None;
+	}
+
+	FDamageSourceMask Union(const FDamageSourceMask& Other) const { return FromBits(Bits | Other.Bits); }
+	FDamageSourceMask Intersect(const FDamageSourceMask& Other) const { return FromBits(Bits & Other.Bits); }
+	FDamageSourceMask Difference(const FDamageSourceMask& Other) const { return FromBits(Bits & ~Other.Bits); }
+
+	FDamageSourceMask operator|(const FDamageSourceMask& Other) const { return Union(Other); }
+	FDamageSourceMask operator&(const FDamageSourceMask& Other) const { return Intersect(Other); }
+	FDamageSourceMask& operator|=(const FDamageSourceMask& Other) { Bits |= Other.Bits; return *this; }
+	FDamageSourceMask& operator&=(const FDamageSourceMask& Other) { Bits &= Other.Bits; return *this; }
+	bool operator==(const FDamageSourceMask& Other) const { return Bits == Other.Bits; }
+	bool operator!=(const FDamageSourceMask& Other) const { return Bits != Other.Bits; }
+
+	TSet<EDamageSource> ToSet() const
+	{
+		TSet<EDamageSource> Result;
+		for (EDamageSource Source : *this)
+			Result.Add(Source);
+		return Result;
+	}
+
+	struct FConstIterator
+	{
+		uint16 Remaining;
+
+		EDamageSource operator*() const
+		{
+			return static_cast<EDamageSource>(FMath::CountTrailingZeros(static_cast<uint32>(Remaining)));
+		}
+		FConstIterator& operator++() { Remaining &= Remaining - 1; return *this; }
+		bool operator!=(const FConstIterator& Other) const { return Remaining != Other.Remaining; }
+	};
+
+	FConstIterator begin() const { return FConstIterator{ Bits }; }
+	FConstIterator end() const { return FConstIterator{ 0 }; }
+
+private:
+	UPROPERTY()
+	uint16 Bits = 0;
+};
+static_assert(static_cast<uint8>(EDamageSource::Mind) < 16, "FDamageSourceMask holds one bit per EDamageSource");
 UENUM(BlueprintType)
 enum class ETargetReach : uint8
 {
@@ -54,11 +135,24 @@ enum class EShapeLayering : uint8
 	BothLayerArea UMETA(DisplayName = "Both Layers Area"),
 };
 USTRUCT(BlueprintType)
-struct FAreaShape
+struct KBS_API FAreaShape
 {
 	GENERATED_BODY()
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Area")
 	TArray<FIntPoint> RelativeCells;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Area")
 	EShapeLayering ShapeLayering = EShapeLayering::BothLayerArea;
+
+	// Precomputes the covered-cell mask for every center cell. Call once after RelativeCells/ShapeLayering are final.
+	void Compile();
+	bool IsCompiled() const { return bCompiled; }
+	// Valid cells covered when centered on CenterCell (GridBitboard layout, layering applied).
+	// The center's own layer is ignored; uncompiled shapes and out-of-grid centers are computed on the fly.
+	uint64 GetMask(const FTacCoordinates& CenterCell) const;
+
+private:
+	uint64 BuildMask(int32 CenterRow, int32 CenterCol) const;
+
+	uint64 CenterMasks[FGridConstants::TotalCells] = {};
+	bool bCompiled = false;
 };
\ No newline at end of file
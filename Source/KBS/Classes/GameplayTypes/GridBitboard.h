@@ -0,0 +1,101 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameplayTypes/GridCoordinates.h"
+
+// 50-cell grid bitboards. Bit index = Layer * TotalCells + Row * GridSize + Col,
+// so ground occupies bits [0..24] and air occupies bits [25..49] of a uint64.
+namespace GridBitboard
+{
+	constexpr int32 NumCells = FGridConstants::TotalCells * 2;
+
+	constexpr int32 CellBit(int32 Row, int32 Col, ETacGridLayer Layer)
+	{
+		return static_cast<int32>(Layer) * FGridConstants::TotalCells + Row * FGridConstants::GridSize + Col;
+	}
+
+	constexpr uint64 CellMask(int32 Row, int32 Col, ETacGridLayer Layer)
+	{
+		return uint64(1) << CellBit(Row, Col, Layer);
+	}
+
+	// Caller is responsible for Coords being inside grid bounds
+	inline uint64 CellMask(const FTacCoordinates& Coords)
+	{
+		return uint64(1) << Coords.GetCellIndex();
+	}
+
+	inline FTacCoordinates CellFromBit(int32 Bit)
+	{
+		return FTacCoordinates::FromCellIndex(Bit);
+	}
+
+	constexpr uint64 LayerMask(ETacGridLayer Layer)
+	{
+		return ((uint64(1) << FGridConstants::TotalCells) - 1) << (static_cast<int32>(Layer) * FGridConstants::TotalCells);
+	}
+
+	constexpr uint64 AllCellsMask = LayerMask(ETacGridLayer::Ground) | LayerMask(ETacGridLayer::Air);
+
+	constexpr uint64 BuildRestrictedMask()
+	{
+		uint64 Mask = 0;
+		for (const ETacGridLayer Layer : { ETacGridLayer::Ground, ETacGridLayer::Air })
+		{
+			Mask |= CellMask(FGridConstants::CenterRow, FGridConstants::ExcludedColLeft, Layer);
+			Mask |= CellMask(FGridConstants::CenterRow, FGridConstants::ExcludedColRight, Layer);
+		}
+		return Mask;
+	}
+
+	constexpr uint64 BuildFlankMask()
+	{
+		uint64 Mask = 0;
+		for (const ETacGridLayer Layer : { ETacGridLayer::Ground, ETacGridLayer::Air })
+		{
+			for (int32 Row = 0; Row < FGridConstants::GridSize; ++Row)
+			{
+				if (Row == FGridConstants::CenterRow)
+					continue;
+				Mask |= CellMask(Row, FGridConstants::ExcludedColLeft, Layer);
+				Mask |= CellMask(Row, FGridConstants::ExcludedColRight, Layer);
+			}
+		}
+		return Mask;
+	}
+
+	constexpr uint64 RestrictedMask = BuildRestrictedMask();
+	constexpr uint64 FlankMask = BuildFlankMask();
+	// Every addressable (non-restricted) cell on both layers
+	constexpr uint64 ValidCellsMask = AllCellsMask & ~RestrictedMask;
+
+	inline int32 Count(uint64 Mask)
+	{
+		return static_cast<int32>(FMath::CountBits(Mask));
+	}
+
+	// Invokes Visitor(const FTacCoordinates&) for every set bit in ascending bit order
+	template<typename TVisitor>
+	void ForEachCell(uint64 Mask, TVisitor&& Visitor)
+	{
+		while (Mask)
+		{
+			const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+			Mask &= Mask - 1;
+			Visitor(CellFromBit(Bit));
+		}
+	}
+
+	// Returns true as soon as Predicate(const FTacCoordinates&) holds for a set bit
+	template<typename TPredicate>
+	bool AnyCell(uint64 Mask, TPredicate&& Predicate)
+	{
+		while (Mask)
+		{
+			const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+			Mask &= Mask - 1;
+			if (Predicate(CellFromBit(Bit)))
+				return true;
+		}
+		return false;
+	}
+}
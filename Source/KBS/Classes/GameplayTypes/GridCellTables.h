@@ -0,0 +1,156 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameplayTypes/GridBitboard.h"
+#include "GameplayTypes/FlankCellDefinitions.h"
+
+// Per-cell lookup tables for all 50 cells, generated at compile time and indexed by GridBitboard bit.
+// Replaces per-neighbor offset walks and the branchy flank rules in FFlankCellDefinitions.
+namespace GridCellTables
+{
+	constexpr int8 NoCell = -1;
+
+	struct FCellInfo
+	{
+		// In-layer neighbors that are valid cells; flank cells included (mask with GridBitboard::FlankMask to drop)
+		uint64 OrthogonalNeighbors = 0;
+		uint64 AllNeighbors = 0;
+		bool bIsFlank = false;
+		bool bIsRestricted = false;
+		// FFlankCellDefinitions::GetEntranceBlockedCell
+		int8 EntranceBlockedCell = NoCell;
+		// FFlankCellDefinitions::GetAdjacentNormalCell
+		int8 AdjacentNormalCell = NoCell;
+		// FFlankCellDefinitions::GetAvailableFlankCell, indexed by ETeamSide
+		int8 AvailableFlankCell[2] = { NoCell, NoCell };
+	};
+
+	struct FCellTable
+	{
+		FCellInfo Cells[GridBitboard::NumCells];
+	};
+
+	namespace Detail
+	{
+		using FFlank = FFlankCellDefinitions;
+
+		constexpr bool IsInGrid(int32 Row, int32 Col)
+		{
+			return Row >= 0 && Row < FGridConstants::GridSize && Col >= 0 && Col < FGridConstants::GridSize;
+		}
+
+		constexpr bool IsValid(int32 Row, int32 Col)
+		{
+			return IsInGrid(Row, Col)
+				&& !(Row == FGridConstants::CenterRow && (Col == FGridConstants::ExcludedColLeft || Col == FGridConstants::ExcludedColRight));
+		}
+
+		constexpr bool IsFlankCol(int32 Col)
+		{
+			return Col == FFlank::FlankColLeft || Col == FFlank::FlankColRight;
+		}
+
+		constexpr bool IsEntranceRow(int32 Row)
+		{
+			return Row == FFlank::FlankEntranceTop || Row == FFlank::FlankEntranceBottom;
+		}
+
+		constexpr int8 Bit(int32 Row, int32 Col, ETacGridLayer Layer)
+		{
+			return static_cast<int8>(GridBitboard::CellBit(Row, Col, Layer));
+		}
+
+		constexpr int32 AdjacentNormalCol(int32 Col)
+		{
+			return Col == FFlank::FlankColLeft ? FFlank::FlankColLeft + 1 : FFlank::FlankColRight - 1;
+		}
+
+		// Mirrors FFlankCellDefinitions::GetAvailableFlankCell; targets are always ground cells
+		constexpr int8 AvailableFlankCell(int32 Row, int32 Col, ETeamSide Team)
+		{
+			const bool bRearAvailable = IsFlankCol(Col) && IsEntranceRow(Row);
+			const bool bEntranceAvailable = Col == FFlank::EntranceLeftClosestCol || Col == FFlank::EntranceRightClosestCol;
+			if (Team == ETeamSide::Attacker)
+			{
+				if (bRearAvailable)
+					return Bit(FFlank::FlankRearBottom, Col == FFlank::FlankColRight ? FFlank::FlankColRight : FFlank::FlankColLeft, ETacGridLayer::Ground);
+				if (bEntranceAvailable)
+					return Bit(FFlank::FlankEntranceBottom, Col == FFlank::EntranceRightClosestCol ? FFlank::FlankColRight : FFlank::FlankColLeft, ETacGridLayer::Ground);
+			}
+			else
+			{
+				if (bRearAvailable)
+					return Bit(FFlank::FlankRearTop, Col == FFlank::FlankColLeft ? FFlank::FlankColLeft : FFlank::FlankColRight, ETacGridLayer::Ground);
+				if (bEntranceAvailable)
+					return Bit(FFlank::FlankEntranceTop, Col == FFlank::EntranceLeftClosestCol ? FFlank::FlankColLeft : FFlank::FlankColRight, ETacGridLayer::Ground);
+			}
+			return NoCell;
+		}
+
+		constexpr FCellTable BuildCellTable()
+		{
+			constexpr int32 Offsets[8][2] = {
+				{ 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 },
+				{ -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 }
+			};
+			FCellTable Table;
+			for (const ETacGridLayer Layer : { ETacGridLayer::Ground, ETacGridLayer::Air })
+			{
+				for (int32 Row = 0; Row < FGridConstants::GridSize; ++Row)
+				{
+					for (int32 Col = 0; Col < FGridConstants::GridSize; ++Col)
+					{
+						FCellInfo& Info = Table.Cells[GridBitboard::CellBit(Row, Col, Layer)];
+						for (int32 i = 0; i < 8; ++i)
+						{
+							const int32 NRow = Row + Offsets[i][0];
+							const int32 NCol = Col + Offsets[i][1];
+							if (!IsValid(NRow, NCol))
+								continue;
+							const uint64 Mask = GridBitboard::CellMask(NRow, NCol, Layer);
+							Info.AllNeighbors |= Mask;
+							if (i < 4)
+								Info.OrthogonalNeighbors |= Mask;
+						}
+						Info.bIsFlank = Row != FGridConstants::CenterRow && IsFlankCol(Col);
+						Info.bIsRestricted = !IsValid(Row, Col);
+						Info.AdjacentNormalCell = Bit(Row, AdjacentNormalCol(Col), Layer);
+						if (IsFlankCol(Col) && IsEntranceRow(Row))
+						{
+							const int32 RearRow = Row == FFlank::FlankEntranceTop ? FFlank::FlankRearTop : FFlank::FlankRearBottom;
+							Info.EntranceBlockedCell = Bit(RearRow, AdjacentNormalCol(Col), Layer);
+						}
+						Info.AvailableFlankCell[static_cast<int32>(ETeamSide::Attacker)] = AvailableFlankCell(Row, Col, ETeamSide::Attacker);
+						Info.AvailableFlankCell[static_cast<int32>(ETeamSide::Defender)] = AvailableFlankCell(Row, Col, ETeamSide::Defender);
+					}
+				}
+			}
+			return Table;
+		}
+	}
+
+	inline constexpr FCellTable CellTable = Detail::BuildCellTable();
+
+	inline bool IsInGrid(const FTacCoordinates& Cell)
+	{
+		return Detail::IsInGrid(Cell.Row, Cell.Col);
+	}
+
+	// Caller guarantees Cell is inside grid bounds
+	inline const FCellInfo& Get(const FTacCoordinates& Cell)
+	{
+		checkSlow(IsInGrid(Cell));
+		return CellTable.Cells[GridBitboard::CellBit(Cell.Row, Cell.Col, Cell.Layer)];
+	}
+
+	inline FTacCoordinates ToCoords(int8 Bit)
+	{
+		return Bit == NoCell ? FTacCoordinates::Invalid() : GridBitboard::CellFromBit(Bit);
+	}
+
+	inline uint64 NeighborMask(const FTacCoordinates& Cell, bool bOrthogonalOnly, bool bIncludeFlank)
+	{
+		const FCellInfo& Info = Get(Cell);
+		const uint64 Neighbors = bOrthogonalOnly ? Info.OrthogonalNeighbors : Info.AllNeighbors;
+		return bIncludeFlank ? Neighbors : Neighbors & ~GridBitboard::FlankMask;
+	}
+}
@@ -90,6 +90,11 @@ struct KBS_API FTacCoordinates
 		return Result;
 	}
 
+	// Linear index into flat [Layer][Row * GridSize + Col] storage; equals the GridBitboard bit.
+	// Only meaningful for in-bounds coordinates.
+	int32 GetCellIndex() const;
+	static FTacCoordinates FromCellIndex(int32 Index);
+
 	bool IsValidCell() const;
 	bool IsFlankCell() const;
 	bool IsRestrictedCell() const;
@@ -194,4 +199,16 @@ struct KBS_API FGridConstants
 		FIntPoint(0, -1), FIntPoint(0, 1), FIntPoint(-1, 0), FIntPoint(1, 0),
 		FIntPoint(-1, -1), FIntPoint(-1, 1), FIntPoint(1, -1), FIntPoint(1, 1)
 	};
-};
\ No newline at end of file
+};
+
+inline int32 FTacCoordinates::GetCellIndex() const
+{
+	return static_cast<int32>(Layer) * FGridConstants::TotalCells + Row * FGridConstants::GridSize + Col;
+}
+
+inline FTacCoordinates FTacCoordinates::FromCellIndex(int32 Index)
+{
+	const int32 LayerIndex = Index / FGridConstants::TotalCells;
+	const int32 Local = Index - LayerIndex * FGridConstants::TotalCells;
+	return FTacCoordinates(Local / FGridConstants::GridSize, Local % FGridConstants::GridSize, static_cast<ETacGridLayer>(LayerIndex));
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/GridBitboard.h"
+
+// Fixed-size set of grid cells backed by a single bitboard (see GridBitboard.h for layout).
+// Value type: no heap storage, O(1) add/contains, iteration in layer → row → col order.
+struct FTacCellSet
+{
+	FTacCellSet() = default;
+	explicit FTacCellSet(uint64 InBits) : Bits(InBits & GridBitboard::AllCellsMask) {}
+
+	static FTacCellSet FromArray(const TArray<FTacCoordinates>& Cells)
+	{
+		FTacCellSet Result;
+		for (const FTacCoordinates& Cell : Cells)
+			Result.Add(Cell);
+		return Result;
+	}
+
+	static bool IsInBounds(const FTacCoordinates& Cell)
+	{
+		return Cell.Row >= 0 && Cell.Row < FGridConstants::GridSize
+			&& Cell.Col >= 0 && Cell.Col < FGridConstants::GridSize;
+	}
+
+	// Out-of-bounds coordinates are ignored; returns false in that case
+	bool Add(const FTacCoordinates& Cell)
+	{
+		if (!IsInBounds(Cell))
+			return false;
+		Bits |= GridBitboard::CellMask(Cell);
+		return true;
+	}
+
+	void Remove(const FTacCoordinates& Cell)
+	{
+		if (IsInBounds(Cell))
+			Bits &= ~GridBitboard::CellMask(Cell);
+	}
+
+	bool Contains(const FTacCoordinates& Cell) const
+	{
+		return IsInBounds(Cell) && (Bits & GridBitboard::CellMask(Cell)) != 0;
+	}
+
+	int32 Num() const { return GridBitboard::Count(Bits); }
+	bool IsEmpty() const { return Bits == 0; }
+	void Reset() { Bits = 0; }
+	uint64 GetBits() const { return Bits; }
+
+	FTacCellSet Union(const FTacCellSet& Other) const { return FTacCellSet(Bits | Other.Bits); }
+	FTacCellSet Intersect(const FTacCellSet& Other) const { return FTacCellSet(Bits & Other.Bits); }
+	FTacCellSet Difference(const FTacCellSet& Other) const { return FTacCellSet(Bits & ~Other.Bits); }
+	FTacCellSet FilterLayer(ETacGridLayer Layer) const { return FTacCellSet(Bits & GridBitboard::LayerMask(Layer)); }
+
+	FTacCellSet operator|(const FTacCellSet& Other) const { return Union(Other); }
+	FTacCellSet operator&(const FTacCellSet& Other) const { return Intersect(Other); }
+	FTacCellSet& operator|=(const FTacCellSet& Other) { Bits |= Other.Bits; return *this; }
+	FTacCellSet& operator&=(const FTacCellSet& Other) { Bits &= Other.Bits; return *this; }
+	bool operator==(const FTacCellSet& Other) const { return Bits == Other.Bits; }
+	bool operator!=(const FTacCellSet& Other) const { return Bits != Other.Bits; }
+
+	template<typename TVisitor>
+	void ForEach(TVisitor&& Visitor) const
+	{
+		GridBitboard::ForEachCell(Bits, Forward<TVisitor>(Visitor));
+	}
+
+	// Legacy adapters for TArray-based callers (UI, AI)
+	void AppendTo(TArray<FTacCoordinates>& OutCells) const
+	{
+		OutCells.Reserve(OutCells.Num() + Num());
+		ForEach([&OutCells](const FTacCoordinates& Cell) { OutCells.Add(Cell); });
+	}
+
+	TArray<FTacCoordinates> Array() const
+	{
+		TArray<FTacCoordinates> Result;
+		AppendTo(Result);
+		return Result;
+	}
+
+	struct FConstIterator
+	{
+		uint64 Remaining;
+
+		FTacCoordinates operator*() const
+		{
+			return GridBitboard::CellFromBit(static_cast<int32>(FMath::CountTrailingZeros64(Remaining)));
+		}
+		FConstIterator& operator++() { Remaining &= Remaining - 1; return *this; }
+		bool operator!=(const FConstIterator& Other) const { return Remaining != Other.Remaining; }
+	};
+
+	FConstIterator begin() const { return FConstIterator{ Bits }; }
+	FConstIterator end() const { return FConstIterator{ 0 }; }
+
+private:
+	uint64 Bits = 0;
+};
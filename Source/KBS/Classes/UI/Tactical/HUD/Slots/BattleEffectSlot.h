@@ -2,22 +2,23 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffect.h"
 #include "BattleEffectSlot.generated.h"
 
-class UBattleEffect;
+class UBattleEffectComponent;
 enum class EEffectPolarity : uint8;
 
 // Display widget for a single battle effect showing icon, duration, and frame
-// Max 5 slots per unit, listens to OnDurationChange delegate
+// Max 5 slots per unit, listens to the owning component's OnEffectDurationChange delegate
 UCLASS(Blueprintable)
 class KBS_API UBattleEffectSlot : public UUserWidget
 {
 	GENERATED_BODY()
 
 public:
-	// Setup the slot with a battle effect (BP invokable)
+	// Setup the slot with an effect applied through Component (BP invokable)
 	UFUNCTION(BlueprintCallable, Category = "Battle Effect Slot")
-	void SetupEffect(UBattleEffect* Effect);
+	void SetupEffect(UBattleEffectComponent* Component, const FActiveBattleEffect& Effect);
 
 	// Clear the slot and unbind from effect
 	UFUNCTION(BlueprintCallable, Category = "Battle Effect Slot")
@@ -56,16 +57,21 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visuals")
 	FLinearColor ImmutableFrameColor = FLinearColor(0.8f, 0.6f, 0.0f, 1.0f);
 
-	// Currently bound effect
+	// Currently bound effect and the component that owns it
 	UPROPERTY(BlueprintReadOnly)
-	TObjectPtr<UBattleEffect> BoundEffect = nullptr;
+	TObjectPtr<UBattleEffectComponent> BoundComponent = nullptr;
+
+	UPROPERTY(BlueprintReadOnly)
+	FActiveBattleEffect BoundEffect;
 
 private:
 	UFUNCTION()
-	void OnEffectDurationChanged(int32 NewDuration);
+	void OnEffectDurationChanged(const FGuid& EffectId, int32 NewDuration);
 
 	UFUNCTION()
-	void OnEffectRemovedHandler(UBattleEffect* Effect);
+	void OnEffectRemovedHandler(const FGuid& EffectId);
+
+	void Unbind();
 
 	void UpdateDurationDisplay();
 	void UpdateEffectFrame();
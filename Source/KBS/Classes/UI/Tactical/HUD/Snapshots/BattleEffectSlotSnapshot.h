@@ -2,9 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffect.h"
 #include "BattleEffectSlotSnapshot.generated.h"
 
-class UBattleEffect;
+class UBattleEffectDataAsset;
 class UImage;
 class UTextBlock;
 class UBorder;
@@ -17,10 +18,14 @@ class KBS_API UBattleEffectSlotSnapshot : public UUserWidget
 	GENERATED_BODY()
 
 public:
-	// Setup from effect data (read-only, no event binding)
+	// Setup from effect data (read-only, no event binding); shows the duration an application would start with
 	UFUNCTION(BlueprintCallable, Category = "Battle Effect Slot Snapshot")
 	void SetupFromEffect(UBattleEffect* Effect);
 
+	// Setup from an effect applied to a unit, showing its remaining duration
+	UFUNCTION(BlueprintCallable, Category = "Battle Effect Slot Snapshot")
+	void SetupFromActiveEffect(const FActiveBattleEffect& Effect);
+
 	// Clear and hide widget
 	UFUNCTION(BlueprintCallable, Category = "Battle Effect Slot Snapshot")
 	void Clear();
@@ -48,4 +53,7 @@ protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visuals")
 	FLinearColor ImmutableFrameColor = FLinearColor(0.8f, 0.6f, 0.0f, 1.0f);
+
+private:
+	void Setup(const UBattleEffectDataAsset* Config, int32 Duration);
 };
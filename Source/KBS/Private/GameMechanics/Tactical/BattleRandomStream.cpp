@@ -0,0 +1,47 @@
+#include "GameMechanics/Tactical/BattleRandomStream.h"
+
+FBattleRandomStream::FBattleRandomStream(int32 InSeed)
+{
+	Seed(InSeed);
+}
+
+void FBattleRandomStream::Seed(int32 InSeed)
+{
+	Stream.Initialize(InSeed);
+	Draws = 0;
+}
+
+void FBattleRandomStream::SeedRandomly()
+{
+	Stream.GenerateNewSeed();
+	Draws = 0;
+}
+
+float FBattleRandomStream::FRand()
+{
+	++Draws;
+	return Stream.FRand();
+}
+
+int32 FBattleRandomStream::RandRange(int32 Min, int32 Max)
+{
+	++Draws;
+	return Stream.RandRange(Min, Max);
+}
+
+FBattleRandomStream FBattleRandomStream::Fork()
+{
+	++Draws;
+	return FBattleRandomStream(static_cast<int32>(Stream.GetUnsignedInt()));
+}
+
+FBattleRandomStream FBattleRandomStream::Derive(uint32 Salt) const
+{
+	return FBattleRandomStream(static_cast<int32>(HashCombine(GetTypeHash(GetSeed()), Salt)));
+}
+
+void FBattleRandomStream::Restore(const FCheckpoint& InCheckpoint)
+{
+	Stream = InCheckpoint.Stream;
+	Draws = InCheckpoint.Draws;
+}
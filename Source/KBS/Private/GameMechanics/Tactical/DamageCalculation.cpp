@@ -1,10 +1,51 @@
 #include "GameMechanics/Tactical/DamageCalculation.h"
+#include "GameMechanics/Tactical/BattleRandomStream.h"
 #include "GameMechanics/Units/Unit.h"
 #include "GameMechanics/Units/Combat/Weapon.h"
 #include "GameMechanics/Units/Combat/CombatDescriptor.h"
 #include "GameMechanics/Units/BattleEffects/BattleEffect.h"
 #include "GameMechanics/Units/Stats/UnitStats.h"
 
+namespace
+{
+	// Per-target rules for a selected Result.DamageSource, shared by CalculateDamage and CalculateDamageBatch:
+	// immunity and ward gates, armour, flanking, flat reduction and the defensive stance
+	FORCEINLINE void ApplyDamageRules(int32 BaseMagnitude, bool bFlanking, const FUnitCoreStats& TargetStats,
+	                                  FDamageResult& Result)
+	{
+		const EDamageSource Source = Result.DamageSource;
+		if (Source == EDamageSource::None)
+			return;
+		const FUnitDefenseStats& Defense = TargetStats.Defense;
+		if (Defense.Immunities.IsImmuneTo(Source))
+		{
+			Result.Damage = 0;
+			Result.DamageBlocked = BaseMagnitude;
+			return;
+		}
+		if (Defense.Wards.HasWardFor(Source))
+		{
+			Result.Damage = 0;
+			Result.DamageBlocked = BaseMagnitude;
+			Result.WardSpent = Source;
+			return;
+		}
+		float DamageAfterArmor = BaseMagnitude * (1.0f - Defense.Armour.GetValue(Source) / 100.0f);
+		if (bFlanking)
+		{
+			DamageAfterArmor *= FLANKING_DAMAGE_MULTIPLIER;
+			BaseMagnitude *= FLANKING_DAMAGE_MULTIPLIER;
+		}
+		float FinalDamage = DamageAfterArmor - Defense.DamageReduction;
+		if (TargetStats.Status.IsDefending())
+		{
+			FinalDamage *= DEFENSIVE_STANCE_MULTIPLIER;
+		}
+		Result.Damage = FMath::RoundToInt(FinalDamage);
+		Result.DamageBlocked = BaseMagnitude - Result.Damage;
+	}
+}
+
 
 float FDamageCalculation::CalculateHitChance(AUnit* Attacker, UCombatDescriptor* Descriptor, AUnit* Target)
 {
@@ -12,59 +53,57 @@ float FDamageCalculation::CalculateHitChance(AUnit* Attacker, UCombatDescriptor*
 	{
 		return 0.0f;
 	}
-	const FUnitCoreStats& AttackerStats = Attacker->GetStats();
-	const FCombatDescriptorStats& DescriptorStats = Descriptor->GetStats();
+	return CalculateHitChance(Attacker->GetStats(), Descriptor->GetStats());
+}
+
+float FDamageCalculation::CalculateHitChance(const FUnitCoreStats& AttackerStats, const FCombatDescriptorStats& DescriptorStats)
+{
 	float HitChance = AttackerStats.Accuracy.GetValue() * DescriptorStats.AccuracyMultiplier / 100.0f;
 	return FMath::Clamp(HitChance, 0.0f, 100.0f);
 }
 
 FDamageResult FDamageCalculation::CalculateDamage(AUnit* Attacker, UCombatDescriptor* Descriptor, AUnit* Target)
 {
-	FDamageResult Result;
 	if (!Attacker || !Descriptor || !Target)
 	{
-		return Result;
-	}
-	const FCombatDescriptorStats& DescriptorStats = Descriptor->GetStats();
-	const FUnitCoreStats& TargetStats = Target->GetStats();
-	const FUnitDefenseStats& Defense = TargetStats.Defense;
-	const bool bIsTargetDefending = Target->GetStats().Status.IsDefending();
-	EDamageSource BestSource = SelectBestDamageSource(DescriptorStats.DamageSources.GetValue(), Target);
-	Result.DamageSource = BestSource;
-	if (BestSource == EDamageSource::None)
-	{
-		return Result;
-	}
-	int32 BaseMagnitude = DescriptorStats.BaseMagnitude.GetValue();
-	if (Defense.Immunities.IsImmuneTo(BestSource))
-	{
-		Result.Damage = 0;
-		Result.DamageBlocked = BaseMagnitude;
-		return Result;
-	}
-	if (Defense.Wards.HasWardFor(BestSource))
-	{
-		Result.Damage = 0;
-		Result.DamageBlocked = BaseMagnitude;
-		Result.WardSpent = BestSource;
-		return Result;
+		return FDamageResult();
 	}
-	int32 ArmorPercent = Defense.Armour.GetValue(BestSource);
-	float ArmorValue = ArmorPercent / 100.0f;
-	float DamageAfterArmor = BaseMagnitude * (1.0f - ArmorValue);
-	if (Attacker->GetGridMetadata().bOnFlank && !Attacker->GetStats().Status.IsFlankDelayed())
-	{
-		DamageAfterArmor *= FLANKING_DAMAGE_MULTIPLIER;
-		BaseMagnitude *= FLANKING_DAMAGE_MULTIPLIER;
-	}
-	float FinalDamage = DamageAfterArmor - Defense.DamageReduction;
-	if (bIsTargetDefending)
+	return CalculateDamage(Attacker->GetStats(), Attacker->GetGridMetadata().bOnFlank, Descriptor->GetStats(),
+	                       Target->GetStats());
+}
+
+FDamageResult FDamageCalculation::CalculateDamage(const FUnitCoreStats& AttackerStats, bool bAttackerOnFlank,
+                                                  const FCombatDescriptorStats& DescriptorStats,
+                                                  const FUnitCoreStats& TargetStats)
+{
+	FDamageResult Result;
+	Result.DamageSource = SelectBestDamageSource(DescriptorStats.DamageSources.GetValue(), TargetStats.Defense);
+	ApplyDamageRules(DescriptorStats.BaseMagnitude.GetValue(), bAttackerOnFlank && !AttackerStats.Status.IsFlankDelayed(),
+	                 TargetStats, Result);
+	return Result;
+}
+
+void FDamageCalculation::CalculateDamageBatch(const FUnitCoreStats& AttackerStats, bool bAttackerOnFlank,
+                                               const FCombatDescriptorStats& DescriptorStats,
+                                               TConstArrayView<const FUnitCoreStats*> Targets,
+                                               TArrayView<FDamageResult> OutResults)
+{
+	checkf(OutResults.Num() >= Targets.Num(), TEXT("CalculateDamageBatch: result view is shorter than the target list"));
+	const int32 Count = Targets.Num();
+	const FDamageSourceMask Sources = DescriptorStats.DamageSources.GetValue();
+	const int32 BaseMagnitude = DescriptorStats.BaseMagnitude.GetValue();
+	const bool bFlanking = bAttackerOnFlank && !AttackerStats.Status.IsFlankDelayed();
+
+	// Pass 1: source selection per target
+	for (int32 i = 0; i < Count; ++i)
 	{
-		FinalDamage *= DEFENSIVE_STANCE_MULTIPLIER;
+		OutResults[i] = FDamageResult();
+		OutResults[i].DamageSource = SelectBestDamageSource(Sources, Targets[i]->Defense);
 	}
-	Result.Damage = FMath::RoundToInt(FinalDamage);
-	Result.DamageBlocked = BaseMagnitude - Result.Damage;
-	return Result;
+
+	// Pass 2: the same per-target rules as CalculateDamage
+	for (int32 i = 0; i < Count; ++i)
+		ApplyDamageRules(BaseMagnitude, bFlanking, *Targets[i], OutResults[i]);
 }
 
 float FDamageCalculation::CalculateEffectApplication(AUnit* Attacker, UBattleEffect* Effect, AUnit* Target)
@@ -73,14 +112,17 @@ float FDamageCalculation::CalculateEffectApplication(AUnit* Attacker, UBattleEff
 	{
 		return 0.0f;
 	}
-	const FUnitCoreStats& AttackerStats = Attacker->GetStats();
-	const FUnitDefenseStats& Defense = Target->GetStats().Defense;
-	EDamageSource EffectSource = Effect->GetDamageSource();
-	if (Defense.Immunities.IsImmuneTo(EffectSource))
+	return CalculateEffectApplication(Attacker->GetStats(), Effect->GetDamageSource(), Target->GetStats().Defense);
+}
+
+float FDamageCalculation::CalculateEffectApplication(const FUnitCoreStats& AttackerStats, EDamageSource EffectSource,
+                                                     const FUnitDefenseStats& TargetDefense)
+{
+	if (TargetDefense.Immunities.IsImmuneTo(EffectSource))
 	{
 		return 0.0f;
 	}
-	if (Defense.Wards.HasWardFor(EffectSource))
+	if (TargetDefense.Wards.HasWardFor(EffectSource))
 	{
 		return 0.0f;
 	}
@@ -91,35 +133,24 @@ float FDamageCalculation::CalculateEffectApplication(AUnit* Attacker, UBattleEff
 FDamageResult FDamageCalculation::CalculateHeal(AUnit* Attacker, UCombatDescriptor* Descriptor, AUnit* Target)
 {
 	if (!Attacker || !Descriptor || !Target) return FDamageResult();
+	return CalculateHeal(Descriptor->GetStats(), Target->GetStats().Defense);
+}
 
-	const FUnitDefenseStats& Defense = Target->GetStats().Defense;
-	const TSet<EDamageSource>& Sources = Descriptor->GetStats().DamageSources.GetValue();
-
-	EDamageSource BestSource = EDamageSource::None;
-	EDamageSource ImmunityFallback = EDamageSource::None;
-	EDamageSource WardFallback = EDamageSource::None;
-
-	for (EDamageSource Source : Sources)
-	{
-		const bool bImmune = Defense.Immunities.IsImmuneTo(Source);
-		const bool bWarded = Defense.Wards.HasWardFor(Source);
-		if (!bImmune && !bWarded)
-		{
-			BestSource = Source;
-			break;
-		}
-		if (bImmune && ImmunityFallback == EDamageSource::None)
-			ImmunityFallback = Source;
-		else if (bWarded && WardFallback == EDamageSource::None)
-			WardFallback = Source;
-	}
+FDamageResult FDamageCalculation::CalculateHeal(const FCombatDescriptorStats& DescriptorStats,
+                                                const FUnitDefenseStats& Defense)
+{
+	const FDamageSourceMask Sources = DescriptorStats.DamageSources.GetValue();
+	const FDamageSourceMask Immune = Sources & Defense.Immunities.GetValue();
+	const FDamageSourceMask Warded = Sources.Intersect(Defense.Wards.GetWards()).Difference(Immune);
 
+	// First unblocked source, else the first immune one, else the first warded one
+	EDamageSource BestSource = Sources.Difference(Immune | Warded).First();
 	if (BestSource == EDamageSource::None)
-		BestSource = (ImmunityFallback != EDamageSource::None) ? ImmunityFallback : WardFallback;
+		BestSource = Immune.IsEmpty() ? Warded.First() : Immune.First();
 
 	FDamageResult Result;
 	Result.DamageSource = BestSource;
-	Result.Damage = Descriptor->GetStats().BaseMagnitude.GetValue();
+	Result.Damage = DescriptorStats.BaseMagnitude.GetValue();
 	return Result;
 }
 
@@ -138,23 +169,6 @@ UCombatDescriptor* FDamageCalculation::SelectMaxReachDescriptor(AUnit* Unit, boo
 	{
 		return Weapons[0]->GetDescriptor();
 	}
-	auto GetReachScore = [](ETargetReach Reach) -> int32
-		{
-			switch (Reach)
-			{
-			case ETargetReach::AllEnemies:         return 100;
-			case ETargetReach::Area:               return 80;
-			case ETargetReach::AnyEnemy:           return 60;
-			case ETargetReach::AllFriendlies:      return 50;
-			case ETargetReach::AnyFriendly:        return 40;
-			case ETargetReach::ClosestEnemies:     return 30;
-			case ETargetReach::EmptyCellOrFriendly: return 20;
-			case ETargetReach::EmptyCell:          return 10;
-			case ETargetReach::Self:               return 5;
-			case ETargetReach::None:               return 0;
-			default:                               return 0;
-			}
-		};
 	UCombatDescriptor* BestDescriptor = nullptr;
 	int32 BestScore = -1;
 	for (UWeapon* W : Weapons)
@@ -172,6 +186,24 @@ UCombatDescriptor* FDamageCalculation::SelectMaxReachDescriptor(AUnit* Unit, boo
 	return BestDescriptor;
 }
 
+int32 FDamageCalculation::GetReachScore(ETargetReach Reach)
+{
+	switch (Reach)
+	{
+	case ETargetReach::AllEnemies:         return 100;
+	case ETargetReach::Area:               return 80;
+	case ETargetReach::AnyEnemy:           return 60;
+	case ETargetReach::AllFriendlies:      return 50;
+	case ETargetReach::AnyFriendly:        return 40;
+	case ETargetReach::ClosestEnemies:     return 30;
+	case ETargetReach::EmptyCellOrFriendly: return 20;
+	case ETargetReach::EmptyCell:          return 10;
+	case ETargetReach::Self:               return 5;
+	case ETargetReach::None:               return 0;
+	default:                               return 0;
+	}
+}
+
 UCombatDescriptor* FDamageCalculation::SelectSpellDescriptor(AUnit* Unit)
 {
 	if (!Unit) return nullptr;
@@ -216,9 +248,19 @@ FPreviewHitResult FDamageCalculation::PreviewDamage(AUnit* Attacker, UCombatDesc
 	return Preview;
 }
 
-bool FDamageCalculation::PerformAccuracyRoll(float HitChance)
+FPreviewHitResult FDamageCalculation::PreviewDamage(const FUnitCoreStats& AttackerStats, bool bAttackerOnFlank,
+                                                  const FCombatDescriptorStats& DescriptorStats,
+                                                  const FUnitCoreStats& TargetStats)
 {
-	float Roll = FMath::FRand() * 100.0f;
+	FPreviewHitResult Preview;
+	Preview.HitProbability = CalculateHitChance(AttackerStats, DescriptorStats);
+	Preview.DamageResult = CalculateDamage(AttackerStats, bAttackerOnFlank, DescriptorStats, TargetStats);
+	return Preview;
+}
+
+bool FDamageCalculation::PerformAccuracyRoll(FBattleRandomStream& Random, float HitChance)
+{
+	float Roll = Random.FRand() * 100.0f;
 	return Roll <= HitChance;
 }
 
@@ -242,44 +284,13 @@ UWeapon* FDamageCalculation::SelectWeaponForTarget(AUnit* Attacker, AUnit* Targe
 	const int32 Distance = Attacker->GetGridMetadata().DistanceTo(Target->GetGridMetadata());
 	const bool bIsFriendly = Attacker->GetGridMetadata().IsAlly(Target->GetGridMetadata());
 
-	// Returns whether a descriptor with this reach can hit a target at Distance with the given affiliation.
-	// Collapses all reach variants to two axes: affiliation (friendly/hostile) and range (melee/any).
-	auto CanReachTarget = [&](ETargetReach Reach) -> bool
-	{
-		switch (Reach)
-		{
-		// Hostile melee-only
-		case ETargetReach::ClosestEnemies:
-			return !bIsFriendly && Distance == 1;
-
-		// Hostile any distance
-		case ETargetReach::AnyEnemy:
-		case ETargetReach::AllEnemies:
-		case ETargetReach::Area:
-		case ETargetReach::AreaEnemy:
-			return !bIsFriendly;
-
-		// Friendly any distance
-		case ETargetReach::Self:
-		case ETargetReach::AnyFriendly:
-		case ETargetReach::AllFriendlies:
-		case ETargetReach::EmptyCellOrFriendly:
-		case ETargetReach::AreaFriendly:
-			return bIsFriendly;
-
-		// Non-unit targets (corpse, movement, empty cell) — never targets a live unit
-		default:
-			return false;
-		}
-	};
-
 	UWeapon* BestWeapon = nullptr;
 	int32 BestDamage = -1;
 	for (UWeapon* W : Weapons)
 	{
 		if (bAutoAttackOnly && !W->IsUsableForAutoAttack()) continue;
 		UCombatDescriptor* Descriptor = W->GetDescriptor();
-		if (!CanReachTarget(Descriptor->GetStats().TargetReach)) continue;
+		if (!CanReachTarget(Descriptor->GetStats().TargetReach, bIsFriendly, Distance)) continue;
 
 		const int32 Dmg = CalculateDamage(Attacker, Descriptor, Target).Damage;
 		if (Dmg > BestDamage)
@@ -291,13 +302,57 @@ UWeapon* FDamageCalculation::SelectWeaponForTarget(AUnit* Attacker, AUnit* Targe
 	return BestWeapon;
 }
 
-EDamageSource FDamageCalculation::SelectBestDamageSource(const TSet<EDamageSource>& DamageSources, AUnit* Target)
+bool FDamageCalculation::CanReachTarget(ETargetReach Reach, bool bIsFriendly, int32 Distance)
 {
-	if (!Target || DamageSources.Num() == 0)
+	// Collapses all reach variants to two axes: affiliation (friendly/hostile) and range (melee/any).
+	switch (Reach)
+	{
+	// Hostile melee-only
+	case ETargetReach::ClosestEnemies:
+		return !bIsFriendly && Distance == 1;
+
+	// Hostile any distance
+	case ETargetReach::AnyEnemy:
+	case ETargetReach::AllEnemies:
+	case ETargetReach::Area:
+	case ETargetReach::AreaEnemy:
+		return !bIsFriendly;
+
+	// Friendly any distance
+	case ETargetReach::Self:
+	case ETargetReach::AnyFriendly:
+	case ETargetReach::AllFriendlies:
+	case ETargetReach::EmptyCellOrFriendly:
+	case ETargetReach::AreaFriendly:
+		return bIsFriendly;
+
+	// Non-unit targets (corpse, movement, empty cell) — never targets a live unit
+	default:
+		return false;
+	}
+}
+
+EDamageSource FDamageCalculation::SelectBestDamageSource(FDamageSourceMask DamageSources, AUnit* Target)
+{
+	if (!Target)
+	{
+		return EDamageSource::None;
+	}
+	return SelectBestDamageSource(DamageSources, Target->GetStats().Defense);
+}
+
+EDamageSource FDamageCalculation::SelectBestDamageSource(FDamageSourceMask DamageSources,
+                                                         const FUnitDefenseStats& Defense)
+{
+	if (DamageSources.IsEmpty())
 	{
 		return EDamageSource::None;
 	}
-	const FUnitDefenseStats& Defense = Target->GetStats().Defense;
+	// A single source needs no armour comparison
+	if (DamageSources.Num() == 1)
+	{
+		return DamageSources.First();
+	}
 	EDamageSource BestSource = EDamageSource::None;
 	int32 LowestArmor = 100;
 	bool bFirstSource = true;
@@ -313,4 +368,3 @@ EDamageSource FDamageCalculation::SelectBestDamageSource(const TSet<EDamageSourc
 	}
 	return BestSource;
 }
-
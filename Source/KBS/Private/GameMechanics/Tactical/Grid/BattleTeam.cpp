@@ -4,92 +4,140 @@
 
 void UBattleTeam::AddUnit(AUnit* Unit)
 {
-	if (Unit)
+	if (!Unit || MemberStates.Contains(Unit))
 	{
-		Units.Add(Unit);
+		return;
 	}
+	Units.Add(Unit);
+	const uint8 State = ReadMemberState(Unit);
+	MemberStates.Add(Unit, State);
+	ApplyMemberState(0, State);
+	Unit->OnUnitDied.AddDynamic(this, &UBattleTeam::HandleMemberDied);
 }
 
 void UBattleTeam::RemoveUnit(AUnit* Unit)
 {
-	if (Unit)
+	if (!Unit)
 	{
-		Units.Remove(Unit);
+		return;
 	}
+	uint8 State = 0;
+	if (MemberStates.RemoveAndCopyValue(Unit, State))
+	{
+		ApplyMemberState(State, 0);
+		Unit->OnUnitDied.RemoveDynamic(this, &UBattleTeam::HandleMemberDied);
+	}
+	Units.Remove(Unit);
 }
 
 bool UBattleTeam::ContainsUnit(AUnit* Unit) const
 {
-	return Units.Contains(Unit);
+	return MemberStates.Contains(Unit);
 }
 
 void UBattleTeam::ClearUnits()
 {
+	for (AUnit* Unit : Units)
+	{
+		if (Unit)
+			Unit->OnUnitDied.RemoveDynamic(this, &UBattleTeam::HandleMemberDied);
+	}
 	Units.Empty();
+	MemberStates.Empty();
+	AliveCount = OnFieldCount = AliveOnFieldCount = 0;
 }
 
-bool UBattleTeam::IsAnyUnitAlive() const
+void UBattleTeam::RefreshUnitState(AUnit* Unit)
 {
-	for (auto Unit : Units)
+	uint8* State = MemberStates.Find(Unit);
+	if (!State)
 	{
-		if (!Unit)
-			continue;
-		if (!Unit->IsDead())
-			return true;
+		return;
 	}
-	return false;
+	const uint8 NewState = ReadMemberState(Unit);
+	ApplyMemberState(*State, NewState);
+	*State = NewState;
 }
 
-bool UBattleTeam::IsAnyUnitOnField() const
+void UBattleTeam::HandleMemberDied(AUnit* Unit)
+{
+	RefreshUnitState(Unit);
+}
+
+uint8 UBattleTeam::ReadMemberState(const AUnit* Unit)
 {
+	uint8 State = 0;
+	if (!Unit->IsDead())
+		State |= MemberAlive;
+	if (Unit->GetGridMetadata().IsOnField())
+		State |= MemberOnField;
+	return State;
+}
+
+uint8 UBattleTeam::GetMemberState(const AUnit* Unit) const
+{
+	const uint8* State = MemberStates.Find(Unit);
+	return State ? *State : 0;
+}
+
+void UBattleTeam::ApplyMemberState(uint8 OldState, uint8 NewState)
+{
+	const uint8 AliveOnField = MemberAlive | MemberOnField;
+	AliveCount += ((NewState & MemberAlive) != 0) - ((OldState & MemberAlive) != 0);
+	OnFieldCount += ((NewState & MemberOnField) != 0) - ((OldState & MemberOnField) != 0);
+	AliveOnFieldCount += ((NewState & AliveOnField) == AliveOnField) - ((OldState & AliveOnField) == AliveOnField);
+}
+
+void UBattleTeam::VerifyCounters() const
+{
+#if DO_GUARD_SLOW
+	int32 Alive = 0;
+	int32 OnField = 0;
+	int32 AliveOnField = 0;
 	for (auto Unit : Units)
 	{
 		if (!Unit)
 			continue;
-		if (Unit->GetGridMetadata().IsOnField())
-			return true;
+		const bool bAlive = !Unit->IsDead();
+		const bool bOnField = Unit->GetGridMetadata().IsOnField();
+		Alive += bAlive;
+		OnField += bOnField;
+		AliveOnField += bAlive && bOnField;
 	}
-	return false;
+	checkf(Alive == AliveCount && OnField == OnFieldCount && AliveOnField == AliveOnFieldCount,
+		TEXT("UBattleTeam: stale liveness counters (alive %d/%d, on field %d/%d, fighting %d/%d)"),
+		AliveCount, Alive, OnFieldCount, OnField, AliveOnFieldCount, AliveOnField);
+#endif
+}
+
+bool UBattleTeam::IsAnyUnitAlive() const
+{
+	VerifyCounters();
+	return AliveCount > 0;
+}
+
+bool UBattleTeam::IsAnyUnitOnField() const
+{
+	VerifyCounters();
+	return OnFieldCount > 0;
 }
 
 bool UBattleTeam::IsOtherUnitAlive(AUnit* OtherUnit) const
 {
-	for (auto Unit : Units)
-	{
-		if (!Unit)
-			continue;
-		if (Unit == OtherUnit)
-			continue;
-		if (!Unit->IsDead())
-			return true;
-	}
-	return false;
+	VerifyCounters();
+	return AliveCount - ((GetMemberState(OtherUnit) & MemberAlive) != 0) > 0;
 }
 
 bool UBattleTeam::IsOtherUnitOnField(AUnit* OtherUnit) const
 {
-	for (auto Unit : Units)
-	{
-		if (!Unit)
-			continue;
-		if (Unit == OtherUnit)
-			continue;
-		if (Unit->GetGridMetadata().IsOnField())
-			return true;
-	}
-	return false;
+	VerifyCounters();
+	return OnFieldCount - ((GetMemberState(OtherUnit) & MemberOnField) != 0) > 0;
 }
 
 bool UBattleTeam::CanContinueFight() const
 {
-	for (auto Unit : Units)
-	{
-		if (Unit->IsDead())
-			continue;
-		if (Unit->GetGridMetadata().IsOnField())
-			return true;
-	}
-	return false;
+	VerifyCounters();
+	return AliveOnFieldCount > 0;
 }
 
 ETeamSide UBattleTeam::ReverseTeamSide(ETeamSide Side)
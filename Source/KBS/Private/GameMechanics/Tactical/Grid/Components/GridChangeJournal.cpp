@@ -0,0 +1,72 @@
+#include "GameMechanics/Tactical/Grid/Components/GridChangeJournal.h"
+#include "GameplayTypes/GridBitboard.h"
+#include "GameMechanics/Units/Unit.h"
+
+uint32 FGridChangeJournal::GetOldestRecoverableVersion() const
+{
+	return Version > static_cast<uint32>(Capacity) ? Version - Capacity : 0;
+}
+
+void FGridChangeJournal::Record(EGridChangeKind Kind, AUnit* Unit, const FTacCoordinates& Coords,
+                                uint64 AffectedCells, AUnit* OtherUnit)
+{
+	if (SuppressionDepth > 0)
+	{
+		return;
+	}
+	if (Entries.Num() < Capacity)
+	{
+		Entries.SetNum(Capacity);
+	}
+	++Version;
+	FGridChange& Entry = Entries[(Version - 1) % Capacity];
+	Entry.Version = Version;
+	Entry.Kind = Kind;
+	Entry.Unit = Unit;
+	Entry.OtherUnit = OtherUnit;
+	Entry.Coords = Coords;
+	Entry.AffectedCells = AffectedCells;
+}
+
+void FGridChangeJournal::Reset()
+{
+	// Skip past the ring window so every version handed out before the reset reads as unrecoverable
+	Entries.Reset();
+	Version += Capacity + 1;
+}
+
+bool FGridChangeJournal::GetChangesSince(uint32 SinceVersion, TArray<FGridChange>& OutChanges) const
+{
+	if (SinceVersion >= Version)
+	{
+		return true;
+	}
+	if (SinceVersion < GetOldestRecoverableVersion() || Entries.IsEmpty())
+	{
+		return false;
+	}
+	OutChanges.Reserve(OutChanges.Num() + static_cast<int32>(Version - SinceVersion));
+	for (uint32 V = SinceVersion + 1; V <= Version; ++V)
+	{
+		OutChanges.Add(EntryFor(V));
+	}
+	return true;
+}
+
+uint64 FGridChangeJournal::GetAffectedCellsSince(uint32 SinceVersion) const
+{
+	if (SinceVersion >= Version)
+	{
+		return 0;
+	}
+	if (SinceVersion < GetOldestRecoverableVersion() || Entries.IsEmpty())
+	{
+		return GridBitboard::AllCellsMask;
+	}
+	uint64 Mask = 0;
+	for (uint32 V = SinceVersion + 1; V <= Version; ++V)
+	{
+		Mask |= EntryFor(V).AffectedCells;
+	}
+	return Mask;
+}
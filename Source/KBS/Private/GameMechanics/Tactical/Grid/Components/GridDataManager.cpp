@@ -1,5 +1,7 @@
 #include "GameMechanics/Tactical/Grid/Components/GridDataManager.h"
 #include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/GridBitboard.h"
+#include "GameplayTypes/BattleZobrist.h"
 #include "GameMechanics/Tactical/Grid/TacBattleGrid.h"
 #include "GameMechanics/Units/Components/UnitVisualsComponent.h"
 #include "GameMechanics/Units/Unit.h"
@@ -9,58 +11,85 @@
 #include "GameMechanics/Units/BattleEffects/BattleEffectComponent.h"
 #include "GameMechanics/Units/Abilities/AbilityInventoryComponent.h"
 
-void FCorpseStack::Push(AUnit* Unit, const FVector& WorldLocation)
+void UGridDataManager::SetCorpseVisibility(AUnit* Corpse, bool bVisible)
 {
-	if (!Unit)
+	if (!Corpse)
 	{
 		return;
 	}
-	if (Corpses.Num() > 0)
+	if (UUnitVisualsComponent* VisualsComp = Corpse->GetVisualsComponent())
 	{
-		AUnit* PreviousTop = Corpses.Last();
-		SetCorpseVisibility(PreviousTop, false);
+		for (USceneComponent* MeshComp : VisualsComp->GetAllMeshComponents())
+		{
+			if (MeshComp)
+			{
+				MeshComp->SetVisibility(bVisible, true);
+			}
+		}
 	}
-	Corpses.Add(Unit);
-	Unit->SetActorLocation(WorldLocation);
-	SetCorpseVisibility(Unit, true);
 }
 
-AUnit* FCorpseStack::Pop()
+int32 UGridDataManager::AllocateOverflowEntry(AUnit* Corpse, int32 Next)
 {
-	if (Corpses.IsEmpty())
+	int32 Index = FreeOverflowHead;
+	if (Index != INDEX_NONE)
 	{
-		return nullptr;
+		FreeOverflowHead = CorpseOverflow[Index].Next;
 	}
-	AUnit* TopCorpse = Corpses.Last();
-	Corpses.RemoveAt(Corpses.Num() - 1);
-	if (Corpses.Num() > 0)
+	else
 	{
-		AUnit* NewTop = Corpses.Last();
-		SetCorpseVisibility(NewTop, true);
+		Index = CorpseOverflow.AddDefaulted();
 	}
-	return TopCorpse;
+	CorpseOverflow[Index].Corpse = Corpse;
+	CorpseOverflow[Index].Next = Next;
+	return Index;
 }
 
-AUnit* FCorpseStack::Top() const
+void UGridDataManager::ReleaseOverflowEntry(int32 Index)
 {
-	return Corpses.Num() > 0 ? Corpses.Last() : nullptr;
+	CorpseOverflow[Index].Corpse = nullptr;
+	CorpseOverflow[Index].Next = FreeOverflowHead;
+	FreeOverflowHead = Index;
 }
 
-void FCorpseStack::SetCorpseVisibility(AUnit* Corpse, bool bVisible)
+int32 UGridDataManager::RosterIndex(EUnitQuerySource Source, ETeamSide Side)
 {
-	if (!Corpse)
+	const int32 SideIndex = Side == ETeamSide::Attacker ? 0 : 1;
+	switch (Source)
 	{
-		return;
+	case EUnitQuerySource::OnField:  return SideIndex;
+	case EUnitQuerySource::OffField: return 2 + SideIndex;
+	case EUnitQuerySource::Corpses:  return 4 + SideIndex;
 	}
-	if (UUnitVisualsComponent* VisualsComp = Corpse->GetVisualsComponent())
+	checkf(false, TEXT("RosterIndex: Source must be a single flag"));
+	return SideIndex;
+}
+
+void UGridDataManager::AddToRoster(EUnitQuerySource Source, AUnit* Unit, ETeamSide Side)
+{
+	Rosters[RosterIndex(Source, Side)].Units.Add(Unit);
+	Unit->BindLiveHash(UnitStateHash);
+}
+
+void UGridDataManager::RemoveFromRoster(EUnitQuerySource Source, AUnit* Unit, ETeamSide Side)
+{
+	// Order-preserving so enumeration stays stable across unrelated removals
+	const int32 Removed = Rosters[RosterIndex(Source, Side)].Units.RemoveSingle(Unit);
+	checkf(Removed == 1, TEXT("RemoveFromRoster: %s missing from its roster"), *Unit->GetLogName());
+	if (!IsInAnyRoster(Unit))
+		Unit->UnbindLiveHash();
+}
+
+bool UGridDataManager::IsInAnyRoster(const AUnit* Unit) const
+{
+	return Rosters.ContainsByPredicate([Unit](const FUnitRoster& Roster) { return Roster.Units.Contains(Unit); });
+}
+
+void UGridDataManager::RefreshTeamState(AUnit* Unit) const
+{
+	if (UBattleTeam* Team = GetTeamBySide(Unit->GridMetadata.Team))
 	{
-		for (USceneComponent* MeshComp : VisualsComp->GetAllMeshComponents())
-		{
-			if (MeshComp)
-			{
-				MeshComp->SetVisibility(bVisible, true);
-			}
-		}
+		Team->RefreshUnitState(Unit);
 	}
 }
 
@@ -76,8 +105,17 @@ void UGridDataManager::Initialize(ATacBattleGrid* InGrid)
 		DefenderTeam->SetTeamSide(ETeamSide::Defender);
 		bPlayerIsAttacker = Grid->GetPlayerTeamSide() == ETeamSide::Attacker;
 	}
-	GroundLayer.SetNum(FGridConstants::GridSize);
-	AirLayer.SetNum(FGridConstants::GridSize);
+	Cells.Init(nullptr, GridBitboard::NumCells);
+	CorpseCells.Init(FCorpseCell(), FGridConstants::TotalCells);
+	CorpseOverflow.Reset();
+	FreeOverflowHead = INDEX_NONE;
+	OffFieldUnits.Reset();
+	Rosters.Init(FUnitRoster(), 6);
+	OccupiedMask = AttackerMask = DefenderMask = CorpseMask = 0;
+	OccupancyHash = 0;
+	// Units still bound to the previous battle's hash move over when they are added again
+	UnitStateHash = MakeShared<uint64>(0);
+	Journal.Reset();
 }
 
 // Primary FTacCoordinates-based implementation
@@ -87,18 +125,16 @@ bool UGridDataManager::PlaceUnit(AUnit* Unit, FTacCoordinates Coords)
 	{
 		return false;
 	}
-	TArray<FGridRow>& LayerArray = GetLayer(Coords.Layer);
-	if (Coords.Row >= LayerArray.Num() || Coords.Col >= LayerArray[Coords.Row].Cells.Num())
-	{
-		return false;
-	}
-
-	if (LayerArray[Coords.Row].Cells[Coords.Col] != nullptr)
+	TObjectPtr<AUnit>& Cell = Cells[Coords.GetCellIndex()];
+	if (Cell != nullptr)
 	{
 		return false;
 	}
 
-	LayerArray[Coords.Row].Cells[Coords.Col] = Unit;
+	Cell = Unit;
+	MarkCellOccupied(Coords, Unit->GetTeamSide());
+	const uint32 Salt = BattleZobrist::UnitSalt(Unit->GetUnitID());
+	OccupancyHash ^= BattleZobrist::OccupantKey(Salt, Coords);
 	Unit->SetActorLocation(Coords.ToWorldLocation(GridWorldLocation, Grid->GetCellSize(), Grid->GetAirLayerHeight()));
 
 	const int32 UnitSize = Unit->GetUnitDefinition()->UnitSize;
@@ -113,20 +149,22 @@ bool UGridDataManager::PlaceUnit(AUnit* Unit, FTacCoordinates Coords)
 	if (UnitSize > 1 && !bOnFlank)
 	{
 		const FTacCoordinates Candidate = GetExtraCellCoords(Coords, Orientation);
-		if (Candidate.IsValidCell()
-			&& Candidate.Row < LayerArray.Num()
-			&& Candidate.Col < LayerArray[Candidate.Row].Cells.Num()
-			&& LayerArray[Candidate.Row].Cells[Candidate.Col] == nullptr)
+		if (Candidate.IsValidCell() && Cells[Candidate.GetCellIndex()] == nullptr)
 		{
-			LayerArray[Candidate.Row].Cells[Candidate.Col] = Unit;
+			Cells[Candidate.GetCellIndex()] = Unit;
+			MarkCellOccupied(Candidate, Unit->GetTeamSide());
+			OccupancyHash ^= BattleZobrist::OccupantKey(Salt, Candidate);
 			ExtraCell = Candidate;
 		}
 	}
 
 	Unit->GridMetadata = FUnitGridMetadata(Coords, Unit->GetTeamSide(), true, bOnFlank,
 		Orientation, ExtraCell, UnitSize);
+	AddToRoster(EUnitQuerySource::OnField, Unit, Unit->GridMetadata.Team);
+	RefreshTeamState(Unit);
 	Unit->GetVisualsComponent()->SetCellSize(Grid->GetCellSize());
 	Unit->NotifyOrientationChanged();
+	Journal.Record(EGridChangeKind::Place, Unit, Coords, UnitCellsMask(Unit->GridMetadata));
 	UE_LOG(LogTacGrid, Log, TEXT("PlaceUnit: %s -> [%d,%d]"), *Unit->GetLogName(), Coords.Row, Coords.Col);
 	return true;
 }
@@ -143,12 +181,7 @@ AUnit* UGridDataManager::GetUnit(FTacCoordinates Coords) const
 	{
 		return nullptr;
 	}
-	const TArray<FGridRow>& LayerArray = GetLayer(Coords.Layer);
-	if (Coords.Row >= LayerArray.Num() || Coords.Col >= LayerArray[Coords.Row].Cells.Num())
-	{
-		return nullptr;
-	}
-	return LayerArray[Coords.Row].Cells[Coords.Col];
+	return Cells[Coords.GetCellIndex()];
 }
 
 // Convenience overload (delegates to primary)
@@ -163,31 +196,31 @@ bool UGridDataManager::RemoveUnit(FTacCoordinates Coords)
 	{
 		return false;
 	}
-	TArray<FGridRow>& LayerArray = GetLayer(Coords.Layer);
-	if (Coords.Row >= LayerArray.Num() || Coords.Col >= LayerArray[Coords.Row].Cells.Num())
-	{
-		return false;
-	}
-	AUnit* Unit = LayerArray[Coords.Row].Cells[Coords.Col];
+	AUnit* Unit = Cells[Coords.GetCellIndex()];
 	if (Unit == nullptr)
 	{
 		return false;
 	}
 
+	const uint64 VacatedCells = UnitCellsMask(Unit->GridMetadata);
+	const uint32 Salt = BattleZobrist::UnitSalt(Unit->GetUnitID());
 	if (Unit->GridMetadata.HasExtraCell())
 	{
 		const FTacCoordinates Extra = Unit->GridMetadata.ExtraCell;
-		TArray<FGridRow>& ExtraLayer = GetLayer(Extra.Layer);
-		if (Extra.Row < ExtraLayer.Num() && Extra.Col < ExtraLayer[Extra.Row].Cells.Num())
-		{
-			ExtraLayer[Extra.Row].Cells[Extra.Col] = nullptr;
-		}
+		Cells[Extra.GetCellIndex()] = nullptr;
+		MarkCellEmpty(Extra);
+		OccupancyHash ^= BattleZobrist::OccupantKey(Salt, Extra);
 	}
 
-	LayerArray[Coords.Row].Cells[Coords.Col] = nullptr;
+	Cells[Coords.GetCellIndex()] = nullptr;
+	MarkCellEmpty(Coords);
+	OccupancyHash ^= BattleZobrist::OccupantKey(Salt, Coords);
+	RemoveFromRoster(EUnitQuerySource::OnField, Unit, Unit->GridMetadata.Team);
 
 	Unit->GridMetadata = FUnitGridMetadata(Unit->GridMetadata.Coords, Unit->GridMetadata.Team, false, false,
 		Unit->GridMetadata.Orientation, FTacCoordinates::Invalid(), Unit->GridMetadata.UnitSize);
+	RefreshTeamState(Unit);
+	Journal.Record(EGridChangeKind::Remove, Unit, Coords, VacatedCells);
 	UE_LOG(LogTacGrid, Log, TEXT("RemoveUnit: %s from [%d,%d]"), *Unit->GetLogName(), Coords.Row, Coords.Col);
 	return true;
 }
@@ -204,14 +237,54 @@ bool UGridDataManager::RemoveUnit(AUnit* Unit)
 	return RemoveUnit(Unit->GridMetadata.Coords);
 }
 
-TArray<FGridRow>& UGridDataManager::GetLayer(ETacGridLayer Layer)
-{
-	return Layer == ETacGridLayer::Ground ? GroundLayer : AirLayer;
-}
-const TArray<FGridRow>& UGridDataManager::GetLayer(ETacGridLayer Layer) const
+bool UGridDataManager::SwapUnits(AUnit* Unit1, FTacCoordinates Pos1, AUnit* Unit2, FTacCoordinates Pos2)
 {
-	return Layer == ETacGridLayer::Ground ? GroundLayer : AirLayer;
+	checkf(Unit1 && Unit2, TEXT("SwapUnits: units must not be null"));
+	const uint64 AffectedCells = UnitCellsMask(Unit1->GridMetadata) | UnitCellsMask(Unit2->GridMetadata);
+	{
+		FGridChangeJournal::FScopedSuppression Suppress(Journal);
+
+		// Remove both units first
+		if (!RemoveUnit(Unit1))
+		{
+			UE_LOG(LogTacGrid, Error, TEXT("SwapUnits: Failed to remove unit from [%d,%d]"), Pos1.Row, Pos1.Col);
+			return false;
+		}
+
+		if (!RemoveUnit(Unit2))
+		{
+			UE_LOG(LogTacGrid, Error, TEXT("SwapUnits: Failed to remove unit from [%d,%d]"), Pos2.Row, Pos2.Col);
+			// Restore Unit1 to maintain consistency
+			PlaceUnit(Unit1, Pos1);
+			return false;
+		}
+
+		// Place both units in swapped positions
+		if (!PlaceUnit(Unit1, Pos2))
+		{
+			UE_LOG(LogTacGrid, Error, TEXT("SwapUnits: Failed to place unit at [%d,%d]"), Pos2.Row, Pos2.Col);
+			// Restore both units
+			PlaceUnit(Unit1, Pos1);
+			PlaceUnit(Unit2, Pos2);
+			return false;
+		}
+
+		if (!PlaceUnit(Unit2, Pos1))
+		{
+			UE_LOG(LogTacGrid, Error, TEXT("SwapUnits: Failed to place unit at [%d,%d]"), Pos1.Row, Pos1.Col);
+			// Restore both units
+			RemoveUnit(Pos2);
+			PlaceUnit(Unit1, Pos1);
+			PlaceUnit(Unit2, Pos2);
+			return false;
+		}
+	}
+
+	Journal.Record(EGridChangeKind::Swap, Unit1, Pos2,
+		AffectedCells | UnitCellsMask(Unit1->GridMetadata) | UnitCellsMask(Unit2->GridMetadata), Unit2);
+	return true;
 }
+
 bool UGridDataManager::IsUnitOnFlank(const AUnit* Unit) const
 {
 	checkf(Unit, TEXT("IsUnitOnFlank: Unit must not be null"));
@@ -223,6 +296,10 @@ void UGridDataManager::SetUnitOrientation(AUnit* Unit, EUnitOrientation Orientat
 	checkf(Unit, TEXT("SetUnitOrientation: Unit must not be null"));
 	Unit->GridMetadata.Orientation = Orientation;
 	Unit->NotifyOrientationChanged();
+	if (Unit->GridMetadata.IsOnField())
+	{
+		Journal.Record(EGridChangeKind::Orientation, Unit, Unit->GridMetadata.Coords, UnitCellsMask(Unit->GridMetadata));
+	}
 }
 
 void UGridDataManager::SetUnitOnFlank(AUnit* Unit, bool bOnFlank)
@@ -256,7 +333,113 @@ UBattleTeam* UGridDataManager::GetTeamBySide(ETeamSide Side) const
 
 bool UGridDataManager::IsCellOccupied(FTacCoordinates Coords) const
 {
-	return GetUnit(Coords) != nullptr;
+	if (!Coords.IsValidCell())
+	{
+		return false;
+	}
+	return (OccupiedMask & GridBitboard::CellMask(Coords)) != 0;
+}
+
+void UGridDataManager::MarkCellOccupied(const FTacCoordinates& Coords, ETeamSide Team)
+{
+	const uint64 Bit = GridBitboard::CellMask(Coords);
+	OccupiedMask |= Bit;
+	if (Team == ETeamSide::Attacker)
+	{
+		AttackerMask |= Bit;
+		DefenderMask &= ~Bit;
+	}
+	else
+	{
+		DefenderMask |= Bit;
+		AttackerMask &= ~Bit;
+	}
+}
+
+void UGridDataManager::MarkCellEmpty(const FTacCoordinates& Coords)
+{
+	const uint64 Bit = ~GridBitboard::CellMask(Coords);
+	OccupiedMask &= Bit;
+	AttackerMask &= Bit;
+	DefenderMask &= Bit;
+}
+
+uint64 UGridDataManager::CorpseTopKey(const AUnit* Corpse, const FTacCoordinates& Coords)
+{
+	return BattleZobrist::Key(BattleZobrist::EFeature::CorpseTop, BattleZobrist::UnitSalt(Corpse->GetUnitID()),
+	                          Coords.GetCellIndex());
+}
+
+uint64 UGridDataManager::ComputeBattleHash() const
+{
+	uint64 Result = 0;
+	for (int32 Bit = 0; Bit < GridBitboard::NumCells; ++Bit)
+	{
+		if (const AUnit* Unit = Cells[Bit])
+			Result ^= BattleZobrist::OccupantKey(BattleZobrist::UnitSalt(Unit->GetUnitID()), GridBitboard::CellFromBit(Bit));
+	}
+	for (int32 Bit = 0; Bit < CorpseCells.Num(); ++Bit)
+	{
+		if (const AUnit* Corpse = CorpseCells[Bit].Top)
+			Result ^= CorpseTopKey(Corpse, GridBitboard::CellFromBit(Bit));
+	}
+	ForEachUnit(EUnitQuerySource::OnField | EUnitQuerySource::OffField | EUnitQuerySource::Corpses,
+		[&Result](const AUnit* Unit) { Result ^= Unit->GetStateHashKey(); });
+	return Result;
+}
+
+uint64 UGridDataManager::UnitCellsMask(const FUnitGridMetadata& Metadata)
+{
+	if (!Metadata.IsOnField() || !Metadata.Coords.IsValidCell())
+	{
+		return 0;
+	}
+	uint64 Mask = GridBitboard::CellMask(Metadata.Coords);
+	if (Metadata.HasExtraCell())
+	{
+		Mask |= GridBitboard::CellMask(Metadata.ExtraCell);
+	}
+	return Mask;
+}
+
+uint64 UGridDataManager::GetOccupancyMask(EGridOccupancyMask Mask) const
+{
+	switch (Mask)
+	{
+	case EGridOccupancyMask::Occupied:      return OccupiedMask;
+	case EGridOccupancyMask::Attacker:      return AttackerMask;
+	case EGridOccupancyMask::Defender:      return DefenderMask;
+	case EGridOccupancyMask::Flank:         return GridBitboard::FlankMask;
+	case EGridOccupancyMask::CorpsePresent: return CorpseMask;
+	case EGridOccupancyMask::Restricted:    return GridBitboard::RestrictedMask;
+	}
+	return 0;
+}
+
+uint64 UGridDataManager::GetOccupancyMask(EGridOccupancyMask Mask, ETacGridLayer Layer) const
+{
+	return GetOccupancyMask(Mask) & GridBitboard::LayerMask(Layer);
+}
+
+uint64 UGridDataManager::GetTeamMask(ETeamSide Side) const
+{
+	return Side == ETeamSide::Attacker ? AttackerMask : DefenderMask;
+}
+
+uint64 UGridDataManager::GetEmptyCellsMask(ETacGridLayer Layer) const
+{
+	return GridBitboard::ValidCellsMask & GridBitboard::LayerMask(Layer) & ~OccupiedMask;
+}
+
+int32 UGridDataManager::CountCells(EGridOccupancyMask Mask, ETacGridLayer Layer) const
+{
+	return GridBitboard::Count(GetOccupancyMask(Mask, Layer));
+}
+
+void UGridDataManager::CellsFromMask(uint64 Mask, TArray<FTacCoordinates>& OutCells)
+{
+	OutCells.Reserve(OutCells.Num() + GridBitboard::Count(Mask));
+	GridBitboard::ForEachCell(Mask, [&OutCells](const FTacCoordinates& Cell) { OutCells.Add(Cell); });
 }
 void UGridDataManager::PushCorpse(AUnit* Unit, FTacCoordinates Coords)
 {
@@ -265,12 +448,24 @@ void UGridDataManager::PushCorpse(AUnit* Unit, FTacCoordinates Coords)
 		return;
 	}
 	// Corpses only exist on ground layer
-	if (Coords.Row >= GroundLayer.Num() || Coords.Col >= GroundLayer[Coords.Row].CorpseStacks.Num())
-	{
-		return;
-	}
-	FVector WorldLocation = FTacCoordinates::CellToWorldLocation(Coords.Row, Coords.Col, ETacGridLayer::Ground, GridWorldLocation, Grid->GetCellSize(), Grid->GetAirLayerHeight());
-	GroundLayer[Coords.Row].CorpseStacks[Coords.Col].Push(Unit, WorldLocation);
+	Coords.Layer = ETacGridLayer::Ground;
+	FCorpseCell& CorpseCell = CorpseCells[Coords.GetCellIndex()];
+	if (CorpseCell.Top)
+	{
+		OccupancyHash ^= CorpseTopKey(CorpseCell.Top, Coords);
+		SetCorpseVisibility(CorpseCell.Top, false);
+		CorpseCell.BuriedHead = AllocateOverflowEntry(CorpseCell.Top, CorpseCell.BuriedHead);
+	}
+	CorpseCell.Top = Unit;
+	OccupancyHash ^= CorpseTopKey(Unit, Coords);
+	++CorpseCell.Count;
+	AddToRoster(EUnitQuerySource::Corpses, Unit, Unit->GetTeamSide());
+	Unit->SetActorLocation(FTacCoordinates::CellToWorldLocation(Coords.Row, Coords.Col, ETacGridLayer::Ground, GridWorldLocation, Grid->GetCellSize(), Grid->GetAirLayerHeight()));
+	SetCorpseVisibility(Unit, true);
+
+	const uint64 CellBit = GridBitboard::CellMask(Coords);
+	CorpseMask |= CellBit;
+	Journal.Record(EGridChangeKind::CorpsePush, Unit, Coords, CellBit);
 	UE_LOG(LogTacGrid, Log, TEXT("PushCorpse: %s -> [%d,%d]"), *Unit->GetLogName(), Coords.Row, Coords.Col);
 }
 AUnit* UGridDataManager::GetTopCorpse(FTacCoordinates Coords) const
@@ -279,11 +474,8 @@ AUnit* UGridDataManager::GetTopCorpse(FTacCoordinates Coords) const
 	{
 		return nullptr;
 	}
-	if (Coords.Row >= GroundLayer.Num() || Coords.Col >= GroundLayer[Coords.Row].CorpseStacks.Num())
-	{
-		return nullptr;
-	}
-	return GroundLayer[Coords.Row].CorpseStacks[Coords.Col].Top();
+	Coords.Layer = ETacGridLayer::Ground;
+	return CorpseCells[Coords.GetCellIndex()].Top;
 }
 AUnit* UGridDataManager::PopCorpse(FTacCoordinates Coords)
 {
@@ -291,11 +483,36 @@ AUnit* UGridDataManager::PopCorpse(FTacCoordinates Coords)
 	{
 		return nullptr;
 	}
-	if (Coords.Row >= GroundLayer.Num() || Coords.Col >= GroundLayer[Coords.Row].CorpseStacks.Num())
+	Coords.Layer = ETacGridLayer::Ground;
+	FCorpseCell& CorpseCell = CorpseCells[Coords.GetCellIndex()];
+	AUnit* Corpse = CorpseCell.Top;
+	if (!Corpse)
 	{
 		return nullptr;
 	}
-	AUnit* Corpse = GroundLayer[Coords.Row].CorpseStacks[Coords.Col].Pop();
+	OccupancyHash ^= CorpseTopKey(Corpse, Coords);
+	if (CorpseCell.BuriedHead != INDEX_NONE)
+	{
+		const int32 Buried = CorpseCell.BuriedHead;
+		CorpseCell.Top = CorpseOverflow[Buried].Corpse;
+		CorpseCell.BuriedHead = CorpseOverflow[Buried].Next;
+		ReleaseOverflowEntry(Buried);
+		SetCorpseVisibility(CorpseCell.Top, true);
+		OccupancyHash ^= CorpseTopKey(CorpseCell.Top, Coords);
+	}
+	else
+	{
+		CorpseCell.Top = nullptr;
+	}
+	--CorpseCell.Count;
+	RemoveFromRoster(EUnitQuerySource::Corpses, Corpse, Corpse->GetTeamSide());
+
+	const uint64 CellBit = GridBitboard::CellMask(Coords);
+	if (CorpseCell.Count == 0)
+	{
+		CorpseMask &= ~CellBit;
+	}
+	Journal.Record(EGridChangeKind::CorpsePop, Corpse, Coords, CellBit);
 	UE_LOG(LogTacGrid, Log, TEXT("PopCorpse: %s from [%d,%d]"), *Corpse->GetLogName(), Coords.Row, Coords.Col);
 	return Corpse;
 }
@@ -303,38 +520,41 @@ int32 UGridDataManager::CorpsesNum(FTacCoordinates Coords) const
 {
 	if (!Coords.IsValidCell())
 	{
-		return false;
-	}
-	if (Coords.Row >= GroundLayer.Num() || Coords.Col >= GroundLayer[Coords.Row].CorpseStacks.Num())
-	{
-		return false;
+		return 0;
 	}
-	return !GroundLayer[Coords.Row].CorpseStacks[Coords.Col].Num();
+	Coords.Layer = ETacGridLayer::Ground;
+	return CorpseCells[Coords.GetCellIndex()].Count;
 }
-const TArray<TObjectPtr<AUnit>>& UGridDataManager::GetCorpseStack(FTacCoordinates Coords) const
+void UGridDataManager::GetCorpseStack(FTacCoordinates Coords, TArray<AUnit*>& OutCorpses) const
 {
-	static const TArray<TObjectPtr<AUnit>> EmptyStack;
 	if (!Coords.IsValidCell())
 	{
-		return EmptyStack;
+		return;
+	}
+	Coords.Layer = ETacGridLayer::Ground;
+	const FCorpseCell& CorpseCell = CorpseCells[Coords.GetCellIndex()];
+	if (!CorpseCell.Top)
+	{
+		return;
 	}
-	if (Coords.Row >= GroundLayer.Num() || Coords.Col >= GroundLayer[Coords.Row].CorpseStacks.Num())
+	OutCorpses.Reserve(OutCorpses.Num() + CorpseCell.Count);
+	OutCorpses.Add(CorpseCell.Top);
+	for (int32 Index = CorpseCell.BuriedHead; Index != INDEX_NONE; Index = CorpseOverflow[Index].Next)
 	{
-		return EmptyStack;
+		OutCorpses.Add(CorpseOverflow[Index].Corpse);
 	}
-	return GroundLayer[Coords.Row].CorpseStacks[Coords.Col].GetAll();
 }
 
 TArray<AUnit*> UGridDataManager::GetUnitsInCells(const TArray<FTacCoordinates>& CellCoords, ETacGridLayer Layer) const
 {
 	TMap<FGuid, TObjectPtr<AUnit>> UniqueUnits;
-	const TArray<FGridRow>& LayerArray = GetLayer(Layer);
 
-	for (const FTacCoordinates& Coords : CellCoords)
+	for (FTacCoordinates Coords : CellCoords)
 	{
-		if (Coords.IsValidCell() && Coords.Row < LayerArray.Num() && Coords.Col < LayerArray[Coords.Row].Cells.Num())
+		if (Coords.IsValidCell())
 		{
-			const TObjectPtr<AUnit>& Unit = LayerArray[Coords.Row].Cells[Coords.Col];
+			Coords.Layer = Layer;
+			const TObjectPtr<AUnit>& Unit = Cells[Coords.GetCellIndex()];
 			if (Unit)
 			{
 				UniqueUnits.Add(Unit->GetUnitID(), Unit);
@@ -349,104 +569,63 @@ TArray<AUnit*> UGridDataManager::GetUnitsInCells(const TArray<FTacCoordinates>&
 
 void UGridDataManager::FilterCells(AUnit* SourceUnit, ETacGridLayer Layer, QueryPredicates::FCellFilterPredicate Predicate, TArray<FTacCoordinates>& OutCells) const
 {
-	for (int32 Row = 0; Row < FGridConstants::GridSize; ++Row)
-	{
-		for (int32 Col = 0; Col < FGridConstants::GridSize; ++Col)
-		{
-			FTacCoordinates Coords(Row, Col, Layer);
-			if (Coords.IsRestrictedCell())
-				continue;
-			if (Predicate(SourceUnit, GetUnit(Coords), Coords))
-			{
-				OutCells.Add(Coords);
-			}
-		}
-	}
+	FTacCellSet Found;
+	FilterCells(SourceUnit, Layer, MoveTemp(Predicate), Found);
+	Found.AppendTo(OutCells);
+}
+
+void UGridDataManager::FilterCells(AUnit* SourceUnit, ETacGridLayer Layer, QueryPredicates::FCellFilterPredicate Predicate, FTacCellSet& OutCells) const
+{
+	FilterCellsWith(SourceUnit, Layer, Predicate, OutCells);
 }
 
 bool UGridDataManager::TestCells(AUnit* SourceUnit, ETacGridLayer Layer,
 	QueryPredicates::FCellFilterPredicate Predicate) const
 {
-	for (int32 Row = 0; Row < FGridConstants::GridSize; ++Row)
-	{
-		for (int32 Col = 0; Col < FGridConstants::GridSize; ++Col)
-		{
-			FTacCoordinates Coords(Row, Col, Layer);
-			if (Coords.IsRestrictedCell())
-				continue;
-			if (Predicate(SourceUnit, GetUnit(Coords), Coords))
-			{
-				return true;
-			}
-		}
-	}
-	return false;
+	return TestCellsWith(SourceUnit, Layer, Predicate);
 }
 
 bool UGridDataManager::TestCorpseCells(AUnit* SourceUnit, QueryPredicates::FCorpseFilterPredicate Predicate) const
 {
-	for (int32 Row = 0; Row < FGridConstants::GridSize; ++Row)
-	{
-		for (int32 Col = 0; Col < FGridConstants::GridSize; ++Col)
-		{
-			FTacCoordinates Coords(Row, Col, ETacGridLayer::Ground);
-			if (Coords.IsRestrictedCell())
-				continue;
-			if (Predicate(Coords, IsCellOccupied(Coords), GetTopCorpse(Coords), CorpsesNum(Coords)))
-			{
-				return true;
-			}
-		}
-	}
-	return false;
+	return TestCorpseCellsWith(Predicate);
 }
 
 void UGridDataManager::FilterCorpseCells(AUnit* SourceUnit, QueryPredicates::FCorpseFilterPredicate Predicate,
                                          TArray<FTacCoordinates>& OutCells) const
 {
-	for (int32 Row = 0; Row < FGridConstants::GridSize; ++Row)
-	{
-		for (int32 Col = 0; Col < FGridConstants::GridSize; ++Col)
-		{
-			FTacCoordinates Coords(Row, Col, ETacGridLayer::Ground);
-			if (Coords.IsRestrictedCell())
-				continue;
-			if (Predicate(Coords, IsCellOccupied(Coords), GetTopCorpse(Coords), CorpsesNum(Coords)))
-			{
-				OutCells.Add(Coords);
-			}
-		}
-	}
+	FTacCellSet Found;
+	FilterCorpseCells(SourceUnit, MoveTemp(Predicate), Found);
+	Found.AppendTo(OutCells);
+}
+
+void UGridDataManager::FilterCorpseCells(AUnit* SourceUnit, QueryPredicates::FCorpseFilterPredicate Predicate,
+                                         FTacCellSet& OutCells) const
+{
+	FilterCorpseCellsWith(Predicate, OutCells);
 }
 
 TArray<AUnit*> UGridDataManager::GetUnits(EUnitQuerySource Sources) const
 {
-	TMap<FGuid, TObjectPtr<AUnit>> Result;
+	TArray<AUnit*> Out;
+	Out.Reserve(NumUnits(Sources));
+	ForEachUnit(Sources, [&Out](AUnit* Unit) { Out.Add(Unit); });
+	return Out;
+}
 
-	if (EnumHasAnyFlags(Sources, EUnitQuerySource::OnField))
-	{
-		for (const TArray<FGridRow>* Layer : { &GroundLayer, &AirLayer })
-			for (const FGridRow& Row : *Layer)
-				for (const TObjectPtr<AUnit>& Unit : Row.Cells)
-					if (Unit) Result.Add(Unit->GetUnitID(), Unit);
-	}
-	if (EnumHasAnyFlags(Sources, EUnitQuerySource::OffField))
-	{
-		for (const auto& Pair : OffFieldUnits)
-			if (Pair.Value) Result.Add(Pair.Key, Pair.Value);
-	}
-	if (EnumHasAnyFlags(Sources, EUnitQuerySource::Corpses))
+TArrayView<const TObjectPtr<AUnit>> UGridDataManager::GetRoster(EUnitQuerySource Source, ETeamSide Side) const
+{
+	return Rosters[RosterIndex(Source, Side)].Units;
+}
+
+int32 UGridDataManager::NumUnits(EUnitQuerySource Sources) const
+{
+	int32 Num = 0;
+	for (const EUnitQuerySource Source : { EUnitQuerySource::OnField, EUnitQuerySource::OffField, EUnitQuerySource::Corpses })
 	{
-		for (const TArray<FGridRow>* Layer : { &GroundLayer, &AirLayer })
-			for (const FGridRow& Row : *Layer)
-				for (const FCorpseStack& Stack : Row.CorpseStacks)
-					for (const TObjectPtr<AUnit>& Corpse : Stack.GetAll())
-						if (Corpse) Result.Add(Corpse->GetUnitID(), Corpse);
+		if (EnumHasAnyFlags(Sources, Source))
+			Num += GetRoster(Source, ETeamSide::Attacker).Num() + GetRoster(Source, ETeamSide::Defender).Num();
 	}
-
-	TArray<TObjectPtr<AUnit>> Out;
-	Result.GenerateValueArray(Out);
-	return Out;
+	return Num;
 }
 
 
@@ -489,7 +668,13 @@ void UGridDataManager::PlaceUnitOffField(AUnit* Unit, bool bClearEffects, bool b
 {
 	checkf(Unit->GridMetadata.IsOnField(), TEXT("PlaceUnitOffField: %s is not on the grid"), *Unit->GetLogName());
 
-	RemoveUnit(Unit);
+	const FTacCoordinates LastCoords = Unit->GridMetadata.Coords;
+	const uint64 VacatedCells = UnitCellsMask(Unit->GridMetadata);
+	{
+		FGridChangeJournal::FScopedSuppression Suppress(Journal);
+		RemoveUnit(Unit);
+	}
+	Journal.Record(EGridChangeKind::OffField, Unit, LastCoords, VacatedCells);
 	Unit->GridMetadata.Coords = FTacCoordinates::Invalid();
 
 	if (bClearEffects)
@@ -502,6 +687,7 @@ void UGridDataManager::PlaceUnitOffField(AUnit* Unit, bool bClearEffects, bool b
 	}
 
 	OffFieldUnits.Add(Unit->GetUnitID(), Unit);
+	AddToRoster(EUnitQuerySource::OffField, Unit, Unit->GetTeamSide());
 	Unit->HandleFieldPresenceChange(false);
 	UE_LOG(LogTacGrid, Log, TEXT("PlaceUnitOffField: %s"), *Unit->GetLogName());
 }
@@ -516,8 +702,17 @@ bool UGridDataManager::ReturnUnitToField(const FGuid& UnitID, FTacCoordinates Ta
 	}
 
 	AUnit* Unit = OffFieldUnits[UnitID];
+	{
+		FGridChangeJournal::FScopedSuppression Suppress(Journal);
+		if (!PlaceUnit(Unit, TargetCoords))
+		{
+			// Still off field: containers and roster are untouched
+			return false;
+		}
+	}
 	OffFieldUnits.Remove(UnitID);
-	PlaceUnit(Unit, TargetCoords);
+	RemoveFromRoster(EUnitQuerySource::OffField, Unit, Unit->GetTeamSide());
+	Journal.Record(EGridChangeKind::ReturnToField, Unit, TargetCoords, UnitCellsMask(Unit->GridMetadata));
 	UE_LOG(LogTacGrid, Log, TEXT("ReturnUnitToField: %s -> [%d,%d]"), *Unit->GetLogName(), TargetCoords.Row, TargetCoords.Col);
 	return true;
 }
@@ -529,9 +724,7 @@ bool UGridDataManager::IsUnitOffField(const AUnit* Unit) const
 
 TArray<AUnit*> UGridDataManager::GetOffFieldUnits() const
 {
-	TArray<TObjectPtr<AUnit>> Values;
-	OffFieldUnits.GenerateValueArray(Values);
-	return Values;
+	return GetUnits(EUnitQuerySource::OffField);
 }
 
 void UGridDataManager::RemoveUnitFromGrid(AUnit* Unit)
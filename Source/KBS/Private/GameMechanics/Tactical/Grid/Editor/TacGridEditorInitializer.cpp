@@ -84,10 +84,8 @@ void UTacGridEditorInitializer::SetupUnitsInLayer(ETacGridLayer Layer)
 	{
 		for (int32 Col = 0; Col < FGridConstants::GridSize; ++Col)
 		{
-			const TArray<FGridRow>& LayerArray = Grid->GetDataManager()->GetLayer(Layer);
-			if (Row < LayerArray.Num() && Col < LayerArray[Row].Cells.Num() && LayerArray[Row].Cells[Col])
+			if (AUnit* Unit = Grid->GetDataManager()->GetUnit(Row, Col, Layer))
 			{
-				AUnit* Unit = LayerArray[Row].Cells[Col];
 				// Skip the extra cell of a 2-cell unit to avoid binding it twice
 				if (Unit->GetGridMetadata().ExtraCell == FTacCoordinates(Row, Col, Layer))
 				{
@@ -0,0 +1,155 @@
+#include "GameMechanics/Tactical/Grid/Subsystems/CombatPhaseRegistry.h"
+#include "GameplayTypes/CombatTypes.h"
+
+FCombatListenerHandle FCombatPhaseRegistry::Add(UObject* Listener, FCombatPhaseCallback Callback, ECombatPhaseMask Phases,
+                                                int32 Priority, const AUnit* Unit, ECombatRole Roles)
+{
+	checkf(Listener && Callback, TEXT("FCombatPhaseRegistry: listener object and callback are required"));
+	FListener Entry;
+	Entry.Id = NextId++;
+	Entry.Priority = Priority;
+	Entry.Object = Listener;
+	Entry.Callback = Callback;
+	Entry.Unit = Unit;
+	Entry.Roles = Roles;
+
+	if (DispatchDepth > 0)
+	{
+		PendingAdds.Emplace(Phases, Entry);
+	}
+	else
+	{
+		for (int32 Phase = 0; Phase < static_cast<int32>(ECombatPhase::Count); ++Phase)
+		{
+			if (EnumHasAnyFlags(Phases, static_cast<ECombatPhaseMask>(1 << Phase)))
+				Insert(static_cast<ECombatPhase>(Phase), Entry);
+		}
+	}
+	return FCombatListenerHandle{ Entry.Id };
+}
+
+void FCombatPhaseRegistry::Insert(ECombatPhase Phase, const FListener& Listener)
+{
+	// After every entry of equal or higher priority, so equal priorities keep registration order
+	TArray<FListener>& PhaseListeners = Listeners[static_cast<int32>(Phase)];
+	int32 Index = PhaseListeners.Num();
+	while (Index > 0 && PhaseListeners[Index - 1].Priority < Listener.Priority)
+		--Index;
+	PhaseListeners.Insert(Listener, Index);
+}
+
+void FCombatPhaseRegistry::Remove(FCombatListenerHandle& Handle)
+{
+	if (!Handle.IsValid())
+		return;
+	const uint32 Id = Handle.Id;
+	Handle = FCombatListenerHandle();
+	PendingAdds.RemoveAll([Id](const TPair<ECombatPhaseMask, FListener>& Pending) { return Pending.Value.Id == Id; });
+	for (TArray<FListener>& PhaseListeners : Listeners)
+	{
+		for (FListener& Entry : PhaseListeners)
+		{
+			if (Entry.Id == Id)
+				Entry.Callback = nullptr;
+		}
+	}
+	bHasDeferredRemovals = true;
+	if (DispatchDepth == 0)
+		FlushDeferred();
+}
+
+void FCombatPhaseRegistry::RemoveAll(const UObject* Listener)
+{
+	PendingAdds.RemoveAll([Listener](const TPair<ECombatPhaseMask, FListener>& Pending)
+	{
+		return Pending.Value.Object.Get() == Listener;
+	});
+	for (TArray<FListener>& PhaseListeners : Listeners)
+	{
+		for (FListener& Entry : PhaseListeners)
+		{
+			if (Entry.Object.Get() == Listener)
+				Entry.Callback = nullptr;
+		}
+	}
+	bHasDeferredRemovals = true;
+	if (DispatchDepth == 0)
+		FlushDeferred();
+}
+
+void FCombatPhaseRegistry::Reset()
+{
+	checkf(DispatchDepth == 0, TEXT("FCombatPhaseRegistry: Reset called during a dispatch"));
+	for (TArray<FListener>& PhaseListeners : Listeners)
+		PhaseListeners.Reset();
+	PendingAdds.Reset();
+	bHasDeferredRemovals = false;
+}
+
+void FCombatPhaseRegistry::Dispatch(ECombatPhase Phase, FCombatContext& Context, FHitInstance* Hit, FDamageResult* Damage,
+                                    ECombatRole Roles, bool bIncludeGlobal)
+{
+	const TArray<FListener>& PhaseListeners = Listeners[static_cast<int32>(Phase)];
+	if (PhaseListeners.IsEmpty())
+		return;
+
+	const AUnit* Attacker = EnumHasAnyFlags(Roles, ECombatRole::Attacker) ? Context.Attacker : nullptr;
+	const AUnit* Target = Hit && EnumHasAnyFlags(Roles, ECombatRole::Target) ? Hit->Target : nullptr;
+	FCombatPhaseEvent Event{ Phase, Context, Hit, Damage };
+
+	++DispatchDepth;
+	// Removals only null out callbacks and additions are queued, so the array is stable while iterating
+	for (const FListener& Entry : PhaseListeners)
+	{
+		if (!Entry.Callback)
+			continue;
+		UObject* Object = Entry.Object.Get();
+		if (!Object)
+		{
+			bHasDeferredRemovals = true;
+			continue;
+		}
+		if (!Entry.Unit)
+		{
+			if (!bIncludeGlobal)
+				continue;
+			Event.Role = ECombatRole::None;
+			Entry.Callback(Object, Event);
+			continue;
+		}
+		// A unit attacking itself hears both sides, attacker first, like the old per-unit mirrors
+		if (Entry.Unit == Attacker && EnumHasAnyFlags(Entry.Roles, ECombatRole::Attacker))
+		{
+			Event.Role = ECombatRole::Attacker;
+			Entry.Callback(Object, Event);
+		}
+		if (Entry.Unit == Target && EnumHasAnyFlags(Entry.Roles, ECombatRole::Target) && Entry.Callback)
+		{
+			Event.Role = ECombatRole::Target;
+			Entry.Callback(Object, Event);
+		}
+	}
+	if (--DispatchDepth == 0 && (bHasDeferredRemovals || !PendingAdds.IsEmpty()))
+		FlushDeferred();
+}
+
+void FCombatPhaseRegistry::FlushDeferred()
+{
+	if (bHasDeferredRemovals)
+	{
+		for (TArray<FListener>& PhaseListeners : Listeners)
+		{
+			PhaseListeners.RemoveAll([](const FListener& Entry) { return !Entry.Callback || !Entry.Object.IsValid(); });
+		}
+		bHasDeferredRemovals = false;
+	}
+	for (const TPair<ECombatPhaseMask, FListener>& Pending : PendingAdds)
+	{
+		for (int32 Phase = 0; Phase < static_cast<int32>(ECombatPhase::Count); ++Phase)
+		{
+			if (EnumHasAnyFlags(Pending.Key, static_cast<ECombatPhaseMask>(1 << Phase)))
+				Insert(static_cast<ECombatPhase>(Phase), Pending.Value);
+		}
+	}
+	PendingAdds.Reset();
+}
@@ -2,6 +2,7 @@
 #include "GameMechanics/Tactical/Grid/Subsystems/Services/TacAICombatService.h"
 DEFINE_LOG_CATEGORY(LogKBSAI);
 #include "GameMechanics/Tactical/Grid/Subsystems/TacGridSubsystem.h"
+#include "GameMechanics/Tactical/Grid/Components/GridDataManager.h"
 #include "GameMechanics/Tactical/Grid/Subsystems/TacCombatSubsystem.h"
 #include "GameMechanics/Tactical/Grid/Subsystems/Services/TacGridTargetingService.h"
 #include "GameMechanics/Tactical/Grid/BattleTeam.h"
@@ -9,6 +10,44 @@ DEFINE_LOG_CATEGORY(LogKBSAI);
 #include "GameMechanics/Units/Abilities/AbilityInventoryComponent.h"
 #include "GameMechanics/Units/Abilities/UnitAbility.h"
 #include "GameplayTypes/AbilityTypes.h"
+#include "GameMechanics/Tactical/Grid/TacBattleGrid.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacTurnSubsystem.h"
+#include "GameMechanics/Tactical/Simulation/BattleSetup.h"
+#include "GameMechanics/Tactical/Simulation/BattleMcts.h"
+#include "GameMechanics/Tactical/Simulation/BattleExpectimax.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/Services/TacThreatMapService.h"
+#include "GameplayTypes/GridBitboard.h"
+#include "GameplayTypes/GridCellTables.h"
+#include "Async/Async.h"
+
+namespace
+{
+	// PickMoveCell weights, in steps: walking into a likely kill costs as much as two extra steps
+	constexpr float MoveDangerWeight = 2.0f;
+	constexpr float MoveHealerCoverBonus = 0.25f;
+
+	// Steps from every cell to the nearest Sources cell over GridCellTables neighbours, with the layers
+	// folded together so ground and air units still close in on each other; MAX_uint8 if unreachable
+	void ComputeStepsToNearest(uint64 Sources, uint8 (&OutSteps)[GridBitboard::NumCells])
+	{
+		const uint64 Ground = GridBitboard::LayerMask(ETacGridLayer::Ground);
+		const uint64 Folded = (Sources & Ground) | ((Sources >> FGridConstants::TotalCells) & Ground);
+		uint64 Frontier = (Folded | (Folded << FGridConstants::TotalCells)) & GridBitboard::ValidCellsMask;
+		uint64 Visited = Frontier;
+		FMemory::Memset(OutSteps, MAX_uint8, sizeof(OutSteps));
+		for (uint8 Step = 0; Frontier; ++Step)
+		{
+			uint64 Next = 0;
+			GridBitboard::ForEachCell(Frontier, [&OutSteps, &Next, Step](const FTacCoordinates& Cell)
+			{
+				OutSteps[Cell.GetCellIndex()] = Step;
+				Next |= GridCellTables::NeighborMask(Cell, false, true);
+			});
+			Frontier = Next & GridBitboard::ValidCellsMask & ~Visited;
+			Visited |= Frontier;
+		}
+	}
+}
 
 void UTacAICombatService::Initialize(UTacGridSubsystem* InGridSubsystem, UTacCombatSubsystem* InCombatSubsystem)
 {
@@ -22,6 +61,8 @@ FAiDecision UTacAICombatService::ThinkOverNextAction(AUnit* Unit) const
 {
 	UE_LOG(LogKBSAI, Log, TEXT("AI thinking for unit: %s"), *Unit->GetName());
 	FAiDecision Decision;
+	const EAIDecisionEngine Engine = GetDecisionEngine(Unit->GetTeamSide());
+	if (Engine != EAIDecisionEngine::Heuristic && TryDecideBySearch(Unit, Engine, Decision)) return Decision;
 	if (TryDecideAttack(Unit, Decision)) return Decision;
 	if (TryDecideMove(Unit, Decision)) return Decision;
 	DecideWait(Unit, Decision);
@@ -30,6 +71,227 @@ FAiDecision UTacAICombatService::ThinkOverNextAction(AUnit* Unit) const
 	return Decision;
 }
 
+EAIDecisionEngine UTacAICombatService::GetDecisionEngine(ETeamSide Side) const
+{
+	const UGridConfig* Config = GridSubsystem->GetGridConfig();
+	if (!Config) return EAIDecisionEngine::Heuristic;
+	return Side == ETeamSide::Attacker ? Config->AttackerAI : Config->DefenderAI;
+}
+
+bool UTacAICombatService::TryDecideBySearch(AUnit* Unit, EAIDecisionEngine Engine, FAiDecision& OutDecision) const
+{
+	FBattleSetup Snapshot;
+	if (!CaptureSnapshot(Snapshot))
+		return false;
+	const FSimAction Action = RunSearch(Snapshot.GetInitialState(), Engine, GridSubsystem->GetGridConfig()->SearchSettings,
+	                                    CombatSubsystem->GetAIRandomStream().Fork().GetSeed(), nullptr);
+	return TryMapSearchAction(Unit, Action, OutDecision);
+}
+
+bool UTacAICombatService::StartThinking(AUnit* Unit, FAiThinkTask& OutTask, TFunction<void()> OnReady) const
+{
+	const EAIDecisionEngine Engine = GetDecisionEngine(Unit->GetTeamSide());
+	if (Engine == EAIDecisionEngine::Heuristic)
+		return false;
+	TSharedRef<FBattleSetup> Snapshot = MakeShared<FBattleSetup>();
+	if (!CaptureSnapshot(*Snapshot))
+		return false;
+
+	UE_LOG(LogKBSAI, Log, TEXT("AI thinking off the game thread for unit: %s"), *Unit->GetName());
+	LaunchSearch(Snapshot, Engine, OutTask, MoveTemp(OnReady));
+	return true;
+}
+
+void UTacAICombatService::LaunchSearch(TSharedRef<FBattleSetup> Snapshot, EAIDecisionEngine Engine, FAiThinkTask& OutTask,
+                                       TFunction<void()> OnReady) const
+{
+	const FAISearchSettings Settings = GridSubsystem->GetGridConfig()->SearchSettings;
+	const int32 Seed = CombatSubsystem->GetAIRandomStream().Fork().GetSeed();
+	TSharedRef<std::atomic<bool>> CancelFlag = MakeShared<std::atomic<bool>>(false);
+	OutTask = FAiThinkTask(Async(EAsyncExecution::TaskGraph,
+		[Snapshot, Engine, Settings, Seed, CancelFlag]()
+		{
+			return RunSearch(Snapshot->GetInitialState(), Engine, Settings, Seed, &CancelFlag.Get());
+		},
+		[OnReady = MoveTemp(OnReady)]()
+		{
+			if (OnReady)
+				AsyncTask(ENamedThreads::GameThread, OnReady);
+		}), CancelFlag);
+}
+
+void UTacAICombatService::StartSpeculating(AUnit* PredictedUnit, TFunction<void()> OnReady)
+{
+	DiscardSpeculation();
+	const EAIDecisionEngine Engine = GetDecisionEngine(PredictedUnit->GetTeamSide());
+	const UTacTurnSubsystem* TurnSubsystem = GetWorld()->GetSubsystem<UTacTurnSubsystem>();
+	if (Engine == EAIDecisionEngine::Heuristic || !TurnSubsystem)
+		return;
+
+	// The snapshot's next unit must be the predicted one; off-field units never make it in
+	TSharedRef<FBattleSetup> Snapshot = MakeShared<FBattleSetup>();
+	FTacCoordinates PredictedCoords;
+	if (!Snapshot->CaptureLiveNextTurn(*GridSubsystem, *TurnSubsystem) ||
+		!GridSubsystem->GetUnitCoordinates(PredictedUnit, PredictedCoords))
+		return;
+	const FBattleState& Root = Snapshot->GetInitialState();
+	if (Root.GetUnit(Root.GetCurrentUnit()).Coords != PredictedCoords || !Root.CanAct(Root.GetCurrentUnit()))
+		return;
+
+	UE_LOG(LogKBSAI, Log, TEXT("AI speculating for next unit: %s"), *PredictedUnit->GetName());
+	FAiThinkTask Task;
+	LaunchSearch(Snapshot, Engine, Task, MoveTemp(OnReady));
+	Speculate(PredictedUnit, MoveTemp(Task));
+}
+
+void UTacAICombatService::Speculate(AUnit* PredictedUnit, FAiThinkTask&& Task)
+{
+	DiscardSpeculation();
+	Speculation = MoveTemp(Task);
+	SpeculatedUnit = PredictedUnit;
+	SpeculatedGridVersion = GridSubsystem->GetGridVersion();
+	SpeculatedStatusSerial = FUnitStatusContainer::GetChangeSerial();
+	SpeculatedStatSerial = FStatModifierAggregate::GetChangeSerial();
+	SpeculatedHealthSerial = FUnitHealth::GetChangeSerial();
+}
+
+bool UTacAICombatService::TakeSpeculation(AUnit* Unit, FAiThinkTask& OutTask)
+{
+	if (!Speculation.IsValid())
+		return false;
+	// Turn-end and turn-start effects change health, statuses and stats without moving anyone
+	const bool bStillValid = SpeculatedUnit.Get() == Unit && SpeculatedGridVersion == GridSubsystem->GetGridVersion()
+		&& SpeculatedStatusSerial == FUnitStatusContainer::GetChangeSerial()
+		&& SpeculatedStatSerial == FStatModifierAggregate::GetChangeSerial()
+		&& SpeculatedHealthSerial == FUnitHealth::GetChangeSerial();
+	if (!bStillValid)
+	{
+		UE_LOG(LogKBSAI, Log, TEXT("AI speculation discarded: battle changed or another unit acts"));
+		DiscardSpeculation();
+		return false;
+	}
+	UE_LOG(LogKBSAI, Log, TEXT("AI speculation reused for unit: %s (%s)"), *Unit->GetName(),
+	       Speculation.IsReady() ? TEXT("ready") : TEXT("still running"));
+	OutTask = MoveTemp(Speculation);
+	Speculation = FAiThinkTask();
+	SpeculatedUnit.Reset();
+	return true;
+}
+
+void UTacAICombatService::DiscardSpeculation()
+{
+	Speculation.Cancel();
+	Speculation = FAiThinkTask();
+	SpeculatedUnit.Reset();
+}
+
+FAiDecision UTacAICombatService::FinishThinking(AUnit* Unit, FAiThinkTask& Task) const
+{
+	checkf(Task.IsReady(), TEXT("TacAICombatService: FinishThinking called before the task was ready"));
+	const FSimAction Action = Task.Result.Get();
+	const bool bCancelled = Task.IsCancelled();
+	Task = FAiThinkTask();
+
+	// The battle moved on under the search: a cancel (state left, battle ended) or the unit gone
+	FAiDecision Decision;
+	if (bCancelled || !Unit || Unit->IsDead() || !Unit->GetGridMetadata().IsOnField())
+	{
+		UE_LOG(LogKBSAI, Log, TEXT("  [Search] answer dropped: task cancelled or unit no longer on the field"));
+		return Decision;
+	}
+	if (TryMapSearchAction(Unit, Action, Decision)) return Decision;
+	if (TryDecideAttack(Unit, Decision)) return Decision;
+	if (TryDecideMove(Unit, Decision)) return Decision;
+	DecideWait(Unit, Decision);
+	return Decision;
+}
+
+bool UTacAICombatService::CaptureSnapshot(FBattleSetup& OutSnapshot) const
+{
+	const UTacTurnSubsystem* TurnSubsystem = GetWorld()->GetSubsystem<UTacTurnSubsystem>();
+	if (!TurnSubsystem || !OutSnapshot.CaptureLive(*GridSubsystem, *TurnSubsystem))
+	{
+		UE_LOG(LogKBSAI, Warning, TEXT("  [Search] Could not snapshot the battle, using heuristics"));
+		return false;
+	}
+	return true;
+}
+
+FSimAction UTacAICombatService::RunSearch(const FBattleState& Root, EAIDecisionEngine Engine,
+                                          const FAISearchSettings& Settings, int32 Seed, const std::atomic<bool>* Cancel)
+{
+	if (Engine == EAIDecisionEngine::Expectimax)
+	{
+		FBattleExpectimaxParams Params;
+		Params.MaxDepth = Settings.SearchDepth;
+		Params.TimeBudgetSeconds = Settings.TimeBudgetMs / 1000.0;
+		Params.MaxMovesPerTurn = Settings.MaxMovesPerTurn;
+		Params.Cancel = Cancel;
+		const FBattleExpectimaxResult Result = FBattleExpectimax::Search(Root, Params);
+		UE_LOG(LogKBSAI, Log, TEXT("  [Search] Expectimax depth %d, %lld nodes, expected score %.2f"),
+		       Result.Depth, Result.Nodes, Result.ExpectedScore);
+		return Result.Action;
+	}
+
+	FBattleSearchParams Params;
+	Params.TimeBudgetSeconds = Settings.TimeBudgetMs / 1000.0;
+	Params.MaxIterations = Settings.MaxIterations;
+	Params.RolloutRounds = Settings.RolloutRounds;
+	Params.Seed = Seed;
+	Params.Cancel = Cancel;
+	const FBattleSearchResult Result = FBattleMcts::Search(Root, Params);
+	UE_LOG(LogKBSAI, Log, TEXT("  [Search] MCTS %d iterations, expected score %.2f"), Result.Iterations, Result.ExpectedScore);
+	return Result.Action;
+}
+
+bool UTacAICombatService::TryMapSearchAction(AUnit* Unit, const FSimAction& Action, FAiDecision& OutDecision) const
+{
+	EDefaultAbilitySlot Slot;
+	switch (Action.Kind)
+	{
+	case ESimActionKind::Attack: Slot = EDefaultAbilitySlot::Attack; break;
+	case ESimActionKind::Move:   Slot = EDefaultAbilitySlot::Move; break;
+	case ESimActionKind::Wait:
+		DecideWait(Unit, OutDecision);
+		return OutDecision.bHasDecision;
+	default:
+		return false;
+	}
+
+	UUnitAbility* Ability = Unit->GetAbilityInventory()->GetDefaultAbility(Slot);
+	if (!Ability || !Ability->CanExecute() ||
+		!GridSubsystem->GetGridTargetingService()->GetValidTargetCells(Unit, Ability->GetTargeting()).Contains(Action.Cell))
+	{
+		UE_LOG(LogKBSAI, Warning, TEXT("  [Search] Chosen cell [%d,%d] is not valid live, using heuristics"),
+		       Action.Cell.Row, Action.Cell.Col);
+		return false;
+	}
+	OutDecision.AbilityToUse = Ability;
+	OutDecision.TargetCell = Action.Cell;
+	OutDecision.bHasDecision = true;
+	UE_LOG(LogKBSAI, Log, TEXT("  [Search] decided '%s' -> cell [%d,%d]"), *Ability->GetAbilityDisplayData().AbilityName,
+	       Action.Cell.Row, Action.Cell.Col);
+	return true;
+}
+
+FAiThinkTask::FAiThinkTask(TFuture<FSimAction>&& InResult, TSharedRef<std::atomic<bool>> InCancelFlag)
+	: Result(MoveTemp(InResult))
+	, CancelFlag(InCancelFlag)
+{
+}
+
+void FAiThinkTask::Cancel()
+{
+	if (CancelFlag)
+		CancelFlag->store(true, std::memory_order_relaxed);
+}
+
+void FAiThinkTask::Wait() const
+{
+	if (Result.IsValid())
+		Result.Wait();
+}
+
 bool UTacAICombatService::TryDecideAttack(AUnit* Unit, FAiDecision& OutDecision) const
 {
 	UUnitAbility* AttackAbility = Unit->GetAbilityInventory()->GetDefaultAbility(EDefaultAbilitySlot::Attack);
@@ -52,9 +314,10 @@ bool UTacAICombatService::TryDecideAttack(AUnit* Unit, FAiDecision& OutDecision)
 	}
 
 	OutDecision.AbilityToUse = AttackAbility;
-	OutDecision.TargetCell = ValidCells[0];  // Targeting service returns closest-first
+	OutDecision.TargetCell = AttackAbility->GetTargeting().Strategy == ETargetingStrategy::Closest
+		? PickAttackCell(Unit, ValidCells) : ValidCells[0];
 	OutDecision.bHasDecision = true;
-	UE_LOG(LogKBSAI, Log, TEXT("  [Attack] decided '%s' -> cell [%d,%d]"), *AttackAbility->GetAbilityDisplayData().AbilityName, ValidCells[0].Row, ValidCells[0].Col);
+	UE_LOG(LogKBSAI, Log, TEXT("  [Attack] decided '%s' -> cell [%d,%d]"), *AttackAbility->GetAbilityDisplayData().AbilityName, OutDecision.TargetCell.Row, OutDecision.TargetCell.Col);
 	return true;
 }
 
@@ -80,7 +343,7 @@ bool UTacAICombatService::TryDecideMove(AUnit* Unit, FAiDecision& OutDecision) c
 	}
 
 	OutDecision.AbilityToUse = MoveAbility;
-	OutDecision.TargetCell = PickMoveTowardEnemy(Unit, ValidCells);
+	OutDecision.TargetCell = PickMoveCell(Unit, ValidCells);
 	OutDecision.bHasDecision = true;
 	UE_LOG(LogKBSAI, Log, TEXT("  [Move] decided '%s' -> cell [%d,%d]"), *MoveAbility->GetAbilityDisplayData().AbilityName, OutDecision.TargetCell.Row, OutDecision.TargetCell.Col);
 	return true;
@@ -102,42 +365,60 @@ void UTacAICombatService::DecideWait(AUnit* Unit, FAiDecision& OutDecision) cons
 		return;
 	}
 
+	// A two-cell unit's own cells come in bit order; wait on its anchor cell as before
+	const FTacCoordinates& Anchor = Unit->GetGridMetadata().Coords;
 	OutDecision.AbilityToUse = WaitAbility;
-	OutDecision.TargetCell = ValidCells[0];
+	OutDecision.TargetCell = ValidCells.Contains(Anchor) ? Anchor : ValidCells[0];
 	OutDecision.bHasDecision = true;
 	UE_LOG(LogKBSAI, Log, TEXT("  [Wait] decided '%s'"), *WaitAbility->GetAbilityDisplayData().AbilityName);
 }
 
-FTacCoordinates UTacAICombatService::PickMoveTowardEnemy(AUnit* Unit, const TArray<FTacCoordinates>& MoveCells) const
+FTacCoordinates UTacAICombatService::PickAttackCell(AUnit* Unit, const TArray<FTacCoordinates>& AttackCells) const
 {
-	UBattleTeam* MyTeam = (Unit->GetTeamSide() == ETeamSide::Attacker)
-		? GridSubsystem->GetAttackerTeam()
-		: GridSubsystem->GetDefenderTeam();
+	for (const FTacCoordinates& From : Unit->GetGridMetadata().GetCells())
+	{
+		for (const FIntPoint& Offset : FGridConstants::AllAdjacentOffsets)
+		{
+			const FTacCoordinates Cell(From.Row + Offset.X, From.Col + Offset.Y, From.Layer);
+			if (AttackCells.Contains(Cell))
+				return Cell;
+		}
+	}
+	return AttackCells[0];
+}
 
-	TArray<FTacCoordinates> EnemyCells;
-	for (AUnit* Candidate : GridSubsystem->GetActiveUnits())
+FTacCoordinates UTacAICombatService::PickMoveCell(AUnit* Unit, const TArray<FTacCoordinates>& MoveCells) const
+{
+	const ETeamSide Side = Unit->GetTeamSide();
+	uint64 EnemyCells = 0;
+	for (AUnit* Candidate : GridSubsystem->GetUnitRoster(EUnitQuerySource::OnField, UBattleTeam::ReverseTeamSide(Side)))
 	{
-		if (MyTeam->ContainsUnit(Candidate)) continue;
 		FTacCoordinates EnemyCell;
 		if (GridSubsystem->GetUnitCoordinates(Candidate, EnemyCell))
-			EnemyCells.Add(EnemyCell);
+			EnemyCells |= GridBitboard::CellMask(EnemyCell);
 	}
+	UTacThreatMapService* ThreatMap = GridSubsystem->GetThreatMapService();
+	if (!EnemyCells || !ThreatMap) return MoveCells[0];
 
-	if (EnemyCells.IsEmpty()) return MoveCells[0];
+	uint8 Steps[GridBitboard::NumCells];
+	ComputeStepsToNearest(EnemyCells, Steps);
+	const float Health = FMath::Max(1, Unit->GetStats().Health.GetCurrent());
 
 	FTacCoordinates BestCell = MoveCells[0];
-	int32 BestDist = INT_MAX;
+	float BestScore = -MAX_flt;
 	for (const FTacCoordinates& MoveCell : MoveCells)
 	{
-		for (const FTacCoordinates& EnemyCell : EnemyCells)
+		const FTacThreatCell Threat = ThreatMap->GetThreat(Side, MoveCell);
+		const float Danger = FMath::Min(Threat.ExpectedDamage / Health, 1.0f);
+		const float Score = -static_cast<float>(Steps[MoveCell.GetCellIndex()]) - MoveDangerWeight * Danger
+			+ (Threat.Healers > 0 ? MoveHealerCoverBonus : 0.0f);
+		if (Score > BestScore)
 		{
-			int32 Dist = FMath::Abs(MoveCell.Row - EnemyCell.Row) + FMath::Abs(MoveCell.Col - EnemyCell.Col);
-			if (Dist < BestDist)
-			{
-				BestDist = Dist;
-				BestCell = MoveCell;
-			}
+			BestScore = Score;
+			BestCell = MoveCell;
 		}
 	}
+	UE_LOG(LogKBSAI, Log, TEXT("  [Move] cell [%d,%d]: %d steps from an enemy, %.1f expected damage"), BestCell.Row,
+	       BestCell.Col, Steps[BestCell.GetCellIndex()], ThreatMap->GetExpectedDamage(Side, BestCell));
 	return BestCell;
 }
@@ -75,42 +75,7 @@ bool UTacGridMovementService::ExecuteDataMove(AUnit* Unit, FTacCoordinates From,
 
 bool UTacGridMovementService::ExecuteSwapMove(AUnit* Unit1, FTacCoordinates Pos1, AUnit* Unit2, FTacCoordinates Pos2)
 {
-	// Remove both units first
-	if (!DataManager->RemoveUnit(Unit1))
-	{
-		UE_LOG(LogTacGrid, Error, TEXT("UTacGridMovementService: Failed to remove unit from [%d,%d]"), Pos1.Row, Pos1.Col);
-		return false;
-	}
-
-	if (!DataManager->RemoveUnit(Unit2))
-	{
-		UE_LOG(LogTacGrid, Error, TEXT("UTacGridMovementService: Failed to remove unit from [%d,%d]"), Pos2.Row, Pos2.Col);
-		// Restore Unit1 to maintain consistency
-		DataManager->PlaceUnit(Unit1, Pos1);
-		return false;
-	}
-
-	// Place both units in swapped positions
-	if (!DataManager->PlaceUnit(Unit1, Pos2))
-	{
-		UE_LOG(LogTacGrid, Error, TEXT("UTacGridMovementService: Failed to place unit at [%d,%d]"), Pos2.Row, Pos2.Col);
-		// Restore both units
-		DataManager->PlaceUnit(Unit1, Pos1);
-		DataManager->PlaceUnit(Unit2, Pos2);
-		return false;
-	}
-
-	if (!DataManager->PlaceUnit(Unit2, Pos1))
-	{
-		UE_LOG(LogTacGrid, Error, TEXT("UTacGridMovementService: Failed to place unit at [%d,%d]"), Pos1.Row, Pos1.Col);
-		// Restore both units
-		DataManager->RemoveUnit(Pos2);
-		DataManager->PlaceUnit(Unit1, Pos1);
-		DataManager->PlaceUnit(Unit2, Pos2);
-		return false;
-	}
-
-	return true;
+	return DataManager->SwapUnits(Unit1, Pos1, Unit2, Pos2);
 }
 
 FTacMovementSegment UTacGridMovementService::CreateMovementSegment(FVector Start, FVector End, float Speed, FRotator TargetRotation)
@@ -8,13 +8,31 @@
 #include "GameMechanics/Tactical/Grid/BattleTeam.h"
 #include "GameMechanics/Units/Combat/CombatDescriptor.h"
 #include "GameplayTypes/GridCoordinates.h"
+#include "GameplayTypes/GridBitboard.h"
+#include "GameplayTypes/GridCellTables.h"
 #include "GameplayTypes/DamageTypes.h"
 #include "GameplayTypes/TargetingDescriptor.h"
 #include "GameplayTypes/FlankCellDefinitions.h"
 #include "GameplayTypes/CombatTypes.h"
+#include "GameMechanics/Units/Stats/UnitStatusContainer.h"
+
+DECLARE_STATS_GROUP(TEXT("KBS Targeting"), STATGROUP_KBSTargeting, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Target cache hits"), STAT_KBSTargetCacheHits, STATGROUP_KBSTargeting);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Target cache misses"), STAT_KBSTargetCacheMisses, STATGROUP_KBSTargeting);
 
 using namespace TargetingPredicates;
 
+namespace
+{
+	const FIntPoint RowAxisOffsets[] = { FIntPoint(-1, 0), FIntPoint(1, 0) };
+	const FIntPoint ColAxisOffsets[] = { FIntPoint(0, -1), FIntPoint(0, 1) };
+
+	TArrayView<const FIntPoint> LinearOffsets(bool bRowAxis)
+	{
+		return bRowAxis ? TArrayView<const FIntPoint>(RowAxisOffsets) : TArrayView<const FIntPoint>(ColAxisOffsets);
+	}
+}
+
 UTacGridTargetingService::UTacGridTargetingService()
 {
 }
@@ -23,14 +41,54 @@ void UTacGridTargetingService::Initialize(UGridDataManager* InDataManager)
 {
 	DataManager = InDataManager;
 	checkf(DataManager, TEXT("TacGridTargetingService: DataManager must be valid after Initialize"));
+	ResetCache();
+}
+
+void UTacGridTargetingService::ResetCache()
+{
+	TargetCache.Reset();
+	CachedGridVersion = DataManager ? DataManager->GetGridVersion() : 0;
+	CachedStatusSerial = FUnitStatusContainer::GetChangeSerial();
+	CacheStats = FTargetingCacheStats();
+}
+
+const FTacCellSet* UTacGridTargetingService::FindCachedCellSet(AUnit* Unit, const FTargetingDescriptor& Desc) const
+{
+	const uint32 GridVersion = DataManager->GetGridVersion();
+	const uint32 StatusSerial = FUnitStatusContainer::GetChangeSerial();
+	if (GridVersion != CachedGridVersion || StatusSerial != CachedStatusSerial)
+	{
+		if (!TargetCache.IsEmpty())
+			++CacheStats.Invalidations;
+		TargetCache.Reset();
+		CachedGridVersion = GridVersion;
+		CachedStatusSerial = StatusSerial;
+		return nullptr;
+	}
+	return TargetCache.Find(FCacheKey{ TObjectKey<AUnit>(Unit), Desc });
 }
 
 // === Public interface ===
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetValidTargetCells(AUnit* Unit, FTargetingDescriptor Desc) const
+FTacCellSet UTacGridTargetingService::GetValidTargetCellSet(AUnit* Unit, FTargetingDescriptor Desc) const
 {
 	check(Unit);
-	TArray<FTacCoordinates> TargetCells;
+	if (const FTacCellSet* Cached = FindCachedCellSet(Unit, Desc))
+	{
+		++CacheStats.Hits;
+		INC_DWORD_STAT(STAT_KBSTargetCacheHits);
+		return *Cached;
+	}
+	++CacheStats.Misses;
+	INC_DWORD_STAT(STAT_KBSTargetCacheMisses);
+	const FTacCellSet TargetCells = ComputeValidTargetCellSet(Unit, Desc);
+	TargetCache.Add(FCacheKey{ TObjectKey<AUnit>(Unit), Desc }, TargetCells);
+	return TargetCells;
+}
+
+FTacCellSet UTacGridTargetingService::ComputeValidTargetCellSet(AUnit* Unit, const FTargetingDescriptor& Desc) const
+{
+	FTacCellSet TargetCells;
 	const FUnitGridMetadata& Metadata = Unit->GetGridMetadata();
 
 	switch (Desc.Strategy)
@@ -38,7 +96,9 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetValidTargetCells(AUnit* Uni
 	case ETargetingStrategy::None:
 		break;
 	case ETargetingStrategy::Self:
-		TargetCells.Append(Metadata.GetCells());
+		TargetCells.Add(Metadata.Coords);
+		if (Metadata.HasExtraCell())
+			TargetCells.Add(Metadata.ExtraCell);
 		break;
 	case ETargetingStrategy::Closest:
 		TargetCells = GetClosestEnemyCells(Unit, Desc);
@@ -49,8 +109,10 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetValidTargetCells(AUnit* Uni
 		TargetCells = GetCellsByAffiliation(Unit, Desc);
 		break;
 	case ETargetingStrategy::EmptyCell:
-		DataManager->FilterCells(Unit, Metadata.Coords.Layer,
-		                         Desc.bAllowFlank ? EmptyCellPredicate : EmptyNotFlankPredicate, TargetCells);
+		if (Desc.bAllowFlank)
+			DataManager->FilterCellsWith(Unit, Metadata.Coords.Layer, TargetingPolicies::FEmptyCell(), TargetCells);
+		else
+			DataManager->FilterCellsWith(Unit, Metadata.Coords.Layer, TargetingPolicies::FEmptyNotFlank(), TargetCells);
 		break;
 	case ETargetingStrategy::Movement:
 		TargetCells = GetValidMovementCells(Unit, Desc);
@@ -66,6 +128,11 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetValidTargetCells(AUnit* Uni
 	return TargetCells;
 }
 
+TArray<FTacCoordinates> UTacGridTargetingService::GetValidTargetCells(AUnit* Unit, FTargetingDescriptor Desc) const
+{
+	return GetValidTargetCellSet(Unit, Desc).Array();
+}
+
 TArray<FTacCoordinates> UTacGridTargetingService::GetValidTargetCells(AUnit* Unit, ETargetReach Reach) const
 {
 	return GetValidTargetCells(Unit, FTargetingDescriptor::FromReach(Reach));
@@ -75,14 +142,14 @@ TArray<AUnit*> UTacGridTargetingService::GetValidTargetUnits(AUnit* Unit, FTarge
                                                              bool bIncludeSelf) const
 {
 	check(Unit);
-	auto TargetCells = GetValidTargetCells(Unit, Desc);
+	FTacCellSet TargetCells = GetValidTargetCellSet(Unit, Desc);
 	if (!bIncludeSelf)
 	{
 		TargetCells.Remove(Unit->GetGridMetadata().Coords);
 		if (Unit->GetGridMetadata().HasExtraCell())
 			TargetCells.Remove(Unit->GetGridMetadata().ExtraCell);
 	}
-	auto TargetUnits{KbsAlgo::ExtractUnits<TArray>(TargetCells, DataManager)};
+	TArray<AUnit*> TargetUnits = KbsAlgo::ExtractUnits(TargetCells, DataManager);
 	UE_LOG(LogTacGrid, Log, TEXT("GetValidTargetUnits: %s Strategy=%d -> %d units"), *Unit->GetLogName(),
 	       (int32)Desc.Strategy, TargetUnits.Num());
 	return TargetUnits;
@@ -100,11 +167,11 @@ FResolvedTargets UTacGridTargetingService::ResolveTargetsFromClick(AUnit* Source
 {
 	check(SourceUnit);
 
-	TArray<FTacCoordinates> Cells;
+	FTacCellSet Cells;
 	switch (Desc.Strategy)
 	{
 	case ETargetingStrategy::All:
-		Cells = GetValidTargetCells(SourceUnit, Desc);
+		Cells = GetValidTargetCellSet(SourceUnit, Desc);
 		return BuildTargetsFromCells(ClickedCell, Cells);
 	case ETargetingStrategy::Area:
 		if (AreaShape)
@@ -112,12 +179,12 @@ FResolvedTargets UTacGridTargetingService::ResolveTargetsFromClick(AUnit* Source
 		return BuildTargetsFromCells(ClickedCell, Cells);
 	case ETargetingStrategy::Corpse:
 		return BuildTargetFromCell(ClickedCell,
-		                           TestCell(ClickedCell, CorpseAffiliationPredicateFactory(SourceUnit, Desc)));
+		                           TestCell(ClickedCell, TargetingPolicies::FCorpseAffiliation(SourceUnit, Desc)));
 	case ETargetingStrategy::Closest:
 		return BuildTargetFromCell(ClickedCell, CanTargetClosestCell(SourceUnit, Desc, ClickedCell));
 	case ETargetingStrategy::Single:
 		return BuildTargetFromCell(ClickedCell,
-		                           TestCell(SourceUnit, ClickedCell, AffiliationPredicateFactory(Desc)));
+		                           TestCell(SourceUnit, ClickedCell, TargetingPolicies::FAffiliation(Desc)));
 	case ETargetingStrategy::EmptyCell:
 		return BuildTargetFromCell(ClickedCell, TestCell(SourceUnit, ClickedCell,
 		                           Desc.bAllowFlank ? EmptyCellPredicate : EmptyNotFlankPredicate));
@@ -156,13 +223,13 @@ bool UTacGridTargetingService::HasValidTargetAtCell(AUnit* Source, FTacCoordinat
 	case ETargetingStrategy::Single:
 	case ETargetingStrategy::All:
 	case ETargetingStrategy::Area:
-		return TestCell(Source, TargetCell, AffiliationPredicateFactory(Desc));
+		return TestCell(Source, TargetCell, TargetingPolicies::FAffiliation(Desc));
 	case ETargetingStrategy::EmptyCell:
 		return TestCell(Source, TargetCell, Desc.bAllowFlank ? EmptyCellPredicate : EmptyNotFlankPredicate);
 	case ETargetingStrategy::Movement:
 		return TestMovementCell(Source, TargetCell, Desc);
 	case ETargetingStrategy::Corpse:
-		return TestCell(TargetCell, CorpseAffiliationPredicateFactory(Source, Desc));
+		return TestCell(TargetCell, TargetingPolicies::FCorpseAffiliation(Source, Desc));
 	default:
 		UE_LOG(LogTacGrid, Warning, TEXT("Unknown targeting strategy: %d in HasValidTargetAtCell"),
 		       (int32)Desc.Strategy);
@@ -183,6 +250,12 @@ bool UTacGridTargetingService::HasAnyValidTargets(AUnit* Source, FTargetingDescr
 		return false;
 	if (Desc.Strategy == ETargetingStrategy::Self)
 		return true;
+	if (const FTacCellSet* Cached = FindCachedCellSet(Source, Desc))
+	{
+		++CacheStats.Hits;
+		INC_DWORD_STAT(STAT_KBSTargetCacheHits);
+		return !Cached->IsEmpty();
+	}
 
 	const FUnitGridMetadata& Metadata = Source->GetGridMetadata();
 	const ETeamSide TeamSide = Metadata.Team;
@@ -205,10 +278,12 @@ bool UTacGridTargetingService::HasAnyValidTargets(AUnit* Source, FTargetingDescr
 		}
 		break;
 	case ETargetFastCheck::EmptyCell:
-		return DataManager->TestCells(Source, Metadata.Coords.Layer,
-		                              Desc.bAllowFlank ? EmptyCellPredicate : EmptyNotFlankPredicate);
+		{
+			const uint64 FlankFilter = Desc.bAllowFlank ? 0 : GridBitboard::FlankMask;
+			return (DataManager->GetEmptyCellsMask(Metadata.Coords.Layer) & ~FlankFilter) != 0;
+		}
 	case ETargetFastCheck::Corpse:
-		return DataManager->TestCorpseCells(Source, CorpseAffiliationPredicateFactory(Source, Desc));
+		return DataManager->TestCorpseCellsWith(TargetingPolicies::FCorpseAffiliation(Source, Desc));
 	case ETargetFastCheck::Movement:
 		{
 			ETacGridLayer QueryLayer;
@@ -219,18 +294,20 @@ bool UTacGridTargetingService::HasAnyValidTargets(AUnit* Source, FTargetingDescr
 			else
 				QueryLayer = ETacGridLayer::Ground;
 
+			// Bitboard equivalents of AirMovePredicate and MovePredicateFactory(false)
 			if (QueryLayer == ETacGridLayer::Air && Desc.MovementPattern == EMovementPattern::AnyToAny)
-				return DataManager->TestCells(Source, ETacGridLayer::Air, AirMovePredicate);
+				return (GridBitboard::ValidCellsMask & GridBitboard::LayerMask(ETacGridLayer::Air)
+					& ~DataManager->GetTeamMask(UBattleTeam::ReverseTeamSide(TeamSide))) != 0;
 			if (QueryLayer == ETacGridLayer::Ground && !Metadata.IsMultiCell() &&
 				Desc.MovementPattern == EMovementPattern::Orthogonal)
-				return DataManager->TestCells(Source, ETacGridLayer::Ground, MovePredicateFactory(false));
+				return DataManager->GetEmptyCellsMask(ETacGridLayer::Ground) != 0;
 		}
 		break;
 	default:
 		break;
 	}
 
-	return GetValidTargetCells(Source, Desc).Num() > 0;
+	return !GetValidTargetCellSet(Source, Desc).IsEmpty();
 }
 
 bool UTacGridTargetingService::HasAnyValidTargets(AUnit* Source, ETargetReach Reach) const
@@ -240,21 +317,17 @@ bool UTacGridTargetingService::HasAnyValidTargets(AUnit* Source, ETargetReach Re
 
 // === Private helpers — targeting ===
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetClosestEnemyCells(AUnit* Unit,
-                                                                        const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetClosestEnemyCells(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	if (!CheckUnitAndData(Unit)) return {};
-	auto EnemyPredicate = AffiliationPredicateFactory(Desc);
-	TSet<FTacCoordinates> FoundEnemyCells = KbsAlgo::CollectAdjacentCellsIf<TSet>(
-		Unit, DataManager.Get(), EnemyPredicate, true);
+	const TargetingPolicies::FAffiliation EnemyPredicate(Desc);
+	FTacCellSet FoundEnemyCells = KbsAlgo::CollectAdjacentCellSetIf(Unit, DataManager.Get(), EnemyPredicate, true);
 	if (FTacCoordinates BlockedCell = FFlankCellDefinitions::GetEntranceBlockedCell(Unit->GetGridMetadata().Coords);
 		BlockedCell.IsValidCell())
 	{
 		FoundEnemyCells.Remove(BlockedCell);
 	}
-	TArray<FTacCoordinates> Result;
-	Algo::Copy(FoundEnemyCells, Result);
-	return Result;
+	return FoundEnemyCells;
 }
 
 bool UTacGridTargetingService::CanTargetClosestCell(AUnit* SourceUnit, const FTargetingDescriptor& Desc,
@@ -266,7 +339,7 @@ bool UTacGridTargetingService::CanTargetClosestCell(AUnit* SourceUnit, const FTa
 		BlockedCell.IsValidCell())
 		if (Cell == BlockedCell)
 			return false;
-	auto Predicate = AffiliationPredicateFactory(Desc);
+	const TargetingPolicies::FAffiliation Predicate(Desc);
 	return KbsAlgo::AdjacentContains(SourceUnit, DataManager, Cell, Predicate);
 }
 
@@ -281,39 +354,38 @@ bool UTacGridTargetingService::CanSelfTarget(AUnit* Source, FTacCoordinates Coor
 	return false;
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetCellsByAffiliation(AUnit* SourceUnit,
-                                                                         const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetCellsByAffiliation(AUnit* SourceUnit,
+                                                             const FTargetingDescriptor& Desc) const
 {
 	if (!CheckUnitAndData(SourceUnit)) return {};
-	TArray<FTacCoordinates> Result;
-	auto AffiliationPredicate = AffiliationPredicateFactory(Desc);
-	DataManager->FilterCells(SourceUnit, ETacGridLayer::Ground, AffiliationPredicate, Result);
-	DataManager->FilterCells(SourceUnit, ETacGridLayer::Air, AffiliationPredicate, Result);
+	FTacCellSet Result;
+	const TargetingPolicies::FAffiliation AffiliationPredicate(Desc);
+	DataManager->FilterCellsWith(SourceUnit, ETacGridLayer::Ground, AffiliationPredicate, Result);
+	DataManager->FilterCellsWith(SourceUnit, ETacGridLayer::Air, AffiliationPredicate, Result);
 	return Result;
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetCorpseCellsByAffiliation(AUnit* Unit,
-                                                                               const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetCorpseCellsByAffiliation(AUnit* Unit,
+                                                                   const FTargetingDescriptor& Desc) const
 {
 	if (!CheckUnitAndData(Unit)) return {};
-	TArray<FTacCoordinates> Result;
-	DataManager->FilterCorpseCells(Unit, CorpseAffiliationPredicateFactory(Unit, Desc), Result);
+	FTacCellSet Result;
+	DataManager->FilterCorpseCellsWith(TargetingPolicies::FCorpseAffiliation(Unit, Desc), Result);
 	return Result;
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetCellsInArea(AUnit* SourceUnit, FTacCoordinates CenterCell,
-                                                                  const FTargetingDescriptor& Desc,
-                                                                  const FAreaShape& AreaShape) const
+FTacCellSet UTacGridTargetingService::GetCellsInArea(AUnit* SourceUnit, FTacCoordinates CenterCell,
+                                                      const FTargetingDescriptor& Desc,
+                                                      const FAreaShape& AreaShape) const
 {
 	if (!CheckUnitAndData(SourceUnit)) return {};
-	auto AffiliationPredicate = AffiliationPredicateFactory(Desc);
-	return KbsAlgo::CollectCellsInArea<TArray>(SourceUnit, DataManager, AffiliationPredicate, CenterCell, AreaShape);
+	// Affiliation set is memoized per grid version, so re-centering the preview is a single mask AND
+	return GetValidTargetCellSet(SourceUnit, Desc) & FTacCellSet(AreaShape.GetMask(CenterCell));
 }
 
 // === Private helpers — movement ===
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetValidMovementCells(AUnit* Unit,
-                                                                         const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetValidMovementCells(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	if (!CheckUnitAndData(Unit)) return {};
 	const FUnitGridMetadata& Metadata = Unit->GetGridMetadata();
@@ -322,8 +394,7 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetValidMovementCells(AUnit* U
 	return GetSingleCellMoveCells(Unit, Desc);
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellMoveCells(AUnit* Unit,
-                                                                          const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetSingleCellMoveCells(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	switch (Desc.MovementPattern)
 	{
@@ -334,8 +405,7 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellMoveCells(AUnit*
 	return {};
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellMoveCells(AUnit* Unit,
-                                                                         const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetMultiCellMoveCells(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	switch (Desc.MovementPattern)
 	{
@@ -346,8 +416,7 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellMoveCells(AUnit* U
 	return {};
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellOrthogonal(AUnit* Unit,
-                                                                           const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetSingleCellOrthogonal(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	const FUnitGridMetadata& Metadata = Unit->GetGridMetadata();
 	const ETacGridLayer UnitLayer = Metadata.Coords.Layer;
@@ -356,10 +425,10 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellOrthogonal(AUnit*
 		: (Desc.MovementLayer == EMovementLayer::Air ? ETacGridLayer::Air : ETacGridLayer::Ground);
 	auto Pred = (TargetLayer == ETacGridLayer::Air) ? AirMovePredicate : MovePredicateFactory(false);
 
-	TArray<FTacCoordinates> Result;
+	FTacCellSet Result;
 	if (TargetLayer == UnitLayer)
 	{
-		Result = KbsAlgo::CollectAdjacentCellsIf<TArray>(
+		Result = KbsAlgo::CollectAdjacentCellSetIf(
 			Unit, DataManager, Pred, false, KbsAlgo::EAdjacencyMode::OrthogonalOnly);
 		if (FTacCoordinates FlankCoord = FFlankCellDefinitions::GetAvailableFlankCell(Metadata.Coords, Metadata.Team);
 			FlankCoord.IsValidCell())
@@ -370,13 +439,12 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellOrthogonal(AUnit*
 	}
 	else
 	{
-		for (const FIntPoint& Off : FGridConstants::OrthogonalOffsets)
+		const FTacCoordinates Projected(Metadata.Coords.Row, Metadata.Coords.Col, TargetLayer);
+		GridBitboard::ForEachCell(GridCellTables::NeighborMask(Projected, true, true), [&](const FTacCoordinates& Candidate)
 		{
-			FTacCoordinates Candidate(Metadata.Coords.Row + Off.X, Metadata.Coords.Col + Off.Y, TargetLayer);
-			if (!Candidate.IsValidCell()) continue;
 			if (Pred(Unit, DataManager->GetUnit(Candidate), Candidate))
 				Result.Add(Candidate);
-		}
+		});
 		FTacCoordinates SamePos(Metadata.Coords.Row, Metadata.Coords.Col, TargetLayer);
 		if (SamePos.IsValidCell() && Pred(Unit, DataManager->GetUnit(SamePos), SamePos))
 			Result.Add(SamePos);
@@ -384,21 +452,21 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellOrthogonal(AUnit*
 	return Result;
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellAnyToAny(AUnit* Unit,
-                                                                          const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetSingleCellAnyToAny(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	const ETacGridLayer UnitLayer = Unit->GetGridMetadata().Coords.Layer;
 	const ETacGridLayer TargetLayer = (Desc.MovementLayer == EMovementLayer::CrossLayer)
 		? (UnitLayer == ETacGridLayer::Ground ? ETacGridLayer::Air : ETacGridLayer::Ground)
 		: (Desc.MovementLayer == EMovementLayer::Air ? ETacGridLayer::Air : ETacGridLayer::Ground);
-	auto Pred = (TargetLayer == ETacGridLayer::Air) ? AirMovePredicate : MovePredicateFactory(false);
-	TArray<FTacCoordinates> Result;
-	DataManager->FilterCells(Unit, TargetLayer, Pred, Result);
+	FTacCellSet Result;
+	if (TargetLayer == ETacGridLayer::Air)
+		DataManager->FilterCellsWith(Unit, TargetLayer, TargetingPolicies::FAirMove(), Result);
+	else
+		DataManager->FilterCellsWith(Unit, TargetLayer, TargetingPolicies::TMove<false>(), Result);
 	return Result;
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellLinear(AUnit* Unit,
-                                                                        const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetSingleCellLinear(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	const FUnitGridMetadata& Metadata = Unit->GetGridMetadata();
 	const ETacGridLayer UnitLayer = Metadata.Coords.Layer;
@@ -407,10 +475,10 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellLinear(AUnit* Uni
 		: (Desc.MovementLayer == EMovementLayer::Air ? ETacGridLayer::Air : ETacGridLayer::Ground);
 	auto Pred = (TargetLayer == ETacGridLayer::Air) ? AirMovePredicate : MovePredicateFactory(false);
 
-	TArray<FTacCoordinates> Result;
+	FTacCellSet Result;
 	const bool bRowAxis = (Metadata.Orientation == EUnitOrientation::GridTop ||
 	                       Metadata.Orientation == EUnitOrientation::GridBottom);
-	for (const FIntPoint& Off : bRowAxis ? TArray<FIntPoint>{{-1,0},{1,0}} : TArray<FIntPoint>{{0,-1},{0,1}})
+	for (const FIntPoint& Off : LinearOffsets(bRowAxis))
 	{
 		FTacCoordinates Candidate(Metadata.Coords.Row + Off.X, Metadata.Coords.Col + Off.Y, TargetLayer);
 		if (!Candidate.IsValidCell()) continue;
@@ -432,8 +500,7 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetSingleCellLinear(AUnit* Uni
 	return Result;
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellOrthogonal(AUnit* Unit,
-                                                                          const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetMultiCellOrthogonal(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	const FUnitGridMetadata& Metadata = Unit->GetGridMetadata();
 	const FTacCoordinates Primary = Metadata.Coords;
@@ -449,7 +516,7 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellOrthogonal(AUnit*
 		return DataManager->IsCellOccupied(Cell);
 	};
 
-	TSet<FTacCoordinates> Candidates;
+	FTacCellSet Result;
 	for (const FIntPoint& Offset : FGridConstants::OrthogonalOffsets)
 	{
 		const FTacCoordinates NewPrimary(Primary.Row + Offset.X, Primary.Col + Offset.Y, TargetLayer);
@@ -460,16 +527,14 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellOrthogonal(AUnit*
 		if (IsBlockedByOther(NewPrimary) || IsBlockedByOther(NewExtra)) continue;
 
 		if (NewPrimary == Extra || NewExtra == Primary)
-			Candidates.Add(NewPrimary);
+			Result.Add(NewPrimary);
 		else
 		{
-			Candidates.Add(NewPrimary);
-			Candidates.Add(NewExtra);
+			Result.Add(NewPrimary);
+			Result.Add(NewExtra);
 		}
 	}
 
-	TArray<FTacCoordinates> Result;
-	Algo::Copy(Candidates, Result);
 	if (TargetLayer == UnitLayer)
 	{
 		if (FTacCoordinates FlankCoord = FFlankCellDefinitions::GetAvailableFlankCell(Primary, Metadata.Team);
@@ -491,8 +556,7 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellOrthogonal(AUnit*
 	return Result;
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellAnyToAny(AUnit* Unit,
-                                                                         const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetMultiCellAnyToAny(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	const FUnitGridMetadata& Metadata = Unit->GetGridMetadata();
 	const FTacCoordinates Primary = Metadata.Coords;
@@ -503,8 +567,8 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellAnyToAny(AUnit* Un
 		: (Desc.MovementLayer == EMovementLayer::Air ? ETacGridLayer::Air : ETacGridLayer::Ground);
 	const FIntPoint ExtraOffset(Extra.Row - Primary.Row, Extra.Col - Primary.Col);
 
-	TArray<FTacCoordinates> Result;
-	QueryPredicates::FCellFilterPredicate Pred = [&](const AUnit* /*Source*/, const AUnit* /*Target*/, const FTacCoordinates& NewPrimary) -> bool
+	FTacCellSet Result;
+	auto Pred = [&](const AUnit* /*Source*/, const AUnit* /*Target*/, const FTacCoordinates& NewPrimary) -> bool
 	{
 		const FTacCoordinates NewExtra(NewPrimary.Row + ExtraOffset.X, NewPrimary.Col + ExtraOffset.Y, TargetLayer);
 		if (!NewExtra.IsValidCell() || NewPrimary.IsFlankCell() || NewExtra.IsFlankCell()) return false;
@@ -515,12 +579,11 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellAnyToAny(AUnit* Un
 		};
 		return !IsBlockedByOther(NewPrimary) && !IsBlockedByOther(NewExtra);
 	};
-	DataManager->FilterCells(Unit, TargetLayer, Pred, Result);
+	DataManager->FilterCellsWith(Unit, TargetLayer, Pred, Result);
 	return Result;
 }
 
-TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellLinear(AUnit* Unit,
-                                                                      const FTargetingDescriptor& Desc) const
+FTacCellSet UTacGridTargetingService::GetMultiCellLinear(AUnit* Unit, const FTargetingDescriptor& Desc) const
 {
 	const FUnitGridMetadata& Metadata = Unit->GetGridMetadata();
 	const FTacCoordinates Primary = Metadata.Coords;
@@ -539,8 +602,8 @@ TArray<FTacCoordinates> UTacGridTargetingService::GetMultiCellLinear(AUnit* Unit
 	const bool bRowAxis = (Metadata.Orientation == EUnitOrientation::GridTop ||
 	                       Metadata.Orientation == EUnitOrientation::GridBottom);
 
-	TArray<FTacCoordinates> Result;
-	for (const FIntPoint& Off : bRowAxis ? TArray<FIntPoint>{{-1,0},{1,0}} : TArray<FIntPoint>{{0,-1},{0,1}})
+	FTacCellSet Result;
+	for (const FIntPoint& Off : LinearOffsets(bRowAxis))
 	{
 		const FTacCoordinates NewPrimary(Primary.Row + Off.X, Primary.Col + Off.Y, TargetLayer);
 		const FTacCoordinates NewExtra(Extra.Row + Off.X, Extra.Col + Off.Y, TargetLayer);
@@ -592,21 +655,22 @@ bool UTacGridTargetingService::CheckUnitAndData(AUnit* Unit) const
 	return Unit->GetGridMetadata().IsValid();
 }
 
-bool UTacGridTargetingService::TestCell(AUnit* SourceUnit, FTacCoordinates Cell,
-                                        QueryPredicates::FCellFilterPredicate Predicate) const
+template <typename TPredicate>
+bool UTacGridTargetingService::TestCell(AUnit* SourceUnit, FTacCoordinates Cell, const TPredicate& Predicate) const
 {
 	AUnit* ClickedUnit = DataManager->GetUnit(Cell);
 	return Predicate(SourceUnit, ClickedUnit, Cell);
 }
 
-bool UTacGridTargetingService::TestCell(FTacCoordinates Cell, QueryPredicates::FCorpseFilterPredicate Predicate) const
+template <typename TPredicate>
+bool UTacGridTargetingService::TestCell(FTacCoordinates Cell, const TPredicate& Predicate) const
 {
 	return Predicate(Cell, DataManager->IsCellOccupied(Cell), DataManager->GetTopCorpse(Cell),
 	                 DataManager->CorpsesNum(Cell));
 }
 
 FResolvedTargets UTacGridTargetingService::BuildTargetsFromCells(FTacCoordinates ClickedCell,
-                                                                 const TArray<FTacCoordinates>& QueriedCells) const
+                                                                 const FTacCellSet& QueriedCells) const
 {
 	FResolvedTargets Result;
 	AUnit* ClickedUnit = DataManager->GetUnit(ClickedCell);
@@ -616,7 +680,7 @@ FResolvedTargets UTacGridTargetingService::BuildTargetsFromCells(FTacCoordinates
 		Result.ClickedTarget = nullptr;
 	Result.ClickedCorpse = DataManager->GetTopCorpse(ClickedCell);
 	Result.bWasCellEmpty = (ClickedUnit == nullptr);
-	Result.SecondaryTargets = KbsAlgo::ExtractUnits<TArray>(QueriedCells, DataManager);
+	Result.SecondaryTargets = KbsAlgo::ExtractUnits(QueriedCells, DataManager);
 	if (Result.ClickedTarget) Result.SecondaryTargets.RemoveSingle(Result.ClickedTarget);
 	if (Result.ClickedTarget)
 		UE_LOG(LogTacGrid, Log, TEXT("ResolveTargets: clicked [%d,%d] -> primary=%s secondary=%d"),
@@ -0,0 +1,266 @@
+#include "GameMechanics/Tactical/Grid/Subsystems/Services/TacThreatMapService.h"
+#include "GameMechanics/Tactical/Grid/Components/GridDataManager.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacGridSubsystem.h"
+#include "GameMechanics/Tactical/Grid/BattleTeam.h"
+#include "GameMechanics/Tactical/DamageCalculation.h"
+#include "GameMechanics/Units/Unit.h"
+#include "GameMechanics/Units/Combat/Weapon.h"
+#include "GameMechanics/Units/Combat/CombatDescriptor.h"
+#include "GameMechanics/Units/Stats/BaseUnitStatTypes.h"
+#include "GameMechanics/Units/Stats/UnitStatusContainer.h"
+#include "GameplayTypes/DamageTypes.h"
+#include "GameplayTypes/GridCellTables.h"
+#include "GameplayTypes/TeamConstants.h"
+
+void UTacThreatMapService::Initialize(UGridDataManager* InDataManager)
+{
+	DataManager = InDataManager;
+	checkf(DataManager, TEXT("TacThreatMapService: DataManager must be valid after Initialize"));
+	Rebuild();
+}
+
+void UTacThreatMapService::Rebuild()
+{
+	for (FTeamMap& Map : Maps)
+		Map = FTeamMap();
+	Influences.Reset();
+	DirtyUnits.Reset();
+	CachedGridVersion = DataManager->GetGridVersion();
+	CachedStatusSerial = FUnitStatusContainer::GetChangeSerial();
+	CachedStatSerial = FStatModifierAggregate::GetChangeSerial();
+	DataManager->ForEachUnit(EUnitQuerySource::OnField, [this](AUnit* Unit)
+	{
+		UpdateUnit(Unit);
+	});
+}
+
+FTacThreatCell UTacThreatMapService::GetThreat(ETeamSide Side, const FTacCoordinates& Cell)
+{
+	const FTeamMap& Map = GetMap(Side);
+	const int32 Index = Cell.GetCellIndex();
+	FTacThreatCell Threat;
+	Threat.ExpectedDamage = static_cast<float>(Map.ExpectedDamage[Index]) / DamageScale;
+	Threat.Attackers = Map.Attackers[Index];
+	Threat.Healers = Map.Healers[Index];
+	return Threat;
+}
+
+float UTacThreatMapService::GetExpectedDamage(ETeamSide Side, const FTacCoordinates& Cell)
+{
+	return static_cast<float>(GetMap(Side).ExpectedDamage[Cell.GetCellIndex()]) / DamageScale;
+}
+
+int32 UTacThreatMapService::GetAttackerCount(ETeamSide Side, const FTacCoordinates& Cell)
+{
+	return GetMap(Side).Attackers[Cell.GetCellIndex()];
+}
+
+int32 UTacThreatMapService::GetHealerCount(ETeamSide Side, const FTacCoordinates& Cell)
+{
+	return GetMap(Side).Healers[Cell.GetCellIndex()];
+}
+
+uint64 UTacThreatMapService::GetThreatenedMask(ETeamSide Side)
+{
+	return GetMap(Side).ThreatenedMask;
+}
+
+const UTacThreatMapService::FTeamMap& UTacThreatMapService::GetMap(ETeamSide Side)
+{
+	CatchUp();
+	return Maps[static_cast<int32>(Side)];
+}
+
+void UTacThreatMapService::HandleUnitStatsModified(AUnit* Unit, FUnitCoreStats& Stats)
+{
+	DirtyUnits.AddUnique(Unit);
+}
+
+void UTacThreatMapService::CatchUp()
+{
+	const uint32 GridVersion = DataManager->GetGridVersion();
+	const uint32 StatusSerial = FUnitStatusContainer::GetChangeSerial();
+	const uint32 StatSerial = FStatModifierAggregate::GetChangeSerial();
+	if (GridVersion == CachedGridVersion && StatusSerial == CachedStatusSerial && StatSerial == CachedStatSerial
+		&& DirtyUnits.IsEmpty())
+		return;
+
+	if (GridVersion != CachedGridVersion)
+	{
+		TArray<FGridChange> Changes;
+		if (!DataManager->GetChangesSince(CachedGridVersion, Changes))
+		{
+			UE_LOG(LogTacGrid, Log, TEXT("TacThreatMapService: grid journal overran, rebuilding"));
+			Rebuild();
+			return;
+		}
+		for (const FGridChange& Change : Changes)
+		{
+			if (Change.Unit.IsValid())
+				DirtyUnits.AddUnique(Change.Unit);
+			if (Change.OtherUnit.IsValid())
+				DirtyUnits.AddUnique(Change.OtherUnit);
+		}
+	}
+	if (StatSerial != CachedStatSerial)
+	{
+		// The serial does not say whose stat moved: every unit is recomputed, and UpdateUnit only
+		// touches the maps for the ones whose influence actually changed
+		for (const TPair<TObjectKey<AUnit>, FUnitInfluence>& Pair : Influences)
+			DirtyUnits.AddUnique(Pair.Value.Unit);
+	}
+	else if (StatusSerial != CachedStatusSerial)
+	{
+		// A status only switches a unit's influence on or off, so only units whose CanAct flipped are redone
+		for (const TPair<TObjectKey<AUnit>, FUnitInfluence>& Pair : Influences)
+		{
+			const AUnit* Unit = Pair.Value.Unit.Get();
+			if (!Unit || Unit->GetStats().Status.CanAct() != Pair.Value.bCanAct)
+				DirtyUnits.AddUnique(Pair.Value.Unit);
+		}
+	}
+	CachedGridVersion = GridVersion;
+	CachedStatusSerial = StatusSerial;
+	CachedStatSerial = StatSerial;
+
+	for (const TWeakObjectPtr<AUnit>& Unit : DirtyUnits)
+	{
+		if (AUnit* Live = Unit.Get())
+		{
+			UpdateUnit(Live);
+		}
+		else
+		{
+			// Destroyed without a journaled removal: drop whatever it still contributes
+			for (auto It = Influences.CreateIterator(); It; ++It)
+			{
+				if (!It.Value().Unit.IsValid())
+				{
+					ApplyInfluence(It.Value(), -1);
+					It.RemoveCurrent();
+				}
+			}
+		}
+	}
+	DirtyUnits.Reset();
+}
+
+void UTacThreatMapService::UpdateUnit(AUnit* Unit)
+{
+	const TObjectKey<AUnit> Key(Unit);
+	FUnitInfluence* Old = Influences.Find(Key);
+	if (Unit->IsDead() || !Unit->GetGridMetadata().bOnField)
+	{
+		if (Old)
+		{
+			ApplyInfluence(*Old, -1);
+			Influences.Remove(Key);
+		}
+		return;
+	}
+
+	FUnitInfluence Influence;
+	ComputeInfluence(Unit, Influence);
+	if (!Old)
+	{
+		ApplyInfluence(Influences.Add(Key, Influence), 1);
+	}
+	else if (!Old->HasSameEffect(Influence))
+	{
+		ApplyInfluence(*Old, -1);
+		*Old = Influence;
+		ApplyInfluence(*Old, 1);
+	}
+	Unit->OnUnitStatsModified.AddUniqueDynamic(this, &UTacThreatMapService::HandleUnitStatsModified);
+}
+
+void UTacThreatMapService::ComputeInfluence(AUnit* Unit, FUnitInfluence& OutInfluence) const
+{
+	// Maps are per team, not per victim, so expected damage is taken against a target with no defenses
+	static const FUnitCoreStats UndefendedTarget;
+
+	const FUnitGridMetadata& Metadata = Unit->GetGridMetadata();
+	const FUnitCoreStats& Stats = Unit->GetStats();
+	OutInfluence.Unit = Unit;
+	OutInfluence.Team = Unit->GetTeamSide();
+	OutInfluence.bCanAct = Stats.Status.CanAct();
+	if (!OutInfluence.bCanAct)
+		return;
+
+	uint64 OwnCells = GridBitboard::CellMask(Metadata.Coords);
+	if (Metadata.HasExtraCell())
+		OwnCells |= GridBitboard::CellMask(Metadata.ExtraCell);
+
+	for (const TObjectPtr<UWeapon>& Weapon : Unit->GetWeapons())
+	{
+		if (!Weapon || !Weapon->IsUsableForAutoAttack() || !Weapon->GetDescriptor())
+			continue;
+		const UCombatDescriptor* Descriptor = Weapon->GetDescriptor();
+		const ETargetReach Reach = Descriptor->GetStats().TargetReach;
+		if (Descriptor->GetMagnitudePolicy() == EMagnitudePolicy::Heal)
+		{
+			if (Reach == ETargetReach::Self)
+				OutInfluence.HealMask |= OwnCells;
+			else if (FDamageCalculation::CanReachTarget(Reach, true, 2))
+				OutInfluence.HealMask = GridBitboard::ValidCellsMask;
+			continue;
+		}
+		if (Descriptor->GetMagnitudePolicy() != EMagnitudePolicy::Damage || !FDamageCalculation::CanReachTarget(Reach, false, 1))
+			continue;
+
+		const FPreviewHitResult Preview = FDamageCalculation::PreviewDamage(Stats, Metadata.bOnFlank, Descriptor->GetStats(),
+		                                                                     UndefendedTarget);
+		// Same roll gate the combat subsystem applies before resolving a hit
+		const float HitChance = Descriptor->IsRequiringAccuracyRoll() ? Preview.HitProbability / 100.0f : 1.0f;
+		const int32 Expected = FMath::RoundToInt(Preview.DamageResult.Damage * HitChance * DamageScale);
+		if (FDamageCalculation::CanReachTarget(Reach, false, 2))
+			OutInfluence.ReachDamage = FMath::Max(OutInfluence.ReachDamage, Expected);
+		else
+			OutInfluence.CloseDamage = FMath::Max(OutInfluence.CloseDamage, Expected);
+	}
+
+	if (OutInfluence.CloseDamage > 0 || OutInfluence.ReachDamage > 0)
+	{
+		// Melee reach as FBattleState::GetAttackCells models it: every neighbour, minus a blocked entrance
+		GridBitboard::ForEachCell(OwnCells, [&OutInfluence](const FTacCoordinates& Cell)
+		{
+			uint64 Neighbors = GridCellTables::NeighborMask(Cell, false, true);
+			const int8 Blocked = GridCellTables::Get(Cell).EntranceBlockedCell;
+			if (Blocked != GridCellTables::NoCell)
+				Neighbors &= ~(uint64(1) << Blocked);
+			OutInfluence.CloseMask |= Neighbors;
+		});
+		OutInfluence.CloseMask &= ~OwnCells;
+		OutInfluence.CloseDamage = FMath::Max(OutInfluence.CloseDamage, OutInfluence.ReachDamage);
+	}
+	if (OutInfluence.ReachDamage > 0)
+		OutInfluence.ReachMask = GridBitboard::ValidCellsMask & ~OutInfluence.CloseMask & ~OwnCells;
+}
+
+void UTacThreatMapService::ApplyInfluence(const FUnitInfluence& Influence, int32 Sign)
+{
+	// Threats land on the other team's map, healing on the unit's own
+	FTeamMap& Threatened = Maps[static_cast<int32>(UBattleTeam::ReverseTeamSide(Influence.Team))];
+	auto ApplyThreat = [&Threatened, Sign](uint64 Mask, int32 Damage)
+	{
+		for (uint64 Bits = Mask; Bits; Bits &= Bits - 1)
+		{
+			const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+			Threatened.ExpectedDamage[Bit] += Sign * Damage;
+			Threatened.Attackers[Bit] = static_cast<uint8>(Threatened.Attackers[Bit] + Sign);
+			if (Threatened.Attackers[Bit] > 0)
+				Threatened.ThreatenedMask |= uint64(1) << Bit;
+			else
+				Threatened.ThreatenedMask &= ~(uint64(1) << Bit);
+		}
+	};
+	ApplyThreat(Influence.CloseMask, Influence.CloseDamage);
+	ApplyThreat(Influence.ReachMask, Influence.ReachDamage);
+
+	FTeamMap& Own = Maps[static_cast<int32>(Influence.Team)];
+	for (uint64 Bits = Influence.HealMask; Bits; Bits &= Bits - 1)
+	{
+		const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+		Own.Healers[Bit] = static_cast<uint8>(Own.Healers[Bit] + Sign);
+	}
+}
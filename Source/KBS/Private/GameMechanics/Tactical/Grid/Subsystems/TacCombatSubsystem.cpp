@@ -12,6 +12,9 @@ DEFINE_LOG_CATEGORY(LogKBSCombat);
 
 namespace
 {
+	// Tells the AI stream apart from other streams derived from the same battle seed
+	constexpr uint32 AIStreamSalt = 0x41495354;
+
 	void LogCancellation(const FCombatContext& Context, const TCHAR* Phase)
 	{
 		UE_LOG(LogKBSCombat, Log, TEXT("[%s CANCELLED] %s's action was cancelled"), Phase,
@@ -38,6 +41,21 @@ namespace
 		UE_LOG(LogKBSCombat, Log, TEXT("[RESOLUTION END] %s: %d/%d hit, total_dmg=%d"),
 		       *Context.Attacker->GetLogName(), HitCount, Results.Num(), TotalDamage);
 	}
+
+	bool IsBatchedReach(ETargetReach Reach)
+	{
+		switch (Reach)
+		{
+		case ETargetReach::AllEnemies:
+		case ETargetReach::AllFriendlies:
+		case ETargetReach::Area:
+		case ETargetReach::AreaEnemy:
+		case ETargetReach::AreaFriendly:
+			return true;
+		default:
+			return false;
+		}
+	}
 }
 
 TArray<FCombatHitResult> UTacCombatSubsystem::ResolveAttack(AUnit* Attacker, TArray<AUnit*> Targets, UCombatDescriptor* Descriptor)
@@ -87,6 +105,13 @@ TArray<FCombatHitResult> UTacCombatSubsystem::ResolveAttackInternal(FCombatConte
 		return Results;
 	}
 
+	if (bBatchedResolution && Context.Hits.Num() >= BatchResolutionMinHits && IsBatchedReach(Context.AttackerDescriptor->GetStats().TargetReach))
+	{
+		ResolveHitsBatched(Context, Results);
+		LogResolutionEnd(Context, Results);
+		return Results;
+	}
+
 	for (FHitInstance& Hit : Context.Hits)
 	{
 		FCombatHitResult Result;
@@ -116,10 +141,94 @@ TArray<FCombatHitResult> UTacCombatSubsystem::ResolveAttackInternal(FCombatConte
 	return Results;
 }
 
+void UTacCombatSubsystem::ResolveHitsBatched(FCombatContext& Context, TArray<FCombatHitResult>& Results)
+{
+	const int32 NumHits = Context.Hits.Num();
+	Results.SetNum(NumHits);
+
+	// Calculation hooks first, for every hit, in hit order. Hooks may modify the attacker for one target
+	// (EvasiveStance), so each hit's chance is read right after its own hooks, as the per-hit path does
+	const FCombatDescriptorStats& DescriptorStats = Context.AttackerDescriptor->GetStats();
+	const bool bRequiresRoll = Context.AttackerDescriptor->IsRequiringAccuracyRoll();
+	TArray<int32, TInlineAllocator<16>> Live;
+	TArray<float, TInlineAllocator<16>> HitChances;
+	for (int32 i = 0; i < NumHits; ++i)
+	{
+		FHitInstance& Hit = Context.Hits[i];
+		PhaseListeners.Dispatch(ECombatPhase::Calculation, Context, &Hit);
+		if (OnCalculationPhase.IsBound())
+			OnCalculationPhase.Broadcast(Context, Hit);
+		Hit.CheckCancellation();
+		if (Hit.bIsHitCancelled || Context.bIsAttackCancelled)
+		{
+			LogCancellation(Context, Hit, TEXT("HIT"));
+			Results[i] = FCombatHitResult::Cancelled(Hit.Target);
+			continue;
+		}
+		Results[i].TargetUnit = Hit.Target;
+		Live.Add(i);
+		if (bRequiresRoll)
+			HitChances.Add(FDamageCalculation::CalculateHitChance(Context.Attacker->GetStats(), DescriptorStats));
+	}
+
+	// Rolls and magnitudes for the surviving hits as flat loops
+	const int32 NumLive = Live.Num();
+	TArray<bool, TInlineAllocator<16>> Landed;
+	Landed.SetNumUninitialized(NumLive);
+	for (int32 k = 0; k < NumLive; ++k)
+		Landed[k] = !bRequiresRoll || FDamageCalculation::PerformAccuracyRoll(RandomStream, HitChances[k]);
+
+	TArray<const FUnitCoreStats*, TInlineAllocator<16>> TargetStats;
+	TArray<FDamageResult, TInlineAllocator<16>> Magnitudes;
+	TargetStats.SetNumUninitialized(NumLive);
+	Magnitudes.SetNum(NumLive);
+	for (int32 k = 0; k < NumLive; ++k)
+		TargetStats[k] = &Context.Hits[Live[k]].Target->GetStats();
+	if (Context.MagnitudePolicy == EMagnitudePolicy::Damage)
+	{
+		FDamageCalculation::CalculateDamageBatch(Context.Attacker->GetStats(), Context.Attacker->GetGridMetadata().bOnFlank,
+		                                         DescriptorStats, TargetStats, Magnitudes);
+	}
+	else if (Context.MagnitudePolicy == EMagnitudePolicy::Heal)
+	{
+		for (int32 k = 0; k < NumLive; ++k)
+			Magnitudes[k] = FDamageCalculation::CalculateHeal(DescriptorStats, TargetStats[k]->Defense);
+	}
+
+	// Application and its hooks, hit by hit as before
+	for (int32 k = 0; k < NumLive; ++k)
+	{
+		FHitInstance& Hit = Context.Hits[Live[k]];
+		FCombatHitResult& Result = Results[Live[k]];
+		// An earlier hit's application can kill this target or the attacker; the per-hit path would have
+		// cancelled this hit in its calculation phase, so it is cancelled the same way here
+		Hit.CheckCancellation();
+		if (Hit.bIsHitCancelled || Context.bIsAttackCancelled)
+		{
+			LogCancellation(Context, Hit, TEXT("HIT"));
+			Result = FCombatHitResult::Cancelled(Hit.Target);
+			continue;
+		}
+		Result.bHit = Landed[k];
+		if (!Result.bHit)
+			continue;
+		Result.DamageResult = Magnitudes[k];
+		ExecuteResultApplyPhase(Context, Hit, Result);
+		if (Result.bHit && !Result.TargetUnit->IsDead())
+		{
+			ExecuteSideEffectApplicationPhase(Context, Hit, Result);
+			ExecuteEffectApplicationPhase(Context, Hit, Result);
+		}
+	}
+}
+
 
 bool UTacCombatSubsystem::ExecutePreResolutionPhase(FCombatContext& Context)
 {
-	OnPreResolutionPhase.Broadcast(Context);
+	// Attack-level pass for global and attacker-side listeners, then one target-side pass per hit
+	PhaseListeners.Dispatch(ECombatPhase::PreResolution, Context, nullptr, nullptr, ECombatRole::Attacker);
+	if (OnPreResolutionPhase.IsBound())
+		OnPreResolutionPhase.Broadcast(Context);
 	Context.CheckCancellation();
 	if (Context.bIsAttackCancelled)
 	{
@@ -127,12 +236,11 @@ bool UTacCombatSubsystem::ExecutePreResolutionPhase(FCombatContext& Context)
 		return false;
 	}
 
-	Context.Attacker->EnterCombatResolutionPhase(Context, Context.Hits[0], false);
 	for (FHitInstance& Hit : Context.Hits)
 	{
 		Hit.Target->OnUnitAttacked.Broadcast(Hit.Target, Context.Attacker);
 		Context.Attacker->OnUnitAttacks.Broadcast(Context.Attacker, Hit.Target);
-		Hit.Target->EnterCombatResolutionPhase(Context, Hit, true);
+		PhaseListeners.Dispatch(ECombatPhase::PreResolution, Context, &Hit, nullptr, ECombatRole::Target, false);
 		Hit.CheckCancellation();
 	}
 
@@ -142,9 +250,9 @@ bool UTacCombatSubsystem::ExecutePreResolutionPhase(FCombatContext& Context)
 void UTacCombatSubsystem::ExecuteCalculationPhase(FCombatContext& Context, FHitInstance& Hit,
                                                   FCombatHitResult& OutResult)
 {
-	OnCalculationPhase.Broadcast(Context, Hit);
-	Context.Attacker->EnterCombatCalculationPhase(Context, Hit, false);
-	Hit.Target->EnterCombatCalculationPhase(Context, Hit, true);
+	PhaseListeners.Dispatch(ECombatPhase::Calculation, Context, &Hit);
+	if (OnCalculationPhase.IsBound())
+		OnCalculationPhase.Broadcast(Context, Hit);
 	Hit.CheckCancellation();
 	if (Hit.bIsHitCancelled || Context.bIsAttackCancelled)
 	{
@@ -156,7 +264,7 @@ void UTacCombatSubsystem::ExecuteCalculationPhase(FCombatContext& Context, FHitI
 	OutResult.TargetUnit = Hit.Target;
 	if (Context.AttackerDescriptor->IsRequiringAccuracyRoll())
 	{
-		OutResult.bHit = FDamageCalculation::PerformAccuracyRoll(
+		OutResult.bHit = FDamageCalculation::PerformAccuracyRoll(RandomStream,
 			FDamageCalculation::CalculateHitChance(Context.Attacker, Context.AttackerDescriptor, Hit.Target));
 	}
 	else
@@ -183,7 +291,9 @@ void UTacCombatSubsystem::ExecuteSideEffectApplicationPhase(FCombatContext& Cont
 	if (!SideEffects.IsActive())
 		return;
 
-	OnSideEffectApplicationPhase.Broadcast(Context, Hit);
+	PhaseListeners.Dispatch(ECombatPhase::SideEffectApplication, Context, &Hit);
+	if (OnSideEffectApplicationPhase.IsBound())
+		OnSideEffectApplicationPhase.Broadcast(Context, Hit);
 	Hit.CheckCancellation();
 	if (Hit.bIsHitCancelled || Context.bIsAttackCancelled)
 		return;
@@ -206,9 +316,9 @@ void UTacCombatSubsystem::ExecuteSideEffectApplicationPhase(FCombatContext& Cont
 void UTacCombatSubsystem::ExecuteEffectApplicationPhase(FCombatContext& Context, FHitInstance& Hit,
                                                         FCombatHitResult& Result)
 {
-	OnEffectApplicationPhase.Broadcast(Context, Hit);
-	Context.Attacker->EnterCombatEffectApplicationPhase(Context, Hit, false);
-	Hit.Target->EnterCombatEffectApplicationPhase(Context, Hit, true);
+	PhaseListeners.Dispatch(ECombatPhase::EffectApplication, Context, &Hit);
+	if (OnEffectApplicationPhase.IsBound())
+		OnEffectApplicationPhase.Broadcast(Context, Hit);
 	Hit.CheckCancellation();
 	if (Hit.bIsHitCancelled || Context.bIsAttackCancelled)
 	{
@@ -220,15 +330,14 @@ void UTacCombatSubsystem::ExecuteEffectApplicationPhase(FCombatContext& Context,
 	{
 		if (Effect->IsRequringRoll())
 		{
-			if (!FDamageCalculation::PerformAccuracyRoll(
+			if (!FDamageCalculation::PerformAccuracyRoll(RandomStream,
 				FDamageCalculation::CalculateEffectApplication(Context.Attacker, Effect, Hit.Target)))
 			{
 				continue;
 			}
 		}
-		TObjectPtr<UBattleEffect> EffectCopy = DuplicateObject(Effect, Hit.Target);
-		EffectCopy->PrepareForApply(Context.Attacker, Hit.Target);
-		if (Hit.Target->ApplyEffect(EffectCopy))
+		// The descriptor's effect is shared; the target's effect component keeps the per-application state
+		if (Hit.Target->ApplyEffect(Effect, Context.Attacker))
 		{
 			++Result.EffectsApplied;
 		}
@@ -237,9 +346,9 @@ void UTacCombatSubsystem::ExecuteEffectApplicationPhase(FCombatContext& Context,
 
 void UTacCombatSubsystem::ExecuteResultApplyPhase(FCombatContext& Context, FHitInstance& Hit, FCombatHitResult& ToApply)
 {
-	OnResultApplicationPhase.Broadcast(Context, Hit, ToApply.DamageResult);
-	Context.Attacker->EnterCombatResultApplyPhase(Context, Hit, ToApply.DamageResult, false);
-	Hit.Target->EnterCombatResultApplyPhase(Context, Hit, ToApply.DamageResult, true);
+	PhaseListeners.Dispatch(ECombatPhase::ResultApplication, Context, &Hit, &ToApply.DamageResult);
+	if (OnResultApplicationPhase.IsBound())
+		OnResultApplicationPhase.Broadcast(Context, Hit, ToApply.DamageResult);
 	Hit.CheckCancellation();
 	if (Hit.bIsHitCancelled || Context.bIsAttackCancelled)
 	{
@@ -263,6 +372,16 @@ void UTacCombatSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	AbilityExecutorService = NewObject<UTacAbilityExecutorService>(this);
 	CombatStatisticsService = NewObject<UTacCombatStatisticsService>(this);
 	CombatLogger = MakeUnique<FTacCategoryLogger>(FName("LogKBSCombat"), TEXT("Combat"));
+	RandomStream.SeedRandomly();
+	AIRandomStream = RandomStream.Derive(AIStreamSalt);
+	UE_LOG(LogKBSCombat, Log, TEXT("Battle random seed: %d"), RandomStream.GetSeed());
+}
+
+void UTacCombatSubsystem::SeedBattle(int32 Seed)
+{
+	RandomStream.Seed(Seed);
+	AIRandomStream = RandomStream.Derive(AIStreamSalt);
+	UE_LOG(LogKBSCombat, Log, TEXT("Battle random seed set: %d"), Seed);
 }
 
 
@@ -3,6 +3,7 @@
 DEFINE_LOG_CATEGORY(LogTacGrid);
 #include "GameMechanics/Tactical/Grid/Subsystems/Services/TacGridMovementService.h"
 #include "GameMechanics/Tactical/Grid/Subsystems/Services/TacGridTargetingService.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/Services/TacThreatMapService.h"
 #include "GameMechanics/Tactical/Grid/Subsystems/TacTurnSubsystem.h"
 #include "GameMechanics/Units/UnitDefinition.h"
 #include "GameMechanics/Tactical/Grid/Components/GridDataManager.h"
@@ -35,43 +36,33 @@ void UTacGridSubsystem::RegisterManager(UGridDataManager* InDataManager)
 	DataManager = InDataManager;
 	HighlightComponent = Highlight;
 
-	for (AUnit* Unit : DataManager->GetUnits(EUnitQuerySource::OnField))
+	DataManager->ForEachUnit(EUnitQuerySource::OnField, [this](AUnit* Unit)
 	{
 		Unit->OnUnitDied.AddDynamic(this, &UTacGridSubsystem::HandleUnitDied);
-	}
+	});
 
 	GridMovementService = NewObject<UTacGridMovementService>(this);
 	GridMovementService->Initialize(InDataManager);
 	GridTargetingService = NewObject<UTacGridTargetingService>(this);
 	GridTargetingService->Initialize(InDataManager);
+	ThreatMapService = NewObject<UTacThreatMapService>(this);
+	ThreatMapService->Initialize(InDataManager);
 	UE_LOG(LogTacGrid, Log, TEXT("RegisterManager: grid '%s' ready"), *Grid->GetName());
 	UTacSubsystemControl* Control = GetWorld()->GetSubsystem<UTacSubsystemControl>();
 	checkf(Control, TEXT("TacGridSubsystem: TacSubsystemControl is nullptr"));
 	Control->NotifyGridReady();
 }
 
-TArray<AUnit*> UTacGridSubsystem::GetActiveUnits()
+TArrayView<const TObjectPtr<AUnit>> UTacGridSubsystem::GetUnitRoster(EUnitQuerySource Source, ETeamSide Side) const
 {
-	if (!DataManager) return TArray<AUnit*>();
-	return DataManager->GetUnits(EUnitQuerySource::OnField);
+	if (!DataManager) return TArrayView<const TObjectPtr<AUnit>>();
+	return DataManager->GetRoster(Source, Side);
 }
 
-TArray<AUnit*> UTacGridSubsystem::GetAllAliveUnits()
+void UTacGridSubsystem::ForEachUnit(EUnitQuerySource Sources, TFunctionRef<void(AUnit*)> Visitor) const
 {
-	if (!DataManager) return TArray<AUnit*>();
-	return DataManager->GetUnits(EUnitQuerySource::OnField | EUnitQuerySource::OffField);
-}
-
-TArray<AUnit*> UTacGridSubsystem::GetAllUnits()
-{
-	if (!DataManager) return TArray<AUnit*>();
-	return DataManager->GetUnits(EUnitQuerySource::OnField | EUnitQuerySource::OffField | EUnitQuerySource::Corpses);
-}
-
-TArray<AUnit*> UTacGridSubsystem::GetDeadUnits()
-{
-	if (!DataManager) return TArray<AUnit*>();
-	return DataManager->GetUnits(EUnitQuerySource::Corpses);
+	if (!DataManager) return;
+	DataManager->ForEachUnit(Sources, Visitor);
 }
 
 UBattleTeam* UTacGridSubsystem::GetAttackerTeam()
@@ -91,6 +82,17 @@ UBattleTeam* UTacGridSubsystem::GetPlayerTeam()
 	return DataManager->GetPlayerTeam();
 }
 
+const UGridConfig* UTacGridSubsystem::GetGridConfig() const
+{
+	if (!DataManager || !DataManager->GetGrid()) return nullptr;
+	return DataManager->GetGrid()->Config;
+}
+
+uint32 UTacGridSubsystem::GetGridVersion() const
+{
+	return DataManager ? DataManager->GetGridVersion() : 0;
+}
+
 bool UTacGridSubsystem::IsBothTeamsAnyUnitAlive()
 {
 	if (!DataManager) return false;
@@ -1,6 +1,7 @@
 #include "GameMechanics/Tactical/Grid/Subsystems/TacTurnSubsystem.h"
 DEFINE_LOG_CATEGORY(LogKBSTurn);
 #include "GameMechanics/Tactical/Grid/Subsystems/TacGridSubsystem.h"
+#include "GameMechanics/Tactical/Grid/Components/GridDataManager.h"
 #include "GameMechanics/Tactical/Grid/Subsystems/TurnStateMachine/TacTurnOrder.h"
 #include "GameMechanics/Tactical/Grid/Subsystems/TurnStateMachine/States/BattleInitializationState.h"
 #include "GameMechanics/Tactical/Grid/Subsystems/TurnStateMachine/States/RoundStartState.h"
@@ -30,6 +31,7 @@ void UTacTurnSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 	}
 	UTacCombatSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UTacCombatSubsystem>();
 	checkf(CombatSubsystem, TEXT("UTacTurnSubsystem: CombatSubsystem not found"));
+	TurnOrder->SetRandomStream(CombatSubsystem->GetRandomStream());
 	AICombatService = NewObject<UTacAICombatService>(this);
 	AICombatService->Initialize(GridSubsystem, CombatSubsystem);
 	UTacSubsystemControl* Control = GetWorld()->GetSubsystem<UTacSubsystemControl>();
@@ -99,6 +101,20 @@ void UTacTurnSubsystem::StartBattle()
 	AttemptTransition();
 }
 
+void UTacTurnSubsystem::EnableInstantTransitions(int32 RoundLimit)
+{
+	checkf(!CurrentState, TEXT("TacTurnSubsystem: instant transitions must be enabled before the battle starts"));
+	checkf(RoundLimit > 0, TEXT("TacTurnSubsystem: instant transitions need a positive round limit"));
+	bInstantTransitions = true;
+	InstantRoundLimit = RoundLimit;
+}
+
+bool UTacTurnSubsystem::IsBattleOver() const
+{
+	const TUniquePtr<FTacTurnState>* EndState = States.Find(ETurnState::EBattleEndState);
+	return CurrentState && EndState && CurrentState == EndState->Get();
+}
+
 void UTacTurnSubsystem::TransitionToState(ETurnState NextState)
 {
 	check(CurrentState);
@@ -119,36 +135,39 @@ void UTacTurnSubsystem::TransitionToState(ETurnState NextState)
 
 void UTacTurnSubsystem::AttemptTransition()
 {
-	AttemptTransition(0);
-}
-
-void UTacTurnSubsystem::AttemptTransition(int32 Depth)
-{
-	checkf(Depth < 100, TEXT("TacTurnSubsystem: AttemptTransition exceeded 100 automatic transitions - likely infinite loop in state machine"));
 	check(CurrentState);
 
-	// Check win condition - if battle ended, force to battle end state
-	if (CurrentState->CheckWinCondition())
-	{
-		TransitionToState(ETurnState::EBattleEndState);
-		return;
-	}
-
-	ETurnProcessingSubstate Substate = CurrentState->CanReleaseState();
-
-	// Can't release - stuck in awaiting input or presentation
-	if (Substate != ETurnProcessingSubstate::EFreeState)
+	// Keep transitioning (allows rapid transitions through multiple "instant" states without waiting for next event).
+	// Iterative rather than recursive: in instant mode a whole battle chains through here.
+	for (int32 Depth = 0; ; ++Depth)
 	{
-		return;
+		checkf(bInstantTransitions || Depth < 100, TEXT("TacTurnSubsystem: AttemptTransition exceeded 100 automatic transitions - likely infinite loop in state machine"));
+
+		// Check win condition - if battle ended, force to battle end state
+		if (CurrentState->CheckWinCondition())
+		{
+			TransitionToState(ETurnState::EBattleEndState);
+			return;
+		}
+
+		if (bInstantTransitions && CurrentRound > InstantRoundLimit)
+		{
+			UE_LOG(LogKBSTurn, Log, TEXT("Round limit %d reached, battle left unresolved"), InstantRoundLimit);
+			return;
+		}
+
+		ETurnProcessingSubstate Substate = CurrentState->CanReleaseState();
+
+		// Can't release - stuck in awaiting input or presentation
+		if (Substate != ETurnProcessingSubstate::EFreeState)
+		{
+			return;
+		}
+
+		// Free to transition - do ONE transition
+		ETurnState NextStateEnum = CurrentState->NextState();
+		TransitionToState(NextStateEnum);
 	}
-
-	// Free to transition - do ONE transition
-	ETurnState NextStateEnum = CurrentState->NextState();
-	TransitionToState(NextStateEnum);
-
-	// Recursively attempt one more transition
-	// (allows rapid transitions through multiple "instant" states without waiting for next event)
-	AttemptTransition(Depth + 1);
 }
 
 void UTacTurnSubsystem::UnitClicked(AUnit* Unit)
@@ -179,6 +198,15 @@ void UTacTurnSubsystem::OnPresentationComplete()
 	AttemptTransition();
 }
 
+void UTacTurnSubsystem::OnAIDecisionReady()
+{
+	// A cancelled think still reports in; only a state waiting on the AI cares
+	if (!CurrentState || CurrentState->CanReleaseState() != ETurnProcessingSubstate::EAwaitingAIState)
+		return;
+	CurrentState->OnAIDecisionReady();
+	AttemptTransition();
+}
+
 void UTacTurnSubsystem::Wait()
 {
 	if (TurnOrder)
@@ -203,6 +231,11 @@ int32 UTacTurnSubsystem::GetUnitInitiative(AUnit* Unit) const
 	return TurnOrder ? TurnOrder->GetUnitInitiative(Unit) : 0;
 }
 
+const FRolledInitiative* UTacTurnSubsystem::FindUnitRolledInitiative(const AUnit* Unit) const
+{
+	return TurnOrder ? TurnOrder->FindRolledInitiative(Unit) : nullptr;
+}
+
 void UTacTurnSubsystem::HandleUnitDied(AUnit* Unit)
 {
 	TurnOrder->RemoveUnit(Unit);
@@ -217,12 +250,12 @@ void UTacTurnSubsystem::RegisterSummonedUnit(AUnit* Unit)
 
 void UTacTurnSubsystem::ReloadTurnOrder()
 {
-	TArray<AUnit*> Units = GridSubsystem->GetActiveUnits();
-	for (AUnit* Unit : GridSubsystem->GetOffFieldUnits())
+	TArray<AUnit*> Units;
+	GridSubsystem->ForEachUnit(EUnitQuerySource::OnField | EUnitQuerySource::OffField, [&Units](AUnit* Unit)
 	{
-		if (!Unit->GetStats().Status.IsFleeing())
+		if (Unit->GetGridMetadata().IsOnField() || !Unit->GetStats().Status.IsFleeing())
 			Units.Add(Unit);
-	}
+	});
 	TurnOrder->Repopulate(Units, GridSubsystem->GetAttackerTeam());
 	for (AUnit* Unit : Units)
 	{
@@ -30,6 +30,8 @@ void FActionsProcessingState::Enter()
 
 void FActionsProcessingState::Exit()
 {
+	PendingThink.Cancel();
+	PendingThink = FAiThinkTask();
 	ExecutorService = nullptr;
 	FTacTurnState::Exit();
 }
@@ -100,6 +102,8 @@ void FActionsProcessingState::ExecuteAbilityOnTarget(FTacCoordinates TargetCell)
 	UE_LOG(LogKBSTurn, Log, TEXT("[Input] Ability '%s' -> cell [%d,%d]"),
 	       *Ability->GetConfig()->AbilityName, TargetCell.Row, TargetCell.Col);
 
+	// Any new action moves the battle past what a speculative think saw
+	ParentTurnSubsystem->GetAICombatService()->DiscardSpeculation();
 	FAbilityResult Result = ExecutorService->CheckAndExecute(Ability, TargetCell);
 
 	if (Result.bInvalidInput)
@@ -123,6 +127,7 @@ void FActionsProcessingState::ExecuteAbilityOnTarget(FTacCoordinates TargetCell)
 	{
 		UE_LOG(LogKBSTurn, Log, TEXT("Awaiting presentation"));
 		TurnProcessing = ETurnProcessingSubstate::EAwaitingPresentationState;
+		SpeculateNextAITurn();
 	}
 	else
 	{
@@ -132,6 +137,8 @@ void FActionsProcessingState::ExecuteAbilityOnTarget(FTacCoordinates TargetCell)
 
 bool FActionsProcessingState::IsAIUnit(AUnit* Unit) const
 {
+	if (ParentTurnSubsystem->IsInstantTransitions())
+		return true;
 	UTacGridSubsystem* GridSubsystem = Unit->GetWorld()->GetSubsystem<UTacGridSubsystem>();
 	return !GridSubsystem->GetPlayerTeam()->ContainsUnit(Unit);
 }
@@ -140,8 +147,56 @@ void FActionsProcessingState::HandleAITurn(AUnit* Unit)
 {
 	UE_LOG(LogKBSTurn, Log, TEXT("AI turn for: %s"), *Unit->GetLogName());
 	UTacAICombatService* AIService = ParentTurnSubsystem->GetAICombatService();
-	FAiDecision Decision = AIService->ThinkOverNextAction(Unit);
+	// Headless batches have no frames to hide the search behind, so they take the answer in place
+	const bool bInstant = ParentTurnSubsystem->IsInstantTransitions();
+	const bool bThinking = AIService->TakeSpeculation(Unit, PendingThink) ||
+		AIService->StartThinking(Unit, PendingThink, bInstant ? TFunction<void()>() : MakeAIReadyCallback());
+	if (!bThinking)
+	{
+		ExecuteAIDecision(Unit, AIService->ThinkOverNextAction(Unit));
+		return;
+	}
+	if (bInstant || PendingThink.IsReady())
+	{
+		PendingThink.Wait();
+		ExecuteAIDecision(Unit, AIService->FinishThinking(Unit, PendingThink));
+		return;
+	}
+	UE_LOG(LogKBSTurn, Log, TEXT("Awaiting AI decision"));
+	TurnProcessing = ETurnProcessingSubstate::EAwaitingAIState;
+}
 
+void FActionsProcessingState::SpeculateNextAITurn()
+{
+	if (ParentTurnSubsystem->IsInstantTransitions())
+		return;
+	const TArray<AUnit*> Next = GetTurnOrder()->GetRemainingUnits(1);
+	if (Next.IsEmpty() || !Next[0] || !IsAIUnit(Next[0]))
+		return;
+	ParentTurnSubsystem->GetAICombatService()->StartSpeculating(Next[0], MakeAIReadyCallback());
+}
+
+TFunction<void()> FActionsProcessingState::MakeAIReadyCallback() const
+{
+	return [WeakTurnSubsystem = TWeakObjectPtr<UTacTurnSubsystem>(ParentTurnSubsystem)]()
+	{
+		if (UTacTurnSubsystem* TurnSubsystem = WeakTurnSubsystem.Get())
+			TurnSubsystem->OnAIDecisionReady();
+	};
+}
+
+void FActionsProcessingState::OnAIDecisionReady()
+{
+	if (TurnProcessing != ETurnProcessingSubstate::EAwaitingAIState || !PendingThink.IsReady())
+		return;
+	TurnProcessing = ETurnProcessingSubstate::EProcessingEndState;
+	UE_LOG(LogKBSTurn, Log, TEXT("AI decision ready"));
+	AUnit* Unit = GetTurnOrder()->GetCurrentUnit();
+	ExecuteAIDecision(Unit, ParentTurnSubsystem->GetAICombatService()->FinishThinking(Unit, PendingThink));
+}
+
+void FActionsProcessingState::ExecuteAIDecision(AUnit* Unit, const FAiDecision& Decision)
+{
 	if (Decision.bHasDecision)
 	{
 		Unit->GetAbilityInventory()->EquipAbility(Decision.AbilityToUse);
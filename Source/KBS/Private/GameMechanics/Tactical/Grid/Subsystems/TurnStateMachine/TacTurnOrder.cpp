@@ -1,6 +1,7 @@
 #include "GameMechanics/Tactical/Grid/Subsystems/TurnStateMachine/TacTurnOrder.h"
 #include "GameMechanics/Units/Unit.h"
 #include "GameMechanics/Tactical/Grid/BattleTeam.h"
+#include "GameMechanics/Tactical/BattleRandomStream.h"
 #include <ranges>
 
 FRolledInitiative::FRolledInitiative(int32 Base) : Rolled(0), Basic(Base), WaitModifier(WAIT_MODIFIER_ACTIVE)
@@ -11,9 +12,9 @@ FRolledInitiative::FRolledInitiative() : Rolled(0), Basic(0), WaitModifier(WAIT_
 {
 }
 
-int32 FRolledInitiative::MakeRoll()
+int32 FRolledInitiative::MakeRoll(FBattleRandomStream& Random)
 {
-	Rolled = RollInitiative();
+	Rolled = RollInitiative(Random);
 	return Rolled;
 }
 
@@ -37,9 +38,9 @@ void FRolledInitiative::UpdateBasic(int32 Base)
 	Basic = Base;
 }
 
-int32 FRolledInitiative::RollInitiative()
+int32 FRolledInitiative::RollInitiative(FBattleRandomStream& Random)
 {
-	return FMath::RandRange(LOWER_INITIATIVE_ROLL, UPPER_INITIATIVE_ROLL);
+	return Random.RandRange(LOWER_INITIATIVE_ROLL, UPPER_INITIATIVE_ROLL);
 }
 
 bool FRolledInitiative::BreakTie(AUnit* UnitA, AUnit* UnitB, UBattleTeam* AttackerTeam)
@@ -64,6 +65,7 @@ FTacTurnOrder::FTacTurnOrder() : Queue(), CurrentUnit(nullptr)
 int32 FTacTurnOrder::InitiativeRoll(AUnit* Unit)
 {
 	if (!Unit) return 0;
+	checkf(Random, TEXT("FTacTurnOrder: initiative rolled before a random stream was set"));
 
 	const FGuid& UnitGuid = Unit->GetUnitID();
 	if (!RolledInitiative.Find(UnitGuid))
@@ -71,7 +73,7 @@ int32 FTacTurnOrder::InitiativeRoll(AUnit* Unit)
 		FRolledInitiative rolled_initiative(Unit->GetStats().Initiative.GetValue());
 		RolledInitiative.Add(UnitGuid, rolled_initiative);
 	}
-	return RolledInitiative[UnitGuid].MakeRoll();
+	return RolledInitiative[UnitGuid].MakeRoll(*Random);
 }
 
 void FTacTurnOrder::SortQueue()
@@ -129,6 +131,11 @@ int32 FTacTurnOrder::GetUnitInitiative(AUnit* Unit) const
 	return Initiative ? Initiative->GetCurrent() : 0;
 }
 
+const FRolledInitiative* FTacTurnOrder::FindRolledInitiative(const AUnit* Unit) const
+{
+	return Unit ? RolledInitiative.Find(Unit->GetUnitID()) : nullptr;
+}
+
 AUnit* FTacTurnOrder::Advance()
 {
 	AUnit* PreviousUnit = CurrentUnit.Get();
@@ -39,6 +39,11 @@ UPresentationSubsystem* UPresentationSubsystem::Get(const UObject* WorldContextO
 
 FBatchHandle UPresentationSubsystem::BeginBatch(const FString& BatchName)
 {
+	if (bInstantMode)
+	{
+		return FBatchHandle();
+	}
+
 	FGuid NewGuid = FGuid::NewGuid();
 	FBatchHandle Handle(NewGuid);
 
@@ -84,6 +89,11 @@ void UPresentationSubsystem::EndBatch(FBatchHandle BatchHandle)
 
 FOperationHandle UPresentationSubsystem::RegisterOperation(const FString& DebugLabel, FBatchHandle BatchHandle)
 {
+	if (bInstantMode)
+	{
+		return FOperationHandle();
+	}
+
 	// If no batch specified, use current active batch or default batch
 	if (!BatchHandle.IsValid())
 	{
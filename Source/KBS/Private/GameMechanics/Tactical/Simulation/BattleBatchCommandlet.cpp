@@ -0,0 +1,289 @@
+#include "GameMechanics/Tactical/Simulation/BattleBatchCommandlet.h"
+#include "GameMechanics/Tactical/Grid/TacBattleGrid.h"
+#include "GameMechanics/Tactical/Grid/BattleTeam.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacGridSubsystem.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacTurnSubsystem.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacCombatSubsystem.h"
+#include "GameMechanics/Tactical/PresentationSubsystem.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/FileManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+UBattleBatchCommandlet::UBattleBatchCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBattleBatchCommandlet::Main(const FString& Params)
+{
+	TArray<FBattleMatchup> Matchups;
+	if (!LoadMatchups(Params, Matchups))
+		return 1;
+
+	FBatchSettings Settings;
+	FParse::Value(*Params, TEXT("Runs="), Settings.Runs);
+	FParse::Value(*Params, TEXT("MaxRounds="), Settings.MaxRounds);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+	FString GridConfigPath;
+	if (FParse::Value(*Params, TEXT("GridConfig="), GridConfigPath))
+	{
+		Settings.DefaultGridConfig = LoadObject<UGridConfig>(nullptr, *GridConfigPath);
+		if (!Settings.DefaultGridConfig)
+		{
+			UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: could not load grid config %s"), *GridConfigPath);
+			return 1;
+		}
+	}
+	if (Settings.MaxRounds <= 0)
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: -MaxRounds must be positive"));
+		return 1;
+	}
+
+	// Child process: play one shard and hand the raw counts back to the parent
+	FString ShardFile;
+	int32 Shard = 0;
+	int32 NumShards = 1;
+	if (FParse::Value(*Params, TEXT("ShardFile="), ShardFile))
+	{
+		FParse::Value(*Params, TEXT("Shard="), Shard);
+		FParse::Value(*Params, TEXT("NumShards="), NumShards);
+		if (NumShards <= 0 || Shard < 0 || Shard >= NumShards)
+		{
+			UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: shard %d of %d is out of range"), Shard, NumShards);
+			return 1;
+		}
+		TArray<FBattleMatchupResult> Results;
+		RunShard(Matchups, Settings, Shard, NumShards, Results);
+		return WriteJson(ShardFile, Results) ? 0 : 1;
+	}
+
+	FString ResultsBase = FPaths::ProjectSavedDir() / TEXT("BattleBatch") / TEXT("Results");
+	FParse::Value(*Params, TEXT("Results="), ResultsBase);
+	int32 NumWorkers = FPlatformMisc::NumberOfCores();
+	FParse::Value(*Params, TEXT("Workers="), NumWorkers);
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FBattleMatchupResult> Results;
+	if (NumWorkers > 1)
+	{
+		if (!RunWorkers(NumWorkers, ResultsBase, Matchups.Num(), Results))
+			return 1;
+	}
+	else
+	{
+		RunShard(Matchups, Settings, 0, 1, Results);
+	}
+
+	for (const FBattleMatchupResult& Result : Results)
+	{
+		UE_LOG(LogKBSSim, Display, TEXT("%s: %d runs, attacker %d / defender %d / unresolved %d, %.1f rounds avg"),
+		       *Result.Name, Result.Runs, Result.AttackerWins, Result.DefenderWins, Result.Unresolved, Result.GetAverageRounds());
+	}
+	UE_LOG(LogKBSSim, Display, TEXT("BattleBatch: %d matchups in %.1fs"), Results.Num(), FPlatformTime::Seconds() - StartTime);
+
+	const bool bWritten = WriteCsv(ResultsBase + TEXT(".csv"), Results) && WriteJson(ResultsBase + TEXT(".json"), Results);
+	return bWritten ? 0 : 1;
+}
+
+bool UBattleBatchCommandlet::LoadMatchups(const FString& Params, TArray<FBattleMatchup>& OutMatchups)
+{
+	FString Source;
+	if (FParse::Value(*Params, TEXT("Table="), Source))
+	{
+		const UDataTable* Table = LoadObject<UDataTable>(nullptr, *Source);
+		if (!Table || Table->GetRowStruct() != FBattleMatchup::StaticStruct())
+		{
+			UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: %s is not a FBattleMatchup data table"), *Source);
+			return false;
+		}
+		Table->ForeachRow<FBattleMatchup>(TEXT("BattleBatch"), [&OutMatchups](const FName& RowName, const FBattleMatchup& Row)
+		{
+			FBattleMatchup& Matchup = OutMatchups.Add_GetRef(Row);
+			if (Matchup.Name.IsEmpty())
+				Matchup.Name = RowName.ToString();
+		});
+	}
+	else if (FParse::Value(*Params, TEXT("Matchups="), Source))
+	{
+		FString Json;
+		if (!FFileHelper::LoadFileToString(Json, *Source) || !BattleBatch::ParseMatchups(Json, OutMatchups))
+		{
+			UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: could not read matchups from %s"), *Source);
+			return false;
+		}
+	}
+	else
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: -Matchups=<file.json> or -Table=<data table> is required"));
+		return false;
+	}
+
+	if (OutMatchups.IsEmpty())
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: %s has no matchups"), *Source);
+		return false;
+	}
+	return true;
+}
+
+void UBattleBatchCommandlet::RunShard(const TArray<FBattleMatchup>& Matchups, const FBatchSettings& Settings, int32 Shard,
+                                      int32 NumShards, TArray<FBattleMatchupResult>& OutResults)
+{
+	int32 BatchIndex = 0;
+	for (const FBattleMatchup& Matchup : Matchups)
+	{
+		FBattleMatchupResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = Matchup.Name;
+		UGridConfig* GridConfig = Matchup.GridConfig ? Matchup.GridConfig.Get() : Settings.DefaultGridConfig;
+		if (!GridConfig)
+		{
+			UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: %s has no grid config and no -GridConfig was given"), *Matchup.Name);
+			continue;
+		}
+
+		const int32 Runs = Matchup.Runs > 0 ? Matchup.Runs : Settings.Runs;
+		for (int32 Run = 0; Run < Runs; ++Run, ++BatchIndex)
+		{
+			if (!BattleBatch::IsInShard(BatchIndex, Shard, NumShards))
+				continue;
+			RunBattle(Matchup, GridConfig, Settings, BattleBatch::GetRunSeed(Settings.Seed, Matchup.Name, Run), Result);
+		}
+	}
+}
+
+void UBattleBatchCommandlet::RunBattle(const FBattleMatchup& Matchup, UGridConfig* GridConfig, const FBatchSettings& Settings,
+                                       int32 Seed, FBattleMatchupResult& Result)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("BattleBatch"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->GetSubsystem<UPresentationSubsystem>()->SetInstantMode(true);
+	World->GetSubsystem<UTacCombatSubsystem>()->SeedBattle(Seed);
+	UTacTurnSubsystem* TurnSubsystem = World->GetSubsystem<UTacTurnSubsystem>();
+	TurnSubsystem->EnableInstantTransitions(Settings.MaxRounds);
+
+	ATacBattleGrid* Grid = World->SpawnActorDeferred<ATacBattleGrid>(ATacBattleGrid::StaticClass(), FTransform::Identity);
+	Grid->Config = GridConfig;
+	Grid->EditorUnitPlacements = Matchup.Placements;
+	Grid->FinishSpawning(FTransform::Identity);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+	// A bare world has no game mode to dispatch actor BeginPlay, so do what AGameStateBase::HandleBeginPlay does.
+	// The grid's BeginPlay places the units and starts the battle, which then runs to the end synchronously.
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	++Result.Runs;
+	Result.TotalRounds += TurnSubsystem->GetCurrentRound();
+	const UBattleTeam* Winner = TurnSubsystem->IsBattleOver() ? World->GetSubsystem<UTacGridSubsystem>()->GetWinnerTeam() : nullptr;
+	if (!Winner)
+		++Result.Unresolved;
+	else if (Winner->GetTeamSide() == ETeamSide::Attacker)
+		++Result.AttackerWins;
+	else
+		++Result.DefenderWins;
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	Result.Seconds += FPlatformTime::Seconds() - StartTime;
+}
+
+bool UBattleBatchCommandlet::RunWorkers(int32 NumWorkers, const FString& ResultsBase, int32 NumMatchups,
+                                        TArray<FBattleMatchupResult>& OutResults)
+{
+	const FString Executable = FPlatformProcess::ExecutablePath();
+	TArray<FProcHandle> Workers;
+	TArray<FString> ShardFiles;
+	for (int32 Shard = 0; Shard < NumWorkers; ++Shard)
+	{
+		const FString ShardFile = FPaths::ConvertRelativePathToFull(FString::Printf(TEXT("%s.shard%d.json"), *ResultsBase, Shard));
+		const FString Args = FString::Printf(TEXT("%s -Shard=%d -NumShards=%d -ShardFile=\"%s\""),
+		                                     FCommandLine::Get(), Shard, NumWorkers, *ShardFile);
+		FProcHandle Handle = FPlatformProcess::CreateProc(*Executable, *Args, false, true, true, nullptr, 0, nullptr, nullptr);
+		if (!Handle.IsValid())
+		{
+			UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: could not start worker %d"), Shard);
+			for (FProcHandle& Worker : Workers)
+			{
+				FPlatformProcess::TerminateProc(Worker);
+				FPlatformProcess::CloseProc(Worker);
+			}
+			return false;
+		}
+		Workers.Add(Handle);
+		ShardFiles.Add(ShardFile);
+	}
+	UE_LOG(LogKBSSim, Display, TEXT("BattleBatch: running on %d workers"), NumWorkers);
+
+	OutResults.SetNum(NumMatchups);
+	bool bAllSucceeded = true;
+	for (int32 Shard = 0; Shard < NumWorkers; ++Shard)
+	{
+		FPlatformProcess::WaitForProc(Workers[Shard]);
+		int32 ReturnCode = 0;
+		FPlatformProcess::GetProcReturnCode(Workers[Shard], &ReturnCode);
+		FPlatformProcess::CloseProc(Workers[Shard]);
+
+		TArray<FBattleMatchupResult> ShardResults;
+		if (ReturnCode != 0 || !ReadJson(ShardFiles[Shard], ShardResults) || !BattleBatch::MergeShard(ShardResults, OutResults))
+		{
+			UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: worker %d failed (exit code %d)"), Shard, ReturnCode);
+			bAllSucceeded = false;
+			continue;
+		}
+		IFileManager::Get().Delete(*ShardFiles[Shard]);
+	}
+	return bAllSucceeded;
+}
+
+bool UBattleBatchCommandlet::WriteJson(const FString& Path, const TArray<FBattleMatchupResult>& Results)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	for (const FBattleMatchupResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		FJsonObjectConverter::UStructToJsonObject(FBattleMatchupResult::StaticStruct(), &Result, Object);
+		Object->SetNumberField(TEXT("AttackerWinRate"), Result.GetAttackerWinRate());
+		Object->SetNumberField(TEXT("AverageRounds"), Result.GetAverageRounds());
+		Values.Add(MakeShared<FJsonValueObject>(Object));
+	}
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	if (!FJsonSerializer::Serialize(Values, Writer) || !FFileHelper::SaveStringToFile(Json, *Path))
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: could not write %s"), *Path);
+		return false;
+	}
+	return true;
+}
+
+bool UBattleBatchCommandlet::ReadJson(const FString& Path, TArray<FBattleMatchupResult>& OutResults)
+{
+	FString Json;
+	return FFileHelper::LoadFileToString(Json, *Path) &&
+		FJsonObjectConverter::JsonArrayStringToUStruct(Json, &OutResults, 0, 0);
+}
+
+bool UBattleBatchCommandlet::WriteCsv(const FString& Path, const TArray<FBattleMatchupResult>& Results)
+{
+	if (!FFileHelper::SaveStringToFile(BattleBatch::ToCsv(Results), *Path))
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleBatch: could not write %s"), *Path);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,78 @@
+#include "GameMechanics/Tactical/Simulation/BattleEstimateCommandlet.h"
+#include "GameMechanics/Tactical/Simulation/BattleSetup.h"
+#include "GameMechanics/Tactical/Simulation/BattleOutcomeEstimator.h"
+#include "GameMechanics/Tactical/Grid/TacBattleGrid.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+UBattleEstimateCommandlet::UBattleEstimateCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBattleEstimateCommandlet::Main(const FString& Params)
+{
+	FString MapName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName))
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleEstimate: -Map=<package> is required"));
+		return 1;
+	}
+
+	FBattleEstimateParams EstimateParams;
+	EstimateParams.Runs = 10000;
+	FParse::Value(*Params, TEXT("Runs="), EstimateParams.Runs);
+	FParse::Value(*Params, TEXT("MaxRounds="), EstimateParams.MaxRounds);
+	if (!FParse::Value(*Params, TEXT("Seed="), EstimateParams.Seed))
+	{
+		FBattleRandomStream Random;
+		Random.SeedRandomly();
+		EstimateParams.Seed = Random.GetSeed();
+	}
+	if (EstimateParams.Runs <= 0)
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleEstimate: -Runs must be positive"));
+		return 1;
+	}
+
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World || !World->PersistentLevel)
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleEstimate: could not load map %s"), *MapName);
+		return 1;
+	}
+
+	const ATacBattleGrid* Grid = nullptr;
+	for (const AActor* Actor : World->PersistentLevel->Actors)
+	{
+		Grid = Cast<ATacBattleGrid>(Actor);
+		if (Grid)
+			break;
+	}
+	if (!Grid)
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleEstimate: %s has no ATacBattleGrid"), *MapName);
+		return 1;
+	}
+
+	FBattleSetup Setup;
+	// A skipped placement, unsimulatable units included, would estimate a different matchup than the map's
+	if (Setup.AddPlacements(Grid->EditorUnitPlacements) != Grid->EditorUnitPlacements.Num())
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleEstimate: some placements on %s were refused, see above; not estimating"), *MapName);
+		return 1;
+	}
+	const FBattleState& Initial = Setup.GetInitialState();
+	if (Initial.GetAliveCount(ETeamSide::Attacker) == 0 || Initial.GetAliveCount(ETeamSide::Defender) == 0)
+	{
+		UE_LOG(LogKBSSim, Error, TEXT("BattleEstimate: both teams need at least one unit"));
+		return 1;
+	}
+
+	FBattleOutcomeEstimator::LogEstimate(FBattleOutcomeEstimator::Estimate(Initial, EstimateParams));
+	return 0;
+}
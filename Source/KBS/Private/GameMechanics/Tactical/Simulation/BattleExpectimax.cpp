@@ -0,0 +1,285 @@
+#include "GameMechanics/Tactical/Simulation/BattleExpectimax.h"
+#include "GameMechanics/Tactical/Simulation/BattleTranspositionTable.h"
+#include "GameMechanics/Tactical/Grid/BattleTeam.h"
+#include "GameplayTypes/BattleZobrist.h"
+
+namespace
+{
+	using FCandidateList = TArray<FSimAction, TInlineAllocator<32>>;
+
+	// Clock reads are not free next to a node expansion; check the deadline every few nodes
+	constexpr int32 DeadlineCheckInterval = 128;
+	// Ordering tiers: any attack before any move, any move before wait
+	constexpr double AttackTier = 2.0;
+	constexpr double MoveTier = 1.0;
+	// Longest Manhattan distance on the grid, flank cells included
+	constexpr double MaxCellDistance = 16.0;
+	// 2^14 slots, 256 KB: plenty for a 50 ms search
+	constexpr int32 PrivateTableCapacityLog2 = 14;
+
+	struct FOrderedAction
+	{
+		FSimAction Action;
+		double Priority = 0.0;
+	};
+	using FOrderedList = TArray<FOrderedAction, TInlineAllocator<32>>;
+
+	struct FChanceOutcome
+	{
+		ESimRollOutcome Rolls = ESimRollOutcome::Roll;
+		double Probability = 1.0;
+	};
+
+	// Scores are the attacker's share of the position, as FBattleSimulator::EvaluatePosition reports it
+	class FExpectimaxSearch
+	{
+	public:
+		FExpectimaxSearch(const FBattleExpectimaxParams& InParams, FBattleTranspositionTable& InTable, int32 InRoundLimit,
+		                  double InDeadline)
+			: Params(InParams), Table(InTable), RoundLimit(InRoundLimit), Deadline(InDeadline)
+		{
+		}
+
+		// Candidates for the current unit, best first, with all but MaxMoves move cells dropped
+		void OrderActions(const FBattleState& State, int32 Unit, int32 MaxMoves, FOrderedList& OutActions) const
+		{
+			FCandidateList Candidates;
+			FBattleSimulator::GetCandidateActions(State, Unit, Candidates);
+			const uint64 EnemyCells = State.GetTeamMask(UBattleTeam::ReverseTeamSide(State.GetUnit(Unit).Team));
+
+			OutActions.Reset();
+			for (const FSimAction& Action : Candidates)
+			{
+				FOrderedAction& Ordered = OutActions.AddDefaulted_GetRef();
+				Ordered.Action = Action;
+				if (Action.Kind == ESimActionKind::Attack)
+				{
+					// Expected share of the target's health removed, with likely kills on top
+					const FPreviewHitResult Preview = State.PreviewAttack(Action.Cell);
+					const FUnitHealth& Health = State.GetUnit(State.GetUnitAt(Action.Cell)).Stats.Health;
+					const double HitChance = Preview.HitProbability / 100.0;
+					const int32 Damage = FMath::Min(Preview.DamageResult.Damage, Health.GetCurrent());
+					Ordered.Priority = AttackTier + HitChance * Damage / FMath::Max(1, Health.GetMaximum());
+					if (Damage >= Health.GetCurrent())
+						Ordered.Priority += HitChance;
+				}
+				else if (Action.Kind == ESimActionKind::Move)
+				{
+					int32 BestDist = MAX_int32;
+					GridBitboard::ForEachCell(EnemyCells, [&](const FTacCoordinates& EnemyCell)
+					{
+						BestDist = FMath::Min(BestDist, FMath::Abs(Action.Cell.Row - EnemyCell.Row) + FMath::Abs(Action.Cell.Col - EnemyCell.Col));
+					});
+					Ordered.Priority = MoveTier + (1.0 - FMath::Min<double>(BestDist, MaxCellDistance) / MaxCellDistance) * 0.5;
+				}
+			}
+			OutActions.StableSort([](const FOrderedAction& A, const FOrderedAction& B) { return A.Priority > B.Priority; });
+
+			int32 MovesKept = 0;
+			OutActions.RemoveAll([&MovesKept, MaxMoves](const FOrderedAction& Ordered)
+			{
+				return Ordered.Action.Kind == ESimActionKind::Move && ++MovesKept > MaxMoves;
+			});
+		}
+
+		// Chance node: expected score of playing Action in State, with Depth turns searched after it.
+		// Star1 narrows each outcome's window using the bounds 0..1 of the outcomes not searched yet.
+		double EvaluateAction(const FBattleState& State, const FSimAction& Action, int32 Depth, double Alpha, double Beta)
+		{
+			FChanceOutcome Outcomes[2];
+			int32 NumOutcomes = 1;
+			if (Action.Kind == ESimActionKind::Attack)
+			{
+				const double HitChance = State.PreviewAttack(Action.Cell).HitProbability / 100.0;
+				if (HitChance >= 1.0)
+				{
+					Outcomes[0] = { ESimRollOutcome::Hit, 1.0 };
+				}
+				else if (HitChance <= 0.0)
+				{
+					Outcomes[0] = { ESimRollOutcome::Miss, 1.0 };
+				}
+				else
+				{
+					Outcomes[0] = { ESimRollOutcome::Hit, HitChance };
+					Outcomes[1] = { ESimRollOutcome::Miss, 1.0 - HitChance };
+					NumOutcomes = 2;
+				}
+			}
+
+			double Known = 0.0;
+			double Remaining = 1.0;
+			for (int32 i = 0; i < NumOutcomes; ++i)
+			{
+				const FChanceOutcome& Outcome = Outcomes[i];
+				Remaining -= Outcome.Probability;
+				const double ChildAlpha = FMath::Max(0.0, (Alpha - Known - Remaining) / Outcome.Probability);
+				const double ChildBeta = FMath::Min(1.0, (Beta - Known) / Outcome.Probability);
+
+				FBattleState Next = State;
+				verifyf(Next.Apply(Action, Outcome.Rolls), TEXT("FBattleExpectimax: candidate action was illegal"));
+				Next.EndTurn();
+				const double Value = FBattleSimulator::AdvanceToDecision(Next, RoundLimit) == FBattleState::NoUnit
+					? FBattleSimulator::EvaluatePosition(Next)
+					: EvaluateTurn(Next, Depth, ChildAlpha, ChildBeta);
+				if (bAborted)
+					return 0.0;
+
+				Known += Outcome.Probability * Value;
+				if (Known + Remaining <= Alpha)
+					return Known + Remaining;
+				if (Known >= Beta)
+					return Known;
+			}
+			return Known;
+		}
+
+		// Decision node for the unit holding the turn in State; fail-soft alpha-beta
+		double EvaluateTurn(const FBattleState& State, int32 Depth, double Alpha, double Beta)
+		{
+			if (++Nodes % DeadlineCheckInterval == 0)
+			{
+				if ((bAbortable && FPlatformTime::Seconds() >= Deadline) ||
+					(Params.Cancel && Params.Cancel->load(std::memory_order_relaxed)))
+					bAborted = true;
+			}
+			if (bAborted)
+				return 0.0;
+			if (Depth == 0)
+				return FBattleSimulator::EvaluatePosition(State);
+
+			// The same position scores differently with fewer rounds left before the search horizon ends
+			// the battle, and a shared table outlives the search whose limit it was stored under
+			const uint64 Key = State.GetHash() ^ BattleZobrist::Key(BattleZobrist::EFeature::RoundsLeft, 0, RoundLimit - State.GetRound());
+			FTranspositionEntry Entry;
+			const bool bHasEntry = Table.Probe(Key, Entry);
+			if (bHasEntry && Entry.Depth >= Depth)
+			{
+				if (Entry.Bound == ETranspositionBound::Exact ||
+					(Entry.Bound == ETranspositionBound::Lower && Entry.Value >= Beta) ||
+					(Entry.Bound == ETranspositionBound::Upper && Entry.Value <= Alpha))
+					return Entry.Value;
+			}
+
+			const int32 Unit = State.GetCurrentUnit();
+			const bool bMaximize = State.GetUnit(Unit).Team == ETeamSide::Attacker;
+			FOrderedList Actions;
+			OrderActions(State, Unit, Params.MaxMovesPerTurn, Actions);
+			if (bHasEntry)
+			{
+				const int32 Known = Actions.IndexOfByPredicate([&Entry](const FOrderedAction& Ordered) { return Ordered.Action == Entry.BestAction; });
+				if (Known > 0)
+				{
+					const FOrderedAction Principal = Actions[Known];
+					Actions.RemoveAt(Known);
+					Actions.Insert(Principal, 0);
+				}
+			}
+
+			const double AlphaIn = Alpha;
+			const double BetaIn = Beta;
+			double Best = bMaximize ? 0.0 : 1.0;
+			FSimAction BestAction = Actions[0].Action;
+			for (const FOrderedAction& Ordered : Actions)
+			{
+				const double Value = EvaluateAction(State, Ordered.Action, Depth - 1, Alpha, Beta);
+				if (bAborted)
+					return 0.0;
+				if (bMaximize ? Value > Best : Value < Best)
+				{
+					Best = Value;
+					BestAction = Ordered.Action;
+				}
+				if (bMaximize)
+					Alpha = FMath::Max(Alpha, Value);
+				else
+					Beta = FMath::Min(Beta, Value);
+				if (Alpha >= Beta)
+					break;
+			}
+
+			Entry.Value = static_cast<float>(Best);
+			Entry.Depth = Depth;
+			Entry.Bound = Best <= AlphaIn ? ETranspositionBound::Upper
+				: Best >= BetaIn ? ETranspositionBound::Lower
+				: ETranspositionBound::Exact;
+			Entry.BestAction = BestAction;
+			Table.Store(Key, Entry);
+			return Best;
+		}
+
+		// The first iteration always completes so there is an answer to fall back on
+		void SetAbortable(bool bInAbortable) { bAbortable = bInAbortable; }
+		bool IsAborted() const { return bAborted; }
+		int64 GetNodes() const { return Nodes; }
+
+	private:
+		const FBattleExpectimaxParams& Params;
+		FBattleTranspositionTable& Table;
+		const int32 RoundLimit;
+		const double Deadline;
+		int64 Nodes = 0;
+		bool bAbortable = false;
+		bool bAborted = false;
+	};
+}
+
+FBattleExpectimaxResult FBattleExpectimax::Search(const FBattleState& Root, const FBattleExpectimaxParams& Params)
+{
+	const int32 Unit = Root.GetCurrentUnit();
+	checkf(Unit != FBattleState::NoUnit, TEXT("FBattleExpectimax::Search: root has no unit mid-turn"));
+
+	FBattleExpectimaxResult Result;
+	Result.Action = FBattleSimulator::ChooseDefaultAction(Root, Unit);
+	const int32 MaxDepth = FMath::Max(1, Params.MaxDepth);
+	TUniquePtr<FBattleTranspositionTable> PrivateTable;
+	if (!Params.Table)
+		PrivateTable = MakeUnique<FBattleTranspositionTable>(PrivateTableCapacityLog2);
+	FBattleTranspositionTable& Table = Params.Table ? *Params.Table : *PrivateTable;
+	FExpectimaxSearch Search(Params, Table, Root.GetRound() + MaxDepth, FPlatformTime::Seconds() + Params.TimeBudgetSeconds);
+
+	// The root keeps every move cell; the cap only thins out the tree below it
+	FOrderedList RootActions;
+	Search.OrderActions(Root, Unit, MAX_int32, RootActions);
+	if (RootActions.Num() == 1)
+	{
+		Result.Action = RootActions[0].Action;
+		return Result;
+	}
+
+	const bool bMaximize = Root.GetUnit(Unit).Team == ETeamSide::Attacker;
+	for (int32 Depth = 1; Depth <= MaxDepth; ++Depth)
+	{
+		Search.SetAbortable(Depth > 1);
+		double Alpha = 0.0;
+		double Beta = 1.0;
+		int32 BestIndex = INDEX_NONE;
+		double BestValue = 0.0;
+		for (int32 i = 0; i < RootActions.Num(); ++i)
+		{
+			const double Value = Search.EvaluateAction(Root, RootActions[i].Action, Depth - 1, Alpha, Beta);
+			if (Search.IsAborted())
+				break;
+			if (BestIndex == INDEX_NONE || (bMaximize ? Value > BestValue : Value < BestValue))
+			{
+				BestIndex = i;
+				BestValue = Value;
+				(bMaximize ? Alpha : Beta) = Value;
+			}
+		}
+		if (Search.IsAborted())
+			break;
+
+		Result.Action = RootActions[BestIndex].Action;
+		Result.Depth = Depth;
+		Result.ExpectedScore = bMaximize ? BestValue : 1.0 - BestValue;
+		// Principal move first next iteration, so the deeper search cuts against it early
+		const FOrderedAction Principal = RootActions[BestIndex];
+		RootActions.RemoveAt(BestIndex);
+		RootActions.Insert(Principal, 0);
+		if (Result.ExpectedScore >= 1.0)
+			break;
+	}
+	Result.Nodes = Search.GetNodes();
+	return Result;
+}
@@ -0,0 +1,53 @@
+#include "GameMechanics/Tactical/Simulation/BattleMatchup.h"
+#include "JsonObjectConverter.h"
+
+void FBattleMatchupResult::Merge(const FBattleMatchupResult& Other)
+{
+	Runs += Other.Runs;
+	AttackerWins += Other.AttackerWins;
+	DefenderWins += Other.DefenderWins;
+	Unresolved += Other.Unresolved;
+	TotalRounds += Other.TotalRounds;
+	Seconds += Other.Seconds;
+}
+
+bool BattleBatch::ParseMatchups(const FString& Json, TArray<FBattleMatchup>& OutMatchups)
+{
+	if (!FJsonObjectConverter::JsonArrayStringToUStruct(Json, &OutMatchups, 0, 0))
+		return false;
+	for (int32 i = 0; i < OutMatchups.Num(); ++i)
+	{
+		if (OutMatchups[i].Name.IsEmpty())
+			OutMatchups[i].Name = FString::Printf(TEXT("Matchup%d"), i);
+	}
+	return true;
+}
+
+int32 BattleBatch::GetRunSeed(int32 BatchSeed, const FString& MatchupName, int32 Run)
+{
+	return static_cast<int32>(HashCombine(HashCombine(GetTypeHash(BatchSeed), GetTypeHash(MatchupName)), GetTypeHash(Run)));
+}
+
+bool BattleBatch::MergeShard(const TArray<FBattleMatchupResult>& ShardResults, TArray<FBattleMatchupResult>& OutResults)
+{
+	if (ShardResults.Num() != OutResults.Num())
+		return false;
+	for (int32 i = 0; i < ShardResults.Num(); ++i)
+	{
+		OutResults[i].Name = ShardResults[i].Name;
+		OutResults[i].Merge(ShardResults[i]);
+	}
+	return true;
+}
+
+FString BattleBatch::ToCsv(const TArray<FBattleMatchupResult>& Results)
+{
+	FString Csv = TEXT("Matchup,Runs,AttackerWins,DefenderWins,Unresolved,AttackerWinRate,AverageRounds,Seconds\n");
+	for (const FBattleMatchupResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("\"%s\",%d,%d,%d,%d,%.4f,%.2f,%.2f\n"), *Result.Name.Replace(TEXT("\""), TEXT("\"\"")),
+		                       Result.Runs, Result.AttackerWins, Result.DefenderWins, Result.Unresolved,
+		                       Result.GetAttackerWinRate(), Result.GetAverageRounds(), Result.Seconds);
+	}
+	return Csv;
+}
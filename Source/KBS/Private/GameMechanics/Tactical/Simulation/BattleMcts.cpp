@@ -0,0 +1,232 @@
+#include "GameMechanics/Tactical/Simulation/BattleMcts.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+namespace
+{
+	using FCandidateList = TArray<FSimAction, TInlineAllocator<32>>;
+
+	// Clock reads are not free next to a rollout; check the deadline every few iterations
+	constexpr int32 DeadlineCheckInterval = 8;
+
+	struct FMctsNode
+	{
+		FSimAction Action;
+		// Side that chose Action; scores are kept from its point of view
+		ETeamSide Actor = ETeamSide::Attacker;
+		TArray<int32, TInlineAllocator<8>> Children;
+		double Score = 0.0;
+		int32 Visits = 0;
+	};
+
+	struct FRootStat
+	{
+		FSimAction Action;
+		double Score = 0.0;
+		int32 Visits = 0;
+	};
+
+	class FMctsTree
+	{
+	public:
+		FMctsTree(const FBattleState& InRoot, const FBattleSearchParams& InParams, const FBattleRandomStream& InRandom)
+			: Root(InRoot), Params(InParams), Random(InRandom)
+		{
+			Nodes.AddDefaulted();
+		}
+
+		void Grow(int32 MaxIterations, double Deadline)
+		{
+			for (int32 Iteration = 0; Iteration < MaxIterations; ++Iteration)
+			{
+				if (Iteration % DeadlineCheckInterval == 0 &&
+					(FPlatformTime::Seconds() >= Deadline || (Params.Cancel && Params.Cancel->load(std::memory_order_relaxed))))
+					break;
+				RunIteration();
+				++Iterations;
+			}
+		}
+
+		void CollectRootStats(TArray<FRootStat>& Stats) const
+		{
+			for (const int32 ChildIndex : Nodes[0].Children)
+			{
+				const FMctsNode& Child = Nodes[ChildIndex];
+				FRootStat* Stat = Stats.FindByPredicate([&Child](const FRootStat& Existing) { return Existing.Action == Child.Action; });
+				if (!Stat)
+				{
+					Stat = &Stats.AddDefaulted_GetRef();
+					Stat->Action = Child.Action;
+				}
+				Stat->Score += Child.Score;
+				Stat->Visits += Child.Visits;
+			}
+		}
+
+		int32 GetIterations() const { return Iterations; }
+
+	private:
+		void RunIteration()
+		{
+			FBattleState State = Root;
+			State.GetRandomStream() = Random.Fork();
+			const int32 RoundLimit = Root.GetRound() + Params.RolloutRounds;
+
+			TArray<int32, TInlineAllocator<32>> Path;
+			int32 NodeIndex = 0;
+			int32 Unit = State.GetCurrentUnit();
+			bool bExpanded = false;
+			while (Unit != FBattleState::NoUnit && !bExpanded)
+			{
+				const ETeamSide Actor = State.GetUnit(Unit).Team;
+				FBattleSimulator::GetCandidateActions(State, Unit, Candidates);
+				int32 ChildIndex = INDEX_NONE;
+				while (ChildIndex == INDEX_NONE && !Candidates.IsEmpty())
+				{
+					const int32 Untried = PickUntried(NodeIndex);
+					const int32 Pick = Untried != INDEX_NONE ? Untried : SelectChild(NodeIndex);
+					const FSimAction Action = Candidates[Pick];
+					Candidates.RemoveAtSwap(Pick, EAllowShrinking::No);
+					if (!State.Apply(Action))
+						continue;
+					bExpanded = Untried != INDEX_NONE;
+					ChildIndex = bExpanded ? AddChild(NodeIndex, Action, Actor) : FindChild(NodeIndex, Action);
+				}
+				if (ChildIndex == INDEX_NONE)
+					break;
+				NodeIndex = ChildIndex;
+				Path.Add(NodeIndex);
+				State.EndTurn();
+				Unit = FBattleSimulator::AdvanceToDecision(State, RoundLimit);
+			}
+
+			// Rollout with the default policy
+			while (Unit != FBattleState::NoUnit)
+			{
+				State.Apply(FBattleSimulator::ChooseDefaultAction(State, Unit));
+				State.EndTurn();
+				Unit = FBattleSimulator::AdvanceToDecision(State, RoundLimit);
+			}
+
+			const double AttackerValue = FBattleSimulator::EvaluatePosition(State);
+			++Nodes[0].Visits;
+			for (const int32 Index : Path)
+			{
+				FMctsNode& Node = Nodes[Index];
+				++Node.Visits;
+				Node.Score += Node.Actor == ETeamSide::Attacker ? AttackerValue : 1.0 - AttackerValue;
+			}
+		}
+
+		// Random candidate the node has no child for yet, INDEX_NONE when all are expanded
+		int32 PickUntried(int32 NodeIndex)
+		{
+			Untried.Reset();
+			for (int32 i = 0; i < Candidates.Num(); ++i)
+			{
+				if (FindChild(NodeIndex, Candidates[i]) == INDEX_NONE)
+					Untried.Add(i);
+			}
+			return Untried.IsEmpty() ? INDEX_NONE : Untried[Random.RandRange(0, Untried.Num() - 1)];
+		}
+
+		// UCB1 over the children that are legal in this iteration's state
+		int32 SelectChild(int32 NodeIndex) const
+		{
+			const double LogParent = FMath::Loge(static_cast<double>(FMath::Max(1, Nodes[NodeIndex].Visits)));
+			int32 Best = 0;
+			double BestValue = -1.0;
+			for (int32 i = 0; i < Candidates.Num(); ++i)
+			{
+				const FMctsNode& Child = Nodes[FindChild(NodeIndex, Candidates[i])];
+				const double Value = Child.Score / Child.Visits + Params.Exploration * FMath::Sqrt(LogParent / Child.Visits);
+				if (Value > BestValue)
+				{
+					BestValue = Value;
+					Best = i;
+				}
+			}
+			return Best;
+		}
+
+		int32 FindChild(int32 NodeIndex, const FSimAction& Action) const
+		{
+			for (const int32 ChildIndex : Nodes[NodeIndex].Children)
+			{
+				if (Nodes[ChildIndex].Action == Action)
+					return ChildIndex;
+			}
+			return INDEX_NONE;
+		}
+
+		int32 AddChild(int32 NodeIndex, const FSimAction& Action, ETeamSide Actor)
+		{
+			const int32 ChildIndex = Nodes.AddDefaulted();
+			Nodes[ChildIndex].Action = Action;
+			Nodes[ChildIndex].Actor = Actor;
+			Nodes[NodeIndex].Children.Add(ChildIndex);
+			return ChildIndex;
+		}
+
+		const FBattleState& Root;
+		const FBattleSearchParams& Params;
+		FBattleRandomStream Random;
+		TArray<FMctsNode> Nodes;
+		FCandidateList Candidates;
+		TArray<int32, TInlineAllocator<32>> Untried;
+		int32 Iterations = 0;
+	};
+}
+
+FBattleSearchResult FBattleMcts::Search(const FBattleState& Root, const FBattleSearchParams& Params)
+{
+	const int32 Unit = Root.GetCurrentUnit();
+	checkf(Unit != FBattleState::NoUnit, TEXT("FBattleMcts::Search: root has no unit mid-turn"));
+
+	FBattleSearchResult Result;
+	FCandidateList RootCandidates;
+	FBattleSimulator::GetCandidateActions(Root, Unit, RootCandidates);
+	if (RootCandidates.Num() == 1)
+	{
+		Result.Action = RootCandidates[0];
+		return Result;
+	}
+
+	const int32 NumWorkers = Params.NumWorkers > 0
+		? Params.NumWorkers
+		: FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	const int32 IterationsPerWorker = FMath::DivideAndRoundUp(FMath::Max(1, Params.MaxIterations), NumWorkers);
+	const double Deadline = FPlatformTime::Seconds() + Params.TimeBudgetSeconds;
+
+	TArray<TUniquePtr<FMctsTree>> Trees;
+	FBattleRandomStream Seeder(Params.Seed);
+	for (int32 i = 0; i < NumWorkers; ++i)
+	{
+		Trees.Add(MakeUnique<FMctsTree>(Root, Params, Seeder.Fork()));
+	}
+	ParallelFor(NumWorkers, [&](int32 Worker)
+	{
+		Trees[Worker]->Grow(IterationsPerWorker, Deadline);
+	});
+
+	TArray<FRootStat> Stats;
+	for (const TUniquePtr<FMctsTree>& Tree : Trees)
+	{
+		Tree->CollectRootStats(Stats);
+		Result.Iterations += Tree->GetIterations();
+	}
+
+	// Falls back to the default policy if the budget ran out before a single iteration
+	Result.Action = FBattleSimulator::ChooseDefaultAction(Root, Unit);
+	int32 BestVisits = 0;
+	for (const FRootStat& Stat : Stats)
+	{
+		if (Stat.Visits > BestVisits)
+		{
+			BestVisits = Stat.Visits;
+			Result.Action = Stat.Action;
+			Result.ExpectedScore = Stat.Score / Stat.Visits;
+		}
+	}
+	return Result;
+}
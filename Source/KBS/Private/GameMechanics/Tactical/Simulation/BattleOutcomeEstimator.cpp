@@ -0,0 +1,190 @@
+#include "GameMechanics/Tactical/Simulation/BattleOutcomeEstimator.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	// Runs per ParallelFor task; small enough to balance uneven battle lengths across workers
+	constexpr int32 RunsPerChunk = 64;
+
+	struct FRunningStat
+	{
+		double Sum = 0.0;
+		double SumSq = 0.0;
+		int32 Count = 0;
+
+		void Add(double Value)
+		{
+			Sum += Value;
+			SumSq += Value * Value;
+			++Count;
+		}
+
+		void Merge(const FRunningStat& Other)
+		{
+			Sum += Other.Sum;
+			SumSq += Other.SumSq;
+			Count += Other.Count;
+		}
+
+		FSimEstimate ToEstimate(double Z) const
+		{
+			FSimEstimate Result;
+			if (Count == 0)
+				return Result;
+			Result.Mean = Sum / Count;
+			const double Variance = Count > 1 ? FMath::Max(0.0, (SumSq - Sum * Result.Mean) / (Count - 1)) : 0.0;
+			const double HalfWidth = Z * FMath::Sqrt(Variance / Count);
+			Result.Low = Result.Mean - HalfWidth;
+			Result.High = Result.Mean + HalfWidth;
+			return Result;
+		}
+	};
+
+	// Every stat is an integer sum, so merging chunks in any order gives bit-identical totals
+	struct FChunkTotals
+	{
+		int32 Wins[2] = { 0, 0 };
+		int32 Unresolved = 0;
+		FRunningStat Turns;
+		TArray<FRunningStat> Dealt;
+		TArray<FRunningStat> Taken;
+		TArray<int32> Survived;
+
+		void Init(int32 NumUnits)
+		{
+			Dealt.SetNum(NumUnits);
+			Taken.SetNum(NumUnits);
+			Survived.SetNumZeroed(NumUnits);
+		}
+
+		void Merge(const FChunkTotals& Other)
+		{
+			Wins[0] += Other.Wins[0];
+			Wins[1] += Other.Wins[1];
+			Unresolved += Other.Unresolved;
+			Turns.Merge(Other.Turns);
+			for (int32 i = 0; i < Dealt.Num(); ++i)
+			{
+				Dealt[i].Merge(Other.Dealt[i]);
+				Taken[i].Merge(Other.Taken[i]);
+				Survived[i] += Other.Survived[i];
+			}
+		}
+	};
+
+	FSimEstimate WilsonInterval(int32 Successes, int32 Trials, double Z)
+	{
+		FSimEstimate Result;
+		if (Trials == 0)
+			return Result;
+		const double P = static_cast<double>(Successes) / Trials;
+		const double Z2 = Z * Z;
+		const double Denominator = 1.0 + Z2 / Trials;
+		const double Center = (P + Z2 / (2.0 * Trials)) / Denominator;
+		const double HalfWidth = Z * FMath::Sqrt(P * (1.0 - P) / Trials + Z2 / (4.0 * Trials * Trials)) / Denominator;
+		Result.Mean = P;
+		Result.Low = FMath::Max(0.0, Center - HalfWidth);
+		Result.High = FMath::Min(1.0, Center + HalfWidth);
+		return Result;
+	}
+}
+
+FBattleEstimate FBattleOutcomeEstimator::Estimate(const FBattleState& Initial, const FBattleEstimateParams& Params)
+{
+	checkf(Params.Runs > 0, TEXT("FBattleOutcomeEstimator: Runs must be positive"));
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 NumUnits = Initial.GetUnits().Num();
+
+	// Seeds are drawn up front so a run's stream depends only on its index, not on scheduling
+	TArray<int32> Seeds;
+	Seeds.SetNumUninitialized(Params.Runs);
+	FBattleRandomStream Root(Params.Seed);
+	for (int32& Seed : Seeds)
+	{
+		Seed = Root.Fork().GetSeed();
+	}
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Params.Runs, RunsPerChunk);
+	TArray<FChunkTotals> Chunks;
+	Chunks.SetNum(NumChunks);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		FChunkTotals& Totals = Chunks[ChunkIndex];
+		Totals.Init(NumUnits);
+		const int32 First = ChunkIndex * RunsPerChunk;
+		const int32 Last = FMath::Min(First + RunsPerChunk, Params.Runs);
+		for (int32 Run = First; Run < Last; ++Run)
+		{
+			FBattleState State = Initial;
+			State.GetRandomStream().Seed(Seeds[Run]);
+			const FBattleSimResult Result = FBattleSimulator::Run(State, Params.MaxRounds);
+			if (Result.bHasWinner)
+			{
+				++Totals.Wins[static_cast<int32>(Result.Winner)];
+				Totals.Turns.Add(Result.Turns);
+			}
+			else
+			{
+				++Totals.Unresolved;
+			}
+			for (int32 i = 0; i < NumUnits; ++i)
+			{
+				const FSimUnit& Unit = State.GetUnit(i);
+				Totals.Dealt[i].Add(Unit.DamageDealt);
+				Totals.Taken[i].Add(Unit.DamageTaken);
+				if (Unit.IsAlive())
+					++Totals.Survived[i];
+			}
+		}
+	});
+
+	FChunkTotals Totals;
+	Totals.Init(NumUnits);
+	for (const FChunkTotals& Chunk : Chunks)
+	{
+		Totals.Merge(Chunk);
+	}
+
+	FBattleEstimate Estimate;
+	Estimate.Runs = Params.Runs;
+	Estimate.Seed = Params.Seed;
+	Estimate.Wins[0] = Totals.Wins[0];
+	Estimate.Wins[1] = Totals.Wins[1];
+	Estimate.Unresolved = Totals.Unresolved;
+	Estimate.WinRate[0] = WilsonInterval(Totals.Wins[0], Params.Runs, Params.ZScore);
+	Estimate.WinRate[1] = WilsonInterval(Totals.Wins[1], Params.Runs, Params.ZScore);
+	Estimate.TurnsToFinish = Totals.Turns.ToEstimate(Params.ZScore);
+	Estimate.Units.SetNum(NumUnits);
+	for (int32 i = 0; i < NumUnits; ++i)
+	{
+		const FSimUnit& Unit = Initial.GetUnit(i);
+		FSimUnitEstimate& UnitEstimate = Estimate.Units[i];
+		UnitEstimate.Name = Unit.Template->Name;
+		UnitEstimate.Team = Unit.Team;
+		UnitEstimate.StartCell = Unit.Coords;
+		UnitEstimate.DamageDealt = Totals.Dealt[i].ToEstimate(Params.ZScore);
+		UnitEstimate.DamageTaken = Totals.Taken[i].ToEstimate(Params.ZScore);
+		UnitEstimate.SurvivalRate = static_cast<double>(Totals.Survived[i]) / Params.Runs;
+	}
+	Estimate.WallSeconds = FPlatformTime::Seconds() - StartTime;
+	return Estimate;
+}
+
+void FBattleOutcomeEstimator::LogEstimate(const FBattleEstimate& Estimate)
+{
+	UE_LOG(LogKBSSim, Display, TEXT("%d runs (seed %d) in %.2fs"), Estimate.Runs, Estimate.Seed, Estimate.WallSeconds);
+	const FSimEstimate& Attacker = Estimate.GetWinRate(ETeamSide::Attacker);
+	const FSimEstimate& Defender = Estimate.GetWinRate(ETeamSide::Defender);
+	UE_LOG(LogKBSSim, Display, TEXT("Attacker wins %.1f%% [%.1f, %.1f]"), Attacker.Mean * 100.0, Attacker.Low * 100.0, Attacker.High * 100.0);
+	UE_LOG(LogKBSSim, Display, TEXT("Defender wins %.1f%% [%.1f, %.1f]"), Defender.Mean * 100.0, Defender.Low * 100.0, Defender.High * 100.0);
+	UE_LOG(LogKBSSim, Display, TEXT("Unresolved %d, turns to finish %.1f [%.1f, %.1f]"), Estimate.Unresolved,
+	       Estimate.TurnsToFinish.Mean, Estimate.TurnsToFinish.Low, Estimate.TurnsToFinish.High);
+	for (const FSimUnitEstimate& Unit : Estimate.Units)
+	{
+		UE_LOG(LogKBSSim, Display, TEXT("  %s %s [%d,%d]: dealt %.1f [%.1f, %.1f], taken %.1f [%.1f, %.1f], survives %.1f%%"),
+		       Unit.Team == ETeamSide::Attacker ? TEXT("ATK") : TEXT("DEF"), *Unit.Name, Unit.StartCell.Row, Unit.StartCell.Col,
+		       Unit.DamageDealt.Mean, Unit.DamageDealt.Low, Unit.DamageDealt.High,
+		       Unit.DamageTaken.Mean, Unit.DamageTaken.Low, Unit.DamageTaken.High,
+		       Unit.SurvivalRate * 100.0);
+	}
+}
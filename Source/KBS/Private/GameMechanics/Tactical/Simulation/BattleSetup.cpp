@@ -0,0 +1,148 @@
+#include "GameMechanics/Tactical/Simulation/BattleSetup.h"
+#include "GameMechanics/Tactical/Grid/Editor/TacGridEditorInitializer.h"
+#include "GameMechanics/Units/Unit.h"
+#include "GameMechanics/Units/UnitDefinition.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffectComponent.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacGridSubsystem.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacTurnSubsystem.h"
+#include "GameMechanics/Tactical/Grid/Components/GridDataManager.h"
+
+bool FBattleSetup::AddPlacement(const FUnitPlacement& Placement)
+{
+	const UUnitDefinition* Definition = Placement.Definition;
+	if (!Definition && Placement.UnitClass)
+		Definition = GetDefault<AUnit>(Placement.UnitClass)->GetUnitDefinition();
+	if (!Definition)
+	{
+		UE_LOG(LogKBSSim, Warning, TEXT("FBattleSetup: placement at [%d,%d] has no unit definition"), Placement.Row, Placement.Col);
+		return false;
+	}
+	if (!FTacCoordinates::IsValidCell(Placement.Row, Placement.Col))
+	{
+		UE_LOG(LogKBSSim, Warning, TEXT("FBattleSetup: invalid cell [%d,%d] for %s"), Placement.Row, Placement.Col, *Definition->UnitName);
+		return false;
+	}
+	const FTacCoordinates Coords(Placement.Row, Placement.Col, Placement.Layer);
+	if (Initial.GetUnitAt(Coords) != FBattleState::NoUnit)
+	{
+		UE_LOG(LogKBSSim, Warning, TEXT("FBattleSetup: cell [%d,%d] is already taken, %s skipped"), Placement.Row, Placement.Col, *Definition->UnitName);
+		return false;
+	}
+	const FSimUnitTemplate* Template = FindOrAddTemplate(*Definition);
+	if (!Template)
+	{
+		UE_LOG(LogKBSSim, Warning, TEXT("FBattleSetup: %s at [%d,%d] cannot be simulated"), *Definition->UnitName, Placement.Row, Placement.Col);
+		return false;
+	}
+	Initial.AddUnit(*Template, Placement.bIsAttacker ? ETeamSide::Attacker : ETeamSide::Defender, Coords);
+	return true;
+}
+
+int32 FBattleSetup::AddPlacements(TConstArrayView<FUnitPlacement> Placements)
+{
+	int32 Added = 0;
+	for (const FUnitPlacement& Placement : Placements)
+	{
+		if (AddPlacement(Placement))
+			++Added;
+	}
+	return Added;
+}
+
+bool FBattleSetup::CaptureLive(const UTacGridSubsystem& GridSubsystem, const UTacTurnSubsystem& TurnSubsystem)
+{
+	checkf(GetNumUnits() == 0, TEXT("FBattleSetup::CaptureLive: setup already has units"));
+	const AUnit* CurrentUnit = TurnSubsystem.GetCurrentUnit();
+	if (!CurrentUnit)
+		return false;
+
+	TMap<const AUnit*, int32> UnitIndices;
+	for (const ETeamSide Side : { ETeamSide::Attacker, ETeamSide::Defender })
+	{
+		for (const TObjectPtr<AUnit>& Unit : GridSubsystem.GetUnitRoster(EUnitQuerySource::OnField, Side))
+		{
+			if (!Unit || Unit->GetStats().Status.IsDead())
+				continue;
+			const UUnitDefinition* Definition = Unit->GetUnitDefinition();
+			FTacCoordinates Coords;
+			if (!Definition || !GridSubsystem.GetUnitCoordinates(Unit.Get(), Coords))
+			{
+				UE_LOG(LogKBSSim, Warning, TEXT("FBattleSetup: %s has no definition or cell, snapshot refused"), *Unit->GetLogName());
+				return false;
+			}
+			const FSimUnitTemplate* Template = FindOrAddTemplate(*Definition);
+			if (!Template)
+			{
+				UE_LOG(LogKBSSim, Warning, TEXT("FBattleSetup: %s cannot be simulated, snapshot refused"), *Unit->GetLogName());
+				return false;
+			}
+			// The copied stats already carry the stat modifiers of these effects
+			TArray<FSimActiveEffect, TInlineAllocator<2>> UnitEffects;
+			if (Unit->EffectManager)
+			{
+				for (const FActiveBattleEffect& Active : Unit->EffectManager->GetActiveEffects())
+				{
+					const FSimEffect* Effect = FindOrAddEffect(*Active.Effect);
+					if (!Effect)
+					{
+						UE_LOG(LogKBSSim, Warning, TEXT("FBattleSetup: %s carries %s, which cannot be simulated; snapshot refused"),
+						       *Unit->GetLogName(), *Active.Effect->GetClass()->GetName());
+						return false;
+					}
+					UnitEffects.Add({ Effect, Active.Duration, Active.EffectId, Active.StatModifiers });
+				}
+			}
+			const FRolledInitiative* Rolled = TurnSubsystem.FindUnitRolledInitiative(Unit.Get());
+			const FRolledInitiative Initiative = Rolled ? *Rolled : FRolledInitiative(Unit->GetStats().Initiative.GetValue());
+			UnitIndices.Add(Unit.Get(), Initial.AddUnit(*Template, Side, Coords, Unit->GetStats(), Initiative, UnitEffects));
+		}
+	}
+
+	const int32* CurrentIndex = UnitIndices.Find(CurrentUnit);
+	if (!CurrentIndex)
+		return false;
+	TArray<int32> Remaining;
+	for (const AUnit* Unit : TurnSubsystem.GetRemainingUnits())
+	{
+		if (const int32* Index = UnitIndices.Find(Unit))
+			Remaining.Add(*Index);
+	}
+	Initial.SetTurn(TurnSubsystem.GetCurrentRound(), *CurrentIndex, Remaining);
+	return true;
+}
+
+bool FBattleSetup::CaptureLiveNextTurn(const UTacGridSubsystem& GridSubsystem, const UTacTurnSubsystem& TurnSubsystem)
+{
+	if (!CaptureLive(GridSubsystem, TurnSubsystem) || Initial.IsRoundOver())
+		return false;
+	Initial.EndTurn();
+	return Initial.BeginTurn() != FBattleState::NoUnit;
+}
+
+const FSimUnitTemplate* FBattleSetup::FindOrAddTemplate(const UUnitDefinition& Definition)
+{
+	if (const int32* Index = TemplateLookup.Find(&Definition))
+		return *Index != INDEX_NONE ? Templates[*Index].Get() : nullptr;
+	TUniquePtr<FSimUnitTemplate> Template = MakeUnique<FSimUnitTemplate>();
+	if (!FSimUnitTemplate::FromDefinition(Definition, *Template))
+	{
+		TemplateLookup.Add(&Definition, INDEX_NONE);
+		return nullptr;
+	}
+	TemplateLookup.Add(&Definition, Templates.Num());
+	return Templates.Add_GetRef(MoveTemp(Template)).Get();
+}
+
+const FSimEffect* FBattleSetup::FindOrAddEffect(const UBattleEffect& Effect)
+{
+	if (const int32* Index = EffectLookup.Find(&Effect))
+		return *Index != INDEX_NONE ? Effects[*Index].Get() : nullptr;
+	TUniquePtr<FSimEffect> SimEffect = MakeUnique<FSimEffect>();
+	if (!FSimEffect::FromConfig(Effect.GetClass(), Effect.GetConfig(), *SimEffect))
+	{
+		EffectLookup.Add(&Effect, INDEX_NONE);
+		return nullptr;
+	}
+	EffectLookup.Add(&Effect, Effects.Num());
+	return Effects.Add_GetRef(MoveTemp(SimEffect)).Get();
+}
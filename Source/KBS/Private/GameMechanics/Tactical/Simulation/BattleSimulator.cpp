@@ -0,0 +1,122 @@
+#include "GameMechanics/Tactical/Simulation/BattleSimulator.h"
+#include "GameMechanics/Tactical/Grid/BattleTeam.h"
+
+FSimAction FBattleSimulator::ChooseDefaultAction(const FBattleState& State, int32 UnitIndex)
+{
+	if (const uint64 AttackCells = State.GetAttackCells(UnitIndex))
+		return FSimAction::Attack(GridBitboard::CellFromBit(static_cast<int32>(FMath::CountTrailingZeros64(AttackCells))));
+
+	if (const uint64 MoveCells = State.GetMoveCells(UnitIndex))
+	{
+		const ETeamSide EnemySide = UBattleTeam::ReverseTeamSide(State.GetUnit(UnitIndex).Team);
+		const uint64 EnemyCells = State.GetTeamMask(EnemySide);
+		FTacCoordinates BestCell = GridBitboard::CellFromBit(static_cast<int32>(FMath::CountTrailingZeros64(MoveCells)));
+		int32 BestDist = MAX_int32;
+		GridBitboard::ForEachCell(MoveCells, [&](const FTacCoordinates& MoveCell)
+		{
+			GridBitboard::ForEachCell(EnemyCells, [&](const FTacCoordinates& EnemyCell)
+			{
+				const int32 Dist = FMath::Abs(MoveCell.Row - EnemyCell.Row) + FMath::Abs(MoveCell.Col - EnemyCell.Col);
+				if (Dist < BestDist)
+				{
+					BestDist = Dist;
+					BestCell = MoveCell;
+				}
+			});
+		});
+		return FSimAction::Move(BestCell);
+	}
+
+	if (State.CanWait(UnitIndex))
+		return FSimAction::Wait();
+	return FSimAction::Skip();
+}
+
+void FBattleSimulator::GetCandidateActions(const FBattleState& State, int32 UnitIndex,
+                                           TArray<FSimAction, TInlineAllocator<32>>& OutActions)
+{
+	OutActions.Reset();
+	GridBitboard::ForEachCell(State.GetAttackCells(UnitIndex), [&OutActions](const FTacCoordinates& Cell)
+	{
+		OutActions.Add(FSimAction::Attack(Cell));
+	});
+	GridBitboard::ForEachCell(State.GetMoveCells(UnitIndex), [&OutActions](const FTacCoordinates& Cell)
+	{
+		OutActions.Add(FSimAction::Move(Cell));
+	});
+	if (State.CanWait(UnitIndex))
+		OutActions.Add(FSimAction::Wait());
+	if (OutActions.IsEmpty())
+		OutActions.Add(FSimAction::Skip());
+}
+
+int32 FBattleSimulator::AdvanceToDecision(FBattleState& State, int32 MaxRounds)
+{
+	while (!State.IsBattleOver())
+	{
+		if (State.IsRoundOver())
+		{
+			if (State.GetRound() >= MaxRounds)
+				break;
+			State.BeginRound();
+		}
+		const int32 Unit = State.BeginTurn();
+		if (Unit == FBattleState::NoUnit)
+			continue;
+		if (State.CanAct(Unit))
+			return Unit;
+		State.EndTurn();
+	}
+	return FBattleState::NoUnit;
+}
+
+void FBattleSimulator::StepTurn(FBattleState& State)
+{
+	if (State.IsRoundOver())
+		State.BeginRound();
+	const int32 Unit = State.BeginTurn();
+	if (Unit == FBattleState::NoUnit)
+		return;
+	if (State.CanAct(Unit))
+	{
+		verifyf(State.Apply(ChooseDefaultAction(State, Unit)),
+		        TEXT("FBattleSimulator: default policy picked an illegal action"));
+	}
+	State.EndTurn();
+}
+
+double FBattleSimulator::EvaluatePosition(const FBattleState& State)
+{
+	ETeamSide Winner;
+	if (State.GetWinner(Winner))
+		return Winner == ETeamSide::Attacker ? 1.0 : 0.0;
+
+	int32 Current[2] = { 0, 0 };
+	int32 Maximum[2] = { 0, 0 };
+	for (const FSimUnit& Unit : State.GetUnits())
+	{
+		const int32 Side = static_cast<int32>(Unit.Team);
+		Maximum[Side] += Unit.Stats.Health.GetMaximum();
+		if (Unit.IsAlive())
+			Current[Side] += Unit.Stats.Health.GetCurrent();
+	}
+	const double AttackerShare = Maximum[0] > 0 ? static_cast<double>(Current[0]) / Maximum[0] : 0.0;
+	const double DefenderShare = Maximum[1] > 0 ? static_cast<double>(Current[1]) / Maximum[1] : 0.0;
+	return 0.5 + 0.5 * (AttackerShare - DefenderShare);
+}
+
+FBattleSimResult FBattleSimulator::Run(FBattleState& State, int32 MaxRounds)
+{
+	FBattleSimResult Result;
+	while (!State.IsBattleOver())
+	{
+		if (State.IsRoundOver() && State.GetRound() >= MaxRounds)
+			break;
+		StepTurn(State);
+	}
+	Result.bFinished = State.IsBattleOver();
+	Result.bHasWinner = State.GetWinner(Result.Winner);
+	Result.Rounds = State.GetRound();
+	Result.Turns = State.GetTurnsTaken();
+	return Result;
+}
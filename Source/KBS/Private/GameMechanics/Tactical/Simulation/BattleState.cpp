@@ -0,0 +1,855 @@
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+#include "Algo/Count.h"
+#include "GameMechanics/Tactical/DamageCalculation.h"
+#include "GameMechanics/Tactical/Grid/BattleTeam.h"
+#include "GameMechanics/Units/UnitDefinition.h"
+#include "GameMechanics/Units/Combat/WeaponDataAsset.h"
+#include "GameMechanics/Units/Combat/CombatDescriptorDataAsset.h"
+#include "GameMechanics/Units/Abilities/UnitAbilityDefinition.h"
+#include "GameMechanics/Units/Abilities/Defaults/MovementAbilityDefinition.h"
+#include "GameMechanics/Units/BattleEffects/TargetDOTBattleEffect.h"
+#include "GameMechanics/Units/BattleEffects/StatModBattleEffect.h"
+#include "GameplayTypes/GridCellTables.h"
+#include "GameplayTypes/FlankCellDefinitions.h"
+#include "GameplayTypes/BattleZobrist.h"
+
+DEFINE_LOG_CATEGORY(LogKBSSim);
+
+namespace
+{
+	// UTargetDOTBattleEffect::HandleReapply and UStatModBattleEffect::HandleReapply
+	EReapplyDecision GetReapplyDecision(const FSimEffect& Old, const FSimEffect& Incoming)
+	{
+		if (Old.Kind == ESimEffectKind::StatMod)
+			return EReapplyDecision::New;
+		if (Incoming.Kind != ESimEffectKind::DamageOverTime)
+			return EReapplyDecision::DoNothing;
+		return Incoming.Magnitude > Old.Magnitude ? EReapplyDecision::New : EReapplyDecision::OverrideDuration;
+	}
+
+	// UStatModBattleEffect::ApplyStatModifications
+	void ApplyStatModifiers(FUnitCoreStats& Stats, FSimActiveEffect& Active)
+	{
+		const FSimEffect& Effect = *Active.Effect;
+		Active.StatModifiers = FAppliedStatModifiers();
+		if (Effect.MaxHealthModifier != 0)
+			Active.StatModifiers.MaxHealth = Stats.Health.AddMaxModifier(Effect.MaxHealthModifier, true);
+		if (Effect.InitiativeModifier != 0)
+			Active.StatModifiers.Initiative = Stats.Initiative.AddFlatModifier(Effect.InitiativeModifier);
+		if (Effect.AccuracyModifier != 0)
+			Active.StatModifiers.Accuracy = Stats.Accuracy.AddFlatModifier(Effect.AccuracyModifier);
+		for (const EDamageSource Immunity : Effect.ImmunitiesToGrant)
+			Stats.Defense.Immunities.AddModifier(Active.EffectId, Immunity, true);
+		for (const TPair<EDamageSource, int32>& Armour : Effect.ArmourModifiers)
+			Stats.Defense.Armour.AddFlatModifier(Active.EffectId, Armour.Value, Armour.Key);
+	}
+
+	// UStatModBattleEffect::RemoveStatModifications
+	void RemoveStatModifiers(FUnitCoreStats& Stats, const FSimActiveEffect& Active)
+	{
+		const FSimEffect& Effect = *Active.Effect;
+		Stats.Health.RemoveMaxModifier(Active.StatModifiers.MaxHealth);
+		Stats.Initiative.RemoveModifier(Active.StatModifiers.Initiative);
+		Stats.Accuracy.RemoveModifier(Active.StatModifiers.Accuracy);
+		for (const EDamageSource Immunity : Effect.ImmunitiesToGrant)
+			Stats.Defense.Immunities.RemoveModifier(Active.EffectId, Immunity, true);
+		for (const TPair<EDamageSource, int32>& Armour : Effect.ArmourModifiers)
+			Stats.Defense.Armour.RemoveFlatModifier(Active.EffectId, Armour.Value, Armour.Key);
+	}
+}
+
+bool FSimEffect::FromConfig(TSubclassOf<UBattleEffect> EffectClass, const UBattleEffectDataAsset* Config, FSimEffect& OutEffect)
+{
+	// Exact classes only: a subclass may override any hook
+	FSimEffect Effect;
+	if (EffectClass.Get() == UTargetDOTBattleEffect::StaticClass())
+	{
+		const UDOTBattleEffectDataAsset* DOTConfig = Cast<UDOTBattleEffectDataAsset>(Config);
+		if (!DOTConfig)
+			return false;
+		Effect.Kind = ESimEffectKind::DamageOverTime;
+		Effect.Duration = DOTConfig->Duration;
+		Effect.Magnitude = DOTConfig->EffectMagnitude;
+	}
+	else if (EffectClass.Get() == UStatModBattleEffect::StaticClass())
+	{
+		const UStatModBattleEffectDataAsset* StatModConfig = Cast<UStatModBattleEffectDataAsset>(Config);
+		if (!StatModConfig)
+			return false;
+		Effect.Kind = ESimEffectKind::StatMod;
+		Effect.Duration = StatModConfig->Duration;
+		Effect.MaxHealthModifier = StatModConfig->MaxHealthModifier;
+		Effect.InitiativeModifier = StatModConfig->InitiativeModifier;
+		Effect.AccuracyModifier = StatModConfig->AccuracyModifier;
+		Effect.ImmunitiesToGrant = StatModConfig->ImmunitiesToGrant.Array();
+		for (const TPair<EDamageSource, int32>& Armour : StatModConfig->ArmourModifiers)
+		{
+			if (Armour.Value != 0)
+				Effect.ArmourModifiers.Add(Armour);
+		}
+	}
+	else
+	{
+		return false;
+	}
+	Effect.ConfigKey = GetTypeHash(Config);
+	Effect.DamageSource = Config->DamageSource;
+	Effect.bRequiresRoll = Config->bIsAccuracyDependent;
+	Effect.StackingId = Config->StackingId;
+	Effect.StackPolicy = Config->StackPolicy;
+	Effect.MaxStacks = Config->MaxStacks;
+	OutEffect = MoveTemp(Effect);
+	return true;
+}
+
+bool FSimWeapon::FromAsset(const UWeaponDataAsset& Asset, FSimWeapon& OutWeapon)
+{
+	checkf(Asset.Descriptor, TEXT("FSimWeapon::FromAsset: %s has no Descriptor"), *Asset.GetName());
+	const UCombatDescriptorDataAsset& Descriptor = *Asset.Descriptor;
+	FSimWeapon Weapon;
+	Weapon.Stats = Descriptor.BaseStats;
+	Weapon.Stats.AreaShape.Compile();
+	if (Asset.DamageOverride != NoWeaponDamageOverride)
+		Weapon.Stats.BaseMagnitude.SetBase(Asset.DamageOverride);
+	Weapon.MagnitudePolicy = Descriptor.MagnitudePolicy;
+	Weapon.SideEffects = Descriptor.SideEffects;
+	Weapon.bRequiresAccuracyRoll = Descriptor.bGuaranteedHit;
+	Weapon.bUsableForAutoAttack = Asset.Designation != ECombatDescriptorDesignation::Spells;
+	for (const FDescriptorEffectConfig& EffectConfig : Descriptor.Effects)
+	{
+		// Incomplete entries are skipped, as UCombatDescriptor::Initialize does
+		if (!EffectConfig.EffectClass || !EffectConfig.EffectConfig)
+			continue;
+		if (!FSimEffect::FromConfig(EffectConfig.EffectClass, EffectConfig.EffectConfig, Weapon.Effects.AddDefaulted_GetRef()))
+		{
+			UE_LOG(LogKBSSim, Warning, TEXT("FSimWeapon: %s applies %s (%s), which the simulation cannot replay"),
+			       *Asset.GetName(), *EffectConfig.EffectClass->GetName(), *EffectConfig.EffectConfig->GetName());
+			return false;
+		}
+	}
+	OutWeapon = MoveTemp(Weapon);
+	return true;
+}
+
+bool FSimUnitTemplate::FromDefinition(const UUnitDefinition& Definition, FSimUnitTemplate& OutTemplate)
+{
+	if (Definition.UnitSize > 1)
+	{
+		UE_LOG(LogKBSSim, Warning, TEXT("FSimUnitTemplate: %s is multi-cell, which the simulation cannot replay"),
+		       *Definition.UnitName);
+		return false;
+	}
+	if (Definition.AdditionalAbilities.Num() > 0 || Definition.SpellbookAbilities.Num() > 0)
+	{
+		UE_LOG(LogKBSSim, Warning, TEXT("FSimUnitTemplate: %s has passives or spells, which the simulation cannot replay"),
+		       *Definition.UnitName);
+		return false;
+	}
+
+	FSimUnitTemplate Template;
+	Template.Name = Definition.UnitName;
+	Template.BaseStats = Definition.BaseStatsTemplate;
+	Template.FlankEntranceArrivalDelay = Definition.FlankEntranceArrivalDelay;
+	Template.FlankRearArrivalDelay = Definition.FlankRearArrivalDelay;
+	for (const TObjectPtr<UWeaponDataAsset>& WeaponAsset : Definition.DefaultWeapons)
+	{
+		if (!WeaponAsset || !WeaponAsset->Descriptor)
+			continue;
+		if (!FSimWeapon::FromAsset(*WeaponAsset, Template.Weapons.AddDefaulted_GetRef()))
+		{
+			UE_LOG(LogKBSSim, Warning, TEXT("FSimUnitTemplate: %s refused for its weapon %s"),
+			       *Definition.UnitName, *WeaponAsset->GetName());
+			return false;
+		}
+	}
+
+	if (const UUnitAbilityDefinition* Attack = Definition.DefaultAttackAbility)
+	{
+		if (Attack->Targeting != ETargetReach::None)
+			Template.AttackTargeting = FTargetingDescriptor::FromReach(Attack->Targeting);
+		else if (const FSimWeapon* Weapon = Template.SelectMaxReachWeapon(true))
+			Template.AttackTargeting = FTargetingDescriptor::FromReach(Weapon->Stats.TargetReach);
+	}
+	if (const UMovementAbilityDefinition* Move = Cast<UMovementAbilityDefinition>(Definition.DefaultMoveAbility))
+	{
+		Template.bHasMove = true;
+		Template.GroundMoveTargeting = Move->GroundTargeting;
+		Template.AirMoveTargeting = Move->AirTargeting;
+		if (Template.GroundMoveTargeting.MovementPattern == EMovementPattern::Linear ||
+			Template.AirMoveTargeting.MovementPattern == EMovementPattern::Linear)
+		{
+			UE_LOG(LogKBSSim, Warning, TEXT("FSimUnitTemplate: %s moves linearly, which the simulation cannot replay"),
+			       *Definition.UnitName);
+			return false;
+		}
+	}
+	Template.bHasWait = Definition.DefaultWaitAbility != nullptr;
+	OutTemplate = MoveTemp(Template);
+	return true;
+}
+
+const FSimWeapon* FSimUnitTemplate::SelectMaxReachWeapon(bool bAutoAttackOnly) const
+{
+	if (Weapons.Num() == 0)
+		return nullptr;
+	if (Weapons.Num() == 1)
+		return &Weapons[0];
+	const FSimWeapon* BestWeapon = nullptr;
+	int32 BestScore = -1;
+	for (const FSimWeapon& Weapon : Weapons)
+	{
+		if (bAutoAttackOnly && !Weapon.bUsableForAutoAttack) continue;
+		const int32 Score = FDamageCalculation::GetReachScore(Weapon.Stats.TargetReach);
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestWeapon = &Weapon;
+		}
+	}
+	return BestWeapon;
+}
+
+FBattleState::FBattleState()
+	: FBattleState(0)
+{
+}
+
+FBattleState::FBattleState(int32 Seed)
+	: Random(Seed)
+{
+	FMemory::Memset(Occupants, NoUnit, sizeof(Occupants));
+}
+
+int32 FBattleState::AddUnit(const FSimUnitTemplate& Template, ETeamSide Team, const FTacCoordinates& Coords)
+{
+	checkf(Coords.IsValidCell(), TEXT("FBattleState::AddUnit: invalid cell [%d,%d]"), Coords.Row, Coords.Col);
+	checkf(GetUnitAt(Coords) == NoUnit, TEXT("FBattleState::AddUnit: cell [%d,%d] is occupied"), Coords.Row, Coords.Col);
+	checkf(Units.Num() < TNumericLimits<int8>::Max(), TEXT("FBattleState::AddUnit: too many units"));
+
+	const int32 Index = Units.AddDefaulted();
+	FSimUnit& Unit = Units[Index];
+	Unit.Template = &Template;
+	Unit.Stats.InitFromBase(Template.BaseStats);
+	Unit.Team = Team;
+	PlaceUnit(Index, Coords);
+	RehashUnit(Index);
+	++AliveCount[static_cast<int32>(Team)];
+	return Index;
+}
+
+int32 FBattleState::AddUnit(const FSimUnitTemplate& Template, ETeamSide Team, const FTacCoordinates& Coords,
+                           const FUnitCoreStats& Stats, const FRolledInitiative& Initiative,
+                           TConstArrayView<FSimActiveEffect> Effects)
+{
+	const int32 Index = AddUnit(Template, Team, Coords);
+	Units[Index].Stats = Stats;
+	Units[Index].Initiative = Initiative;
+	Units[Index].Effects.Append(Effects.GetData(), Effects.Num());
+	RehashUnit(Index);
+	return Index;
+}
+
+bool FBattleState::AddEffect(int32 UnitIndex, const FSimEffect& Effect)
+{
+	FSimUnit& Unit = Units[UnitIndex];
+	const int32 Existing = Effect.StackingId.IsNone() ? INDEX_NONE : Unit.Effects.IndexOfByPredicate(
+		[&Effect](const FSimActiveEffect& Active) { return Active.Effect->StackingId == Effect.StackingId; });
+	bool bApplied = false;
+
+	// Same policy switch as UBattleEffectComponent::AddEffect
+	if (Existing == INDEX_NONE)
+	{
+		ApplyEffect(UnitIndex, Effect);
+		bApplied = true;
+	}
+	else
+	{
+		switch (Effect.StackPolicy)
+		{
+		case EEffectStackPolicy::Unique:
+			break;
+
+		case EEffectStackPolicy::AlwaysReplaced:
+			RemoveEffectAt(UnitIndex, Existing);
+			ApplyEffect(UnitIndex, Effect);
+			bApplied = true;
+			break;
+
+		case EEffectStackPolicy::RefreshOld:
+			Unit.Effects[Existing].Duration = FMath::Max(Effect.Duration, Unit.Effects[Existing].Duration);
+			break;
+
+		case EEffectStackPolicy::RefreshOrReplace:
+		case EEffectStackPolicy::Custom:
+			switch (GetReapplyDecision(*Unit.Effects[Existing].Effect, Effect))
+			{
+			case EReapplyDecision::New:
+				RemoveEffectAt(UnitIndex, Existing);
+				ApplyEffect(UnitIndex, Effect);
+				bApplied = true;
+				break;
+			case EReapplyDecision::OverrideDuration:
+				Unit.Effects[Existing].Duration = FMath::Max(Effect.Duration, Unit.Effects[Existing].Duration);
+				break;
+			default:
+				break;
+			}
+			break;
+
+		case EEffectStackPolicy::StackInfinite:
+			ApplyEffect(UnitIndex, Effect);
+			bApplied = true;
+			break;
+
+		case EEffectStackPolicy::Stack:
+			if (Algo::CountIf(Unit.Effects, [&Effect](const FSimActiveEffect& Active)
+				{ return Active.Effect->StackingId == Effect.StackingId; }) < Effect.MaxStacks)
+			{
+				ApplyEffect(UnitIndex, Effect);
+				bApplied = true;
+			}
+			break;
+		}
+	}
+	RehashUnit(UnitIndex);
+	return bApplied;
+}
+
+void FBattleState::SetTurn(int32 InRound, int32 Current, TConstArrayView<int32> Remaining)
+{
+	checkf(Units.IsValidIndex(Current), TEXT("FBattleState::SetTurn: invalid current unit %d"), Current);
+	Round = InRound;
+	SetCurrentUnit(static_cast<int8>(Current));
+	Queue.Reset();
+	for (int32 i = Remaining.Num() - 1; i >= 0; --i)
+	{
+		checkf(Units.IsValidIndex(Remaining[i]), TEXT("FBattleState::SetTurn: invalid queued unit %d"), Remaining[i]);
+		Queue.Add(static_cast<int8>(Remaining[i]));
+	}
+	RehashQueue();
+}
+
+void FBattleState::BeginRound()
+{
+	++Round;
+	Queue.Reset();
+	SetCurrentUnit(NoUnit);
+	for (int32 i = 0; i < Units.Num(); ++i)
+	{
+		FSimUnit& Unit = Units[i];
+		if (!Unit.IsAlive()) continue;
+		const bool bHadWaited = !Unit.Initiative.CanWait();
+		Unit.Initiative = FRolledInitiative(Unit.Stats.Initiative.GetValue());
+		Unit.Initiative.MakeRoll(Random);
+		if (bHadWaited)
+			RehashUnit(i);
+		Queue.Add(static_cast<int8>(i));
+	}
+	SortQueue();
+	RehashQueue();
+}
+
+int32 FBattleState::BeginTurn()
+{
+	if (Queue.IsEmpty())
+	{
+		SetCurrentUnit(NoUnit);
+		return NoUnit;
+	}
+	// Popping the back leaves every other slot where it was, so only its key goes
+	const uint64 SlotKey = BattleZobrist::Key(BattleZobrist::EFeature::QueueSlot, Queue.Last(), Queue.Num() - 1);
+	QueueHash ^= SlotKey;
+	Hash ^= SlotKey;
+	SetCurrentUnit(Queue.Pop(EAllowShrinking::No));
+	Units[CurrentUnit].Stats.Status.ClearStatus(EUnitStatus::Defending);
+	RehashUnit(CurrentUnit);
+	++TurnsTaken;
+	return CurrentUnit;
+}
+
+void FBattleState::EndTurn()
+{
+	// AUnit::HandleTurnEnd: flank delay first, then the effects' turn-end hooks
+	if (CurrentUnit != NoUnit && Units[CurrentUnit].IsAlive())
+	{
+		Units[CurrentUnit].Stats.Status.TickFlankDelay();
+		TickEffects(CurrentUnit);
+		RehashUnit(CurrentUnit);
+	}
+	SetCurrentUnit(NoUnit);
+}
+
+bool FBattleState::CanAct(int32 UnitIndex) const
+{
+	const FSimUnit& Unit = Units[UnitIndex];
+	return Unit.IsAlive() && Unit.Stats.Status.CanAct();
+}
+
+uint64 FBattleState::GetAttackCells(int32 UnitIndex) const
+{
+	if (!CanAct(UnitIndex))
+		return 0;
+	const FSimUnit& Unit = Units[UnitIndex];
+	const FTargetingDescriptor& Desc = Unit.Template->AttackTargeting;
+	switch (Desc.Strategy)
+	{
+	case ETargetingStrategy::Closest:
+	{
+		uint64 Mask = GridCellTables::NeighborMask(Unit.Coords, false, true) & GetAffiliationMask(Unit, Desc);
+		const int8 Blocked = GridCellTables::Get(Unit.Coords).EntranceBlockedCell;
+		if (Blocked != GridCellTables::NoCell)
+			Mask &= ~(uint64(1) << Blocked);
+		return Mask;
+	}
+	case ETargetingStrategy::Single:
+	case ETargetingStrategy::All:
+	case ETargetingStrategy::Area:
+		return GetAffiliationMask(Unit, Desc);
+	default:
+		return 0;
+	}
+}
+
+uint64 FBattleState::GetMoveCells(int32 UnitIndex) const
+{
+	const FSimUnit& Unit = Units[UnitIndex];
+	if (!Unit.Template->bHasMove || !Unit.IsAlive() || !Unit.Stats.Status.CanMove())
+		return 0;
+	const FTargetingDescriptor& Desc = Unit.Coords.Layer == ETacGridLayer::Air
+		? Unit.Template->AirMoveTargeting
+		: Unit.Template->GroundMoveTargeting;
+	// Single-cell rules of UTacGridTargetingService::GetSingleCellMoveCells. Air moves may land on
+	// a friendly unit and swap with it, ground moves need an empty cell
+	const ETacGridLayer TargetLayer = Desc.MovementLayer == EMovementLayer::CrossLayer
+		? (Unit.Coords.Layer == ETacGridLayer::Ground ? ETacGridLayer::Air : ETacGridLayer::Ground)
+		: (Desc.MovementLayer == EMovementLayer::Air ? ETacGridLayer::Air : ETacGridLayer::Ground);
+	const uint64 Occupied = GetOccupiedMask();
+	const uint64 Passable = ~GridBitboard::CellMask(Unit.Coords) & (TargetLayer == ETacGridLayer::Air
+		? ~GetTeamMask(UBattleTeam::ReverseTeamSide(Unit.Team))
+		: ~Occupied);
+
+	switch (Desc.MovementPattern)
+	{
+	case EMovementPattern::Orthogonal:
+	{
+		if (TargetLayer != Unit.Coords.Layer)
+		{
+			const FTacCoordinates Projected(Unit.Coords.Row, Unit.Coords.Col, TargetLayer);
+			return (GridCellTables::NeighborMask(Projected, true, true) | GridBitboard::CellMask(Projected)) & Passable;
+		}
+		uint64 Mask = GridCellTables::NeighborMask(Unit.Coords, true, false) & Passable;
+		const int8 Flank = GridCellTables::Get(Unit.Coords).AvailableFlankCell[static_cast<int32>(Unit.Team)];
+		if (Flank != GridCellTables::NoCell && !(Occupied & (uint64(1) << Flank)))
+			Mask |= uint64(1) << Flank;
+		return Mask;
+	}
+	case EMovementPattern::AnyToAny:
+		return GridBitboard::ValidCellsMask & GridBitboard::LayerMask(TargetLayer) & Passable;
+	case EMovementPattern::Linear:
+		// Needs unit orientation, which the simulation does not track; FromDefinition refuses such units
+		return 0;
+	}
+	return 0;
+}
+
+bool FBattleState::CanWait(int32 UnitIndex) const
+{
+	const FSimUnit& Unit = Units[UnitIndex];
+	return Unit.Template->bHasWait && CanAct(UnitIndex) && Unit.Initiative.CanWait();
+}
+
+bool FBattleState::Apply(const FSimAction& Action, ESimRollOutcome Rolls)
+{
+	checkf(CurrentUnit != NoUnit, TEXT("FBattleState::Apply called outside a turn"));
+	switch (Action.Kind)
+	{
+	case ESimActionKind::Attack: return ApplyAttack(Action.Cell, Rolls);
+	case ESimActionKind::Move:   return ApplyMove(Action.Cell);
+	case ESimActionKind::Wait:   return ApplyWait();
+	case ESimActionKind::Skip:   return true;
+	}
+	return false;
+}
+
+bool FBattleState::GetWinner(ETeamSide& OutWinner) const
+{
+	const bool bAttackerAlive = AliveCount[static_cast<int32>(ETeamSide::Attacker)] > 0;
+	const bool bDefenderAlive = AliveCount[static_cast<int32>(ETeamSide::Defender)] > 0;
+	if (bAttackerAlive == bDefenderAlive)
+		return false;
+	OutWinner = bAttackerAlive ? ETeamSide::Attacker : ETeamSide::Defender;
+	return true;
+}
+
+uint64 FBattleState::GetAffiliationMask(const FSimUnit& Source, const FTargetingDescriptor& Desc) const
+{
+	uint64 Mask = 0;
+	switch (Desc.Affiliation)
+	{
+	case ETargetAffiliation::Enemy:
+		Mask = GetTeamMask(UBattleTeam::ReverseTeamSide(Source.Team));
+		break;
+	case ETargetAffiliation::Friendly:
+		Mask = GetTeamMask(Source.Team);
+		break;
+	case ETargetAffiliation::Any:
+		Mask = GetOccupiedMask();
+		break;
+	}
+	if (!Desc.bAllowFlank)
+		Mask &= ~GridBitboard::FlankMask;
+	// Closest targeting skips units still arriving on a flank (TargetingPolicies::FAffiliation::bAllowDelayed)
+	if (Desc.Strategy == ETargetingStrategy::Closest)
+	{
+		GridBitboard::ForEachCell(Mask & GridBitboard::FlankMask, [&](const FTacCoordinates& Cell)
+		{
+			if (Units[GetUnitAt(Cell)].Stats.Status.IsFlankDelayed())
+				Mask &= ~GridBitboard::CellMask(Cell);
+		});
+	}
+	return Mask;
+}
+
+const FSimWeapon* FBattleState::SelectWeaponForTarget(const FSimUnit& Attacker, const FSimUnit& Target) const
+{
+	const int32 Distance = Attacker.Coords.DistanceTo(Target.Coords);
+	const bool bIsFriendly = Attacker.Team == Target.Team;
+	const FSimWeapon* BestWeapon = nullptr;
+	int32 BestDamage = -1;
+	for (const FSimWeapon& Weapon : Attacker.Template->Weapons)
+	{
+		if (!Weapon.bUsableForAutoAttack) continue;
+		if (!FDamageCalculation::CanReachTarget(Weapon.Stats.TargetReach, bIsFriendly, Distance)) continue;
+
+		const int32 Damage = FDamageCalculation::CalculateDamage(Attacker.Stats, Attacker.IsOnFlank(), Weapon.Stats,
+		                                                         Target.Stats).Damage;
+		if (Damage > BestDamage)
+		{
+			BestDamage = Damage;
+			BestWeapon = &Weapon;
+		}
+	}
+	return BestWeapon;
+}
+
+FPreviewHitResult FBattleState::PreviewAttack(const FTacCoordinates& Cell) const
+{
+	if (CurrentUnit == NoUnit || !Cell.IsValidCell() || !(GetAttackCells(CurrentUnit) & GridBitboard::CellMask(Cell)))
+		return FPreviewHitResult();
+	const FSimUnit& Attacker = Units[CurrentUnit];
+	const FSimUnit& Target = Units[GetUnitAt(Cell)];
+	const FSimWeapon* Weapon = SelectWeaponForTarget(Attacker, Target);
+	if (!Weapon)
+		return FPreviewHitResult();
+
+	FPreviewHitResult Preview = FDamageCalculation::PreviewDamage(Attacker.Stats, Attacker.IsOnFlank(), Weapon->Stats, Target.Stats);
+	if (!Weapon->bRequiresAccuracyRoll)
+		Preview.HitProbability = 100.0f;
+	return Preview;
+}
+
+bool FBattleState::ApplyAttack(const FTacCoordinates& Cell, ESimRollOutcome Rolls)
+{
+	const uint64 ValidCells = GetAttackCells(CurrentUnit);
+	if (!Cell.IsValidCell() || !(ValidCells & GridBitboard::CellMask(Cell)))
+		return false;
+	const int32 PrimaryIndex = GetUnitAt(Cell);
+	const FSimWeapon* Weapon = SelectWeaponForTarget(Units[CurrentUnit], Units[PrimaryIndex]);
+	if (!Weapon)
+		return false;
+
+	// Clicked target first, then the rest in cell order, like FResolvedTargets::GetAllTargets
+	uint64 SecondaryCells = 0;
+	switch (Units[CurrentUnit].Template->AttackTargeting.Strategy)
+	{
+	case ETargetingStrategy::All:
+		SecondaryCells = ValidCells;
+		break;
+	case ETargetingStrategy::Area:
+		SecondaryCells = ValidCells & Weapon->Stats.AreaShape.GetMask(Cell);
+		break;
+	default:
+		break;
+	}
+	SecondaryCells &= ~GridBitboard::CellMask(Cell);
+
+	TArray<int8, TInlineAllocator<16>> Targets;
+	Targets.Add(static_cast<int8>(PrimaryIndex));
+	GridBitboard::ForEachCell(SecondaryCells, [&](const FTacCoordinates& TargetCell)
+	{
+		Targets.Add(Occupants[TargetCell.GetCellIndex()]);
+	});
+	for (const int8 TargetIndex : Targets)
+	{
+		ResolveHit(CurrentUnit, *Weapon, TargetIndex, Rolls);
+		RehashUnit(TargetIndex);
+	}
+	return true;
+}
+
+void FBattleState::ResolveHit(int32 AttackerIndex, const FSimWeapon& Weapon, int32 TargetIndex, ESimRollOutcome Rolls)
+{
+	FSimUnit& Attacker = Units[AttackerIndex];
+	FSimUnit& Target = Units[TargetIndex];
+	if (!Target.IsAlive())
+		return;
+
+	// Calculation phase
+	if (Weapon.bRequiresAccuracyRoll)
+	{
+		const bool bHit = Rolls == ESimRollOutcome::Roll
+			? FDamageCalculation::PerformAccuracyRoll(Random, FDamageCalculation::CalculateHitChance(Attacker.Stats, Weapon.Stats))
+			: Rolls == ESimRollOutcome::Hit;
+		if (!bHit)
+			return;
+	}
+
+	// Result application phase
+	const int32 HealthBefore = Target.Stats.Health.GetCurrent();
+	if (Weapon.MagnitudePolicy == EMagnitudePolicy::Damage)
+	{
+		const FDamageResult Result = FDamageCalculation::CalculateDamage(Attacker.Stats, Attacker.IsOnFlank(),
+		                                                                 Weapon.Stats, Target.Stats);
+		Target.Stats.Health.ApplyDelta(-Result.Damage);
+		if (Result.WardSpent != EDamageSource::None)
+			Target.Stats.Defense.Wards.UseWard(Result.WardSpent);
+		const int32 HealthLost = HealthBefore - Target.Stats.Health.GetCurrent();
+		Attacker.DamageDealt += HealthLost;
+		Target.DamageTaken += HealthLost;
+	}
+	else if (Weapon.MagnitudePolicy == EMagnitudePolicy::Heal)
+	{
+		Target.Stats.Health.ApplyDelta(FDamageCalculation::CalculateHeal(Weapon.Stats, Target.Stats.Defense).Damage);
+	}
+	if (Target.Stats.Health.IsDead())
+	{
+		KillUnit(TargetIndex);
+		return;
+	}
+
+	// Side effect phase; no descriptor in the default ability set dispels
+	const FDescriptorSideEffects& SideEffects = Weapon.SideEffects;
+	if (SideEffects.IsActive())
+	{
+		if (SideEffects.WardPolicy == EWardApplicationPolicy::Take)
+		{
+			for (EDamageSource Source : SideEffects.WardSources)
+				Target.Stats.Defense.Wards.Remove(Source);
+		}
+		else if (SideEffects.WardPolicy == EWardApplicationPolicy::Give)
+		{
+			for (EDamageSource Source : SideEffects.WardSources)
+				Target.Stats.Defense.Wards.Add(Source);
+		}
+		if (SideEffects.bRemovesDefensiveStance)
+			Target.Stats.Status.ClearStatus(EUnitStatus::Defending);
+	}
+
+	// Effect application phase
+	for (const FSimEffect& Effect : Weapon.Effects)
+	{
+		if (Effect.bRequiresRoll && !FDamageCalculation::PerformAccuracyRoll(Random,
+			FDamageCalculation::CalculateEffectApplication(Attacker.Stats, Effect.DamageSource, Target.Stats.Defense)))
+		{
+			continue;
+		}
+		AddEffect(TargetIndex, Effect);
+	}
+}
+
+bool FBattleState::ApplyMove(const FTacCoordinates& Cell)
+{
+	if (!Cell.IsValidCell() || !(GetMoveCells(CurrentUnit) & GridBitboard::CellMask(Cell)))
+		return false;
+	FSimUnit& Unit = Units[CurrentUnit];
+	const FTacCoordinates From = Unit.Coords;
+	// GetMoveCells only offers an occupied cell when it holds a friendly unit: swap, as
+	// UTacGridMovementService::MoveUnit does
+	const int32 Swapped = GetUnitAt(Cell);
+	RemoveFromGrid(CurrentUnit);
+	if (Swapped != NoUnit)
+	{
+		RemoveFromGrid(Swapped);
+		PlaceUnit(Swapped, From);
+	}
+	PlaceUnit(CurrentUnit, Cell);
+
+	// Ground -> flank arrival delay, same rule as UTacGridMovementService::MoveUnit
+	if (Cell.IsFlankCell() && From.Layer == ETacGridLayer::Ground)
+	{
+		const bool bIsRear = !FFlankCellDefinitions::IsEntranceCell(From);
+		const int32 Delay = bIsRear ? Unit.Template->FlankRearArrivalDelay : Unit.Template->FlankEntranceArrivalDelay;
+		if (Delay > 0)
+		{
+			Unit.Stats.Status.SetFlankDelay(Delay);
+			RehashUnit(CurrentUnit);
+		}
+	}
+	return true;
+}
+
+bool FBattleState::ApplyWait()
+{
+	if (!CanWait(CurrentUnit))
+		return false;
+	Units[CurrentUnit].Initiative.Wait();
+	RehashUnit(CurrentUnit);
+	Queue.Add(CurrentUnit);
+	SortQueue();
+	RehashQueue();
+	return true;
+}
+
+void FBattleState::PlaceUnit(int32 UnitIndex, const FTacCoordinates& Coords)
+{
+	FSimUnit& Unit = Units[UnitIndex];
+	Unit.Coords = Coords;
+	Occupants[Coords.GetCellIndex()] = static_cast<int8>(UnitIndex);
+	TeamMasks[static_cast<int32>(Unit.Team)] |= GridBitboard::CellMask(Coords);
+	Hash ^= BattleZobrist::OccupantKey(UnitIndex, Coords);
+}
+
+void FBattleState::RemoveFromGrid(int32 UnitIndex)
+{
+	const FSimUnit& Unit = Units[UnitIndex];
+	Occupants[Unit.Coords.GetCellIndex()] = NoUnit;
+	TeamMasks[static_cast<int32>(Unit.Team)] &= ~GridBitboard::CellMask(Unit.Coords);
+	Hash ^= BattleZobrist::OccupantKey(UnitIndex, Unit.Coords);
+}
+
+void FBattleState::KillUnit(int32 UnitIndex)
+{
+	FSimUnit& Unit = Units[UnitIndex];
+	Unit.Stats.Status.SetDead();
+	RemoveFromGrid(UnitIndex);
+	--AliveCount[static_cast<int32>(Unit.Team)];
+	// Corpses are not tracked: nothing in the default ability set interacts with them
+	Queue.Remove(static_cast<int8>(UnitIndex));
+	// UBattleEffectComponent::OnOwnerDied clears every effect
+	while (Unit.Effects.Num() > 0)
+		RemoveEffectAt(UnitIndex, Unit.Effects.Num() - 1);
+	RehashUnit(UnitIndex);
+	RehashQueue();
+}
+
+void FBattleState::ApplyEffect(int32 UnitIndex, const FSimEffect& Effect)
+{
+	FSimUnit& Unit = Units[UnitIndex];
+	FSimActiveEffect& Active = Unit.Effects.AddDefaulted_GetRef();
+	Active.Effect = &Effect;
+	Active.Duration = Effect.Duration;
+	Active.EffectId = FGuid(UnitIndex + 1, ++NextEffectSerial, 0, 0);
+	if (Effect.Kind == ESimEffectKind::StatMod)
+		ApplyStatModifiers(Unit.Stats, Active);
+}
+
+void FBattleState::RemoveEffectAt(int32 UnitIndex, int32 EffectIndex)
+{
+	FSimUnit& Unit = Units[UnitIndex];
+	if (Unit.Effects[EffectIndex].Effect->Kind == ESimEffectKind::StatMod)
+		RemoveStatModifiers(Unit.Stats, Unit.Effects[EffectIndex]);
+	Unit.Effects.RemoveAt(EffectIndex);
+}
+
+void FBattleState::TickEffects(int32 UnitIndex)
+{
+	FSimUnit& Unit = Units[UnitIndex];
+	// Newest first, each entry removed right after its own hook once expired, like BroadcastToEffects
+	for (int32 i = Unit.Effects.Num() - 1; i >= 0; --i)
+	{
+		FSimActiveEffect& Active = Unit.Effects[i];
+		if (Active.Effect->Kind == ESimEffectKind::DamageOverTime)
+		{
+			// UTargetDOTBattleEffect hits through AUnit::HandleHit without an attacker
+			const int32 HealthBefore = Unit.Stats.Health.GetCurrent();
+			Unit.Stats.Health.ApplyDelta(-FMath::RoundToInt(Active.Effect->Magnitude));
+			Unit.DamageTaken += HealthBefore - Unit.Stats.Health.GetCurrent();
+			if (Unit.Stats.Health.IsDead())
+			{
+				KillUnit(UnitIndex);
+				return;
+			}
+		}
+		if (Active.Duration > 0)
+			--Active.Duration;
+		if (Active.Duration <= 0)
+			RemoveEffectAt(UnitIndex, i);
+	}
+}
+
+void FBattleState::SortQueue()
+{
+	Algo::Sort(Queue, [this](int8 A, int8 B)
+	{
+		const int32 ValueA = Units[A].Initiative.GetCurrent();
+		const int32 ValueB = Units[B].Initiative.GetCurrent();
+		// FRolledInitiative::BreakTie: attackers sort later, so they act first on ties
+		if (ValueA == ValueB)
+			return (Units[A].Team == ETeamSide::Attacker) < (Units[B].Team == ETeamSide::Attacker);
+		return ValueA < ValueB;
+	});
+}
+
+void FBattleState::SetCurrentUnit(int8 UnitIndex)
+{
+	if (CurrentUnit != NoUnit)
+		Hash ^= BattleZobrist::Key(BattleZobrist::EFeature::CurrentUnit, CurrentUnit, 0);
+	CurrentUnit = UnitIndex;
+	if (CurrentUnit != NoUnit)
+		Hash ^= BattleZobrist::Key(BattleZobrist::EFeature::CurrentUnit, CurrentUnit, 0);
+}
+
+void FBattleState::RehashUnit(int32 UnitIndex)
+{
+	FSimUnit& Unit = Units[UnitIndex];
+	Hash ^= Unit.StateKey;
+	Unit.StateKey = ComputeUnitStateKey(UnitIndex);
+	Hash ^= Unit.StateKey;
+}
+
+void FBattleState::RehashQueue()
+{
+	Hash ^= QueueHash;
+	QueueHash = ComputeQueueHash();
+	Hash ^= QueueHash;
+}
+
+uint64 FBattleState::ComputeUnitStateKey(int32 UnitIndex) const
+{
+	using namespace BattleZobrist;
+	const FSimUnit& Unit = Units[UnitIndex];
+	const FUnitCoreStats& Stats = Unit.Stats;
+	// Summed like UBattleEffectComponent::GetHashKey, so two identical stacks do not cancel out
+	uint64 EffectKey = 0;
+	for (const FSimActiveEffect& Active : Unit.Effects)
+		EffectKey += Key(EFeature::Effect, UnitIndex, HashCombine(Active.Effect->ConfigKey, GetTypeHash(Active.Duration)));
+	// Health and status keys are the ones the live grid hash uses
+	return Stats.Health.GetHashKey(UnitIndex) ^
+		Stats.Status.GetHashKey(UnitIndex) ^
+		EffectKey ^
+		Key(EFeature::Wards, UnitIndex, Stats.Defense.Wards.GetWards().GetBits()) ^
+		Key(EFeature::Waited, UnitIndex, Unit.Initiative.CanWait() ? 0 : 1);
+}
+
+uint64 FBattleState::ComputeQueueHash() const
+{
+	uint64 Result = 0;
+	for (int32 Slot = 0; Slot < Queue.Num(); ++Slot)
+		Result ^= BattleZobrist::Key(BattleZobrist::EFeature::QueueSlot, Queue[Slot], Slot);
+	return Result;
+}
+
+uint64 FBattleState::ComputeHash() const
+{
+	uint64 Result = ComputeQueueHash();
+	for (int32 i = 0; i < Units.Num(); ++i)
+	{
+		const FSimUnit& Unit = Units[i];
+		Result ^= ComputeUnitStateKey(i);
+		if (Unit.IsAlive())
+			Result ^= BattleZobrist::OccupantKey(i, Unit.Coords);
+	}
+	if (CurrentUnit != NoUnit)
+		Result ^= BattleZobrist::Key(BattleZobrist::EFeature::CurrentUnit, CurrentUnit, 0);
+	return Result;
+}
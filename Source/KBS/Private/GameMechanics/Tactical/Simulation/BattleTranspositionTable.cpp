@@ -0,0 +1,74 @@
+#include "GameMechanics/Tactical/Simulation/BattleTranspositionTable.h"
+
+namespace
+{
+	// Data layout: [0..31] value bits, [32..39] depth, [40..41] bound, [42..43] action kind,
+	// [44..49] action cell index, [63] occupied
+	constexpr uint64 OccupiedBit = uint64(1) << 63;
+	constexpr int32 MaxCapacityLog2 = 24;
+}
+
+FBattleTranspositionTable::FBattleTranspositionTable(int32 CapacityLog2)
+{
+	checkf(CapacityLog2 > 0 && CapacityLog2 <= MaxCapacityLog2,
+	       TEXT("FBattleTranspositionTable: capacity 2^%d out of range"), CapacityLog2);
+	IndexMask = (uint64(1) << CapacityLog2) - 1;
+	Slots = MakeUnique<FSlot[]>(IndexMask + 1);
+}
+
+bool FBattleTranspositionTable::Probe(uint64 Key, FTranspositionEntry& OutEntry) const
+{
+	const FSlot& Slot = Slots[Key & IndexMask];
+	const uint64 Data = Slot.Data.load(std::memory_order_relaxed);
+	if (!(Data & OccupiedBit) || (Slot.Check.load(std::memory_order_relaxed) ^ Data) != Key)
+		return false;
+	OutEntry = Unpack(Data);
+	return true;
+}
+
+void FBattleTranspositionTable::Store(uint64 Key, const FTranspositionEntry& Entry)
+{
+	FSlot& Slot = Slots[Key & IndexMask];
+	const uint64 Existing = Slot.Data.load(std::memory_order_relaxed);
+	if ((Existing & OccupiedBit) && (Slot.Check.load(std::memory_order_relaxed) ^ Existing) == Key &&
+		Unpack(Existing).Depth > Entry.Depth)
+		return;
+	const uint64 Data = Pack(Entry);
+	Slot.Check.store(Key ^ Data, std::memory_order_relaxed);
+	Slot.Data.store(Data, std::memory_order_relaxed);
+}
+
+void FBattleTranspositionTable::Clear()
+{
+	for (uint64 i = 0; i <= IndexMask; ++i)
+	{
+		Slots[i].Check.store(0, std::memory_order_relaxed);
+		Slots[i].Data.store(0, std::memory_order_relaxed);
+	}
+}
+
+uint64 FBattleTranspositionTable::Pack(const FTranspositionEntry& Entry)
+{
+	const int32 CellIndex = Entry.BestAction.Cell.IsValidCell() ? Entry.BestAction.Cell.GetCellIndex() : 0;
+	uint32 ValueBits;
+	FMemory::Memcpy(&ValueBits, &Entry.Value, sizeof(ValueBits));
+	return uint64(ValueBits) |
+		(uint64(FMath::Clamp(Entry.Depth, 0, 255)) << 32) |
+		(uint64(Entry.Bound) << 40) |
+		(uint64(Entry.BestAction.Kind) << 42) |
+		(uint64(CellIndex) << 44) |
+		OccupiedBit;
+}
+
+FTranspositionEntry FBattleTranspositionTable::Unpack(uint64 Data)
+{
+	FTranspositionEntry Entry;
+	const uint32 ValueBits = static_cast<uint32>(Data);
+	FMemory::Memcpy(&Entry.Value, &ValueBits, sizeof(ValueBits));
+	Entry.Depth = static_cast<int32>((Data >> 32) & 0xFF);
+	Entry.Bound = static_cast<ETranspositionBound>((Data >> 40) & 0x3);
+	Entry.BestAction.Kind = static_cast<ESimActionKind>((Data >> 42) & 0x3);
+	if (Entry.BestAction.Kind == ESimActionKind::Attack || Entry.BestAction.Kind == ESimActionKind::Move)
+		Entry.BestAction.Cell = FTacCoordinates::FromCellIndex(static_cast<int32>((Data >> 44) & 0x3F));
+	return Entry;
+}
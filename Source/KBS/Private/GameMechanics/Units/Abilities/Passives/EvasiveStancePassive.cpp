@@ -1,34 +1,44 @@
 #include "GameMechanics/Units/Abilities/Passives/EvasiveStancePassive.h"
 #include "GameMechanics/Units/Unit.h"
 #include "GameplayTypes/CombatTypes.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacCombatSubsystem.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogEvasiveStance, Log, All);
 
 void UEvasiveStancePassive::InitializeFromDefinition(UUnitAbilityDefinition* InDefinition, AUnit* InOwner)
 {
 	Super::InitializeFromDefinition(InDefinition, InOwner);
-	ModifierID = FGuid::NewGuid();
-	UE_LOG(LogEvasiveStance, Log, TEXT("[EvasiveStance] Initialized on %s (ModifierID=%s)"),
-		*InOwner->GetLogName(), *ModifierID.ToString());
+	UE_LOG(LogEvasiveStance, Log, TEXT("[EvasiveStance] Initialized on %s"), *InOwner->GetLogName());
 }
 
 void UEvasiveStancePassive::Subscribe()
 {
-	Owner->OnBeingTargetedInCalculation.AddUObject(this, &UEvasiveStancePassive::OnBeingTargeted);
-	UE_LOG(LogEvasiveStance, Log, TEXT("[EvasiveStance] %s subscribed to OnBeingTargetedInCalculation"),
+	UTacCombatSubsystem* CombatSubsystem = GetCombatSubsystem();
+	if (!CombatSubsystem)
+	{
+		UE_LOG(LogEvasiveStance, Warning, TEXT("[EvasiveStance] %s: no combat subsystem to subscribe to"),
+			*Owner->GetLogName());
+		return;
+	}
+	ListenerHandle = CombatSubsystem->GetPhaseListeners().Add<UEvasiveStancePassive, &UEvasiveStancePassive::OnBeingTargeted>(
+		this, ECombatPhaseMask::Calculation, 0, Owner, ECombatRole::Target);
+	UE_LOG(LogEvasiveStance, Log, TEXT("[EvasiveStance] %s subscribed to the calculation phase as target"),
 		*Owner->GetLogName());
 }
 
 void UEvasiveStancePassive::Unsubscribe()
 {
-	Owner->OnBeingTargetedInCalculation.RemoveAll(this);
-	UE_LOG(LogEvasiveStance, Log, TEXT("[EvasiveStance] %s unsubscribed from OnBeingTargetedInCalculation"),
+	if (UTacCombatSubsystem* CombatSubsystem = GetCombatSubsystem())
+		CombatSubsystem->GetPhaseListeners().Remove(ListenerHandle);
+	UE_LOG(LogEvasiveStance, Log, TEXT("[EvasiveStance] %s unsubscribed from the calculation phase"),
 		*Owner->GetLogName());
 }
 
-void UEvasiveStancePassive::OnBeingTargeted(FCombatContext& Context, FHitInstance& Hit)
+void UEvasiveStancePassive::OnBeingTargeted(const FCombatPhaseEvent& Event)
 {
-	Context.Attacker->GetStats().Accuracy.AddFlatModifier(ModifierID, AccuracyPenalty);
+	FCombatContext& Context = Event.Context;
+	FHitInstance& Hit = *Event.Hit;
+	AppliedPenalty = Context.Attacker->GetStats().Accuracy.AddFlatModifier(AccuracyPenalty);
 	Hit.Interfere(this);
 	UE_LOG(LogEvasiveStance, Log,
 		TEXT("[EvasiveStance] %s being targeted by %s — applied %d accuracy penalty (now %d)"),
@@ -38,7 +48,8 @@ void UEvasiveStancePassive::OnBeingTargeted(FCombatContext& Context, FHitInstanc
 
 void UEvasiveStancePassive::HitTriggerCleanup(FHitInstance& Hit)
 {
-	Hit.Attacker->GetStats().Accuracy.RemoveFlatModifier(ModifierID, AccuracyPenalty);
+	Hit.Attacker->GetStats().Accuracy.RemoveModifier(AppliedPenalty);
+	AppliedPenalty.Invalidate();
 	UE_LOG(LogEvasiveStance, Log,
 		TEXT("[EvasiveStance] Cleanup — restored %s accuracy after hit on %s (now %d)"),
 		*Hit.Attacker->GetLogName(), *Owner->GetLogName(),
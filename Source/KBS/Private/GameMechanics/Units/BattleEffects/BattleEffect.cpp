@@ -3,6 +3,10 @@
 #include "GameplayTypes/TargetingDescriptor.h"
 #include "GameMechanics/Units/Unit.h"
 #include "NiagaraSystem.h"
+UBattleEffectDataAsset* FActiveBattleEffect::GetConfig() const
+{
+	return Effect ? Effect->GetConfig() : nullptr;
+}
 void UBattleEffect::Initialize(UBattleEffectDataAsset* InConfig)
 {
 	if (!InConfig)
@@ -10,13 +14,21 @@ void UBattleEffect::Initialize(UBattleEffectDataAsset* InConfig)
 		return;
 	}
 	Config = InConfig;
-	EffectId = FGuid::NewGuid();
 
 	if (Config->AppliedVFX.IsNull() == false)
 	{
 		Config->AppliedVFX.LoadSynchronous();
 	}
 }
+FActiveBattleEffect UBattleEffect::CreateActive(AUnit* Source)
+{
+	FActiveBattleEffect Active;
+	Active.Effect = this;
+	Active.Source = Source;
+	Active.EffectId = FGuid::NewGuid();
+	Active.Duration = Duration;
+	return Active;
+}
 EDamageSource UBattleEffect::GetDamageSource() const
 {
 	return Config ? Config->DamageSource : EDamageSource::Physical;
@@ -25,18 +37,14 @@ FTargetingDescriptor UBattleEffect::GetEffectTargeting() const
 {
 	return FTargetingDescriptor::FromReach(Config->EffectTarget);
 }
-EReapplyDecision UBattleEffect::HandleReapply(UBattleEffect* NewEffect)
+EReapplyDecision UBattleEffect::HandleReapply(const FActiveBattleEffect& Existing, const FActiveBattleEffect& Incoming)
 {
 	return EReapplyDecision::OverrideDuration;
 }
-void UBattleEffect::OnRemoved()
-{
-	OnEffectRemoved.Broadcast(this);
-}
-void UBattleEffect::NotifyOnTriggered()
+void UBattleEffect::NotifyOnTriggered(const FActiveBattleEffect& Active)
 {
-	if (Owner)
+	if (Active.Owner)
 	{
-		Owner->NotifyEffectTriggered(this);
+		Active.Owner->NotifyEffectTriggered(Active);
 	}
 }
@@ -1,7 +1,6 @@
 #include "GameMechanics/Units/BattleEffects/BattleEffectComponent.h"
 
 #include "Algo/Count.h"
-#include "Algo/RemoveIf.h"
 #include "GameMechanics/Units/BattleEffects/BattleEffect.h"
 #include "GameMechanics/Units/Unit.h"
 
@@ -40,111 +39,125 @@ void UBattleEffectComponent::BeginPlay()
 	OwnerUnit->OnUnitDied.AddDynamic(this, &UBattleEffectComponent::OnOwnerDied);
 }
 
-bool UBattleEffectComponent::AddEffect(UBattleEffect* NewEffect)
+bool UBattleEffectComponent::AddEffect(UBattleEffect* Effect, AUnit* Source, FActiveBattleEffect* OutApplied)
 {
-	if (!CheckAndLogEffect(NewEffect, GetOwnerUnit())) { return false; }
+	if (!CheckAndLogEffect(Effect, GetOwnerUnit())) { return false; }
 
-	const FName StackId = NewEffect->GetStackingId();
+	FActiveBattleEffect NewEffect = Effect->CreateActive(Source);
+	const FName StackId = Effect->GetStackingId();
+	const int32 Existing = StackId.IsNone() ? INDEX_NONE : FindByStackingId(StackId);
+	bool bApplied = false;
 
-	// No stacking identity — always add
-	if (StackId.IsNone())
+	// No stacking identity or nothing to stack with — always add
+	if (Existing == INDEX_NONE)
 	{
 		ApplyEffect(NewEffect);
-		return true;
-	}
-
-	UBattleEffect* Existing = FindByStackingId(StackId);
-	if (!Existing)
-	{
-		ApplyEffect(NewEffect);
-		return true;
+		bApplied = true;
 	}
-
-	const UBattleEffectDataAsset* Config = NewEffect->GetConfig();
-	switch (Config->StackPolicy)
+	else
 	{
-	case EEffectStackPolicy::Unique:
-		return false;
-
-	case EEffectStackPolicy::AlwaysReplaced:
-		RemoveEffect(Existing);
-		ApplyEffect(NewEffect);
-		return true;
-
-	case EEffectStackPolicy::RefreshOld:
-		Existing->RefreshDuration(NewEffect->GetDuration());
-		return false;
-
-	case EEffectStackPolicy::RefreshOrReplace:
-		{
-			const EReapplyDecision Decision = Existing->HandleReapply(NewEffect);
-			ExecuteReapplyDecision(Decision, Existing, NewEffect);
-			return Decision == EReapplyDecision::New;
-		}
-
-	case EEffectStackPolicy::StackInfinite:
-		ApplyEffect(NewEffect);
-		return true;
-
-	case EEffectStackPolicy::Stack:
-		if (CountByStackingId(StackId) >= Config->MaxStacks)
-			return false;
-		ApplyEffect(NewEffect);
-		return true;
-
-	case EEffectStackPolicy::Custom:
+		const UBattleEffectDataAsset* Config = Effect->GetConfig();
+		switch (Config->StackPolicy)
 		{
-			const EReapplyDecision Decision = Existing->HandleReapply(NewEffect);
-			ExecuteReapplyDecision(Decision, Existing, NewEffect);
-			return Decision == EReapplyDecision::New;
+		case EEffectStackPolicy::Unique:
+			break;
+
+		case EEffectStackPolicy::AlwaysReplaced:
+			RemoveAt(Existing);
+			ApplyEffect(NewEffect);
+			bApplied = true;
+			break;
+
+		case EEffectStackPolicy::RefreshOld:
+			SetDuration(Existing, FMath::Max(NewEffect.Duration, ActiveEffects[Existing].Duration));
+			break;
+
+		case EEffectStackPolicy::RefreshOrReplace:
+		case EEffectStackPolicy::Custom:
+			{
+				const FActiveBattleEffect& Old = ActiveEffects[Existing];
+				const EReapplyDecision Decision = Old.GetEffect()->HandleReapply(Old, NewEffect);
+				ExecuteReapplyDecision(Decision, Existing, NewEffect);
+				bApplied = Decision == EReapplyDecision::New;
+			}
+			break;
+
+		case EEffectStackPolicy::StackInfinite:
+			ApplyEffect(NewEffect);
+			bApplied = true;
+			break;
+
+		case EEffectStackPolicy::Stack:
+			if (CountByStackingId(StackId) < Config->MaxStacks)
+			{
+				ApplyEffect(NewEffect);
+				bApplied = true;
+			}
+			break;
 		}
 	}
-	return false;
-}
 
-void UBattleEffectComponent::RemoveEffect(UBattleEffect* Effect)
-{
-	if (Effect)
+	// OnApplied writes its changes (stat modifier handles, duration) to the stored entry, not to NewEffect
+	if (bApplied && OutApplied)
 	{
-		Effect->OnRemoved();
-		ActiveEffects.Remove(Effect);
+		const FActiveBattleEffect* Stored = FindEffect(NewEffect.EffectId);
+		*OutApplied = Stored ? *Stored : NewEffect;
 	}
+	return bApplied;
 }
 
 void UBattleEffectComponent::RemoveEffect(FName StackingId)
 {
-	auto ToRemove = FindByStackingId(StackingId);
-	if (ToRemove)
-		RemoveEffect(ToRemove);
+	const int32 Index = FindByStackingId(StackingId);
+	if (Index != INDEX_NONE)
+		RemoveAt(Index);
 }
 
 void UBattleEffectComponent::RemoveEffect(const FGuid EffectId)
 {
-	auto Effect = ActiveEffects.FindByPredicate([=](const UBattleEffect* Effect){return Effect->GetEffectId() == EffectId; });
-	if (Effect)
-	{
-		(*Effect)->OnRemoved();
-		ActiveEffects.RemoveSingle(*Effect);
-	}
+	const int32 Index = IndexOf(EffectId);
+	if (Index != INDEX_NONE)
+		RemoveAt(Index);
 }
 
 void UBattleEffectComponent::ClearAllEffects()
 {
-	for (UBattleEffect* Effect : ActiveEffects)
+	TArray<FActiveBattleEffect> Removed = MoveTemp(ActiveEffects);
+	ActiveEffects.Reset();
+	for (FActiveBattleEffect& Active : Removed)
 	{
-		if (Effect)
+		if (UBattleEffect* Effect = Active.GetEffect())
 		{
-			Effect->OnRemoved();
+			Effect->OnRemoved(Active);
 		}
+		OnEffectRemoved.Broadcast(Active.EffectId);
 	}
-	ActiveEffects.Empty();
+	UpdateLiveHash();
+}
+
+const FActiveBattleEffect* UBattleEffectComponent::FindEffect(const FGuid& EffectId) const
+{
+	return ActiveEffects.FindByPredicate([&EffectId](const FActiveBattleEffect& Active)
+	{
+		return Active.EffectId == EffectId;
+	});
+}
+
+uint64 UBattleEffectComponent::GetHashKey(uint32 Salt) const
+{
+	// Summed rather than XOR'd so two identical stacks do not cancel out
+	uint64 Result = 0;
+	for (const FActiveBattleEffect& Active : ActiveEffects)
+		Result += BattleZobrist::Key(BattleZobrist::EFeature::Effect, Salt,
+		                             HashCombine(GetTypeHash(Active.Effect), GetTypeHash(Active.Duration)));
+	return Result;
 }
 
 bool UBattleEffectComponent::HasEffectWithTag(const FGameplayTag& Tag) const
 {
-	for (auto& Effect : ActiveEffects)
+	for (const FActiveBattleEffect& Active : ActiveEffects)
 	{
-		if (Effect->HasTag(Tag))
+		if (Active.Effect->HasTag(Tag))
 			return true;
 	}
 	return false;
@@ -152,36 +165,35 @@ bool UBattleEffectComponent::HasEffectWithTag(const FGameplayTag& Tag) const
 
 int32 UBattleEffectComponent::CountEffectsWithTag(const FGameplayTag& Tag) const
 {
-	return Algo::CountIf(ActiveEffects, [=](const UBattleEffect* Effect) { return Effect->HasTag(Tag); });
+	return Algo::CountIf(ActiveEffects, [=](const FActiveBattleEffect& Active) { return Active.Effect->HasTag(Tag); });
 }
 
-TArray<UBattleEffect*> UBattleEffectComponent::GetEffectsMatching(TOptional<FGameplayTag> Tag,
-                                                                  TOptional<EEffectPolarity> PolarityFilter,
-                                                                  TOptional<bool> DispellableFilter) const
+TArray<FGuid> UBattleEffectComponent::GetEffectsMatching(TOptional<FGameplayTag> Tag,
+                                                         TOptional<EEffectPolarity> PolarityFilter,
+                                                         TOptional<bool> DispellableFilter) const
 {
-	TArray<UBattleEffect*> FilteredEffects;
-	Algo::CopyIf(ActiveEffects, FilteredEffects, [=](const UBattleEffect* Effect)
+	TArray<FGuid> FilteredEffects;
+	for (const FActiveBattleEffect& Active : ActiveEffects)
 	{
+		const UBattleEffect* Effect = Active.Effect;
 		if (Tag.IsSet() && !Effect->HasTag(Tag.GetValue()))
-			return false;
+			continue;
 
 		if (PolarityFilter.IsSet() && Effect->GetPolarity() != PolarityFilter.GetValue())
-			return false;
+			continue;
 
 		if (DispellableFilter.IsSet() && Effect->IsDispellable() != DispellableFilter.GetValue())
-			return false;
+			continue;
 
-		return true;
-	});
+		FilteredEffects.Add(Active.EffectId);
+	}
 	return FilteredEffects;
 }
 
 int32 UBattleEffectComponent::DispelEffects(TOptional<EEffectPolarity> PolarityFilter,
                                             TOptional<FGameplayTag> TagFilter, int32 MaxToRemove)
 {
-	TArray<UBattleEffect*> FilteredEffects{GetEffectsMatching(TagFilter, PolarityFilter, true)};
-	TArray<FGuid> GuidsToRemove;
-	Algo::Transform(FilteredEffects, GuidsToRemove, [=](UBattleEffect* Effect) {return Effect->GetEffectId();});
+	const TArray<FGuid> GuidsToRemove = GetEffectsMatching(TagFilter, PolarityFilter, true);
 	int32 EffectsToRemove{FMath::Min(MaxToRemove, GuidsToRemove.Num())};
 	for (int i = 0; i < EffectsToRemove; i++)
 	{
@@ -190,89 +202,155 @@ int32 UBattleEffectComponent::DispelEffects(TOptional<EEffectPolarity> PolarityF
 	return EffectsToRemove;
 }
 
-UBattleEffect* UBattleEffectComponent::FindByStackingId(FName StackingId) const
+int32 UBattleEffectComponent::IndexOf(const FGuid& EffectId) const
+{
+	return ActiveEffects.IndexOfByPredicate([&EffectId](const FActiveBattleEffect& Active)
+	{
+		return Active.EffectId == EffectId;
+	});
+}
+
+int32 UBattleEffectComponent::FindByStackingId(FName StackingId) const
 {
-	auto Found = Algo::FindByPredicate(ActiveEffects, [=](const UBattleEffect* Effect)
+	return ActiveEffects.IndexOfByPredicate([=](const FActiveBattleEffect& Active)
 	{
-		return Effect->GetStackingId() == StackingId;
+		return Active.Effect->GetStackingId() == StackingId;
 	});
-	return Found? *Found : nullptr;
 }
 
 int32 UBattleEffectComponent::CountByStackingId(FName StackingId) const
 {
-	return Algo::CountIf(ActiveEffects, [=](const UBattleEffect* Effect)
+	return Algo::CountIf(ActiveEffects, [=](const FActiveBattleEffect& Active)
 	{
-		return Effect->GetStackingId() == StackingId;
+		return Active.Effect->GetStackingId() == StackingId;
 	});
 }
 
-void UBattleEffectComponent::ApplyEffect(UBattleEffect* Effect)
+void UBattleEffectComponent::ApplyEffect(FActiveBattleEffect& Active)
+{
+	AUnit* OwnerUnit = GetOwnerUnit();
+	Active.Owner = OwnerUnit;
+	if (Active.Effect->RequiresInstance())
+	{
+		Active.Instance = DuplicateObject(Active.Effect.Get(), OwnerUnit);
+		Active.Instance->PrepareForApply(Active.Source.Get(), OwnerUnit);
+		// PrepareForApply may scale the instance's duration to the source and target
+		Active.Duration = Active.Instance->GetInitialDuration();
+	}
+	ActiveEffects.Add(Active);
+	UpdateLiveHash();
+	RunHook(Active, [](UBattleEffect* E, FActiveBattleEffect& A) { E->OnApplied(A); });
+}
+
+void UBattleEffectComponent::RemoveAt(int32 Index)
+{
+	// Out of the list before OnRemoved, so anything its hooks query no longer sees it
+	FActiveBattleEffect Removed = ActiveEffects[Index];
+	ActiveEffects.RemoveAt(Index);
+	UpdateLiveHash();
+	if (UBattleEffect* Effect = Removed.GetEffect())
+	{
+		Effect->OnRemoved(Removed);
+	}
+	OnEffectRemoved.Broadcast(Removed.EffectId);
+}
+
+void UBattleEffectComponent::SetDuration(int32 Index, int32 NewDuration)
 {
-	ActiveEffects.Add(Effect);
-	Effect->SetOwner(GetOwnerUnit());
-	Effect->OnApplied();
+	FActiveBattleEffect& Active = ActiveEffects[Index];
+	Active.Duration = NewDuration;
+	UpdateLiveHash();
+	OnEffectDurationChange.Broadcast(Active.EffectId, NewDuration);
 }
 
-void UBattleEffectComponent::ExecuteReapplyDecision(EReapplyDecision Decision, UBattleEffect* OldEffect,
-                                                    UBattleEffect* NewEffect)
+void UBattleEffectComponent::ExecuteReapplyDecision(EReapplyDecision Decision, int32 OldIndex,
+                                                    FActiveBattleEffect& NewEffect)
 {
 	switch (Decision)
 	{
 	case EReapplyDecision::Old:
 		break;
 	case EReapplyDecision::New:
-		RemoveEffect(OldEffect);
+		RemoveAt(OldIndex);
 		ApplyEffect(NewEffect);
 		break;
 	case EReapplyDecision::OverrideDuration:
-		OldEffect->RefreshDuration(NewEffect->GetDuration());
+		SetDuration(OldIndex, FMath::Max(NewEffect.Duration, ActiveEffects[OldIndex].Duration));
 		break;
 	case EReapplyDecision::DoNothing:
 		break;
 	}
 }
 
-void UBattleEffectComponent::BroadcastToEffects(TFunctionRef<void(UBattleEffect*)> Notify, bool bCheckExpiry)
+void UBattleEffectComponent::RunHook(const FActiveBattleEffect& Entry, FEffectHook Notify)
+{
+	// Entry may live in ActiveEffects, which the hook can reallocate
+	FActiveBattleEffect Active = Entry;
+	const int32 DurationBefore = Active.Duration;
+	if (UBattleEffect* Effect = Active.GetEffect())
+	{
+		Notify(Effect, Active);
+	}
+	const int32 Index = IndexOf(Active.EffectId);
+	if (Index == INDEX_NONE)
+		return;
+	ActiveEffects[Index] = MoveTemp(Active);
+	if (ActiveEffects[Index].Duration != DurationBefore)
+		SetDuration(Index, ActiveEffects[Index].Duration);
+}
+
+void UBattleEffectComponent::UpdateLiveHash()
+{
+	if (LiveHash.IsBound())
+		LiveHash.Update(GetHashKey(LiveHash.GetSalt()));
+}
+
+void UBattleEffectComponent::BroadcastToEffects(FEffectHook Notify, bool bCheckExpiry)
 {
 	for (int32 i = ActiveEffects.Num() - 1; i >= 0; --i)
 	{
-		if (UBattleEffect* Effect = ActiveEffects[i])
+		// A hook can remove several entries at once, e.g. by killing the owner
+		if (i >= ActiveEffects.Num())
+			continue;
+		const FGuid EffectId = ActiveEffects[i].EffectId;
+		RunHook(ActiveEffects[i], Notify);
+		if (bCheckExpiry)
 		{
-			Notify(Effect);
-			if (bCheckExpiry && Effect->IsExpired()) RemoveEffect(Effect);
+			const int32 Index = IndexOf(EffectId);
+			if (Index != INDEX_NONE && ActiveEffects[Index].IsExpired())
+				RemoveAt(Index);
 		}
 	}
 }
 
 void UBattleEffectComponent::OnOwnerTurnStart(AUnit* Unit)
 {
-	BroadcastToEffects([](UBattleEffect* E) { E->OnTurnStart(); });
+	BroadcastToEffects([](UBattleEffect* E, FActiveBattleEffect& A) { E->OnTurnStart(A); });
 }
 
 void UBattleEffectComponent::OnOwnerTurnEnd(AUnit* Unit)
 {
-	BroadcastToEffects([](UBattleEffect* E) { E->OnTurnEnd(); });
+	BroadcastToEffects([](UBattleEffect* E, FActiveBattleEffect& A) { E->OnTurnEnd(A); });
 }
 
 void UBattleEffectComponent::OnOwnerAttacked(AUnit* Victim, AUnit* Attacker)
 {
-	BroadcastToEffects([Attacker](UBattleEffect* E) { E->OnUnitAttacked(Attacker); });
+	BroadcastToEffects([Attacker](UBattleEffect* E, FActiveBattleEffect& A) { E->OnUnitAttacked(A, Attacker); });
 }
 
 void UBattleEffectComponent::OnOwnerAttacks(AUnit* Attacker, AUnit* Target)
 {
-	BroadcastToEffects([Target](UBattleEffect* E) { E->OnUnitAttacks(Target); });
+	BroadcastToEffects([Target](UBattleEffect* E, FActiveBattleEffect& A) { E->OnUnitAttacks(A, Target); });
 }
 
 void UBattleEffectComponent::OnOwnerMoved(AUnit* Unit, const FTacMovementVisualData& MovementData)
 {
-	BroadcastToEffects([](UBattleEffect* E) { E->OnUnitMoved(); });
+	BroadcastToEffects([](UBattleEffect* E, FActiveBattleEffect& A) { E->OnUnitMoved(A); });
 }
 
 void UBattleEffectComponent::OnOwnerDied(AUnit* Unit)
 {
-	BroadcastToEffects([](UBattleEffect* E) { E->OnUnitDied(); }, false);
+	BroadcastToEffects([](UBattleEffect* E, FActiveBattleEffect& A) { E->OnUnitDied(A); }, false);
 	ClearAllEffects();
 }
 
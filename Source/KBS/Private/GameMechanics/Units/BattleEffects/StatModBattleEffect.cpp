@@ -12,82 +12,77 @@ void UStatModBattleEffect::Initialize(UBattleEffectDataAsset* InConfig)
 	}
 }
 
-void UStatModBattleEffect::OnTurnEnd()
+void UStatModBattleEffect::OnTurnEnd(FActiveBattleEffect& Active)
 {
-	DecrementDuration();
+	DecrementDuration(Active);
 	UE_LOG(LogTemp, Log, TEXT("%s: StatMod effect '%s' tick (%d turns remaining)"),
-		*Owner->GetName(),
+		*Active.Owner->GetName(),
 		*Config->Name.ToString(),
-		Duration);
+		Active.Duration);
 }
 
-void UStatModBattleEffect::OnApplied()
+void UStatModBattleEffect::OnApplied(FActiveBattleEffect& Active)
 {
-	if (!Owner)
+	if (!Active.Owner)
 	{
 		return;
 	}
-	ApplyStatModifications();
+	ApplyStatModifications(Active);
 	UE_LOG(LogTemp, Log, TEXT("%s: StatMod effect '%s' applied for %d turns"),
-		*Owner->GetName(),
+		*Active.Owner->GetName(),
 		*Config->Name.ToString(),
-		Duration);
+		Active.Duration);
 }
 
-void UStatModBattleEffect::OnRemoved()
+void UStatModBattleEffect::OnRemoved(FActiveBattleEffect& Active)
 {
-	if (!Owner)
+	if (!Active.Owner)
 	{
 		return;
 	}
-	RemoveStatModifications();
+	RemoveStatModifications(Active);
 	UE_LOG(LogTemp, Log, TEXT("%s: StatMod effect '%s' removed"),
-		*Owner->GetName(),
+		*Active.Owner->GetName(),
 		*Config->Name.ToString());
 }
 
-EReapplyDecision UStatModBattleEffect::HandleReapply(UBattleEffect* NewEffect)
+EReapplyDecision UStatModBattleEffect::HandleReapply(const FActiveBattleEffect& Existing,
+                                                     const FActiveBattleEffect& Incoming)
 {
-	if (!NewEffect)
-	{
-		return EReapplyDecision::DoNothing;
-	}
 	return EReapplyDecision::New;
 }
 
-void UStatModBattleEffect::ApplyStatModifications()
+void UStatModBattleEffect::ApplyStatModifications(FActiveBattleEffect& Active) const
 {
 	UStatModBattleEffectDataAsset* Cfg = GetStatModConfig();
+	AUnit* Owner = Active.Owner;
 	if (!Owner || !Cfg)
 	{
 		return;
 	}
 
 	FUnitCoreStats& Stats = Owner->GetStats();
-	const FGuid& EffId = GetEffectId();
+	const FGuid& EffId = Active.EffectId;
 
 	// Apply stat modifiers (0 = no modification)
-	AppliedMaxHealthMod = Cfg->MaxHealthModifier;
-	if (AppliedMaxHealthMod != 0)
+	Active.StatModifiers = FAppliedStatModifiers();
+	if (Cfg->MaxHealthModifier != 0)
 	{
-		Stats.Health.AddMaxModifier(EffId, AppliedMaxHealthMod, true);
+		Active.StatModifiers.MaxHealth = Stats.Health.AddMaxModifier(Cfg->MaxHealthModifier, true);
 	}
 
-	AppliedInitiativeMod = Cfg->InitiativeModifier;
-	if (AppliedInitiativeMod != 0)
+	if (Cfg->InitiativeModifier != 0)
 	{
-		Stats.Initiative.AddFlatModifier(EffId, AppliedInitiativeMod);
+		Active.StatModifiers.Initiative = Stats.Initiative.AddFlatModifier(Cfg->InitiativeModifier);
 	}
 
-	AppliedAccuracyMod = Cfg->AccuracyModifier;
-	if (AppliedAccuracyMod != 0)
+	if (Cfg->AccuracyModifier != 0)
 	{
-		Stats.Accuracy.AddFlatModifier(EffId, AppliedAccuracyMod);
+		Active.StatModifiers.Accuracy = Stats.Accuracy.AddFlatModifier(Cfg->AccuracyModifier);
 	}
 
 	// Apply immunities
-	AppliedImmunities = Cfg->ImmunitiesToGrant.Array();
-	for (EDamageSource Immunity : AppliedImmunities)
+	for (EDamageSource Immunity : Cfg->ImmunitiesToGrant)
 	{
 		Stats.Defense.Immunities.AddModifier(EffId, Immunity, true);
 	}
@@ -97,52 +92,43 @@ void UStatModBattleEffect::ApplyStatModifications()
 	{
 		if (ArmorPair.Value != 0)
 		{
-			AppliedArmourMods.Add(ArmorPair.Key, ArmorPair.Value);
 			Stats.Defense.Armour.AddFlatModifier(EffId, ArmorPair.Value, ArmorPair.Key);
 		}
 	}
+	Owner->OnUnitStatsModified.Broadcast(Owner, Stats);
 }
 
-void UStatModBattleEffect::RemoveStatModifications()
+void UStatModBattleEffect::RemoveStatModifications(const FActiveBattleEffect& Active) const
 {
-	if (!Owner)
+	// The config is immutable, so it names exactly the modifiers ApplyStatModifications added
+	UStatModBattleEffectDataAsset* Cfg = GetStatModConfig();
+	AUnit* Owner = Active.Owner;
+	if (!Owner || !Cfg)
 	{
 		return;
 	}
 
 	FUnitCoreStats& Stats = Owner->GetStats();
-	const FGuid& EffId = GetEffectId();
-
-	// Remove using cached amounts
-	if (AppliedMaxHealthMod != 0)
-	{
-		Stats.Health.RemoveMaxModifier(EffId, AppliedMaxHealthMod);
-		AppliedMaxHealthMod = 0;
-	}
-
-	if (AppliedInitiativeMod != 0)
-	{
-		Stats.Initiative.RemoveFlatModifier(EffId, AppliedInitiativeMod);
-		AppliedInitiativeMod = 0;
-	}
+	const FGuid& EffId = Active.EffectId;
 
-	if (AppliedAccuracyMod != 0)
-	{
-		Stats.Accuracy.RemoveFlatModifier(EffId, AppliedAccuracyMod);
-		AppliedAccuracyMod = 0;
-	}
+	// Handles of stats the effect left alone are invalid, and removing them does nothing
+	Stats.Health.RemoveMaxModifier(Active.StatModifiers.MaxHealth);
+	Stats.Initiative.RemoveModifier(Active.StatModifiers.Initiative);
+	Stats.Accuracy.RemoveModifier(Active.StatModifiers.Accuracy);
 
 	// Remove immunities
-	for (EDamageSource Immunity : AppliedImmunities)
+	for (EDamageSource Immunity : Cfg->ImmunitiesToGrant)
 	{
 		Stats.Defense.Immunities.RemoveModifier(EffId, Immunity, true);
 	}
-	AppliedImmunities.Empty();
 
 	// Remove armour modifications
-	for (const auto& ArmorPair : AppliedArmourMods)
+	for (const auto& ArmorPair : Cfg->ArmourModifiers)
 	{
-		Stats.Defense.Armour.RemoveFlatModifier(EffId, ArmorPair.Value, ArmorPair.Key);
+		if (ArmorPair.Value != 0)
+		{
+			Stats.Defense.Armour.RemoveFlatModifier(EffId, ArmorPair.Value, ArmorPair.Key);
+		}
 	}
-	AppliedArmourMods.Empty();
+	Owner->OnUnitStatsModified.Broadcast(Owner, Stats);
 }
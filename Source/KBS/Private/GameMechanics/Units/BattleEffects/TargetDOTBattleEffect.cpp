@@ -11,9 +11,10 @@ void UTargetDOTBattleEffect::Initialize(UBattleEffectDataAsset* InConfig)
 		Duration = DOTConfig->Duration;
 	}
 }
-void UTargetDOTBattleEffect::OnTurnEnd()
+void UTargetDOTBattleEffect::OnTurnEnd(FActiveBattleEffect& Active)
 {
 	UDOTBattleEffectDataAsset* DOTConfig = GetDOTConfig();
+	AUnit* Owner = Active.Owner;
 	if (!Owner || !DOTConfig)
 	{
 		return;
@@ -23,39 +24,40 @@ void UTargetDOTBattleEffect::OnTurnEnd()
 	Damage.DamageSource = Config->DamageSource;
 	Damage.DamageBlocked = 0;
 	Owner->HandleHit(Damage, nullptr);
-	NotifyOnTriggered();
+	NotifyOnTriggered(Active);
 	UE_LOG(LogTemp, Log, TEXT("%s: DOT effect '%s' dealt %d damage (%d turns remaining)"),
 		*Owner->GetName(),
 		*Config->Name.ToString(),
 		Damage.Damage,
-		Duration);
-	DecrementDuration();
+		Active.Duration);
+	DecrementDuration(Active);
 }
-void UTargetDOTBattleEffect::OnApplied()
+void UTargetDOTBattleEffect::OnApplied(FActiveBattleEffect& Active)
 {
-	checkf(Owner, TEXT("TargetDOTBattleEffect::OnApplied called without Owner set"));
-	NotifyOnTriggered();
+	checkf(Active.Owner, TEXT("TargetDOTBattleEffect::OnApplied called without Owner set"));
+	NotifyOnTriggered(Active);
 	UE_LOG(LogTemp, Log, TEXT("%s: DOT effect '%s' applied for %d turns"),
-		*Owner->GetName(),
+		*Active.Owner->GetName(),
 		*Config->Name.ToString(),
-		Duration);
+		Active.Duration);
 }
-void UTargetDOTBattleEffect::OnRemoved()
+void UTargetDOTBattleEffect::OnRemoved(FActiveBattleEffect& Active)
 {
-	checkf(Owner, TEXT("TargetDOTBattleEffect::OnRemoved called without Owner set"));
+	checkf(Active.Owner, TEXT("TargetDOTBattleEffect::OnRemoved called without Owner set"));
 	UE_LOG(LogTemp, Log, TEXT("%s: DOT effect '%s' removed"),
-		*Owner->GetName(),
+		*Active.Owner->GetName(),
 		*Config->Name.ToString());
 }
-EReapplyDecision UTargetDOTBattleEffect::HandleReapply(UBattleEffect* NewEffect)
+EReapplyDecision UTargetDOTBattleEffect::HandleReapply(const FActiveBattleEffect& Existing,
+                                                       const FActiveBattleEffect& Incoming)
 {
 	UDOTBattleEffectDataAsset* DOTConfig = GetDOTConfig();
-	UDOTBattleEffectDataAsset* NewDOTConfig = NewEffect ? Cast<UDOTBattleEffectDataAsset>(NewEffect->GetConfig()) : nullptr;
-	if (!NewEffect || !DOTConfig || !NewDOTConfig)
+	UDOTBattleEffectDataAsset* NewDOTConfig = Cast<UDOTBattleEffectDataAsset>(Incoming.GetConfig());
+	if (!DOTConfig || !NewDOTConfig)
 	{
 		return EReapplyDecision::DoNothing;
 	}
-	checkf(Owner, TEXT("TargetDOTBattleEffect::HandleReapply called without Owner set"));
+	checkf(Existing.Owner, TEXT("TargetDOTBattleEffect::HandleReapply called without Owner set"));
 	float NewMagnitude = NewDOTConfig->EffectMagnitude;
 	float CurrentMagnitude = DOTConfig->EffectMagnitude;
 	if (NewMagnitude > CurrentMagnitude)
@@ -12,6 +12,7 @@ void UCombatDescriptor::Initialize(UObject* Outer, UCombatDescriptorDataAsset* D
 	}
 	Config = Data;
 	Stats = Data->BaseStats;
+	Stats.AreaShape.Compile();
 	if (BaseMagnitudeOverride != -1)
 		Stats.BaseMagnitude.SetBase(BaseMagnitudeOverride);
 	bIsImmutable = Data->bIsImmutable;
@@ -34,22 +35,17 @@ void UCombatDescriptor::Initialize(UObject* Outer, UCombatDescriptorDataAsset* D
 }
 
 
-void UCombatDescriptor::ModifyMagnitude(int32 Magnitude, FGuid ModificatorGuid, bool bIsFlat)
+FStatModifierHandle UCombatDescriptor::ModifyMagnitude(int32 Magnitude, bool bIsFlat)
 {
-	if (!bIsImmutable)
-		if (bIsFlat)
-			Stats.BaseMagnitude.AddFlatModifier(ModificatorGuid, Magnitude);
-		else
-			Stats.BaseMagnitude.AddMultiplier(ModificatorGuid, Magnitude);
+	if (bIsImmutable)
+		return FStatModifierHandle();
+	return bIsFlat ? Stats.BaseMagnitude.AddFlatModifier(Magnitude) : Stats.BaseMagnitude.AddMultiplier(Magnitude);
 }
 
-void UCombatDescriptor::RemoveMagnitudeModifier(int32 Magnitude, FGuid ModificatorGuid, bool bIsFlat)
+void UCombatDescriptor::RemoveMagnitudeModifier(FStatModifierHandle Handle)
 {
 	if (!bIsImmutable)
-		if (bIsFlat)
-			Stats.BaseMagnitude.RemoveFlatModifier(ModificatorGuid, Magnitude);
-		else
-			Stats.BaseMagnitude.RemoveMultiplier(ModificatorGuid, Magnitude);
+		Stats.BaseMagnitude.RemoveModifier(Handle);
 }
 
 void UCombatDescriptor::RemoveSourceModifier(FGuid ModificatorGuid)
@@ -60,7 +56,7 @@ void UCombatDescriptor::RemoveSourceModifier(FGuid ModificatorGuid)
 
 
 
-void UCombatDescriptor::ModifySource(const TSet<EDamageSource>& Sources, FGuid ModificatorGuid)
+void UCombatDescriptor::ModifySource(FDamageSourceMask Sources, FGuid ModificatorGuid)
 {
 	if (!bIsImmutable)
 	{
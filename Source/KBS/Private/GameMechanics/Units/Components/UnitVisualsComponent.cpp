@@ -56,9 +56,9 @@ void UUnitVisualsComponent::OnOwnerDamaged(AUnit* Victim, AUnit* Attacker)
 	}
 	PlayHitReactionMontage(HitMontage);
 }
-void UUnitVisualsComponent::OnOwnerEffectTriggered(AUnit* OwnerUnit, UBattleEffect* Effect)
+void UUnitVisualsComponent::OnOwnerEffectTriggered(AUnit* OwnerUnit, const FActiveBattleEffect& Effect)
 {
-	ShowBattleEffect(Effect);
+	ShowBattleEffect(Effect.GetConfig());
 }
 
 void UUnitVisualsComponent::OnOwnerOrientationChanged(EUnitOrientation NewOrientation)
@@ -131,9 +131,8 @@ void UUnitVisualsComponent::CompleteMovementOperation()
 		CurrentMovementOperation = FOperationHandle();
 	}
 }
-void UUnitVisualsComponent::ShowBattleEffect(UBattleEffect* Effect)
+void UUnitVisualsComponent::ShowBattleEffect(const UBattleEffectDataAsset* EffectConfig)
 {
-	const UBattleEffectDataAsset* EffectConfig = Effect->GetConfig();
 	if (!EffectConfig || EffectConfig->AppliedVFX.IsNull())
 	{
 		return;
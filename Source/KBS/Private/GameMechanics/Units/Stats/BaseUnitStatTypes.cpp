@@ -1,65 +1,95 @@
 #include "GameMechanics/Units/Stats/BaseUnitStatTypes.h"
 
-// FUnitStatPercent implementations
-FUnitStatPercent::FUnitStatPercent(int32 InBase)
-	: Base(FMath::Clamp(InBase, 0, 100)), Modified(Base), bIsDirty(true)
+namespace
 {
+	thread_local uint32 GStatChangeSerial = 0;
 }
 
-bool FUnitStatPercent::IsDirty() const
+// FStatModifierAggregate implementations
+uint32 FStatModifierAggregate::GetChangeSerial()
 {
-	return bIsDirty;
+	return GStatChangeSerial;
 }
 
-void FUnitStatPercent::Recalc() const
+void FStatModifierAggregate::MarkChanged()
 {
-	Modified = FMath::RoundToInt((Base + CalcFlatModifiers()) * CalcStatMultipliers());
-	Modified = FMath::Clamp(Modified, 0, 100);
-	bIsDirty = false;
+	++GStatChangeSerial;
 }
 
-int32 FUnitStatPercent::CalcFlatModifiers() const
+FStatModifierHandle FStatModifierAggregate::Add(int32 Amount, bool bIsMultiplier)
 {
-	int32 Result = 0;
-	for (const FInt32StatModifier& Mod : FlatModifiers)
-	{
-		Result += Mod.Amount;
-	}
-	return Result;
+	FSlot Slot;
+	Slot.Amount = Amount;
+	Slot.Serial = NextSerial;
+	Slot.bIsMultiplier = bIsMultiplier;
+	// Serial 0 marks an invalid handle
+	NextSerial = NextSerial == MAX_uint16 ? 1 : NextSerial + 1;
+
+	const int32 Index = Slots.Add(Slot);
+	checkf(Index <= MAX_uint16, TEXT("FStatModifierAggregate: more than %d modifiers on one stat"), MAX_uint16);
+	(bIsMultiplier ? MultiplierSum : FlatSum) += Amount;
+	MarkChanged();
+
+	FStatModifierHandle Handle;
+	Handle.Index = static_cast<uint16>(Index);
+	Handle.Serial = Slot.Serial;
+	return Handle;
 }
 
-float FUnitStatPercent::CalcStatMultipliers() const
+bool FStatModifierAggregate::Remove(FStatModifierHandle Handle)
 {
-	float Result = 1.0f;
-	for (const FInt32StatModifier& Mod : StatMultipliers)
+	if (!Handle.IsValid() || !Slots.IsValidIndex(Handle.Index) || Slots[Handle.Index].Serial != Handle.Serial)
 	{
-		Result += Mod.Amount / 100.0f;
+		return false;
 	}
-	return Result;
+	const FSlot& Slot = Slots[Handle.Index];
+	(Slot.bIsMultiplier ? MultiplierSum : FlatSum) -= Slot.Amount;
+	Slots.RemoveAt(Handle.Index);
+	MarkChanged();
+	return true;
 }
 
-void FUnitStatPercent::AddFlatModifier(const FGuid& EffectId, int32 Amount)
+void FStatModifierAggregate::Reset()
 {
-	FlatModifiers.Add(FInt32StatModifier(EffectId, Amount));
-	bIsDirty = true;
+	Slots.Empty();
+	FlatSum = 0;
+	MultiplierSum = 0;
+	MarkChanged();
 }
 
-void FUnitStatPercent::AddMultiplier(const FGuid& EffectId, int32 Amount)
+// FUnitStatPercent implementations
+FUnitStatPercent::FUnitStatPercent(int32 InBase)
+	: Base(FMath::Clamp(InBase, 0, 100)), Modified(Base), bIsDirty(true)
 {
-	StatMultipliers.Add(FInt32StatModifier(EffectId, Amount));
-	bIsDirty = true;
 }
 
-void FUnitStatPercent::RemoveFlatModifier(const FGuid& EffectId, int32 Amount)
+bool FUnitStatPercent::IsDirty() const
+{
+	return bIsDirty;
+}
+
+void FUnitStatPercent::Recalc() const
+{
+	Modified = FMath::Clamp(Modifiers.Apply(Base), 0, 100);
+	bIsDirty = false;
+}
+
+FStatModifierHandle FUnitStatPercent::AddFlatModifier(int32 Amount)
 {
-	FlatModifiers.Remove(FInt32StatModifier(EffectId, Amount));
 	bIsDirty = true;
+	return Modifiers.Add(Amount, false);
 }
 
-void FUnitStatPercent::RemoveMultiplier(const FGuid& EffectId, int32 Amount)
+FStatModifierHandle FUnitStatPercent::AddMultiplier(int32 Amount)
 {
-	StatMultipliers.Remove(FInt32StatModifier(EffectId, Amount));
 	bIsDirty = true;
+	return Modifiers.Add(Amount, true);
+}
+
+void FUnitStatPercent::RemoveModifier(FStatModifierHandle Handle)
+{
+	if (Modifiers.Remove(Handle))
+		bIsDirty = true;
 }
 
 int32 FUnitStatPercent::GetValue() const
@@ -73,14 +103,14 @@ void FUnitStatPercent::SetBase(const int32 NewBase)
 {
 	Base = FMath::Clamp(NewBase, 0, 100);
 	bIsDirty = true;
+	FStatModifierAggregate::MarkChanged();
 }
 
 void FUnitStatPercent::InitFromBase(int32 InBase)
 {
 	Base = FMath::Clamp(InBase, 0, 100);
 	Modified = Base;
-	FlatModifiers.Empty();
-	StatMultipliers.Empty();
+	Modifiers.Reset();
 	bIsDirty = true;
 }
 
@@ -97,53 +127,26 @@ bool FUnitStatPositive::IsDirty() const
 
 void FUnitStatPositive::Recalc() const
 {
-	Modified = FMath::RoundToInt((Base + CalcFlatModifiers()) * CalcStatMultipliers());
-	Modified = FMath::Max(Modified, 0);
+	Modified = FMath::Max(Modifiers.Apply(Base), 0);
 	bIsDirty = false;
 }
 
-int32 FUnitStatPositive::CalcFlatModifiers() const
-{
-	int32 Result = 0;
-	for (const FInt32StatModifier& Mod : FlatModifiers)
-	{
-		Result += Mod.Amount;
-	}
-	return Result;
-}
-
-float FUnitStatPositive::CalcStatMultipliers() const
+FStatModifierHandle FUnitStatPositive::AddFlatModifier(int32 Amount)
 {
-	float Result = 1.0f;
-	for (const FInt32StatModifier& Mod : StatMultipliers)
-	{
-		Result += Mod.Amount / 100.0f;
-	}
-	return Result;
-}
-
-void FUnitStatPositive::AddFlatModifier(const FGuid& EffectId, int32 Amount)
-{
-	FlatModifiers.Add(FInt32StatModifier(EffectId, Amount));
 	bIsDirty = true;
+	return Modifiers.Add(Amount, false);
 }
 
-void FUnitStatPositive::AddMultiplier(const FGuid& EffectId, int32 Amount)
+FStatModifierHandle FUnitStatPositive::AddMultiplier(int32 Amount)
 {
-	StatMultipliers.Add(FInt32StatModifier(EffectId, Amount));
 	bIsDirty = true;
+	return Modifiers.Add(Amount, true);
 }
 
-void FUnitStatPositive::RemoveFlatModifier(const FGuid& EffectId, int32 Amount)
+void FUnitStatPositive::RemoveModifier(FStatModifierHandle Handle)
 {
-	FlatModifiers.Remove(FInt32StatModifier(EffectId, Amount));
-	bIsDirty = true;
-}
-
-void FUnitStatPositive::RemoveMultiplier(const FGuid& EffectId, int32 Amount)
-{
-	StatMultipliers.Remove(FInt32StatModifier(EffectId, Amount));
-	bIsDirty = true;
+	if (Modifiers.Remove(Handle))
+		bIsDirty = true;
 }
 
 int32 FUnitStatPositive::GetValue() const
@@ -157,20 +160,20 @@ void FUnitStatPositive::SetBase(const int32 NewBase)
 {
 	Base = FMath::Max(NewBase, 0);
 	bIsDirty = true;
+	FStatModifierAggregate::MarkChanged();
 }
 
 void FUnitStatPositive::InitFromBase(int32 InBase)
 {
 	Base = FMath::Max(InBase, 0);
 	Modified = Base;
-	FlatModifiers.Empty();
-	StatMultipliers.Empty();
+	Modifiers.Reset();
 	bIsDirty = false;
 }
 
 // FDamageSourceSetStat implementations
 FDamageSourceSetStat::FDamageSourceSetStat(const TSet<EDamageSource>& InBase)
-	: Base(InBase), Modified(InBase), bIsDirty(true)
+	: Base(InBase), bIsDirty(true)
 {
 }
 
@@ -181,15 +184,15 @@ bool FDamageSourceSetStat::IsDirty() const
 
 void FDamageSourceSetStat::Recalc() const
 {
-	Modified = Base;
+	Modified = FDamageSourceMask(Base);
 	for (const FDamageSourceSetModifier& Mod : Modifiers)
 	{
-		Modified.Append(Mod.Sources);
+		Modified |= Mod.Sources;
 	}
 	bIsDirty = false;
 }
 
-void FDamageSourceSetStat::AddModifier(const FGuid& EffectId, const TSet<EDamageSource>& Sources)
+void FDamageSourceSetStat::AddModifier(const FGuid& EffectId, FDamageSourceMask Sources)
 {
 	Modifiers.Add(FDamageSourceSetModifier(EffectId, Sources));
 	bIsDirty = true;
@@ -204,7 +207,7 @@ void FDamageSourceSetStat::RemoveModifier(const FGuid& EffectId)
 	bIsDirty = true;
 }
 
-const TSet<EDamageSource>& FDamageSourceSetStat::GetValue() const
+FDamageSourceMask FDamageSourceSetStat::GetValue() const
 {
 	if (bIsDirty)
 		Recalc();
@@ -220,7 +223,6 @@ void FDamageSourceSetStat::SetBase(const TSet<EDamageSource>& NewBase)
 void FDamageSourceSetStat::InitFromBase(const TSet<EDamageSource>& InBase)
 {
 	Base = InBase;
-	Modified = InBase;
 	Modifiers.Empty();
 	bIsDirty = true;
 }
@@ -2,12 +2,12 @@
 
 // FUnitImmunities implementations
 FUnitImmunities::FUnitImmunities()
-	: BaseImmunities(), ModifiedImmunities(), ModifyingEffects(), bIsDirty(true)
+	: BaseImmunities(), ModifyingEffects(), ModifiedImmunities(), bIsDirty(true)
 {
 }
 
 FUnitImmunities::FUnitImmunities(TSet<EDamageSource> Immunities)
-	: BaseImmunities(Immunities), ModifiedImmunities(Immunities), ModifyingEffects(), bIsDirty(true)
+	: BaseImmunities(Immunities), ModifyingEffects(), ModifiedImmunities(), bIsDirty(true)
 {
 }
 
@@ -15,14 +15,14 @@ void FUnitImmunities::Recalc() const
 {
 	if (bIsDirty)
 	{
-		ModifiedImmunities = BaseImmunities.Union(CalcAdditions()).Difference(CalcSubtractions());
+		ModifiedImmunities = FDamageSourceMask(BaseImmunities).Union(CalcAdditions()).Difference(CalcSubtractions());
 		bIsDirty = false;
 	}
 }
 
-TSet<EDamageSource> FUnitImmunities::CalcAdditions() const
+FDamageSourceMask FUnitImmunities::CalcAdditions() const
 {
-	TSet<EDamageSource> AdditionsMap;
+	FDamageSourceMask AdditionsMap;
 	for (const FUnitImmunityModifier& Mod : ModifyingEffects)
 	{
 		if (Mod.bIsGranting)
@@ -31,9 +31,9 @@ TSet<EDamageSource> FUnitImmunities::CalcAdditions() const
 	return AdditionsMap;
 }
 
-TSet<EDamageSource> FUnitImmunities::CalcSubtractions() const
+FDamageSourceMask FUnitImmunities::CalcSubtractions() const
 {
-	TSet<EDamageSource> SubtractionsMap;
+	FDamageSourceMask SubtractionsMap;
 	for (const FUnitImmunityModifier& Mod : ModifyingEffects)
 	{
 		if (!Mod.bIsGranting)
@@ -61,16 +61,22 @@ bool FUnitImmunities::IsImmuneTo(EDamageSource Source) const
 	return ModifiedImmunities.Contains(Source);
 }
 
+FDamageSourceMask FUnitImmunities::GetValue() const
+{
+	if (bIsDirty)
+		Recalc();
+	return ModifiedImmunities;
+}
+
 void FUnitImmunities::InitFromBase(const FUnitImmunities& Template)
 {
 	BaseImmunities = Template.BaseImmunities;
-	ModifiedImmunities = BaseImmunities;
 	ModifyingEffects.Empty();
 	bIsDirty = true;
 }
 
 // FUnitWards implementations
-FUnitWards::FUnitWards(TSet<EDamageSource> Source)
+FUnitWards::FUnitWards(FDamageSourceMask Source)
 	: Wards(Source)
 {
 }
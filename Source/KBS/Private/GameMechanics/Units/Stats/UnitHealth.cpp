@@ -1,7 +1,13 @@
 #include "GameMechanics/Units/Stats/UnitHealth.h"
 
+namespace
+{
+	thread_local uint32 GHealthChangeSerial = 0;
+}
+
 void FUnitHealth::SetMaxBase(int32 NewBase, bool bShouldHeal)
 {
+	const int32 CurrentBefore = Current;
 	int32 OldMax = Maximum.GetValue();
 	Maximum.SetBase(NewBase);
 	int32 NewMax = Maximum.GetValue();
@@ -15,12 +21,15 @@ void FUnitHealth::SetMaxBase(int32 NewBase, bool bShouldHeal)
 	{
 		ClampCurrent();
 	}
+	if (Current != CurrentBefore)
+		MarkChanged();
 }
 
-void FUnitHealth::AddMaxModifier(const FGuid& EffectId, int32 Amount, bool bShouldHeal)
+FStatModifierHandle FUnitHealth::AddMaxModifier(int32 Amount, bool bShouldHeal)
 {
+	const int32 CurrentBefore = Current;
 	int32 OldMax = Maximum.GetValue();
-	Maximum.AddFlatModifier(EffectId, Amount);
+	const FStatModifierHandle Handle = Maximum.AddFlatModifier(Amount);
 	int32 NewMax = Maximum.GetValue();
 	int32 Delta = NewMax - OldMax;
 
@@ -32,12 +41,16 @@ void FUnitHealth::AddMaxModifier(const FGuid& EffectId, int32 Amount, bool bShou
 	{
 		ClampCurrent();
 	}
+	if (Current != CurrentBefore)
+		MarkChanged();
+	return Handle;
 }
 
-void FUnitHealth::AddMaxMultiplier(const FGuid& EffectId, int32 Amount, bool bShouldHeal)
+FStatModifierHandle FUnitHealth::AddMaxMultiplier(int32 Amount, bool bShouldHeal)
 {
+	const int32 CurrentBefore = Current;
 	int32 OldMax = Maximum.GetValue();
-	Maximum.AddMultiplier(EffectId, Amount);
+	const FStatModifierHandle Handle = Maximum.AddMultiplier(Amount);
 	int32 NewMax = Maximum.GetValue();
 	int32 Delta = NewMax - OldMax;
 
@@ -49,18 +62,18 @@ void FUnitHealth::AddMaxMultiplier(const FGuid& EffectId, int32 Amount, bool bSh
 	{
 		ClampCurrent();
 	}
+	if (Current != CurrentBefore)
+		MarkChanged();
+	return Handle;
 }
 
-void FUnitHealth::RemoveMaxModifier(const FGuid& EffectId, int32 Amount)
-{
-	Maximum.RemoveFlatModifier(EffectId, Amount);
-	ClampCurrent();
-}
-
-void FUnitHealth::RemoveMaxMultiplier(const FGuid& EffectId, int32 Amount)
+void FUnitHealth::RemoveMaxModifier(FStatModifierHandle Handle)
 {
-	Maximum.RemoveMultiplier(EffectId, Amount);
+	const int32 CurrentBefore = Current;
+	Maximum.RemoveModifier(Handle);
 	ClampCurrent();
+	if (Current != CurrentBefore)
+		MarkChanged();
 }
 
 
@@ -69,17 +82,38 @@ void FUnitHealth::SetCurrent(int32 NewCurrent)
 {
 	Current = NewCurrent;
 	ClampCurrent();
+	MarkChanged();
 }
 
 void FUnitHealth::ApplyDelta(int32 Amount)
 {
 	Current += Amount;
 	ClampCurrent();
+	MarkChanged();
 }
 
 void FUnitHealth::FullHeal()
 {
 	Current = Maximum.GetValue();
+	MarkChanged();
+}
+
+uint32 FUnitHealth::GetChangeSerial()
+{
+	return GHealthChangeSerial;
+}
+
+uint64 FUnitHealth::GetHashKey(uint32 Salt) const
+{
+	// Keyed per point rather than bucketed so distinct health values never share a key
+	return BattleZobrist::Key(BattleZobrist::EFeature::Health, Salt, Current);
+}
+
+void FUnitHealth::MarkChanged()
+{
+	++GHealthChangeSerial;
+	if (LiveHash.IsBound())
+		LiveHash.Update(GetHashKey(LiveHash.GetSalt()));
 }
 
 int32 FUnitHealth::GetMaximum() const
@@ -105,4 +139,5 @@ void FUnitHealth::InitFromBase(const FUnitHealth& Template)
 {
 	Maximum.InitFromBase(Template.Maximum.GetBase());
 	Current = Maximum.GetValue();
+	MarkChanged();
 }
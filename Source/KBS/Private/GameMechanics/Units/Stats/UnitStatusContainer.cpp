@@ -1,7 +1,32 @@
 #include "GameMechanics/Units/Stats/UnitStatusContainer.h"
+#include "Misc/ScopeExit.h"
+
+namespace
+{
+	thread_local uint32 GStatusChangeSerial = 0;
+}
+
+uint32 FUnitStatusContainer::GetChangeSerial()
+{
+	return GStatusChangeSerial;
+}
+
+void FUnitStatusContainer::MarkChanged()
+{
+	++GStatusChangeSerial;
+	if (LiveHash.IsBound())
+		LiveHash.Update(GetHashKey(LiveHash.GetSalt()));
+}
+
+uint64 FUnitStatusContainer::GetHashKey(uint32 Salt) const
+{
+	return BattleZobrist::Key(BattleZobrist::EFeature::Status, Salt, GetStatusBits()) ^
+		BattleZobrist::Key(BattleZobrist::EFeature::FlankDelay, Salt, FlankDelay);
+}
 
 bool FUnitStatusContainer::AddStatus(EUnitStatus Status, const FGuid& EffectId)
 {
+	ON_SCOPE_EXIT { MarkChanged(); };
 	switch (Status)
 	{
 	case EUnitStatus::TurnBlocked:
@@ -53,6 +78,7 @@ bool FUnitStatusContainer::AddStatus(EUnitStatus Status, const FGuid& EffectId)
 
 bool FUnitStatusContainer::RemoveStatus(EUnitStatus Status, const FGuid& EffectId)
 {
+	ON_SCOPE_EXIT { MarkChanged(); };
 	switch (Status)
 	{
 	case EUnitStatus::TurnBlocked:
@@ -100,6 +126,9 @@ bool FUnitStatusContainer::RemoveStatus(EUnitStatus Status, const FGuid& EffectI
 
 void FUnitStatusContainer::ClearStatus(EUnitStatus Status)
 {
+	// Every turn start clears Defending; only an actual change may invalidate the caches
+	if (!IsStatusActive(Status))
+		return;
 	switch (Status)
 	{
 	case EUnitStatus::TurnBlocked:
@@ -124,6 +153,7 @@ void FUnitStatusContainer::ClearStatus(EUnitStatus Status)
 		bDefending = false;
 		break;
 	}
+	MarkChanged();
 }
 
 void FUnitStatusContainer::ClearAll()
@@ -135,6 +165,7 @@ void FUnitStatusContainer::ClearAll()
 	bFleeing = false;
 	bChanneling = false;
 	bDefending = false;
+	MarkChanged();
 }
 
 bool FUnitStatusContainer::CanAct() const
@@ -179,3 +210,15 @@ bool FUnitStatusContainer::IsStatusActive(EUnitStatus Status) const
 		return false;
 	}
 }
+
+int32 FUnitStatusContainer::GetStatusBits() const
+{
+	// IsStatusActive does not report Dead
+	int32 StatusBits = bDead ? 1 << static_cast<int32>(EUnitStatus::Dead) : 0;
+	for (int32 Status = 0; Status < static_cast<int32>(EUnitStatus::Dead); ++Status)
+	{
+		if (IsStatusActive(static_cast<EUnitStatus>(Status)))
+			StatusBits |= 1 << Status;
+	}
+	return StatusBits;
+}
@@ -16,6 +16,30 @@ FString AUnit::GetLogName() const
 	return FString::Printf(TEXT("%s [%s]"), *Name, *UnitID.ToString().Left(8));
 }
 
+uint64 AUnit::GetStateHashKey() const
+{
+	const uint32 Salt = BattleZobrist::UnitSalt(UnitID);
+	return BaseStats.Health.GetHashKey(Salt) ^ BaseStats.Status.GetHashKey(Salt) ^
+		(EffectManager ? EffectManager->GetHashKey(Salt) : 0);
+}
+
+void AUnit::BindLiveHash(const TSharedRef<uint64>& Sink)
+{
+	const uint32 Salt = BattleZobrist::UnitSalt(UnitID);
+	BaseStats.Health.BindLiveHash(Sink, Salt);
+	BaseStats.Status.BindLiveHash(Sink, Salt);
+	if (EffectManager)
+		EffectManager->BindLiveHash(Sink, Salt);
+}
+
+void AUnit::UnbindLiveHash()
+{
+	BaseStats.Health.UnbindLiveHash();
+	BaseStats.Status.UnbindLiveHash();
+	if (EffectManager)
+		EffectManager->UnbindLiveHash();
+}
+
 AUnit::AUnit()
 {
 	UnitID = FGuid::NewGuid();
@@ -114,9 +138,9 @@ FUnitDisplayData AUnit::GetDisplayData() const
 {
 	const FString Name = UnitDefinition ? UnitDefinition->UnitName : TEXT("Unknown");
 	UTexture2D* Portrait = ActiveVisualDefinition ? ActiveVisualDefinition->Portrait : nullptr;
-	const TArray<TObjectPtr<UBattleEffect>> Effects = EffectManager
-		                                                  ? EffectManager->GetActiveEffects()
-		                                                  : TArray<TObjectPtr<UBattleEffect>>();
+	const TArray<FActiveBattleEffect> Effects = EffectManager
+		                                            ? EffectManager->GetActiveEffects()
+		                                            : TArray<FActiveBattleEffect>();
 	return BuildUnitDisplayData(Name, BaseStats.Health.GetCurrent(), BaseStats, Portrait, Effects, Weapons,
 	                            GridMetadata.Team);
 }
@@ -148,38 +172,6 @@ void AUnit::HandleDeath(bool Emits)
 	if (Emits) OnUnitDied.Broadcast(this);
 }
 
-void AUnit::EnterCombatResolutionPhase(FCombatContext& Context, FHitInstance& Hit, bool IsTarget)
-{
-	if (IsTarget)
-		OnCombatResolutionCaptured.Broadcast(Context, Hit);
-	else
-		OnStartingCombatResolution.Broadcast(Context, Hit);
-}
-
-void AUnit::EnterCombatCalculationPhase(FCombatContext& Context, FHitInstance& Hit, bool IsTarget)
-{
-	if (IsTarget)
-		OnBeingTargetedInCalculation.Broadcast(Context, Hit);
-	else
-		OnResolutionCalculating.Broadcast(Context, Hit);
-}
-
-void AUnit::EnterCombatResultApplyPhase(FCombatContext& Context, FHitInstance& Hit, FDamageResult& DamageResult, bool IsTarget)
-{
-	if (IsTarget)
-		OnCombatResolutionResultApplied.Broadcast(Context, Hit, DamageResult);
-	else
-		OnCombatResolutionResultApplication.Broadcast(Context, Hit, DamageResult);
-}
-
-void AUnit::EnterCombatEffectApplicationPhase(FCombatContext& Context, FHitInstance& Hit, bool IsTarget)
-{
-	if (IsTarget)
-		OnCombatResolutionEffectApplied.Broadcast(Context, Hit);
-	else
-		OnCombatResolutionEffectApplication.Broadcast(Context, Hit);
-}
-
 void AUnit::ChangeUnitHP(int32 Delta, bool Emits)
 {
 	BaseStats.Health.ApplyDelta(Delta);
@@ -193,17 +185,18 @@ void AUnit::ConsumeWard(EDamageSource Source, bool Emits)
 	if (Emits) OnUnitStatsModified.Broadcast(this, BaseStats);
 }
 
-bool AUnit::ApplyEffect(UBattleEffect* Effect, bool Emits)
+bool AUnit::ApplyEffect(UBattleEffect* Effect, AUnit* Source, bool Emits)
 {
 	checkf(Effect, TEXT("ApplyEffect called with null Effect on %s"), *GetLogName());
 	checkf(EffectManager, TEXT("EffectManager is null on %s - component may have been GC'd"), *GetLogName());
 	if (IsDead()) return false;
-	const bool bApplied = EffectManager->AddEffect(Effect);
-	if (bApplied && Emits) OnUnitEffectApplied.Broadcast(this, Effect);
+	FActiveBattleEffect Applied;
+	const bool bApplied = EffectManager->AddEffect(Effect, Source, &Applied);
+	if (bApplied && Emits) OnUnitEffectApplied.Broadcast(this, Applied);
 	return bApplied;
 }
 
-void AUnit::NotifyEffectTriggered(UBattleEffect* Effect)
+void AUnit::NotifyEffectTriggered(const FActiveBattleEffect& Effect)
 {
 	if (IsDead()) return;
 	OnUnitEffectTriggered.Broadcast(this, Effect);
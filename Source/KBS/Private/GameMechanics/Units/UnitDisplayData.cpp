@@ -73,14 +73,14 @@ FCombatDescriptorDisplayData ConvertWeapon(UWeapon* Weapon)
 	DisplayData.DamageTypes = FString::Join(DamageTypeArray, TEXT(" + "));
 	return DisplayData;
 }
-TArray<FString> ConvertActiveEffects(const TArray<TObjectPtr<UBattleEffect>>& Effects)
+TArray<FString> ConvertActiveEffects(const TArray<FActiveBattleEffect>& Effects)
 {
 	TArray<FString> Result;
-	for (const TObjectPtr<UBattleEffect>& Effect : Effects)
+	for (const FActiveBattleEffect& Active : Effects)
 	{
-		if (Effect)
+		if (Active.Effect)
 		{
-			Result.Add(Effect->GetEffectName().ToString());
+			Result.Add(Active.Effect->GetEffectName().ToString());
 		}
 	}
 	return Result;
@@ -103,7 +103,7 @@ FUnitDisplayData BuildUnitDisplayData(
 	float CurrentHealth,
 	const FUnitCoreStats& Stats,
 	UTexture2D* PortraitTexture,
-	const TArray<TObjectPtr<UBattleEffect>>& ActiveEffects,
+	const TArray<FActiveBattleEffect>& ActiveEffects,
 	const TArray<TObjectPtr<UWeapon>>& Weapons,
 	ETeamSide TeamSide
 )
@@ -0,0 +1,46 @@
+#include "GameplayTypes/DamageTypes.h"
+#include "GameplayTypes/GridBitboard.h"
+
+void FAreaShape::Compile()
+{
+	for (int32 Row = 0; Row < FGridConstants::GridSize; ++Row)
+	{
+		for (int32 Col = 0; Col < FGridConstants::GridSize; ++Col)
+		{
+			CenterMasks[Row * FGridConstants::GridSize + Col] = BuildMask(Row, Col);
+		}
+	}
+	bCompiled = true;
+}
+
+uint64 FAreaShape::GetMask(const FTacCoordinates& CenterCell) const
+{
+	const bool bInGrid = CenterCell.Row >= 0 && CenterCell.Row < FGridConstants::GridSize
+		&& CenterCell.Col >= 0 && CenterCell.Col < FGridConstants::GridSize;
+	if (bCompiled && bInGrid)
+	{
+		return CenterMasks[CenterCell.Row * FGridConstants::GridSize + CenterCell.Col];
+	}
+	return BuildMask(CenterCell.Row, CenterCell.Col);
+}
+
+uint64 FAreaShape::BuildMask(int32 CenterRow, int32 CenterCol) const
+{
+	uint64 LayerLocal = 0;
+	for (const FIntPoint& Offset : RelativeCells)
+	{
+		const int32 Row = CenterRow + Offset.X;
+		const int32 Col = CenterCol + Offset.Y;
+		if (FTacCoordinates::IsValidCell(Row, Col))
+		{
+			LayerLocal |= GridBitboard::CellMask(Row, Col, ETacGridLayer::Ground);
+		}
+	}
+	switch (ShapeLayering)
+	{
+	case EShapeLayering::GroundArea:    return LayerLocal;
+	case EShapeLayering::AirArea:       return LayerLocal << FGridConstants::TotalCells;
+	case EShapeLayering::BothLayerArea: return LayerLocal | (LayerLocal << FGridConstants::TotalCells);
+	}
+	return 0;
+}
@@ -1,4 +1,5 @@
 #include "GameplayTypes/FlankCellDefinitions.h"
+#include "GameplayTypes/GridCellTables.h"
 
 const TArray<int32> FFlankCellDefinitions::CenterColumns = {1, 2, 3};
 const FTacCoordinates FFlankCellDefinitions::AttackerLeftEntranceCell(FlankEntranceBottom, FlankColRight,
@@ -52,30 +53,9 @@ bool FFlankCellDefinitions::IsEntranceAvailable(FTacCoordinates Cell)
 
 FTacCoordinates FFlankCellDefinitions::GetAvailableFlankCell(FTacCoordinates Cell, ETeamSide Team)
 {
-	if (Team == ETeamSide::Attacker)
-	{
-		if (IsRearAvailable(Cell))
-		{
-			return Cell.Col == AttackerLeftEntranceCell.Col ? AttackerLeftRearCell : AttackerRightRearCell;
-		}
-		if (IsEntranceAvailable(Cell))
-		{
-			// reversed since attacker relative is reversed
-			return Cell.Col == EntranceRightClosestCol ? AttackerLeftEntranceCell : AttackerRightEntranceCell;
-		}
-	}
-	if (Team == ETeamSide::Defender)
-	{
-		if (IsRearAvailable(Cell))
-		{
-			return Cell.Col == DefenderLeftEntranceCell.Col ? DefenderLeftRearCell : DefenderRightRearCell;
-		}
-		if (IsEntranceAvailable(Cell))
-		{
-			return Cell.Col == EntranceLeftClosestCol ? DefenderLeftEntranceCell : DefenderRightEntranceCell;
-		}
-	}
-	return FTacCoordinates::Invalid();
+	if (!GridCellTables::IsInGrid(Cell))
+		return FTacCoordinates::Invalid();
+	return GridCellTables::ToCoords(GridCellTables::Get(Cell).AvailableFlankCell[static_cast<int32>(Team)]);
 }
 
 bool FFlankCellDefinitions::IsRearAvailable(FTacCoordinates Cell)
@@ -86,16 +66,15 @@ bool FFlankCellDefinitions::IsRearAvailable(FTacCoordinates Cell)
 
 FTacCoordinates FFlankCellDefinitions::GetAdjacentNormalCell(FTacCoordinates Cell)
 {
+	if (GridCellTables::IsInGrid(Cell))
+		return GridCellTables::ToCoords(GridCellTables::Get(Cell).AdjacentNormalCell);
 	const int32 NormalCol = (Cell.Col == FlankColLeft) ? FlankColLeft + 1 : FlankColRight - 1;
 	return FTacCoordinates(Cell.Row, NormalCol, Cell.Layer);
 }
 
 FTacCoordinates FFlankCellDefinitions::GetEntranceBlockedCell(FTacCoordinates Cell)
 {
-	if (IsEntranceCell(Cell))
-	{
-		const int32 RearRow = (Cell.Row == FlankEntranceTop) ? FlankRearTop : FlankRearBottom;
-		return GetAdjacentNormalCell(FTacCoordinates(RearRow, Cell.Col, Cell.Layer));
-	}
-	return FTacCoordinates::Invalid();
+	if (!GridCellTables::IsInGrid(Cell))
+		return FTacCoordinates::Invalid();
+	return GridCellTables::ToCoords(GridCellTables::Get(Cell).EntranceBlockedCell);
 }
@@ -239,7 +239,7 @@ void UCurrentUnitPanel::RefreshEffects(AUnit* Unit)
 		return;
 	}
 
-	const TArray<TObjectPtr<UBattleEffect>>& ActiveEffects = EffectManager->GetActiveEffects();
+	const TArray<FActiveBattleEffect>& ActiveEffects = EffectManager->GetActiveEffects();
 
 	// Ensure we have enough slots (up to MAX_EFFECT_SLOTS)
 	int32 NumNeeded = FMath::Min(ActiveEffects.Num(), MAX_EFFECT_SLOTS);
@@ -261,7 +261,7 @@ void UCurrentUnitPanel::RefreshEffects(AUnit* Unit)
 	{
 		if (i < ActiveEffects.Num())
 		{
-			EffectSlots[i]->SetupEffect(ActiveEffects[i]);
+			EffectSlots[i]->SetupEffect(EffectManager, ActiveEffects[i]);
 		}
 		else
 		{
@@ -179,7 +179,7 @@ void UHoveredUnitPanel::RefreshEffectSnapshots(AUnit* Unit)
 		return;
 	}
 
-	const TArray<TObjectPtr<UBattleEffect>>& ActiveEffects = EffectManager->GetActiveEffects();
+	const TArray<FActiveBattleEffect>& ActiveEffects = EffectManager->GetActiveEffects();
 
 	// Ensure we have enough snapshot slots (up to MAX_EFFECT_SNAPSHOTS)
 	int32 NumNeeded = FMath::Min(ActiveEffects.Num(), MAX_EFFECT_SNAPSHOTS);
@@ -201,7 +201,7 @@ void UHoveredUnitPanel::RefreshEffectSnapshots(AUnit* Unit)
 	{
 		if (i < ActiveEffects.Num())
 		{
-			EffectSnapshots[i]->SetupFromEffect(ActiveEffects[i]);
+			EffectSnapshots[i]->SetupFromActiveEffect(ActiveEffects[i]);
 		}
 		else
 		{
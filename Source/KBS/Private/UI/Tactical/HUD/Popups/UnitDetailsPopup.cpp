@@ -441,16 +441,16 @@ void UUnitDetailsPopup::PopulateEffects(AUnit* Unit)
 	UBattleEffectComponent* EffectComponent = Unit->EffectManager;
 	if (!EffectComponent) return;
 
-	const TArray<TObjectPtr<UBattleEffect>>& ActiveEffects = EffectComponent->GetActiveEffects();
+	const TArray<FActiveBattleEffect>& ActiveEffects = EffectComponent->GetActiveEffects();
 
-	for (UBattleEffect* Effect : ActiveEffects)
+	for (const FActiveBattleEffect& Effect : ActiveEffects)
 	{
-		if (!Effect) continue;
+		if (!Effect.GetConfig()) continue;
 
 		UBattleEffectSlotSnapshot* EffectSlot = GetOrCreateEffectSlot();
 		if (EffectSlot)
 		{
-			EffectSlot->SetupFromEffect(Effect);
+			EffectSlot->SetupFromActiveEffect(Effect);
 		}
 	}
 }
@@ -1,5 +1,6 @@
 #include "UI/Tactical/HUD/Slots/BattleEffectSlot.h"
 #include "GameMechanics/Units/BattleEffects/BattleEffect.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffectComponent.h"
 #include "GameMechanics/Units/BattleEffects/BattleEffectDataAsset.h"
 #include "GameplayTypes/EffectTypes.h"
 #include "Components/Border.h"
@@ -19,27 +20,24 @@ void UBattleEffectSlot::NativeDestruct()
 	Super::NativeDestruct();
 }
 
-void UBattleEffectSlot::SetupEffect(UBattleEffect* Effect)
+void UBattleEffectSlot::SetupEffect(UBattleEffectComponent* Component, const FActiveBattleEffect& Effect)
 {
-	if (!Effect)
+	if (!Component || !Effect.GetEffect())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UBattleEffectSlot::SetupEffect - Effect is null"));
+		UE_LOG(LogTemp, Warning, TEXT("UBattleEffectSlot::SetupEffect - Component or Effect is null"));
 		Clear();
 		return;
 	}
 
 	// Unbind from previous effect if any
-	if (BoundEffect)
-	{
-		BoundEffect->OnDurationChange.RemoveDynamic(this, &UBattleEffectSlot::OnEffectDurationChanged);
-		BoundEffect->OnEffectRemoved.RemoveDynamic(this, &UBattleEffectSlot::OnEffectRemovedHandler);
-	}
+	Unbind();
 
+	BoundComponent = Component;
 	BoundEffect = Effect;
 
-	// Bind to effect events
-	BoundEffect->OnDurationChange.AddDynamic(this, &UBattleEffectSlot::OnEffectDurationChanged);
-	BoundEffect->OnEffectRemoved.AddDynamic(this, &UBattleEffectSlot::OnEffectRemovedHandler);
+	// Bind to the owning component's effect events, filtered by id in the handlers
+	BoundComponent->OnEffectDurationChange.AddDynamic(this, &UBattleEffectSlot::OnEffectDurationChanged);
+	BoundComponent->OnEffectRemoved.AddDynamic(this, &UBattleEffectSlot::OnEffectRemovedHandler);
 
 	// Update all visuals
 	UpdateEffectIcon();
@@ -57,12 +55,7 @@ void UBattleEffectSlot::SetupEffect(UBattleEffect* Effect)
 void UBattleEffectSlot::Clear()
 {
 	// Unbind from effect
-	if (BoundEffect)
-	{
-		BoundEffect->OnDurationChange.RemoveDynamic(this, &UBattleEffectSlot::OnEffectDurationChanged);
-		BoundEffect->OnEffectRemoved.RemoveDynamic(this, &UBattleEffectSlot::OnEffectRemovedHandler);
-		BoundEffect = nullptr;
-	}
+	Unbind();
 
 	// Clear visuals
 	if (EffectIcon)
@@ -83,25 +76,44 @@ void UBattleEffectSlot::Clear()
 	SetToolTipText(FText::GetEmpty());
 }
 
-void UBattleEffectSlot::OnEffectDurationChanged(int32 NewDuration)
+void UBattleEffectSlot::Unbind()
+{
+	if (BoundComponent)
+	{
+		BoundComponent->OnEffectDurationChange.RemoveDynamic(this, &UBattleEffectSlot::OnEffectDurationChanged);
+		BoundComponent->OnEffectRemoved.RemoveDynamic(this, &UBattleEffectSlot::OnEffectRemovedHandler);
+		BoundComponent = nullptr;
+	}
+	BoundEffect = FActiveBattleEffect();
+}
+
+void UBattleEffectSlot::OnEffectDurationChanged(const FGuid& EffectId, int32 NewDuration)
 {
+	if (EffectId != BoundEffect.EffectId)
+	{
+		return;
+	}
+	BoundEffect.Duration = NewDuration;
 	UpdateDurationDisplay();
 }
 
-void UBattleEffectSlot::OnEffectRemovedHandler(UBattleEffect* Effect)
+void UBattleEffectSlot::OnEffectRemovedHandler(const FGuid& EffectId)
 {
 	// Auto-clear when effect is removed
-	Clear();
+	if (EffectId == BoundEffect.EffectId)
+	{
+		Clear();
+	}
 }
 
 void UBattleEffectSlot::UpdateDurationDisplay()
 {
-	if (!BoundEffect || !DurationText)
+	if (!BoundEffect.GetEffect() || !DurationText)
 	{
 		return;
 	}
 
-	const int32 Duration = BoundEffect->GetDuration();
+	const int32 Duration = BoundEffect.Duration;
 
 	// Display duration as number of turns remaining
 	if (Duration > 0)
@@ -117,12 +129,12 @@ void UBattleEffectSlot::UpdateDurationDisplay()
 
 void UBattleEffectSlot::UpdateEffectFrame()
 {
-	if (!BoundEffect || !EffectFrameBorder)
+	if (!BoundEffect.GetEffect() || !EffectFrameBorder)
 	{
 		return;
 	}
 
-	UBattleEffectDataAsset* Config = BoundEffect->GetConfig();
+	UBattleEffectDataAsset* Config = BoundEffect.GetConfig();
 	if (!Config)
 	{
 		return;
@@ -130,7 +142,7 @@ void UBattleEffectSlot::UpdateEffectFrame()
 
 	FLinearColor FrameColor = NeutralFrameColor;
 
-	switch (BoundEffect->GetPolarity())
+	switch (Config->Polarity)
 	{
 		case EEffectPolarity::Positive:
 			FrameColor = PositiveFrameColor;
@@ -148,12 +160,12 @@ void UBattleEffectSlot::UpdateEffectFrame()
 
 void UBattleEffectSlot::UpdateEffectIcon()
 {
-	if (!BoundEffect || !EffectIcon)
+	if (!BoundEffect.GetEffect() || !EffectIcon)
 	{
 		return;
 	}
 
-	UBattleEffectDataAsset* Config = BoundEffect->GetConfig();
+	UBattleEffectDataAsset* Config = BoundEffect.GetConfig();
 	if (!Config)
 	{
 		return;
@@ -172,13 +184,13 @@ void UBattleEffectSlot::UpdateEffectIcon()
 
 void UBattleEffectSlot::UpdateTooltip()
 {
-	if (!BoundEffect)
+	if (!BoundEffect.GetEffect())
 	{
 		SetToolTipText(FText::GetEmpty());
 		return;
 	}
 
-	UBattleEffectDataAsset* Config = BoundEffect->GetConfig();
+	UBattleEffectDataAsset* Config = BoundEffect.GetConfig();
 	if (!Config)
 	{
 		SetToolTipText(FText::GetEmpty());
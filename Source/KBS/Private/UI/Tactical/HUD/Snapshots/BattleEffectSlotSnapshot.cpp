@@ -13,8 +13,16 @@ void UBattleEffectSlotSnapshot::SetupFromEffect(UBattleEffect* Effect)
 		Clear();
 		return;
 	}
+	Setup(Effect->GetConfig(), Effect->GetInitialDuration());
+}
 
-	UBattleEffectDataAsset* Config = Effect->GetConfig();
+void UBattleEffectSlotSnapshot::SetupFromActiveEffect(const FActiveBattleEffect& Effect)
+{
+	Setup(Effect.GetConfig(), Effect.Duration);
+}
+
+void UBattleEffectSlotSnapshot::Setup(const UBattleEffectDataAsset* Config, int32 Duration)
+{
 	if (!Config)
 	{
 		Clear();
@@ -35,7 +43,6 @@ void UBattleEffectSlotSnapshot::SetupFromEffect(UBattleEffect* Effect)
 	// Set duration
 	if (DurationText)
 	{
-		const int32 Duration = Effect->GetDuration();
 		if (Duration > 0)
 		{
 			DurationText->SetText(FText::AsNumber(Duration));
@@ -52,7 +59,7 @@ void UBattleEffectSlotSnapshot::SetupFromEffect(UBattleEffect* Effect)
 	{
 		FLinearColor FrameColor = NeutralFrameColor;
 
-		switch (Effect->GetPolarity())
+		switch (Config->Polarity)
 		{
 			case EEffectPolarity::Positive:
 				FrameColor = PositiveFrameColor;
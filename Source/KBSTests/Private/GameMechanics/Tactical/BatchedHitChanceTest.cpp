@@ -0,0 +1,61 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/UnitTestWorld.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacCombatSubsystem.h"
+#include "GameMechanics/Units/Combat/CombatDescriptor.h"
+#include "GameMechanics/Units/Combat/CombatDescriptorDataAsset.h"
+#include "GameMechanics/Units/Abilities/Passives/EvasiveStancePassive.h"
+
+// Test: In a batched AoE, an evasive target's accuracy penalty applies to its own roll only, not to the
+// targets resolved before it
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBatchedHitChanceTest,
+    "KBS.Combat.BatchedResolution.PerHitChance",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBatchedHitChanceTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 Attacks = 60;
+
+    FUnitTestWorld World;
+    UTacCombatSubsystem* Combat = World.GetSubsystem<UTacCombatSubsystem>();
+    Combat->SeedBattle(1234);
+
+    AUnit* Attacker = World.SpawnUnit(ETeamSide::Attacker);
+    Attacker->GetStats().Accuracy = FUnitStatPercent(100);
+    AUnit* Normal = World.SpawnUnit(ETeamSide::Defender, 100000);
+    AUnit* Evasive = World.SpawnUnit(ETeamSide::Defender, 100000);
+
+    UEvasiveStancePassive* Stance = NewObject<UEvasiveStancePassive>(Evasive);
+    Stance->InitializeFromDefinition(nullptr, Evasive);
+    Stance->Subscribe();
+
+    UCombatDescriptorDataAsset* Data = NewObject<UCombatDescriptorDataAsset>();
+    Data->BaseStats.TargetReach = ETargetReach::AllEnemies;
+    Data->BaseStats.BaseMagnitude = FUnitStatPositive(1);
+    // Named inversely: true makes the descriptor roll for accuracy
+    Data->bGuaranteedHit = true;
+    UCombatDescriptor* Descriptor = NewObject<UCombatDescriptor>(Attacker);
+    Descriptor->Initialize(Attacker, Data);
+
+    int32 NormalHits = 0;
+    int32 EvasiveHits = 0;
+    for (int32 i = 0; i < Attacks; ++i)
+    {
+        const TArray<FCombatHitResult> Results = Combat->ResolveAttack(Attacker, { Normal, Evasive }, Descriptor);
+        if (Results.Num() != 2)
+        {
+            AddError(TEXT("Every target gets a result"));
+            return false;
+        }
+        NormalHits += Results[0].bHit ? 1 : 0;
+        EvasiveHits += Results[1].bHit ? 1 : 0;
+    }
+
+    TestEqual("100% hit chance on the normal target is never reduced", NormalHits, Attacks);
+    TestTrue("Evasive target is rolled at the reduced chance", EvasiveHits < Attacks);
+    TestEqual("Penalty is removed once the attack ends", Attacker->GetStats().Accuracy.GetValue(), 100);
+
+    Stance->Unsubscribe();
+    return true;
+}
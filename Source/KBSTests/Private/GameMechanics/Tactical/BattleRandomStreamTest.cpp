@@ -0,0 +1,46 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/Tactical/BattleRandomStream.h"
+
+// Test: Seeded streams replay, checkpoints rewind, forks are deterministic but distinct and derived
+// streams leave their parent untouched
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleRandomStreamReplayTest,
+    "KBS.Combat.RandomStream.Replay",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleRandomStreamReplayTest::RunTest(const FString& Parameters)
+{
+    FBattleRandomStream A(1234);
+    FBattleRandomStream B(1234);
+    bool bSameSequence = true;
+    for (int32 i = 0; i < 32; ++i)
+    {
+        bSameSequence &= A.RandRange(0, 100) == B.RandRange(0, 100);
+    }
+    TestTrue("Same seed gives the same sequence", bSameSequence);
+    TestEqual("Draws are counted", A.GetDrawCount(), uint32(32));
+
+    const FBattleRandomStream::FCheckpoint Saved = A.Checkpoint();
+    const float First = A.FRand();
+    const float Second = A.FRand();
+    A.Restore(Saved);
+    TestEqual("Restore replays the first draw", A.FRand(), First);
+    TestEqual("Restore replays the second draw", A.FRand(), Second);
+    TestEqual("Restore rewinds the draw count", A.GetDrawCount(), Saved.Draws + 2);
+
+    FBattleRandomStream Root(99);
+    FBattleRandomStream SameRoot(99);
+    FBattleRandomStream ForkA = Root.Fork();
+    FBattleRandomStream ForkB = Root.Fork();
+    FBattleRandomStream ForkAAgain = SameRoot.Fork();
+    TestEqual("Forks are determined by the root seed", ForkA.GetSeed(), ForkAAgain.GetSeed());
+    TestNotEqual("Sibling forks differ", ForkA.GetSeed(), ForkB.GetSeed());
+
+    const uint32 DrawsBefore = Root.GetDrawCount();
+    TestEqual("Derived streams are determined by the seed and salt", Root.Derive(7).GetSeed(), SameRoot.Derive(7).GetSeed());
+    TestNotEqual("Salts give distinct streams", Root.Derive(7).GetSeed(), Root.Derive(8).GetSeed());
+    TestEqual("Deriving draws nothing", Root.GetDrawCount(), DrawsBefore);
+
+    return true;
+}
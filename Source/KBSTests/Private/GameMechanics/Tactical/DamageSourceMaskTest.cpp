@@ -0,0 +1,89 @@
+#include "Misc/AutomationTest.h"
+#include "GameplayTypes/DamageTypes.h"
+#include "GameMechanics/Tactical/DamageCalculation.h"
+#include "GameMechanics/Units/Combat/CombatDescriptor.h"
+#include "GameMechanics/Units/Stats/UnitStats.h"
+
+// Test: Set operations and iteration of FDamageSourceMask, and conversion from authored TSets
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FDamageSourceMaskOpsTest,
+    "KBS.Combat.DamageSourceMask.Ops",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDamageSourceMaskOpsTest::RunTest(const FString& Parameters)
+{
+    FDamageSourceMask Mask;
+    TestTrue("Default mask is empty", Mask.IsEmpty());
+    TestTrue("Empty mask has no first source", Mask.First() == EDamageSource::None);
+
+    Mask.Add(EDamageSource::Mind);
+    Mask.Add(EDamageSource::Fire);
+    Mask.Add(EDamageSource::Fire);
+    TestEqual("Duplicates count once", Mask.Num(), 2);
+    TestTrue("Contains added source", Mask.Contains(EDamageSource::Mind));
+    TestFalse("Does not contain other sources", Mask.Contains(EDamageSource::Water));
+    TestTrue("First is lowest in enum order", Mask.First() == EDamageSource::Fire);
+
+    TArray<EDamageSource> Iterated;
+    for (EDamageSource Source : Mask)
+        Iterated.Add(Source);
+    TestTrue("Iterates in enum order", Iterated == TArray<EDamageSource>({ EDamageSource::Fire, EDamageSource::Mind }));
+
+    const FDamageSourceMask Other{ EDamageSource::Fire, EDamageSource::Water };
+    TestTrue("Union", (Mask | Other) == FDamageSourceMask({ EDamageSource::Fire, EDamageSource::Water, EDamageSource::Mind }));
+    TestTrue("Intersect", (Mask & Other) == FDamageSourceMask({ EDamageSource::Fire }));
+    TestTrue("Difference", Mask.Difference(Other) == FDamageSourceMask({ EDamageSource::Mind }));
+
+    Mask.Remove(EDamageSource::Fire);
+    TestTrue("Remove drops the source", Mask.First() == EDamageSource::Mind);
+
+    const TSet<EDamageSource> Authored = { EDamageSource::Death, EDamageSource::Physical };
+    const FDamageSourceMask Converted(Authored);
+    TestTrue("Converts from TSet", Converted == FDamageSourceMask({ EDamageSource::Physical, EDamageSource::Death }));
+    TestTrue("Round-trips to TSet", Converted.ToSet().Num() == 2 && Converted.ToSet().Contains(EDamageSource::Death));
+
+    return true;
+}
+
+// Test: Source selection on masks - lowest armour for damage, unblocked then immune then warded for heals
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FDamageSourceMaskSelectionTest,
+    "KBS.Combat.DamageSourceMask.Selection",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDamageSourceMaskSelectionTest::RunTest(const FString& Parameters)
+{
+    FUnitDefenseStats Defense;
+    Defense.Armour.SetBase(50, EDamageSource::Physical);
+    Defense.Armour.SetBase(20, EDamageSource::Fire);
+    Defense.Armour.SetBase(20, EDamageSource::Water);
+
+    const FDamageSourceMask Sources{ EDamageSource::Physical, EDamageSource::Fire, EDamageSource::Water };
+    TestTrue("Lowest armour wins, ties by enum order",
+        FDamageCalculation::SelectBestDamageSource(Sources, Defense) == EDamageSource::Fire);
+    TestTrue("Empty mask selects nothing",
+        FDamageCalculation::SelectBestDamageSource(FDamageSourceMask(), Defense) == EDamageSource::None);
+
+    FCombatDescriptorStats Heal;
+    Heal.BaseMagnitude.InitFromBase(25);
+    Heal.DamageSources.InitFromBase({ EDamageSource::Life, EDamageSource::Water });
+
+    FUnitDefenseStats Target;
+    TestTrue("Unblocked source first", FDamageCalculation::CalculateHeal(Heal, Target).DamageSource == EDamageSource::Water);
+
+    Target.Wards.Add(EDamageSource::Water);
+    TestTrue("Warded source is skipped", FDamageCalculation::CalculateHeal(Heal, Target).DamageSource == EDamageSource::Life);
+
+    Target.Immunities = FUnitImmunities({ EDamageSource::Life });
+    TestTrue("All blocked: immune source before warded",
+        FDamageCalculation::CalculateHeal(Heal, Target).DamageSource == EDamageSource::Life);
+
+    Target.Immunities.AddModifier(FGuid::NewGuid(), EDamageSource::Life, false);
+    TestTrue("Revoked immunity makes the source usable",
+        FDamageCalculation::CalculateHeal(Heal, Target).DamageSource == EDamageSource::Life);
+    TestEqual("Heal keeps the descriptor magnitude", FDamageCalculation::CalculateHeal(Heal, Target).Damage, 25);
+
+    return true;
+}
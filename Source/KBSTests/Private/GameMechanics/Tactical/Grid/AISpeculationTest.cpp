@@ -0,0 +1,63 @@
+#include "Misc/AutomationTest.h"
+#include "Async/Future.h"
+#include "GameMechanics/UnitTestWorld.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacGridSubsystem.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/TacCombatSubsystem.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/Services/TacAICombatService.h"
+
+namespace
+{
+    // A finished search, so only the staleness check decides whether it is handed over
+    void SpeculateFor(UTacAICombatService* AIService, AUnit* Unit)
+    {
+        AIService->Speculate(Unit, FAiThinkTask(MakeFulfilledPromise<FSimAction>(FSimAction::Wait()).GetFuture(),
+                                                MakeShared<std::atomic<bool>>(false)));
+    }
+}
+
+// Test: A speculation is handed over only to the unit it was for and only while the battle is as it was
+// when it started; health, status or stat changes made during the presentation discard it, turn
+// housekeeping that changes nothing does not
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAISpeculationTest,
+    "KBS.Grid.AI.SpeculationInvalidation",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FAISpeculationTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    UTacAICombatService* AIService = NewObject<UTacAICombatService>(World.Get());
+    AIService->Initialize(World.GetSubsystem<UTacGridSubsystem>(), World.GetSubsystem<UTacCombatSubsystem>());
+    AUnit* Orc = World.SpawnUnit(ETeamSide::Defender);
+    AUnit* Knight = World.SpawnUnit(ETeamSide::Attacker);
+    FAiThinkTask Task;
+
+    SpeculateFor(AIService, Orc);
+    TestTrue("Unchanged battle hands the speculation over", AIService->TakeSpeculation(Orc, Task));
+    TestTrue("with its task", Task.IsReady());
+    TestFalse("A speculation is handed over once", AIService->TakeSpeculation(Orc, Task));
+
+    SpeculateFor(AIService, Orc);
+    TestFalse("Another unit acting does not take it", AIService->TakeSpeculation(Knight, Task));
+    TestFalse("and it is discarded", AIService->TakeSpeculation(Orc, Task));
+
+    SpeculateFor(AIService, Orc);
+    Knight->HandleTurnEnd();
+    Orc->HandleTurnStart();
+    TestTrue("Turn housekeeping that changes nothing keeps it", AIService->TakeSpeculation(Orc, Task));
+
+    SpeculateFor(AIService, Orc);
+    Knight->ChangeUnitHP(-10);
+    TestFalse("Health change discards it", AIService->TakeSpeculation(Orc, Task));
+
+    SpeculateFor(AIService, Orc);
+    Orc->GetStats().Status.AddStatus(EUnitStatus::TurnBlocked, FGuid::NewGuid());
+    TestFalse("Status change discards it", AIService->TakeSpeculation(Orc, Task));
+
+    SpeculateFor(AIService, Orc);
+    Knight->GetStats().Accuracy.AddFlatModifier(-20);
+    TestFalse("Stat modifier discards it", AIService->TakeSpeculation(Orc, Task));
+
+    return true;
+}
@@ -0,0 +1,59 @@
+#include "Misc/AutomationTest.h"
+#include "Async/Async.h"
+#include "GameMechanics/UnitTestWorld.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/Services/TacAICombatService.h"
+
+namespace
+{
+    // Stands in for a search: runs until cancelled or released, then answers an attack like a finished one
+    FAiThinkTask StartFakeSearch(const FTacCoordinates& Target, TSharedRef<std::atomic<bool>> Release)
+    {
+        TSharedRef<std::atomic<bool>> CancelFlag = MakeShared<std::atomic<bool>>(false);
+        return FAiThinkTask(Async(EAsyncExecution::ThreadPool,
+            [Target, CancelFlag, Release]()
+            {
+                while (!CancelFlag->load() && !Release->load())
+                    FPlatformProcess::Sleep(0.001f);
+                return FSimAction::Attack(Target);
+            }), CancelFlag);
+    }
+}
+
+// Test: A search still in flight when the battle ends (the state cancels it on exit) or when its unit
+// dies answers as usual, but FinishThinking turns that answer into no decision
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAIThinkCancelTest,
+    "KBS.Grid.AI.CancelledThinkAppliesNothing",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FAIThinkCancelTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    UGridDataManager* DataManager = World.SpawnGrid();
+    AUnit* Orc = World.SpawnUnit(ETeamSide::Defender);
+    AUnit* Knight = World.SpawnUnit(ETeamSide::Attacker);
+    const FTacCoordinates KnightCell(1, 2, ETacGridLayer::Ground);
+    DataManager->PlaceUnit(Orc, 3, 2, ETacGridLayer::Ground);
+    DataManager->PlaceUnit(Knight, KnightCell);
+    UTacAICombatService* AIService = NewObject<UTacAICombatService>(World.Get());
+    const TSharedRef<std::atomic<bool>> Release = MakeShared<std::atomic<bool>>(false);
+
+    FAiThinkTask BattleEnd = StartFakeSearch(KnightCell, Release);
+    TestFalse("Search is in flight", BattleEnd.IsReady());
+    BattleEnd.Cancel();
+    BattleEnd.Wait();
+    TestTrue("Cancelled search still answers", BattleEnd.IsReady());
+    TestTrue("and knows it was cancelled", BattleEnd.IsCancelled());
+    TestFalse("Cancelled search applies no decision", AIService->FinishThinking(Orc, BattleEnd).bHasDecision);
+    TestFalse("and the task is spent", BattleEnd.IsValid());
+
+    FAiThinkTask Death = StartFakeSearch(KnightCell, Release);
+    Orc->ChangeUnitHP(-1000);
+    Release->store(true);
+    Death.Wait();
+    TestFalse("Search finished without a cancel", Death.IsCancelled());
+    TestFalse("A unit that died mid-search applies no decision", AIService->FinishThinking(Orc, Death).bHasDecision);
+
+    return true;
+}
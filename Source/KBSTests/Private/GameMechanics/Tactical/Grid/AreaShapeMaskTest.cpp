@@ -0,0 +1,34 @@
+#include "Misc/AutomationTest.h"
+#include "GameplayTypes/DamageTypes.h"
+#include "GameplayTypes/GridBitboard.h"
+
+// Test: Compiled area masks apply layering, clip to valid cells and match on-the-fly masks
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAreaShapeMaskTest,
+    "KBS.Grid.AreaShape.Mask",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FAreaShapeMaskTest::RunTest(const FString& Parameters)
+{
+    FAreaShape Plus;
+    Plus.RelativeCells = { FIntPoint(0, 0), FIntPoint(-1, 0), FIntPoint(1, 0), FIntPoint(0, -1), FIntPoint(0, 1) };
+    Plus.ShapeLayering = EShapeLayering::GroundArea;
+
+    const uint64 Uncompiled = Plus.GetMask(FTacCoordinates(2, 1));
+    Plus.Compile();
+    TestTrue("Shape is compiled", Plus.IsCompiled());
+    TestEqual("Compiled mask matches on-the-fly mask", Plus.GetMask(FTacCoordinates(2, 1)), Uncompiled);
+
+    const uint64 Center = Plus.GetMask(FTacCoordinates(2, 2, ETacGridLayer::Air));
+    TestEqual("Plus covers 5 cells", GridBitboard::Count(Center), 5);
+    TestEqual("Ground layering ignores center layer", Center & GridBitboard::LayerMask(ETacGridLayer::Air), uint64(0));
+    TestEqual("Restricted (2,0) is clipped", GridBitboard::Count(Uncompiled), 4);
+
+    FAreaShape BothLayers = Plus;
+    BothLayers.ShapeLayering = EShapeLayering::BothLayerArea;
+    BothLayers.Compile();
+    TestEqual("Both layers doubles coverage", GridBitboard::Count(BothLayers.GetMask(FTacCoordinates(2, 2))), 10);
+
+    return true;
+}
@@ -0,0 +1,92 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/UnitTestWorld.h"
+#include "GameMechanics/Tactical/Grid/BattleTeam.h"
+
+namespace
+{
+    // Compares the incrementally kept counters against a scan of the members
+    bool MatchesRecount(FAutomationTestBase& Test, const TCHAR* Step, const UBattleTeam* Team)
+    {
+        int32 Alive = 0;
+        int32 OnField = 0;
+        int32 AliveOnField = 0;
+        for (const AUnit* Unit : Team->GetUnits())
+        {
+            const bool bAlive = !Unit->IsDead();
+            const bool bOnField = Unit->GetGridMetadata().IsOnField();
+            Alive += bAlive;
+            OnField += bOnField;
+            AliveOnField += bAlive && bOnField;
+        }
+        const bool bMatches = Team->GetAliveCount() == Alive && Team->GetOnFieldCount() == OnField
+            && Team->GetOffFieldCount() == Alive - AliveOnField && Team->CanContinueFight() == (AliveOnField > 0)
+            && Team->IsAnyUnitAlive() == (Alive > 0) && Team->IsAnyUnitOnField() == (OnField > 0);
+        if (!bMatches)
+        {
+            Test.AddError(FString::Printf(TEXT("%s: counters (alive %d, on field %d, off field %d) differ from a recount (%d, %d, %d)"),
+                Step, Team->GetAliveCount(), Team->GetOnFieldCount(), Team->GetOffFieldCount(),
+                Alive, OnField, Alive - AliveOnField));
+        }
+        return bMatches;
+    }
+}
+
+// Test: Liveness counters follow every transition - death, leaving and returning to the field, revival
+// and removal - and agree with a full recount after each
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleTeamCountersTest,
+    "KBS.Grid.BattleTeam.LivenessCounters",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleTeamCountersTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    UGridDataManager* DataManager = World.SpawnGrid();
+    UBattleTeam* Team = DataManager->GetTeamBySide(ETeamSide::Attacker);
+    AUnit* Knight = World.SpawnUnit(ETeamSide::Attacker);
+    AUnit* Archer = World.SpawnUnit(ETeamSide::Attacker);
+    Team->AddUnit(Knight);
+    Team->AddUnit(Archer);
+    if (!MatchesRecount(*this, TEXT("Before placement"), Team))
+        return false;
+    TestEqual("Unplaced members are alive off field", Team->GetOffFieldCount(), 2);
+
+    const FTacCoordinates KnightCell(1, 2, ETacGridLayer::Ground);
+    DataManager->PlaceUnit(Knight, KnightCell);
+    DataManager->PlaceUnit(Archer, 0, 2, ETacGridLayer::Ground);
+    if (!MatchesRecount(*this, TEXT("After placement"), Team))
+        return false;
+
+    DataManager->PlaceUnitOffField(Archer, false, false);
+    if (!MatchesRecount(*this, TEXT("After leaving the field"), Team))
+        return false;
+    TestTrue("Other unit still fights", Team->IsOtherUnitOnField(Archer));
+
+    Knight->ChangeUnitHP(-1000);
+    if (!MatchesRecount(*this, TEXT("After dying on the field"), Team))
+        return false;
+    TestFalse("A dead unit on the field cannot carry the fight", Team->CanContinueFight());
+
+    DataManager->RemoveUnit(Knight);
+    DataManager->PushCorpse(Knight, KnightCell);
+    if (!MatchesRecount(*this, TEXT("After becoming a corpse"), Team))
+        return false;
+
+    TestTrue("Archer returns", DataManager->ReturnUnitToField(Archer->GetUnitID(), FTacCoordinates(1, 1, ETacGridLayer::Ground)));
+    if (!MatchesRecount(*this, TEXT("After returning"), Team))
+        return false;
+    TestTrue("Returned unit carries the fight", Team->CanContinueFight());
+
+    DataManager->PopCorpse(KnightCell);
+    Knight->GetStats().Status.ClearDead();
+    Knight->GetStats().Health = FUnitHealth(100);
+    DataManager->PlaceUnit(Knight, KnightCell);
+    if (!MatchesRecount(*this, TEXT("After revival"), Team))
+        return false;
+    TestEqual("Both alive again", Team->GetAliveCount(), 2);
+
+    DataManager->RemoveUnitFromGrid(Archer);
+    TestFalse("Removed unit leaves the team", Team->ContainsUnit(Archer));
+    return MatchesRecount(*this, TEXT("After removal"), Team);
+}
@@ -0,0 +1,216 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/UnitTestWorld.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/CombatPhaseRegistry.h"
+#include "GameplayTypes/CombatTypes.h"
+#include "UObject/Package.h"
+
+namespace
+{
+    TArray<int32> GCalls;
+    FCombatPhaseRegistry* GRegistry = nullptr;
+    FCombatListenerHandle GLateHandle;
+
+    void RecordFirst(UObject*, const FCombatPhaseEvent&) { GCalls.Add(1); }
+    void RecordSecond(UObject*, const FCombatPhaseEvent&) { GCalls.Add(2); }
+    void RecordThird(UObject*, const FCombatPhaseEvent&) { GCalls.Add(3); }
+
+    void RemoveLate(UObject*, const FCombatPhaseEvent&)
+    {
+        GCalls.Add(4);
+        GRegistry->Remove(GLateHandle);
+    }
+
+    void AddDuringDispatch(UObject*, const FCombatPhaseEvent&)
+    {
+        GCalls.Add(5);
+        GRegistry->Add(GetTransientPackage(), &RecordThird, ECombatPhaseMask::Calculation, 100);
+    }
+
+    struct FScopedCall
+    {
+        int32 Listener = 0;
+        ECombatRole Role = ECombatRole::None;
+        bool bHasHit = false;
+
+        bool operator==(const FScopedCall& Other) const
+        {
+            return Listener == Other.Listener && Role == Other.Role && bHasHit == Other.bHasHit;
+        }
+    };
+    TArray<FScopedCall> GScopedCalls;
+
+    template <int32 Listener>
+    void RecordScoped(UObject*, const FCombatPhaseEvent& Event)
+    {
+        GScopedCalls.Add({ Listener, Event.Role, Event.Hit != nullptr });
+    }
+
+    // Dispatches and compares what the scoped listeners heard, in order
+    bool Heard(FAutomationTestBase& Test, const TCHAR* Step, TFunctionRef<void()> Dispatch,
+               const TArray<FScopedCall>& Expected)
+    {
+        GScopedCalls.Reset();
+        Dispatch();
+        if (GScopedCalls == Expected)
+            return true;
+        Test.AddError(FString::Printf(TEXT("%s: %d calls heard, %d expected, or in another order or role"),
+            Step, GScopedCalls.Num(), Expected.Num()));
+        return false;
+    }
+}
+
+// Test: Listeners run by priority, ties in registration order, and only for the phases in their mask
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCombatPhaseRegistryOrderTest,
+    "KBS.Combat.PhaseRegistry.Order",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FCombatPhaseRegistryOrderTest::RunTest(const FString& Parameters)
+{
+    FCombatPhaseRegistry Registry;
+    FCombatContext Context;
+    UObject* Listener = GetTransientPackage();
+    GCalls.Reset();
+
+    Registry.Add(Listener, &RecordSecond, ECombatPhaseMask::Calculation);
+    Registry.Add(Listener, &RecordThird, ECombatPhaseMask::Calculation);
+    Registry.Add(Listener, &RecordFirst, ECombatPhaseMask::Calculation | ECombatPhaseMask::EffectApplication, 10);
+
+    Registry.Dispatch(ECombatPhase::Calculation, Context, nullptr);
+    TestEqual("All three ran", GCalls.Num(), 3);
+    if (GCalls.Num() == 3)
+    {
+        TestEqual("Highest priority first", GCalls[0], 1);
+        TestEqual("Ties keep registration order", GCalls[1], 2);
+        TestEqual("Ties keep registration order", GCalls[2], 3);
+    }
+
+    GCalls.Reset();
+    Registry.Dispatch(ECombatPhase::EffectApplication, Context, nullptr);
+    TestEqual("Only the masked listener runs", GCalls.Num(), 1);
+    Registry.Dispatch(ECombatPhase::ResultApplication, Context, nullptr);
+    TestEqual("Unlistened phase runs nothing", GCalls.Num(), 1);
+
+    GCalls.Reset();
+    Registry.Dispatch(ECombatPhase::Calculation, Context, nullptr, nullptr, ECombatRole::Target, false);
+    TestEqual("Global listeners can be excluded", GCalls.Num(), 0);
+
+    Registry.RemoveAll(Listener);
+    Registry.Dispatch(ECombatPhase::Calculation, Context, nullptr);
+    TestEqual("RemoveAll drops every registration", GCalls.Num(), 0);
+
+    return true;
+}
+
+// Test: Removing or adding listeners from inside a callback takes effect after the dispatch
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCombatPhaseRegistryReentrancyTest,
+    "KBS.Combat.PhaseRegistry.Reentrancy",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FCombatPhaseRegistryReentrancyTest::RunTest(const FString& Parameters)
+{
+    FCombatPhaseRegistry Registry;
+    FCombatContext Context;
+    UObject* Listener = GetTransientPackage();
+    GRegistry = &Registry;
+    GCalls.Reset();
+
+    Registry.Add(Listener, &RemoveLate, ECombatPhaseMask::Calculation, 5);
+    Registry.Add(Listener, &AddDuringDispatch, ECombatPhaseMask::Calculation, 3);
+    GLateHandle = Registry.Add(Listener, &RecordSecond, ECombatPhaseMask::Calculation, 1);
+    TestTrue("Handle is valid", GLateHandle.IsValid());
+
+    Registry.Dispatch(ECombatPhase::Calculation, Context, nullptr);
+    TestTrue("Removed listener is skipped, added one waits", GCalls == TArray<int32>({ 4, 5 }));
+    TestFalse("Remove clears the handle", GLateHandle.IsValid());
+
+    GCalls.Reset();
+    Registry.Reset();
+    Registry.Add(Listener, &AddDuringDispatch, ECombatPhaseMask::Calculation, 3);
+    Registry.Dispatch(ECombatPhase::Calculation, Context, nullptr);
+    GCalls.Reset();
+    Registry.Dispatch(ECombatPhase::Calculation, Context, nullptr);
+    TestTrue("Listener added during a dispatch runs next time, sorted by priority",
+        GCalls.Num() >= 2 && GCalls[0] == 3 && GCalls[1] == 5);
+
+    GRegistry = nullptr;
+    return true;
+}
+
+// Test: Unit-scoped listeners hear only their own side of the hit, and the attack-level PreResolution
+// dispatch carries no Hit and reaches only the attacker side
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCombatPhaseRegistryScopedTest,
+    "KBS.Combat.PhaseRegistry.ScopedRoles",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FCombatPhaseRegistryScopedTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    AUnit* Knight = World.SpawnUnit(ETeamSide::Attacker);
+    AUnit* Orc = World.SpawnUnit(ETeamSide::Defender);
+    AUnit* Goblin = World.SpawnUnit(ETeamSide::Defender);
+    FCombatPhaseRegistry Registry;
+    UObject* Listener = GetTransientPackage();
+    const ECombatPhaseMask Phases = ECombatPhaseMask::PreResolution | ECombatPhaseMask::Calculation;
+    Registry.Add(Listener, &RecordScoped<1>, Phases, 0, Knight, ECombatRole::Attacker);
+    Registry.Add(Listener, &RecordScoped<2>, Phases, 0, Orc, ECombatRole::Target);
+    Registry.Add(Listener, &RecordScoped<3>, Phases, 0, Goblin);
+    Registry.Add(Listener, &RecordScoped<4>, Phases, 0, Orc, ECombatRole::Attacker);
+
+    FCombatContext Context;
+    Context.Attacker = Knight;
+    FHitInstance Hit;
+    Hit.Attacker = Knight;
+    Hit.Target = Orc;
+
+    // Dispatched as UTacCombatSubsystem does: attack level for the attacker, then per hit for the target
+    if (!Heard(*this, TEXT("Attack-level PreResolution"),
+        [&] { Registry.Dispatch(ECombatPhase::PreResolution, Context, nullptr, nullptr, ECombatRole::Attacker); },
+        { { 1, ECombatRole::Attacker, false } }))
+        return false;
+    if (!Heard(*this, TEXT("Per-hit PreResolution"),
+        [&] { Registry.Dispatch(ECombatPhase::PreResolution, Context, &Hit, nullptr, ECombatRole::Target, false); },
+        { { 2, ECombatRole::Target, true } }))
+        return false;
+    return Heard(*this, TEXT("Calculation"),
+        [&] { Registry.Dispatch(ECombatPhase::Calculation, Context, &Hit); },
+        { { 1, ECombatRole::Attacker, true }, { 2, ECombatRole::Target, true } });
+}
+
+// Test: A unit attacking itself hears both sides of the hit, attacker first, each only if its roles ask
+// for it; the attack-level PreResolution still reaches it only as the attacker
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCombatPhaseRegistrySelfAttackTest,
+    "KBS.Combat.PhaseRegistry.SelfAttack",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FCombatPhaseRegistrySelfAttackTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    AUnit* Shaman = World.SpawnUnit(ETeamSide::Attacker);
+    FCombatPhaseRegistry Registry;
+    UObject* Listener = GetTransientPackage();
+    const ECombatPhaseMask Phases = ECombatPhaseMask::PreResolution | ECombatPhaseMask::Calculation;
+    Registry.Add(Listener, &RecordScoped<1>, Phases, 0, Shaman);
+    Registry.Add(Listener, &RecordScoped<2>, Phases, 0, Shaman, ECombatRole::Target);
+
+    FCombatContext Context;
+    Context.Attacker = Shaman;
+    FHitInstance Hit;
+    Hit.Attacker = Shaman;
+    Hit.Target = Shaman;
+
+    if (!Heard(*this, TEXT("Self hit"),
+        [&] { Registry.Dispatch(ECombatPhase::Calculation, Context, &Hit); },
+        { { 1, ECombatRole::Attacker, true }, { 1, ECombatRole::Target, true }, { 2, ECombatRole::Target, true } }))
+        return false;
+    return Heard(*this, TEXT("Attack-level PreResolution"),
+        [&] { Registry.Dispatch(ECombatPhase::PreResolution, Context, nullptr, nullptr, ECombatRole::Attacker); },
+        { { 1, ECombatRole::Attacker, false } });
+}
@@ -0,0 +1,100 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/UnitTestWorld.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffectComponent.h"
+#include "GameMechanics/Units/BattleEffects/StatModBattleEffect.h"
+#include "GameMechanics/Units/BattleEffects/StatModBattleEffectDataAsset.h"
+#include "GameMechanics/Units/BattleEffects/TargetDOTBattleEffect.h"
+#include "GameMechanics/Units/BattleEffects/DOTBattleEffectDataAsset.h"
+
+namespace
+{
+    UTargetDOTBattleEffect* MakeBurn()
+    {
+        UDOTBattleEffectDataAsset* Config = NewObject<UDOTBattleEffectDataAsset>();
+        Config->Duration = 2;
+        Config->EffectMagnitude = 5;
+        Config->DamageSource = EDamageSource::Fire;
+        UTargetDOTBattleEffect* Effect = NewObject<UTargetDOTBattleEffect>();
+        Effect->Initialize(Config);
+        return Effect;
+    }
+
+    UStatModBattleEffect* MakeVigour()
+    {
+        UStatModBattleEffectDataAsset* Config = NewObject<UStatModBattleEffectDataAsset>();
+        Config->Duration = 2;
+        Config->MaxHealthModifier = 20;
+        UStatModBattleEffect* Effect = NewObject<UStatModBattleEffect>();
+        Effect->Initialize(Config);
+        return Effect;
+    }
+}
+
+// Test: The live battle hash, maintained by the units as their health, statuses and effects change,
+// matches a from-scratch recompute after every kind of change and returns to its earlier value when
+// the battle does; copies of live stats do not touch it
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGridBattleHashTest,
+    "KBS.Grid.BattleHash.MatchesRecompute",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FGridBattleHashTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    UGridDataManager* DataManager = World.SpawnGrid();
+    AUnit* Knight = World.SpawnUnit(ETeamSide::Attacker);
+    AUnit* Archer = World.SpawnUnit(ETeamSide::Attacker);
+    AUnit* Orc = World.SpawnUnit(ETeamSide::Defender);
+    DataManager->PlaceUnit(Knight, 1, 2, ETacGridLayer::Ground);
+    DataManager->PlaceUnit(Archer, 0, 2, ETacGridLayer::Ground);
+    DataManager->PlaceUnit(Orc, 3, 2, ETacGridLayer::Ground);
+
+    auto Matches = [&](const TCHAR* What)
+    {
+        TestEqual(What, DataManager->GetBattleHash(), DataManager->ComputeBattleHash());
+    };
+
+    const uint64 Placed = DataManager->GetBattleHash();
+    Matches(TEXT("Placement"));
+    TestNotEqual("Unit state is part of the hash", Placed, DataManager->GetOccupancyHash());
+
+    Orc->ChangeUnitHP(-10);
+    Matches(TEXT("Damage"));
+    TestNotEqual("Damage changes the hash", DataManager->GetBattleHash(), Placed);
+    const uint64 Damaged = DataManager->GetBattleHash();
+
+    const FGuid PinId = FGuid::NewGuid();
+    Knight->GetStats().Status.AddStatus(EUnitStatus::Pinned, PinId);
+    Matches(TEXT("Status added"));
+    TestNotEqual("Status changes the hash", DataManager->GetBattleHash(), Damaged);
+    Knight->GetStats().Status.RemoveStatus(EUnitStatus::Pinned, PinId);
+    TestEqual("Status removed returns to the earlier hash", DataManager->GetBattleHash(), Damaged);
+    Knight->GetStats().Status.SetFlankDelay(2);
+    Matches(TEXT("Flank delay"));
+
+    Orc->EffectManager->AddEffect(MakeBurn(), Knight);
+    Matches(TEXT("Effect applied"));
+    Orc->HandleTurnEnd();
+    Matches(TEXT("Effect ticked"));
+    Archer->EffectManager->AddEffect(MakeVigour(), Archer);
+    Matches(TEXT("Max health raised by an effect"));
+    Archer->EffectManager->ClearAllEffects();
+    Matches(TEXT("Effects cleared"));
+
+    const uint64 BeforeCopy = DataManager->GetBattleHash();
+    FUnitCoreStats Copy = Archer->GetStats();
+    Copy.Health.ApplyDelta(-5);
+    Copy.Status.SetDefending();
+    TestEqual("A copy of live stats does not write into the hash", DataManager->GetBattleHash(), BeforeCopy);
+
+    DataManager->PlaceUnitOffField(Knight, false, false);
+    Matches(TEXT("Off field"));
+    DataManager->PushCorpse(Orc, Orc->GetGridMetadata().Coords);
+    DataManager->RemoveUnit(Orc);
+    Matches(TEXT("Corpse"));
+    DataManager->PopCorpse(FTacCoordinates(3, 2, ETacGridLayer::Ground));
+    Matches(TEXT("Corpse removed from the grid"));
+
+    return true;
+}
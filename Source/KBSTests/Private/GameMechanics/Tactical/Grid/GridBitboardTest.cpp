@@ -0,0 +1,51 @@
+#include "Misc/AutomationTest.h"
+#include "GameplayTypes/GridBitboard.h"
+
+// Test: Bit layout round-trips through coordinates
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGridBitboardLayoutTest,
+    "KBS.Grid.Bitboard.Layout",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FGridBitboardLayoutTest::RunTest(const FString& Parameters)
+{
+    TestEqual("(0,0) ground is bit 0", GridBitboard::CellBit(0, 0, ETacGridLayer::Ground), 0);
+    TestEqual("(4,4) air is bit 49", GridBitboard::CellBit(4, 4, ETacGridLayer::Air), 49);
+
+    bool bRoundTrip = true;
+    for (int32 Bit = 0; Bit < GridBitboard::NumCells; ++Bit)
+    {
+        const FTacCoordinates Cell = GridBitboard::CellFromBit(Bit);
+        bRoundTrip &= GridBitboard::CellBit(Cell.Row, Cell.Col, Cell.Layer) == Bit;
+        bRoundTrip &= Cell.GetCellIndex() == Bit;
+    }
+    TestTrue("Every bit round-trips", bRoundTrip);
+
+    return true;
+}
+
+// Test: Static masks agree with FTacCoordinates classification
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGridBitboardStaticMasksTest,
+    "KBS.Grid.Bitboard.StaticMasks",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FGridBitboardStaticMasksTest::RunTest(const FString& Parameters)
+{
+    TestEqual("4 restricted cells", GridBitboard::Count(GridBitboard::RestrictedMask), 4);
+    TestEqual("16 flank cells", GridBitboard::Count(GridBitboard::FlankMask), 16);
+    TestEqual("46 valid cells", GridBitboard::Count(GridBitboard::ValidCellsMask), 46);
+
+    bool bMatches = true;
+    GridBitboard::ForEachCell(GridBitboard::AllCellsMask, [&](const FTacCoordinates& Cell)
+    {
+        const uint64 Bit = GridBitboard::CellMask(Cell);
+        bMatches &= ((GridBitboard::FlankMask & Bit) != 0) == Cell.IsFlankCell();
+        bMatches &= ((GridBitboard::RestrictedMask & Bit) != 0) == Cell.IsRestrictedCell();
+    });
+    TestTrue("Masks match coordinate predicates", bMatches);
+
+    return true;
+}
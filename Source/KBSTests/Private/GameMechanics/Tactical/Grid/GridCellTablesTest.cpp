@@ -0,0 +1,67 @@
+#include "Misc/AutomationTest.h"
+#include "GameplayTypes/GridCellTables.h"
+#include "GameplayTypes/FlankCellDefinitions.h"
+
+// Test: Neighbor masks skip restricted cells and never cross layers
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGridCellTablesNeighborsTest,
+    "KBS.Grid.CellTables.Neighbors",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FGridCellTablesNeighborsTest::RunTest(const FString& Parameters)
+{
+    const FTacCoordinates Center(2, 2, ETacGridLayer::Ground);
+    TestEqual("Center has 8 neighbors", GridBitboard::Count(GridCellTables::NeighborMask(Center, false, true)), 8);
+    TestEqual("Center has 4 orthogonal neighbors", GridBitboard::Count(GridCellTables::NeighborMask(Center, true, true)), 4);
+
+    const FTacCoordinates BesideRestricted(2, 1, ETacGridLayer::Air);
+    const uint64 Ortho = GridCellTables::NeighborMask(BesideRestricted, true, true);
+    TestEqual("Restricted (2,0) is not a neighbor", GridBitboard::Count(Ortho), 3);
+    TestEqual("Neighbors stay on the air layer", Ortho & GridBitboard::LayerMask(ETacGridLayer::Ground), uint64(0));
+
+    const FTacCoordinates NearFlank(1, 1, ETacGridLayer::Ground);
+    TestTrue("Flank neighbor kept when taking flank",
+        (GridCellTables::NeighborMask(NearFlank, true, true) & GridBitboard::CellMask(1, 0, ETacGridLayer::Ground)) != 0);
+    TestTrue("Flank neighbor dropped otherwise",
+        (GridCellTables::NeighborMask(NearFlank, true, false) & GridBitboard::FlankMask) == 0);
+
+    bool bFlagsMatch = true;
+    GridBitboard::ForEachCell(GridBitboard::AllCellsMask, [&](const FTacCoordinates& Cell)
+    {
+        const GridCellTables::FCellInfo& Info = GridCellTables::Get(Cell);
+        bFlagsMatch &= Info.bIsFlank == Cell.IsFlankCell();
+        bFlagsMatch &= Info.bIsRestricted == Cell.IsRestrictedCell();
+    });
+    TestTrue("Flags match coordinate predicates", bFlagsMatch);
+
+    return true;
+}
+
+// Test: Flank rules resolve to the expected cells
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGridCellTablesFlankTest,
+    "KBS.Grid.CellTables.Flank",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FGridCellTablesFlankTest::RunTest(const FString& Parameters)
+{
+    TestTrue("Attacker at (4,3) enters left entrance",
+        FFlankCellDefinitions::GetAvailableFlankCell(FTacCoordinates(4, 3, ETacGridLayer::Ground), ETeamSide::Attacker) == FFlankCellDefinitions::AttackerLeftEntranceCell);
+    TestTrue("Defender at (0,1) enters left entrance",
+        FFlankCellDefinitions::GetAvailableFlankCell(FTacCoordinates(0, 1, ETacGridLayer::Ground), ETeamSide::Defender) == FFlankCellDefinitions::DefenderLeftEntranceCell);
+    TestTrue("Attacker on entrance (3,0) moves to rear",
+        FFlankCellDefinitions::GetAvailableFlankCell(FTacCoordinates(3, 0, ETacGridLayer::Ground), ETeamSide::Attacker) == FFlankCellDefinitions::AttackerRightRearCell);
+    TestFalse("Center column has no flank cell",
+        FFlankCellDefinitions::GetAvailableFlankCell(FTacCoordinates(2, 2, ETacGridLayer::Ground), ETeamSide::Defender).IsValidCell());
+
+    TestTrue("Entrance (1,4) blocks (0,3)",
+        FFlankCellDefinitions::GetEntranceBlockedCell(FTacCoordinates(1, 4, ETacGridLayer::Air)) == FTacCoordinates(0, 3, ETacGridLayer::Air));
+    TestFalse("Rear cell blocks nothing",
+        FFlankCellDefinitions::GetEntranceBlockedCell(FTacCoordinates(0, 0, ETacGridLayer::Ground)).IsValidCell());
+    TestTrue("Adjacent normal of (3,0) is (3,1)",
+        FFlankCellDefinitions::GetAdjacentNormalCell(FTacCoordinates(3, 0, ETacGridLayer::Ground)) == FTacCoordinates(3, 1, ETacGridLayer::Ground));
+
+    return true;
+}
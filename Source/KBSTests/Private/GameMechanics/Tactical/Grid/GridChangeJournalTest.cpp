@@ -0,0 +1,75 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/Tactical/Grid/Components/GridChangeJournal.h"
+#include "GameplayTypes/GridBitboard.h"
+
+// Test: Deltas since a version come back in order with their affected cells
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGridChangeJournalDeltaTest,
+    "KBS.Grid.ChangeJournal.Delta",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FGridChangeJournalDeltaTest::RunTest(const FString& Parameters)
+{
+    FGridChangeJournal Journal;
+    TestEqual("Starts at version 0", Journal.GetVersion(), uint32(0));
+
+    const FTacCoordinates A(0, 1);
+    const FTacCoordinates B(3, 3, ETacGridLayer::Air);
+    Journal.Record(EGridChangeKind::Place, nullptr, A, GridBitboard::CellMask(A));
+    const uint32 Seen = Journal.GetVersion();
+    Journal.Record(EGridChangeKind::Remove, nullptr, A, GridBitboard::CellMask(A));
+    Journal.Record(EGridChangeKind::Place, nullptr, B, GridBitboard::CellMask(B));
+
+    TArray<FGridChange> Changes;
+    TestTrue("Delta is recoverable", Journal.GetChangesSince(Seen, Changes));
+    TestEqual("Two changes since", Changes.Num(), 2);
+    if (Changes.Num() == 2)
+    {
+        TestTrue("Oldest first", Changes[0].Kind == EGridChangeKind::Remove);
+        TestEqual("Versions are consecutive", Changes[1].Version, Changes[0].Version + 1);
+    }
+    TestEqual("Affected cells union", Journal.GetAffectedCellsSince(Seen),
+        GridBitboard::CellMask(A) | GridBitboard::CellMask(B));
+    TestEqual("Nothing since current", Journal.GetAffectedCellsSince(Journal.GetVersion()), uint64(0));
+
+    {
+        FGridChangeJournal::FScopedSuppression Suppress(Journal);
+        Journal.Record(EGridChangeKind::Remove, nullptr, B, GridBitboard::CellMask(B));
+    }
+    TestEqual("Suppressed changes are not journaled", Journal.GetVersion(), Seen + 2);
+
+    return true;
+}
+
+// Test: Overwritten or reset history is reported as unrecoverable
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGridChangeJournalOverflowTest,
+    "KBS.Grid.ChangeJournal.Overflow",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FGridChangeJournalOverflowTest::RunTest(const FString& Parameters)
+{
+    FGridChangeJournal Journal;
+    const FTacCoordinates Cell(1, 1);
+    for (int32 i = 0; i < FGridChangeJournal::Capacity + 10; ++i)
+    {
+        Journal.Record(EGridChangeKind::Orientation, nullptr, Cell, GridBitboard::CellMask(Cell));
+    }
+
+    TArray<FGridChange> Changes;
+    TestFalse("Version 0 fell out of the ring", Journal.GetChangesSince(0, Changes));
+    TestEqual("Lost delta reports every cell", Journal.GetAffectedCellsSince(0), GridBitboard::AllCellsMask);
+    TestTrue("Oldest recoverable still works",
+        Journal.GetChangesSince(Journal.GetOldestRecoverableVersion(), Changes));
+    TestEqual("Full ring returned", Changes.Num(), FGridChangeJournal::Capacity);
+
+    const uint32 BeforeReset = Journal.GetVersion();
+    Journal.Reset();
+    TestTrue("Reset advances the version", Journal.GetVersion() > BeforeReset);
+    Changes.Reset();
+    TestFalse("Pre-reset versions are unrecoverable", Journal.GetChangesSince(BeforeReset, Changes));
+
+    return true;
+}
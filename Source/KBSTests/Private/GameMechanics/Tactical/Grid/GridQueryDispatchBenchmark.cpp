@@ -0,0 +1,53 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "GameMechanics/Tactical/Grid/Components/GridDataManager.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/Services/TacGridQueryPredicates.h"
+
+// Benchmark: TFunction predicate (factory closure per query) vs inlined policy struct.
+// Runs on an empty, grid-less data manager so only dispatch cost is measured.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGridQueryDispatchBenchmark,
+    "KBS.Grid.Benchmark.PredicateDispatch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FGridQueryDispatchBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr int32 Iterations = 100000;
+
+    UGridDataManager* DataManager = NewObject<UGridDataManager>();
+    DataManager->Initialize(nullptr);
+
+    FTargetingDescriptor Desc;
+    Desc.Strategy = ETargetingStrategy::Single;
+    Desc.Affiliation = ETargetAffiliation::Any;
+    Desc.bAllowEmpty = true;
+    Desc.bAllowFlank = false;
+
+    int32 FunctionCells = 0;
+    const double FunctionStart = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Iterations; ++i)
+    {
+        FTacCellSet Cells;
+        DataManager->FilterCells(nullptr, ETacGridLayer::Ground, TargetingPredicates::AffiliationPredicateFactory(Desc), Cells);
+        FunctionCells += Cells.Num();
+    }
+    const double FunctionSeconds = FPlatformTime::Seconds() - FunctionStart;
+
+    int32 PolicyCells = 0;
+    const double PolicyStart = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Iterations; ++i)
+    {
+        FTacCellSet Cells;
+        DataManager->FilterCellsWith(nullptr, ETacGridLayer::Ground, TargetingPolicies::FAffiliation(Desc), Cells);
+        PolicyCells += Cells.Num();
+    }
+    const double PolicySeconds = FPlatformTime::Seconds() - PolicyStart;
+
+    TestEqual("Both paths select the same cells", PolicyCells, FunctionCells);
+    AddInfo(FString::Printf(TEXT("FilterCells x%d: TFunction %.3f ms, policy %.3f ms, speedup %.2fx"),
+        Iterations, FunctionSeconds * 1000.0, PolicySeconds * 1000.0,
+        PolicySeconds > 0.0 ? FunctionSeconds / PolicySeconds : 0.0));
+
+    return true;
+}
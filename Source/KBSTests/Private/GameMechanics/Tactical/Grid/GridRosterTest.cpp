@@ -0,0 +1,73 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/UnitTestWorld.h"
+
+namespace
+{
+    TArray<AUnit*> Enumerate(const UGridDataManager* DataManager, EUnitQuerySource Sources)
+    {
+        TArray<AUnit*> Units;
+        DataManager->ForEachUnit(Sources, [&Units](AUnit* Unit) { Units.Add(Unit); });
+        return Units;
+    }
+}
+
+// Test: Each roster holds exactly the units of its source and side through place, off-field, return,
+// death and removal, and a failed return leaves the unit off field
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGridRosterTest,
+    "KBS.Grid.Roster.Transitions",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FGridRosterTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    UGridDataManager* DataManager = World.SpawnGrid();
+    AUnit* Knight = World.SpawnUnit(ETeamSide::Attacker);
+    AUnit* Archer = World.SpawnUnit(ETeamSide::Attacker);
+    AUnit* Orc = World.SpawnUnit(ETeamSide::Defender);
+    const FTacCoordinates KnightCell(1, 2, ETacGridLayer::Ground);
+    DataManager->PlaceUnit(Knight, KnightCell);
+    DataManager->PlaceUnit(Archer, 0, 2, ETacGridLayer::Ground);
+    DataManager->PlaceUnit(Orc, 3, 2, ETacGridLayer::Ground);
+
+    TestEqual("Attackers on field", DataManager->GetRoster(EUnitQuerySource::OnField, ETeamSide::Attacker).Num(), 2);
+    TestEqual("Defenders on field", DataManager->GetRoster(EUnitQuerySource::OnField, ETeamSide::Defender).Num(), 1);
+    TestTrue("Rosters keep placement order",
+        Enumerate(DataManager, EUnitQuerySource::OnField) == TArray<AUnit*>({ Knight, Archer, Orc }));
+
+    DataManager->PlaceUnitOffField(Knight, false, false);
+    TestTrue("Off field unit leaves the on-field roster",
+        !DataManager->GetRoster(EUnitQuerySource::OnField, ETeamSide::Attacker).Contains(Knight));
+    TestTrue("and joins the off-field roster",
+        DataManager->GetRoster(EUnitQuerySource::OffField, ETeamSide::Attacker).Contains(Knight));
+    TestEqual("Alive units span both", DataManager->NumUnits(EUnitQuerySource::OnField | EUnitQuerySource::OffField), 3);
+
+    AUnit* Blocker = World.SpawnUnit(ETeamSide::Defender);
+    DataManager->PlaceUnit(Blocker, KnightCell);
+    TestFalse("Return to an occupied cell fails", DataManager->ReturnUnitToField(Knight->GetUnitID(), KnightCell));
+    TestTrue("Unit stays in the off-field container", DataManager->IsUnitOffField(Knight));
+    TestTrue("and in the off-field roster", DataManager->GetRoster(EUnitQuerySource::OffField, ETeamSide::Attacker).Contains(Knight));
+    TestFalse("and out of the on-field roster", DataManager->GetRoster(EUnitQuerySource::OnField, ETeamSide::Attacker).Contains(Knight));
+
+    const FTacCoordinates FreeCell(1, 1, ETacGridLayer::Ground);
+    TestTrue("Return to a free cell succeeds", DataManager->ReturnUnitToField(Knight->GetUnitID(), FreeCell));
+    TestFalse("Returned unit leaves the off-field container", DataManager->IsUnitOffField(Knight));
+    TestEqual("Off-field roster is empty", DataManager->GetRoster(EUnitQuerySource::OffField, ETeamSide::Attacker).Num(), 0);
+    TestTrue("Returned unit is on field", DataManager->GetRoster(EUnitQuerySource::OnField, ETeamSide::Attacker).Contains(Knight));
+
+    const FTacCoordinates OrcCell = Orc->GetGridMetadata().Coords;
+    Orc->ChangeUnitHP(-1000);
+    DataManager->RemoveUnit(Orc);
+    DataManager->PushCorpse(Orc, OrcCell);
+    TestFalse("Dead unit leaves the on-field roster", DataManager->GetRoster(EUnitQuerySource::OnField, ETeamSide::Defender).Contains(Orc));
+    TestTrue("and becomes a corpse", Enumerate(DataManager, EUnitQuerySource::Corpses) == TArray<AUnit*>({ Orc }));
+
+    DataManager->RemoveUnit(Archer);
+    TestEqual("Removed unit is in no roster",
+        Enumerate(DataManager, EUnitQuerySource::OnField | EUnitQuerySource::OffField | EUnitQuerySource::Corpses).Find(Archer), INDEX_NONE);
+    TestEqual("Copying query agrees with the views", DataManager->GetUnits(EUnitQuerySource::OnField).Num(),
+        DataManager->NumUnits(EUnitQuerySource::OnField));
+
+    return true;
+}
@@ -0,0 +1,62 @@
+#include "Misc/AutomationTest.h"
+#include "GameplayTypes/TacCellSet.h"
+
+// Test: Basic membership and bounds handling
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FTacCellSetMembershipTest,
+    "KBS.Grid.CellSet.Membership",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FTacCellSetMembershipTest::RunTest(const FString& Parameters)
+{
+    FTacCellSet Set;
+    TestTrue("Default set is empty", Set.IsEmpty());
+
+    TestTrue("Add (1,1) ground", Set.Add(FTacCoordinates(1, 1, ETacGridLayer::Ground)));
+    TestTrue("Add (1,1) air", Set.Add(FTacCoordinates(1, 1, ETacGridLayer::Air)));
+    TestFalse("Invalid() is rejected", Set.Add(FTacCoordinates::Invalid()));
+    TestFalse("Row 5 is rejected", Set.Add(FTacCoordinates(5, 0)));
+
+    TestEqual("Two cells stored", Set.Num(), 2);
+    TestTrue("Contains ground cell", Set.Contains(FTacCoordinates(1, 1, ETacGridLayer::Ground)));
+    TestFalse("Layers are distinct", Set.Contains(FTacCoordinates(1, 2, ETacGridLayer::Air)));
+
+    Set.Remove(FTacCoordinates(1, 1, ETacGridLayer::Air));
+    TestEqual("Remove drops one cell", Set.Num(), 1);
+
+    return true;
+}
+
+// Test: Set algebra and iteration order
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FTacCellSetAlgebraTest,
+    "KBS.Grid.CellSet.Algebra",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FTacCellSetAlgebraTest::RunTest(const FString& Parameters)
+{
+    const FTacCellSet A = FTacCellSet::FromArray({ FTacCoordinates(0, 1), FTacCoordinates(3, 3), FTacCoordinates(4, 4, ETacGridLayer::Air) });
+    const FTacCellSet B = FTacCellSet::FromArray({ FTacCoordinates(3, 3), FTacCoordinates(1, 2) });
+
+    TestEqual("Union size", (A | B).Num(), 4);
+    TestEqual("Intersection size", (A & B).Num(), 1);
+    TestTrue("Intersection holds shared cell", (A & B).Contains(FTacCoordinates(3, 3)));
+    TestEqual("Difference size", A.Difference(B).Num(), 2);
+    TestEqual("Ground filter", A.FilterLayer(ETacGridLayer::Ground).Num(), 2);
+
+    const TArray<FTacCoordinates> Cells = A.Array();
+    TestEqual("Array adapter size", Cells.Num(), 3);
+    TestTrue("Ground row-major first", Cells[0] == FTacCoordinates(0, 1));
+    TestTrue("Air cells last", Cells[2] == FTacCoordinates(4, 4, ETacGridLayer::Air));
+
+    int32 Visited = 0;
+    for (const FTacCoordinates& Cell : A)
+    {
+        Visited += A.Contains(Cell) ? 1 : 0;
+    }
+    TestEqual("Range-for visits every cell", Visited, 3);
+
+    return true;
+}
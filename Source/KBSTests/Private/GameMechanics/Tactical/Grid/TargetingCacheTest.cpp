@@ -0,0 +1,69 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/UnitTestWorld.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/Services/TacGridTargetingService.h"
+#include "GameMechanics/Units/Stats/UnitStatusContainer.h"
+
+// Test: Repeated queries are served from the memo, a different descriptor or unit is its own entry,
+// and any grid or status change drops every entry
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FTargetingCacheTest,
+    "KBS.Grid.Targeting.Cache",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FTargetingCacheTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    UGridDataManager* DataManager = World.SpawnGrid();
+    AUnit* Attacker = World.SpawnUnit(ETeamSide::Attacker);
+    AUnit* Defender = World.SpawnUnit(ETeamSide::Defender);
+    AUnit* Reserve = World.SpawnUnit(ETeamSide::Defender);
+    TestTrue("Attacker placed", DataManager->PlaceUnit(Attacker, 1, 2, ETacGridLayer::Ground));
+    TestTrue("Defender placed", DataManager->PlaceUnit(Defender, 3, 2, ETacGridLayer::Ground));
+
+    UTacGridTargetingService* Targeting = NewObject<UTacGridTargetingService>();
+    Targeting->Initialize(DataManager);
+    const FTargetingCacheStats& Stats = Targeting->GetCacheStats();
+
+    FTargetingDescriptor Enemies;
+    Enemies.Strategy = ETargetingStrategy::Single;
+    Enemies.Affiliation = ETargetAffiliation::Enemy;
+    FTargetingDescriptor Empty;
+    Empty.Strategy = ETargetingStrategy::EmptyCell;
+
+    const FTacCellSet First = Targeting->GetValidTargetCellSet(Attacker, Enemies);
+    TestTrue("Enemy is targetable", First.Contains(FTacCoordinates(3, 2, ETacGridLayer::Ground)));
+    TestEqual("First query misses", Stats.Misses, 1u);
+    const FTacCellSet Second = Targeting->GetValidTargetCellSet(Attacker, Enemies);
+    TestEqual("Repeated query hits", Stats.Hits, 1u);
+    TestTrue("Hit returns the computed set", Second == First);
+    TestTrue("HasAnyValidTargets reads the memo", Targeting->HasAnyValidTargets(Attacker, Enemies));
+    TestEqual("and counts as a hit", Stats.Hits, 2u);
+
+    Targeting->GetValidTargetCellSet(Attacker, Empty);
+    TestEqual("Another descriptor is its own entry", Stats.Misses, 2u);
+    Targeting->GetValidTargetCellSet(Defender, Enemies);
+    TestEqual("Another unit is its own entry", Stats.Misses, 3u);
+    TestEqual("Neither invalidates", Stats.Invalidations, 0u);
+
+    TestTrue("Reserve placed", DataManager->PlaceUnit(Reserve, 3, 1, ETacGridLayer::Ground));
+    const FTacCellSet AfterPlace = Targeting->GetValidTargetCellSet(Attacker, Enemies);
+    TestEqual("Grid change invalidates", Stats.Invalidations, 1u);
+    TestEqual("and recomputes", Stats.Misses, 4u);
+    TestTrue("Recomputed set sees the new unit", AfterPlace.Contains(FTacCoordinates(3, 1, ETacGridLayer::Ground)));
+
+    Targeting->GetValidTargetCellSet(Attacker, Enemies);
+    TestEqual("Unchanged state hits again", Stats.Hits, 3u);
+
+    Defender->GetStats().Status.AddStatus(EUnitStatus::Pinned, FGuid::NewGuid());
+    Targeting->GetValidTargetCellSet(Attacker, Enemies);
+    TestEqual("Status change invalidates", Stats.Invalidations, 2u);
+    TestEqual("and recomputes", Stats.Misses, 5u);
+
+    Targeting->ResetCache();
+    TestEqual("Reset clears the counters", Stats.Hits + Stats.Misses + Stats.Invalidations, 0u);
+    Targeting->GetValidTargetCellSet(Attacker, Enemies);
+    TestEqual("Reset drops the entries", Stats.Misses, 1u);
+
+    return true;
+}
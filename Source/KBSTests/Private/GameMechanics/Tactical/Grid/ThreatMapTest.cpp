@@ -0,0 +1,126 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/UnitTestWorld.h"
+#include "GameMechanics/Tactical/Grid/Subsystems/Services/TacThreatMapService.h"
+#include "GameMechanics/Units/Combat/CombatDescriptor.h"
+#include "GameMechanics/Units/Combat/CombatDescriptorDataAsset.h"
+#include "GameMechanics/Units/Combat/Weapon.h"
+#include "GameMechanics/Units/Combat/WeaponDataAsset.h"
+#include "GameplayTypes/GridBitboard.h"
+
+namespace
+{
+    AUnit* SpawnArmed(FUnitTestWorld& World, ETeamSide Team, ETargetReach Reach)
+    {
+        UCombatDescriptorDataAsset* Attack = NewObject<UCombatDescriptorDataAsset>();
+        Attack->BaseStats.TargetReach = Reach;
+        Attack->BaseStats.BaseMagnitude = FUnitStatPositive(20);
+        Attack->BaseStats.DamageSources.InitFromBase({ EDamageSource::Physical });
+        // Named inversely: true makes the descriptor roll for accuracy
+        Attack->bGuaranteedHit = true;
+        UWeaponDataAsset* Weapon = NewObject<UWeaponDataAsset>();
+        Weapon->Descriptor = Attack;
+
+        UUnitDefinition* Definition = NewObject<UUnitDefinition>();
+        Definition->BaseStatsTemplate.Health = FUnitHealth(100);
+        Definition->BaseStatsTemplate.Accuracy = FUnitStatPercent(80);
+        Definition->DefaultWeapons.Add(Weapon);
+        AUnit* Unit = World.SpawnUnit(Team);
+        Unit->SetUnitDefinition(Definition);
+        return Unit;
+    }
+
+    // Every cell of both maps against a service rebuilt from scratch
+    bool MatchesRebuild(FAutomationTestBase& Test, const TCHAR* Step, UTacThreatMapService* Incremental,
+                        UGridDataManager* DataManager)
+    {
+        UTacThreatMapService* Rebuilt = NewObject<UTacThreatMapService>();
+        Rebuilt->Initialize(DataManager);
+        for (const ETeamSide Side : { ETeamSide::Attacker, ETeamSide::Defender })
+        {
+            if (Incremental->GetThreatenedMask(Side) != Rebuilt->GetThreatenedMask(Side))
+            {
+                Test.AddError(FString::Printf(TEXT("%s: threatened mask differs from a rebuild"), Step));
+                return false;
+            }
+            // Both layers: reach and heal masks cross from one to the other
+            for (int32 Bit = 0; Bit < GridBitboard::NumCells; ++Bit)
+            {
+                const FTacCoordinates Cell = GridBitboard::CellFromBit(Bit);
+                if (!Cell.IsValidCell())
+                    continue;
+                const FTacThreatCell A = Incremental->GetThreat(Side, Cell);
+                const FTacThreatCell B = Rebuilt->GetThreat(Side, Cell);
+                if (A.ExpectedDamage != B.ExpectedDamage || A.Attackers != B.Attackers || A.Healers != B.Healers)
+                {
+                    Test.AddError(FString::Printf(TEXT("%s: cell [%d,%d] layer %d differs from a rebuild"), Step,
+                        Cell.Row, Cell.Col, static_cast<int32>(Cell.Layer)));
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+// Test: Incremental catch-up after moves, stat modifiers that raise no unit event and status changes
+// leaves the maps equal to a full rebuild
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FThreatMapCatchUpTest,
+    "KBS.Grid.ThreatMap.CatchUpMatchesRebuild",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FThreatMapCatchUpTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    UGridDataManager* DataManager = World.SpawnGrid();
+    AUnit* Melee = SpawnArmed(World, ETeamSide::Attacker, ETargetReach::ClosestEnemies);
+    AUnit* Archer = SpawnArmed(World, ETeamSide::Attacker, ETargetReach::AnyEnemy);
+    AUnit* Defender = SpawnArmed(World, ETeamSide::Defender, ETargetReach::ClosestEnemies);
+    DataManager->PlaceUnit(Melee, 1, 2, ETacGridLayer::Ground);
+    DataManager->PlaceUnit(Archer, 0, 2, ETacGridLayer::Ground);
+    DataManager->PlaceUnit(Defender, 3, 2, ETacGridLayer::Ground);
+    AUnit* Harpy = SpawnArmed(World, ETeamSide::Defender, ETargetReach::ClosestEnemies);
+    DataManager->PlaceUnit(Harpy, 2, 3, ETacGridLayer::Air);
+
+    UTacThreatMapService* ThreatMap = NewObject<UTacThreatMapService>();
+    ThreatMap->Initialize(DataManager);
+    const FTacCoordinates FarCell(4, 2, ETacGridLayer::Ground);
+    const float Before = ThreatMap->GetExpectedDamage(ETeamSide::Defender, FarCell);
+    TestTrue("The archer threatens the back row", Before > 0.0f);
+
+    DataManager->RemoveUnit(Melee);
+    DataManager->PlaceUnit(Melee, 2, 1, ETacGridLayer::Ground);
+    if (!MatchesRebuild(*this, TEXT("After a move"), ThreatMap, DataManager))
+        return false;
+    DataManager->RemoveUnit(Harpy);
+    DataManager->PlaceUnit(Harpy, 2, 3, ETacGridLayer::Ground);
+    if (!MatchesRebuild(*this, TEXT("After landing"), ThreatMap, DataManager))
+        return false;
+    DataManager->RemoveUnit(Harpy);
+    DataManager->PlaceUnit(Harpy, 1, 1, ETacGridLayer::Air);
+    if (!MatchesRebuild(*this, TEXT("After taking off"), ThreatMap, DataManager))
+        return false;
+
+    // Evasive Stance style penalty: a bare modifier on the attacker, no unit event
+    const FStatModifierHandle Penalty = Archer->GetStats().Accuracy.AddFlatModifier(-40);
+    TestTrue("Accuracy penalty lowers the threat", ThreatMap->GetExpectedDamage(ETeamSide::Defender, FarCell) < Before);
+    if (!MatchesRebuild(*this, TEXT("After an accuracy penalty"), ThreatMap, DataManager))
+        return false;
+    Archer->GetStats().Accuracy.RemoveModifier(Penalty);
+    TestEqual("Removing it restores the threat", ThreatMap->GetExpectedDamage(ETeamSide::Defender, FarCell), Before);
+
+    UCombatDescriptor* Bow = Archer->GetWeapons()[0]->GetDescriptor();
+    const FStatModifierHandle Enchant = Bow->ModifyMagnitude(10, true);
+    TestTrue("Descriptor magnitude raises the threat", ThreatMap->GetExpectedDamage(ETeamSide::Defender, FarCell) > Before);
+    if (!MatchesRebuild(*this, TEXT("After a magnitude change"), ThreatMap, DataManager))
+        return false;
+    Bow->RemoveMagnitudeModifier(Enchant);
+
+    Archer->GetStats().Status.AddStatus(EUnitStatus::TurnBlocked, FGuid::NewGuid());
+    if (!MatchesRebuild(*this, TEXT("After a status change"), ThreatMap, DataManager))
+        return false;
+
+    DataManager->RemoveUnit(Defender);
+    return MatchesRebuild(*this, TEXT("After a removal"), ThreatMap, DataManager);
+}
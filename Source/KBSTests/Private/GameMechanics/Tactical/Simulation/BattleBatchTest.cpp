@@ -0,0 +1,124 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/Tactical/Simulation/BattleMatchup.h"
+
+// Test: Matchup JSON parsing names unnamed rows by position and rejects anything but an array
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleBatchParseTest,
+    "KBS.Simulation.BattleBatch.ParseMatchups",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleBatchParseTest::RunTest(const FString& Parameters)
+{
+    TArray<FBattleMatchup> Matchups;
+    TestTrue("Parses an array", BattleBatch::ParseMatchups(TEXT("[{\"Name\":\"Duel\",\"Runs\":3},{\"Runs\":0},{}]"), Matchups));
+    if (Matchups.Num() != 3)
+    {
+        AddError(TEXT("Every element becomes a matchup"));
+        return false;
+    }
+    TestEqual("Named matchup keeps its name", Matchups[0].Name, FString(TEXT("Duel")));
+    TestEqual("Run count is read", Matchups[0].Runs, 3);
+    TestEqual("Unnamed matchups are named by position", Matchups[1].Name, FString(TEXT("Matchup1")));
+    TestEqual("even without fields", Matchups[2].Name, FString(TEXT("Matchup2")));
+    TestTrue("Missing grid config falls back to the command line one", Matchups[2].GridConfig == nullptr);
+
+    TArray<FBattleMatchup> Rejected;
+    TestFalse("An object is not a matchup list", BattleBatch::ParseMatchups(TEXT("{\"Name\":\"Duel\"}"), Rejected));
+    TestFalse("Malformed JSON is rejected", BattleBatch::ParseMatchups(TEXT("[{\"Name\":"), Rejected));
+
+    return true;
+}
+
+// Test: Any worker count deals every run to exactly one shard with the same seed, and merging the shards
+// gives the single-process totals
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleBatchShardTest,
+    "KBS.Simulation.BattleBatch.Shards",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleBatchShardTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 TotalRuns = 23;
+    for (const int32 NumShards : { 1, 2, 4, 7, 32 })
+    {
+        for (int32 BatchIndex = 0; BatchIndex < TotalRuns; ++BatchIndex)
+        {
+            int32 Owners = 0;
+            for (int32 Shard = 0; Shard < NumShards; ++Shard)
+                Owners += BattleBatch::IsInShard(BatchIndex, Shard, NumShards) ? 1 : 0;
+            if (Owners != 1)
+            {
+                AddError(FString::Printf(TEXT("Run %d has %d owners among %d shards"), BatchIndex, Owners, NumShards));
+                return false;
+            }
+        }
+    }
+
+    TestEqual("Seed is reproducible", BattleBatch::GetRunSeed(7, TEXT("Duel"), 3), BattleBatch::GetRunSeed(7, TEXT("Duel"), 3));
+    TestNotEqual("Runs get distinct seeds", BattleBatch::GetRunSeed(7, TEXT("Duel"), 3), BattleBatch::GetRunSeed(7, TEXT("Duel"), 4));
+    TestNotEqual("Matchups get distinct seeds", BattleBatch::GetRunSeed(7, TEXT("Duel"), 3), BattleBatch::GetRunSeed(7, TEXT("Siege"), 3));
+    TestNotEqual("The batch seed reseeds every run", BattleBatch::GetRunSeed(7, TEXT("Duel"), 3), BattleBatch::GetRunSeed(8, TEXT("Duel"), 3));
+
+    auto MakeResult = [](int32 AttackerWins, int32 DefenderWins, int32 Unresolved, int64 Rounds)
+    {
+        FBattleMatchupResult Result;
+        Result.Name = TEXT("Duel");
+        Result.AttackerWins = AttackerWins;
+        Result.DefenderWins = DefenderWins;
+        Result.Unresolved = Unresolved;
+        Result.Runs = AttackerWins + DefenderWins + Unresolved;
+        Result.TotalRounds = Rounds;
+        Result.Seconds = 0.5;
+        return Result;
+    };
+    TArray<FBattleMatchupResult> Merged;
+    Merged.SetNum(1);
+    TestTrue("First shard merges", BattleBatch::MergeShard({ MakeResult(3, 1, 0, 40) }, Merged));
+    TestTrue("Second shard merges", BattleBatch::MergeShard({ MakeResult(1, 2, 1, 80) }, Merged));
+    TestEqual("Name comes from the shards", Merged[0].Name, FString(TEXT("Duel")));
+    TestEqual("Runs add up", Merged[0].Runs, 8);
+    TestEqual("Wins add up", Merged[0].AttackerWins, 4);
+    TestEqual("Unresolved add up", Merged[0].Unresolved, 1);
+    TestEqual("Rate is taken over the merged runs", Merged[0].GetAttackerWinRate(), 0.5);
+    TestEqual("Average rounds over the merged runs", Merged[0].GetAverageRounds(), 15.0);
+    TestFalse("A shard with another matchup count is rejected", BattleBatch::MergeShard({}, Merged));
+    TestEqual("and leaves the totals alone", Merged[0].Runs, 8);
+
+    return true;
+}
+
+// Test: CSV rows carry the merged counts and derived rates, with names quoted and their quotes doubled
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleBatchCsvTest,
+    "KBS.Simulation.BattleBatch.Csv",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleBatchCsvTest::RunTest(const FString& Parameters)
+{
+    FBattleMatchupResult Quoted;
+    Quoted.Name = TEXT("Knights, \"elite\" vs orcs");
+    Quoted.Runs = 4;
+    Quoted.AttackerWins = 3;
+    Quoted.DefenderWins = 1;
+    Quoted.TotalRounds = 10;
+    Quoted.Seconds = 1.25;
+    FBattleMatchupResult Empty;
+    Empty.Name = TEXT("Empty");
+
+    TArray<FString> Lines;
+    BattleBatch::ToCsv({ Quoted, Empty }).ParseIntoArrayLines(Lines);
+    if (Lines.Num() != 3)
+    {
+        AddError(TEXT("Header plus one row per matchup"));
+        return false;
+    }
+    TestEqual("Header", Lines[0], FString(TEXT("Matchup,Runs,AttackerWins,DefenderWins,Unresolved,AttackerWinRate,AverageRounds,Seconds")));
+    TestEqual("Commas and quotes in names stay inside one quoted field",
+        Lines[1], FString(TEXT("\"Knights, \"\"elite\"\" vs orcs\",4,3,1,0,0.7500,2.50,1.25")));
+    TestEqual("No runs gives zero rates rather than NaN", Lines[2], FString(TEXT("\"Empty\",0,0,0,0,0.0000,0.00,0.00")));
+
+    return true;
+}
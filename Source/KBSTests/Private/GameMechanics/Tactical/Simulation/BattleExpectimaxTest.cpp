@@ -0,0 +1,103 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+#include "GameMechanics/Tactical/Simulation/BattleExpectimax.h"
+#include "GameMechanics/Tactical/Simulation/SimulationTestFixture.h"
+
+using namespace SimulationTestFixture;
+
+// Test: Forced roll outcomes and the attack preview line up with what Apply resolves
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleStateForcedRollsTest,
+    "KBS.Simulation.Expectimax.ForcedRolls",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleStateForcedRollsTest::RunTest(const FString& Parameters)
+{
+    const FSimUnitTemplate Template = MakeMeleeTemplate(30, true);
+    FBattleState Root;
+    const int32 A = Root.AddUnit(Template, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    const int32 B = Root.AddUnit(Template, ETeamSide::Defender, FTacCoordinates(2, 2));
+    const int32 Queued[] = { B };
+    Root.SetTurn(1, A, Queued);
+    const FTacCoordinates Cell = Root.GetUnit(B).Coords;
+
+    const FPreviewHitResult Preview = Root.PreviewAttack(Cell);
+    TestEqual("Preview damage", Preview.DamageResult.Damage, 10);
+    TestEqual("Empty cell has no preview", Root.PreviewAttack(FTacCoordinates(4, 4)).DamageResult.Damage, 0);
+
+    FBattleState Missed = Root;
+    TestTrue("Forced miss applies", Missed.Apply(FSimAction::Attack(Cell), ESimRollOutcome::Miss));
+    TestEqual("Miss leaves the target whole", Missed.GetUnit(B).Stats.Health.GetCurrent(), 30);
+
+    FBattleState Hit = Root;
+    TestTrue("Forced hit applies", Hit.Apply(FSimAction::Attack(Cell), ESimRollOutcome::Hit));
+    TestEqual("Hit lands the previewed damage", Hit.GetUnit(B).Stats.Health.GetCurrent(), 30 - Preview.DamageResult.Damage);
+
+    return true;
+}
+
+// Test: Expectimax takes the guaranteed finishing blow and reports a completed depth
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleExpectimaxFinishingBlowTest,
+    "KBS.Simulation.Expectimax.FinishingBlow",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleExpectimaxFinishingBlowTest::RunTest(const FString& Parameters)
+{
+    const FSimUnitTemplate Strong = MakeMeleeTemplate(30, false);
+    const FSimUnitTemplate Weak = MakeMeleeTemplate(10, false);
+    FBattleState Root(3);
+    const int32 A = Root.AddUnit(Strong, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    const int32 B = Root.AddUnit(Weak, ETeamSide::Defender, FTacCoordinates(2, 2));
+    const int32 Queued[] = { B };
+    Root.SetTurn(1, A, Queued);
+
+    FBattleExpectimaxParams Params;
+    Params.MaxDepth = 3;
+    Params.TimeBudgetSeconds = 10.0;
+    const FBattleExpectimaxResult Result = FBattleExpectimax::Search(Root, Params);
+    TestTrue("Search attacks", Result.Action == FSimAction::Attack(Root.GetUnit(B).Coords));
+    TestTrue("A depth completed", Result.Depth >= 1);
+    TestEqual("Winning line is certain", Result.ExpectedScore, 1.0);
+
+    return true;
+}
+
+// Benchmark: Depth iterative deepening reaches inside the default 50 ms budget on a mid-game position,
+// three units a side with wounds and rolls, in round 3
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleExpectimaxDepthBenchmark,
+    "KBS.Simulation.Benchmark.ExpectimaxDepth",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FBattleExpectimaxDepthBenchmark::RunTest(const FString& Parameters)
+{
+    const FSimUnitTemplate Fresh = MakeMeleeTemplate(40, true);
+    const FSimUnitTemplate Wounded = MakeMeleeTemplate(15, true);
+    FBattleState Root(7);
+    const int32 A = Root.AddUnit(Fresh, ETeamSide::Attacker, FTacCoordinates(1, 1));
+    const int32 A2 = Root.AddUnit(Wounded, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    const int32 A3 = Root.AddUnit(Fresh, ETeamSide::Attacker, FTacCoordinates(0, 3));
+    const int32 D = Root.AddUnit(Wounded, ETeamSide::Defender, FTacCoordinates(2, 1));
+    const int32 D2 = Root.AddUnit(Fresh, ETeamSide::Defender, FTacCoordinates(2, 3));
+    const int32 D3 = Root.AddUnit(Fresh, ETeamSide::Defender, FTacCoordinates(3, 2));
+    const int32 Queued[] = { D, A2, D2, A3, D3 };
+    Root.SetTurn(3, A, Queued);
+
+    FBattleExpectimaxParams Params;
+    Params.MaxDepth = 16;
+    Params.TimeBudgetSeconds = 0.05;
+    const double Start = FPlatformTime::Seconds();
+    const FBattleExpectimaxResult Result = FBattleExpectimax::Search(Root, Params);
+    const double Elapsed = FPlatformTime::Seconds() - Start;
+
+    TestTrue("A depth completed", Result.Depth >= 1);
+    AddInfo(FString::Printf(TEXT("Expectimax, 6 units, round 3, %.0f ms budget: depth %d, %lld nodes, %.3f ms"),
+        Params.TimeBudgetSeconds * 1000.0, Result.Depth, Result.Nodes, Elapsed * 1000.0));
+
+    return true;
+}
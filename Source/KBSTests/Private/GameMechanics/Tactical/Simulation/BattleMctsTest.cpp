@@ -0,0 +1,40 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+#include "GameMechanics/Tactical/Simulation/BattleMcts.h"
+#include "GameMechanics/Tactical/Simulation/SimulationTestFixture.h"
+
+using namespace SimulationTestFixture;
+
+// Test: Search finds the attack that wins the battle outright, reproducibly for a fixed seed
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleMctsFinishingBlowTest,
+    "KBS.Simulation.Mcts.FinishingBlow",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleMctsFinishingBlowTest::RunTest(const FString& Parameters)
+{
+    const FSimUnitTemplate Strong = MakeMeleeTemplate(30);
+    const FSimUnitTemplate Weak = MakeMeleeTemplate(10);
+    FBattleState Root(7);
+    const int32 A = Root.AddUnit(Strong, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    const int32 B = Root.AddUnit(Weak, ETeamSide::Defender, FTacCoordinates(2, 2));
+    const int32 Queued[] = { B };
+    Root.SetTurn(1, A, Queued);
+
+    FBattleSearchParams Params;
+    Params.MaxIterations = 400;
+    Params.TimeBudgetSeconds = 10.0;
+    Params.NumWorkers = 1;
+    Params.Seed = 11;
+    const FBattleSearchResult Result = FBattleMcts::Search(Root, Params);
+    TestTrue("Search attacks", Result.Action == FSimAction::Attack(Root.GetUnit(B).Coords));
+    TestTrue("Search ran", Result.Iterations > 0);
+    TestTrue("Winning line scores high", Result.ExpectedScore > 0.9);
+
+    const FBattleSearchResult Replay = FBattleMcts::Search(Root, Params);
+    TestTrue("Same seed, same answer", Replay.Action == Result.Action);
+    TestEqual("Root is untouched", Root.GetUnit(B).Stats.Health.GetCurrent(), 10);
+
+    return true;
+}
@@ -0,0 +1,36 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/Tactical/Simulation/BattleOutcomeEstimator.h"
+#include "GameMechanics/Tactical/Simulation/SimulationTestFixture.h"
+
+using namespace SimulationTestFixture;
+
+// Test: Estimates account for every run, bracket their means and repeat exactly for the same seed
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleOutcomeEstimatorTest,
+    "KBS.Simulation.OutcomeEstimator.Estimate",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleOutcomeEstimatorTest::RunTest(const FString& Parameters)
+{
+    const FSimUnitTemplate Template = MakeMeleeTemplate(30, true);
+
+    FBattleState Initial;
+    Initial.AddUnit(Template, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    Initial.AddUnit(Template, ETeamSide::Defender, FTacCoordinates(2, 2));
+
+    FBattleEstimateParams Params;
+    Params.Runs = 300;
+    Params.Seed = 7;
+    const FBattleEstimate First = FBattleOutcomeEstimator::Estimate(Initial, Params);
+    const FBattleEstimate Second = FBattleOutcomeEstimator::Estimate(Initial, Params);
+
+    TestEqual("Every run is counted", First.Wins[0] + First.Wins[1] + First.Unresolved, Params.Runs);
+    const FSimEstimate& AttackerRate = First.GetWinRate(ETeamSide::Attacker);
+    TestTrue("Interval brackets the rate", AttackerRate.Low <= AttackerRate.Mean && AttackerRate.Mean <= AttackerRate.High);
+    TestEqual("Per-unit estimates", First.Units.Num(), 2);
+    TestEqual("Same seed, same attacker wins", Second.Wins[0], First.Wins[0]);
+    TestEqual("Same seed, same turns", Second.TurnsToFinish.Mean, First.TurnsToFinish.Mean);
+
+    return true;
+}
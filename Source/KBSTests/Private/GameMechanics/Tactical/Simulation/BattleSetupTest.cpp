@@ -0,0 +1,81 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/Tactical/Simulation/BattleSetup.h"
+#include "GameMechanics/Tactical/Grid/Editor/TacGridEditorInitializer.h"
+#include "GameMechanics/Units/UnitDefinition.h"
+#include "GameMechanics/Units/Combat/CombatDescriptorDataAsset.h"
+#include "GameMechanics/Units/Combat/WeaponDataAsset.h"
+#include "GameMechanics/Units/BattleEffects/TargetDOTBattleEffect.h"
+#include "GameMechanics/Units/BattleEffects/StatModBattleEffect.h"
+#include "GameMechanics/Units/BattleEffects/DOTBattleEffectDataAsset.h"
+#include "GameMechanics/Units/BattleEffects/StatModBattleEffectDataAsset.h"
+
+namespace
+{
+    // Unit whose only weapon applies one effect of EffectClass configured by Config
+    UUnitDefinition* MakeDefinition(TSubclassOf<UBattleEffect> EffectClass, UBattleEffectDataAsset* Config)
+    {
+        UCombatDescriptorDataAsset* Attack = NewObject<UCombatDescriptorDataAsset>();
+        Attack->BaseStats.TargetReach = ETargetReach::ClosestEnemies;
+        Attack->BaseStats.DamageSources.InitFromBase({ EDamageSource::Physical });
+        FDescriptorEffectConfig& Effect = Attack->Effects.AddDefaulted_GetRef();
+        Effect.EffectClass = EffectClass;
+        Effect.EffectConfig = Config;
+        UWeaponDataAsset* Weapon = NewObject<UWeaponDataAsset>();
+        Weapon->Descriptor = Attack;
+
+        UUnitDefinition* Definition = NewObject<UUnitDefinition>();
+        Definition->BaseStatsTemplate.Health = FUnitHealth(30);
+        Definition->DefaultWeapons.Add(Weapon);
+        return Definition;
+    }
+
+    FUnitPlacement MakePlacement(UUnitDefinition* Definition, int32 Row, bool bIsAttacker)
+    {
+        FUnitPlacement Placement;
+        Placement.Definition = Definition;
+        Placement.Row = Row;
+        Placement.Col = 2;
+        Placement.bIsAttacker = bIsAttacker;
+        return Placement;
+    }
+}
+
+// Test: Units whose weapons apply stock DOT effects are simulated with them; an unsupported weapon effect,
+// a multi-cell body or anything else the simulation cannot replay refuses the placement
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleSetupRefusalTest,
+    "KBS.Simulation.BattleSetup.RefusesUnsimulatable",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleSetupRefusalTest::RunTest(const FString& Parameters)
+{
+    UDOTBattleEffectDataAsset* BurnConfig = NewObject<UDOTBattleEffectDataAsset>();
+    BurnConfig->Duration = 2;
+    BurnConfig->EffectMagnitude = 5;
+    UUnitDefinition* Burner = MakeDefinition(UTargetDOTBattleEffect::StaticClass(), BurnConfig);
+    // A DOT class reading a stat-mod config is not a stock effect
+    UUnitDefinition* Mismatched = MakeDefinition(UTargetDOTBattleEffect::StaticClass(),
+                                                 NewObject<UStatModBattleEffectDataAsset>());
+    UUnitDefinition* Large = MakeDefinition(UTargetDOTBattleEffect::StaticClass(), BurnConfig);
+    Large->UnitSize = 2;
+
+    FBattleSetup Setup;
+    TestTrue("Stock DOT weapon is simulated", Setup.AddPlacement(MakePlacement(Burner, 1, true)));
+    if (Setup.GetNumUnits() == 1)
+    {
+        const FSimWeapon& Weapon = Setup.GetInitialState().GetUnit(0).Template->Weapons[0];
+        TestEqual("with its effect", Weapon.Effects.Num(), 1);
+        TestEqual("as a DOT", Weapon.Effects[0].Magnitude, 5.0f);
+    }
+    TestFalse("Unsupported weapon effect is refused", Setup.AddPlacement(MakePlacement(Mismatched, 2, false)));
+    TestFalse("and stays refused", Setup.AddPlacement(MakePlacement(Mismatched, 3, false)));
+    TestFalse("Multi-cell unit is refused", Setup.AddPlacement(MakePlacement(Large, 4, false)));
+    TestEqual("Refused units are not added", Setup.GetNumUnits(), 1);
+
+    FSimEffect Effect;
+    TestFalse("Stat-mod class with a DOT config is refused",
+              FSimEffect::FromConfig(UStatModBattleEffect::StaticClass(), BurnConfig, Effect));
+
+    return true;
+}
@@ -0,0 +1,218 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+#include "GameMechanics/Tactical/Simulation/BattleSimulator.h"
+#include "GameMechanics/Tactical/Simulation/SimulationTestFixture.h"
+
+using namespace SimulationTestFixture;
+
+// Test: A melee attack resolves through the shared damage rules and removes the killed unit
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleStateAttackTest,
+    "KBS.Simulation.BattleState.Attack",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleStateAttackTest::RunTest(const FString& Parameters)
+{
+    const FSimUnitTemplate Template = MakeMeleeTemplate();
+    FBattleState State;
+    const int32 A = State.AddUnit(Template, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    const int32 B = State.AddUnit(Template, ETeamSide::Defender, FTacCoordinates(2, 2));
+
+    State.BeginRound();
+    const int32 Actor = State.BeginTurn();
+    const int32 Victim = Actor == A ? B : A;
+    const FTacCoordinates VictimCell = State.GetUnit(Victim).Coords;
+    TestTrue("Adjacent enemy is attackable", (State.GetAttackCells(Actor) & GridBitboard::CellMask(VictimCell)) != 0);
+    TestFalse("Occupied cell is not a move target", (State.GetMoveCells(Actor) & GridBitboard::CellMask(VictimCell)) != 0);
+
+    TestTrue("Attack applies", State.Apply(FSimAction::Attack(VictimCell)));
+    TestEqual("Victim lost base magnitude", State.GetUnit(Victim).Stats.Health.GetCurrent(), 20);
+    TestEqual("Damage is credited", State.GetUnit(Actor).DamageDealt, 10);
+    State.EndTurn();
+
+    const FBattleState Snapshot = State;
+    FBattleSimulator::Run(State);
+    TestTrue("Original plays to the end", State.IsBattleOver());
+    TestEqual("Copied state is unaffected", Snapshot.GetUnit(Victim).Stats.Health.GetCurrent(), 20);
+
+    return true;
+}
+
+// Test: The default policy closes distance and plays the battle to a decisive end
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleSimulatorRunTest,
+    "KBS.Simulation.BattleState.Run",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleSimulatorRunTest::RunTest(const FString& Parameters)
+{
+    const FSimUnitTemplate Template = MakeMeleeTemplate();
+    FBattleState State;
+    State.AddUnit(Template, ETeamSide::Attacker, FTacCoordinates(0, 2));
+    State.AddUnit(Template, ETeamSide::Attacker, FTacCoordinates(0, 1));
+    State.AddUnit(Template, ETeamSide::Defender, FTacCoordinates(4, 2));
+    State.AddUnit(Template, ETeamSide::Defender, FTacCoordinates(4, 3));
+
+    const FBattleSimResult Result = FBattleSimulator::Run(State);
+    TestTrue("Battle finished", Result.bFinished);
+    TestTrue("Battle has a winner", Result.bHasWinner);
+    if (Result.bHasWinner)
+    {
+        TestTrue("Winner has survivors", State.GetAliveCount(Result.Winner) > 0);
+        TestEqual("Loser is wiped", State.GetAliveCount(Result.Winner == ETeamSide::Attacker ? ETeamSide::Defender : ETeamSide::Attacker), 0);
+    }
+    TestTrue("Turns were played", Result.Turns >= Result.Rounds && Result.Rounds > 0);
+
+    return true;
+}
+
+// Test: Flyers reach any free air cell, swap with air allies, and cross-layer movers land next to their column
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleStateFlyerMoveTest,
+    "KBS.Simulation.BattleState.FlyerMove",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleStateFlyerMoveTest::RunTest(const FString& Parameters)
+{
+    FSimUnitTemplate Flyer = MakeFlyerTemplate();
+    Flyer.BaseStats.Initiative = FUnitStatPercent(100);
+    FSimUnitTemplate Melee = MakeMeleeTemplate();
+    Melee.BaseStats.Initiative = FUnitStatPercent(0);
+
+    FBattleState State;
+    const int32 Harpy = State.AddUnit(Flyer, ETeamSide::Attacker, FTacCoordinates(0, 2, ETacGridLayer::Air));
+    const int32 Ally = State.AddUnit(Melee, ETeamSide::Attacker, FTacCoordinates(1, 1, ETacGridLayer::Air));
+    State.AddUnit(Melee, ETeamSide::Defender, FTacCoordinates(4, 2, ETacGridLayer::Air));
+    State.AddUnit(Melee, ETeamSide::Defender, FTacCoordinates(4, 3));
+
+    const uint64 Moves = State.GetMoveCells(Harpy);
+    TestTrue("Distant free air cell is reachable", (Moves & GridBitboard::CellMask(3, 3, ETacGridLayer::Air)) != 0);
+    TestTrue("Air ally cell is a swap target", (Moves & GridBitboard::CellMask(1, 1, ETacGridLayer::Air)) != 0);
+    TestFalse("Enemy air cell is blocked", (Moves & GridBitboard::CellMask(4, 2, ETacGridLayer::Air)) != 0);
+    TestFalse("Own cell is not a move", (Moves & GridBitboard::CellMask(0, 2, ETacGridLayer::Air)) != 0);
+    TestTrue("Air movement stays on its layer", (Moves & GridBitboard::LayerMask(ETacGridLayer::Ground)) == 0);
+
+    State.BeginRound();
+    TestEqual("Flyer acts first", State.BeginTurn(), Harpy);
+    TestTrue("Long flight applies", State.Apply(FSimAction::Move(FTacCoordinates(3, 1, ETacGridLayer::Air))));
+    TestTrue("Flyer landed at the target", State.GetUnit(Harpy).Coords == FTacCoordinates(3, 1, ETacGridLayer::Air));
+    TestTrue("Hash follows the move", State.GetHash() == State.ComputeHash());
+
+    FBattleState SwapState;
+    const int32 Swapper = SwapState.AddUnit(Flyer, ETeamSide::Attacker, FTacCoordinates(0, 2, ETacGridLayer::Air));
+    const int32 Swapped = SwapState.AddUnit(Melee, ETeamSide::Attacker, FTacCoordinates(1, 1, ETacGridLayer::Air));
+    SwapState.AddUnit(Melee, ETeamSide::Defender, FTacCoordinates(4, 2));
+    SwapState.BeginRound();
+    SwapState.BeginTurn();
+    TestTrue("Swap applies", SwapState.Apply(FSimAction::Move(FTacCoordinates(1, 1, ETacGridLayer::Air))));
+    TestTrue("Mover took the ally's cell", SwapState.GetUnit(Swapper).Coords == FTacCoordinates(1, 1, ETacGridLayer::Air));
+    TestTrue("Ally took the mover's cell", SwapState.GetUnit(Swapped).Coords == FTacCoordinates(0, 2, ETacGridLayer::Air));
+    TestEqual("Grid agrees with the swap", SwapState.GetUnitAt(FTacCoordinates(0, 2, ETacGridLayer::Air)), Swapped);
+    TestTrue("Hash follows the swap", SwapState.GetHash() == SwapState.ComputeHash());
+
+    FSimUnitTemplate Lander = MakeFlyerTemplate();
+    Lander.AirMoveTargeting.MovementPattern = EMovementPattern::Orthogonal;
+    Lander.AirMoveTargeting.MovementLayer = EMovementLayer::CrossLayer;
+    FBattleState LandState;
+    const int32 Landing = LandState.AddUnit(Lander, ETeamSide::Attacker, FTacCoordinates(1, 2, ETacGridLayer::Air));
+    LandState.AddUnit(Melee, ETeamSide::Defender, FTacCoordinates(1, 3));
+    const uint64 Landings = LandState.GetMoveCells(Landing);
+    TestTrue("Cross-layer moves only target the other layer", (Landings & GridBitboard::LayerMask(ETacGridLayer::Air)) == 0);
+    TestTrue("Can land straight down", (Landings & GridBitboard::CellMask(1, 2, ETacGridLayer::Ground)) != 0);
+    TestTrue("Can land on an orthogonal neighbour", (Landings & GridBitboard::CellMask(0, 2, ETacGridLayer::Ground)) != 0);
+    TestFalse("Occupied ground cell is blocked", (Landings & GridBitboard::CellMask(1, 3, ETacGridLayer::Ground)) != 0);
+    TestFalse("Diagonal ground cell is not orthogonal", (Landings & GridBitboard::CellMask(0, 1, ETacGridLayer::Ground)) != 0);
+
+    return true;
+}
+
+namespace
+{
+    FSimEffect MakeBurn(int32 Duration, float Magnitude)
+    {
+        FSimEffect Burn;
+        Burn.Kind = ESimEffectKind::DamageOverTime;
+        Burn.ConfigKey = 1;
+        Burn.DamageSource = EDamageSource::Fire;
+        Burn.bRequiresRoll = false;
+        Burn.Duration = Duration;
+        Burn.Magnitude = Magnitude;
+        return Burn;
+    }
+
+    FSimEffect MakeWeaken(int32 Duration, int32 AccuracyModifier)
+    {
+        FSimEffect Weaken;
+        Weaken.Kind = ESimEffectKind::StatMod;
+        Weaken.ConfigKey = 2;
+        Weaken.bRequiresRoll = false;
+        Weaken.Duration = Duration;
+        Weaken.AccuracyModifier = AccuracyModifier;
+        return Weaken;
+    }
+}
+
+// Test: Weapon effects land with a hit and tick only at their owner's turn end: a DOT deals its damage
+// each tick and can kill, a stat mod's modifier goes with it when it expires
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleStateEffectsTest,
+    "KBS.Simulation.BattleState.Effects",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleStateEffectsTest::RunTest(const FString& Parameters)
+{
+    FSimUnitTemplate Caster = MakeMeleeTemplate();
+    Caster.Weapons[0].Effects.Add(MakeBurn(2, 5.0f));
+    Caster.Weapons[0].Effects.Add(MakeWeaken(1, -20));
+    const FSimUnitTemplate Melee = MakeMeleeTemplate();
+    FBattleState State;
+    const int32 A = State.AddUnit(Caster, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    const int32 B = State.AddUnit(Melee, ETeamSide::Defender, FTacCoordinates(2, 2));
+    const int32 Accuracy = State.GetUnit(B).Stats.Accuracy.GetValue();
+    const int32 Queued[] = { B };
+    State.SetTurn(1, A, Queued);
+
+    TestTrue("Attack applies", State.Apply(FSimAction::Attack(State.GetUnit(B).Coords), ESimRollOutcome::Hit));
+    TestEqual("Both effects landed", State.GetUnit(B).Effects.Num(), 2);
+    TestEqual("Stat mod applied", State.GetUnit(B).Stats.Accuracy.GetValue(), Accuracy - 20);
+    TestTrue("Hash follows the effects", State.GetHash() == State.ComputeHash());
+    State.EndTurn();
+    TestEqual("Effects do not tick on the attacker's turn end", State.GetUnit(B).Stats.Health.GetCurrent(), 20);
+
+    TestEqual("Target acts next", State.BeginTurn(), B);
+    State.EndTurn();
+    TestEqual("DOT ticked", State.GetUnit(B).Stats.Health.GetCurrent(), 15);
+    TestEqual("DOT damage is tallied", State.GetUnit(B).DamageTaken, 15);
+    TestEqual("Expired stat mod is gone", State.GetUnit(B).Effects.Num(), 1);
+    TestEqual("and so is its modifier", State.GetUnit(B).Stats.Accuracy.GetValue(), Accuracy);
+    TestTrue("Hash follows the tick", State.GetHash() == State.ComputeHash());
+
+    State.BeginRound();
+    while (State.BeginTurn() != B)
+        State.EndTurn();
+    State.EndTurn();
+    TestEqual("DOT ticked again", State.GetUnit(B).Stats.Health.GetCurrent(), 10);
+    TestEqual("and expired", State.GetUnit(B).Effects.Num(), 0);
+    TestTrue("Hash follows the expiry", State.GetHash() == State.ComputeHash());
+
+    const FSimUnitTemplate Frail = MakeMeleeTemplate(13);
+    FBattleState KillState;
+    const int32 Burner = KillState.AddUnit(Caster, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    const int32 Victim = KillState.AddUnit(Frail, ETeamSide::Defender, FTacCoordinates(2, 2));
+    const int32 VictimNext[] = { Victim };
+    KillState.SetTurn(1, Burner, VictimNext);
+    KillState.Apply(FSimAction::Attack(KillState.GetUnit(Victim).Coords), ESimRollOutcome::Hit);
+    KillState.EndTurn();
+    KillState.BeginTurn();
+    KillState.EndTurn();
+    TestFalse("DOT kills", KillState.GetUnit(Victim).IsAlive());
+    TestTrue("Battle is over", KillState.IsBattleOver());
+    TestEqual("Death clears the effects", KillState.GetUnit(Victim).Effects.Num(), 0);
+    TestTrue("Hash follows the kill", KillState.GetHash() == KillState.ComputeHash());
+
+    return true;
+}
@@ -0,0 +1,138 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+#include "GameMechanics/Tactical/Simulation/BattleSimulator.h"
+#include "GameMechanics/Tactical/Simulation/BattleTranspositionTable.h"
+#include "GameMechanics/Tactical/Simulation/SimulationTestFixture.h"
+
+using namespace SimulationTestFixture;
+
+// Test: The incremental hash matches a full rebuild through a whole battle, and equal positions hash equal
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleZobristHashTest,
+    "KBS.Simulation.Zobrist.Incremental",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleZobristHashTest::RunTest(const FString& Parameters)
+{
+    const FSimUnitTemplate Template = MakeMeleeTemplate();
+    FBattleState State;
+    State.AddUnit(Template, ETeamSide::Attacker, FTacCoordinates(0, 2));
+    State.AddUnit(Template, ETeamSide::Attacker, FTacCoordinates(0, 1));
+    State.AddUnit(Template, ETeamSide::Defender, FTacCoordinates(4, 2));
+    State.AddUnit(Template, ETeamSide::Defender, FTacCoordinates(4, 3));
+    TestEqual("Setup hash matches rebuild", State.GetHash(), State.ComputeHash());
+
+    bool bConsistent = true;
+    for (int32 Round = 0; Round < 30 && bConsistent && !State.IsBattleOver(); ++Round)
+    {
+        State.BeginRound();
+        bConsistent &= State.GetHash() == State.ComputeHash();
+        while (bConsistent && !State.IsBattleOver() && State.BeginTurn() != FBattleState::NoUnit)
+        {
+            bConsistent &= State.GetHash() == State.ComputeHash();
+            State.Apply(FBattleSimulator::ChooseDefaultAction(State, State.GetCurrentUnit()));
+            bConsistent &= State.GetHash() == State.ComputeHash();
+            State.EndTurn();
+            bConsistent &= State.GetHash() == State.ComputeHash();
+        }
+    }
+    TestTrue("Hash stays in sync through moves, attacks, kills and turns", bConsistent);
+
+    FBattleState Fresh;
+    const int32 A = Fresh.AddUnit(Template, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    const int32 B = Fresh.AddUnit(Template, ETeamSide::Defender, FTacCoordinates(2, 2));
+    Fresh.BeginRound();
+    const int32 Actor = Fresh.BeginTurn();
+    const FTacCoordinates VictimCell = Fresh.GetUnit(Actor == A ? B : A).Coords;
+    FBattleState Attacked = Fresh;
+    FBattleState Waited = Fresh;
+    TestEqual("Copies hash equal", Attacked.GetHash(), Fresh.GetHash());
+    TestTrue("Attack applies", Attacked.Apply(FSimAction::Attack(VictimCell)));
+    TestTrue("Wait applies", Waited.Apply(FSimAction::Wait()));
+    TestNotEqual("Different actions diverge", Attacked.GetHash(), Waited.GetHash());
+    TestNotEqual("Damage changes the hash", Attacked.GetHash(), Fresh.GetHash());
+
+    return true;
+}
+
+// Test: Entries round-trip through the table and a shallower result never evicts a deeper one
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleTranspositionTableTest,
+    "KBS.Simulation.Zobrist.TranspositionTable",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleTranspositionTableTest::RunTest(const FString& Parameters)
+{
+    FBattleTranspositionTable Table(4);
+    TestEqual("Capacity is a power of two", Table.GetCapacity(), 16);
+
+    const uint64 Key = 0x9E3779B97F4A7C15ull;
+    FTranspositionEntry Entry;
+    TestFalse("Empty table misses", Table.Probe(Key, Entry));
+
+    FTranspositionEntry Deep;
+    Deep.Value = 0.75f;
+    Deep.Depth = 5;
+    Deep.Bound = ETranspositionBound::Lower;
+    Deep.BestAction = FSimAction::Attack(FTacCoordinates(2, 3, ETacGridLayer::Air));
+    Table.Store(Key, Deep);
+
+    TestTrue("Stored entry is found", Table.Probe(Key, Entry));
+    TestEqual("Value round-trips", Entry.Value, Deep.Value);
+    TestEqual("Depth round-trips", Entry.Depth, Deep.Depth);
+    TestTrue("Bound round-trips", Entry.Bound == ETranspositionBound::Lower);
+    TestTrue("Action round-trips", Entry.BestAction == Deep.BestAction);
+    TestFalse("Same slot, other key misses", Table.Probe(Key + Table.GetCapacity(), Entry));
+
+    FTranspositionEntry Shallow = Deep;
+    Shallow.Depth = 2;
+    Shallow.Value = 0.25f;
+    Table.Store(Key, Shallow);
+    Table.Probe(Key, Entry);
+    TestEqual("Deeper result is kept", Entry.Depth, 5);
+
+    Table.Clear();
+    TestFalse("Cleared table misses", Table.Probe(Key, Entry));
+
+    return true;
+}
+
+// Test: Spending a ward and waiting are part of the position, so neither leaves the hash unchanged
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleZobristWardWaitTest,
+    "KBS.Simulation.Zobrist.WardsAndWait",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleZobristWardWaitTest::RunTest(const FString& Parameters)
+{
+    FSimUnitTemplate Template = MakeMeleeTemplate();
+    Template.BaseStats.Defense.Wards.Add(EDamageSource::Physical);
+    FBattleState State;
+    const int32 A = State.AddUnit(Template, ETeamSide::Attacker, FTacCoordinates(1, 2));
+    const int32 B = State.AddUnit(Template, ETeamSide::Defender, FTacCoordinates(2, 2));
+    State.BeginRound();
+    const int32 Actor = State.BeginTurn();
+    const int32 Victim = Actor == A ? B : A;
+
+    FBattleState Attacked = State;
+    TestTrue("Attack applies", Attacked.Apply(FSimAction::Attack(State.GetUnit(Victim).Coords)));
+    TestEqual("Ward absorbed the hit", Attacked.GetUnit(Victim).Stats.Health.GetCurrent(),
+              State.GetUnit(Victim).Stats.Health.GetCurrent());
+    TestTrue("Ward was spent", Attacked.GetUnit(Victim).Stats.Defense.Wards.GetWards().IsEmpty());
+    TestNotEqual("Spent ward changes the hash", Attacked.GetHash(), State.GetHash());
+    TestEqual("Incremental hash matches rebuild after the ward", Attacked.GetHash(), Attacked.ComputeHash());
+
+    FBattleState Waited = State;
+    TestTrue("Wait applies", Waited.Apply(FSimAction::Wait()));
+    TestNotEqual("Waiting changes the unit key", Waited.GetUnit(Actor).StateKey, State.GetUnit(Actor).StateKey);
+    TestEqual("Incremental hash matches rebuild after waiting", Waited.GetHash(), Waited.ComputeHash());
+    Waited.EndTurn();
+    Waited.BeginRound();
+    TestEqual("New round clears the waited flag", Waited.GetUnit(Actor).StateKey, State.GetUnit(Actor).StateKey);
+    TestEqual("Incremental hash matches rebuild in the new round", Waited.GetHash(), Waited.ComputeHash());
+
+    return true;
+}
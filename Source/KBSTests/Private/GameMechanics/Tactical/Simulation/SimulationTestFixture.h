@@ -0,0 +1,35 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameMechanics/Tactical/Simulation/BattleState.h"
+
+// Unit templates shared by the simulation tests, so a change to FSimUnitTemplate is made once
+namespace SimulationTestFixture
+{
+    // Single-weapon melee unit that can move and wait
+    inline FSimUnitTemplate MakeMeleeTemplate(int32 Health = 30, bool bRequiresAccuracyRoll = false)
+    {
+        FSimWeapon Sword;
+        Sword.Stats.TargetReach = ETargetReach::ClosestEnemies;
+        Sword.Stats.DamageSources.InitFromBase({ EDamageSource::Physical });
+        Sword.bRequiresAccuracyRoll = bRequiresAccuracyRoll;
+
+        FSimUnitTemplate Template;
+        Template.Name = TEXT("Swordsman");
+        Template.BaseStats.Health = FUnitHealth(Health);
+        Template.Weapons.Add(Sword);
+        Template.AttackTargeting = FTargetingDescriptor::FromReach(ETargetReach::ClosestEnemies);
+        Template.bHasMove = true;
+        Template.bHasWait = true;
+        return Template;
+    }
+
+    // Melee unit with the default movement ability layout: orthogonal on the ground, any-to-any in the air
+    inline FSimUnitTemplate MakeFlyerTemplate()
+    {
+        FSimUnitTemplate Template = MakeMeleeTemplate();
+        Template.Name = TEXT("Harpy");
+        Template.AirMoveTargeting.MovementPattern = EMovementPattern::AnyToAny;
+        Template.AirMoveTargeting.MovementLayer = EMovementLayer::Air;
+        return Template;
+    }
+}
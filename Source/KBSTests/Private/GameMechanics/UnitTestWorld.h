@@ -0,0 +1,58 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameMechanics/Units/Unit.h"
+#include "GameMechanics/Units/UnitDefinition.h"
+#include "GameMechanics/Tactical/Grid/TacBattleGrid.h"
+#include "GameMechanics/Tactical/Grid/Components/GridDataManager.h"
+
+// Transient game world for tests that need live units and the tactical world subsystems.
+// Spawned units begin play so their components bind to the unit events as in a battle; they carry
+// a blank single-cell definition, so tests set the stats they need.
+class FUnitTestWorld
+{
+public:
+    FUnitTestWorld()
+    {
+        World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("KBSUnitTestWorld"));
+        GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+    }
+
+    ~FUnitTestWorld()
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+
+    FUnitTestWorld(const FUnitTestWorld&) = delete;
+    FUnitTestWorld& operator=(const FUnitTestWorld&) = delete;
+
+    UWorld* Get() const { return World; }
+
+    template <typename T>
+    T* GetSubsystem() const { return World->GetSubsystem<T>(); }
+
+    AUnit* SpawnUnit(ETeamSide Team, int32 Health = 100)
+    {
+        AUnit* Unit = World->SpawnActor<AUnit>();
+        Unit->SetUnitDefinition(NewObject<UUnitDefinition>(Unit));
+        Unit->SetTeamSide(Team);
+        Unit->GetStats().Health = FUnitHealth(Health);
+        Unit->DispatchBeginPlay();
+        return Unit;
+    }
+
+    // Grid actor with its data manager initialized but not registered with the grid subsystem, so
+    // tests place units by hand without the editor spawn and turn-order setup of BeginPlay
+    UGridDataManager* SpawnGrid()
+    {
+        ATacBattleGrid* Grid = World->SpawnActor<ATacBattleGrid>();
+        UGridDataManager* DataManager = Grid->GetDataManager();
+        DataManager->Initialize(Grid);
+        return DataManager;
+    }
+
+private:
+    UWorld* World = nullptr;
+};
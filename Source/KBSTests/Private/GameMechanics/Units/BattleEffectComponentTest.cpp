@@ -0,0 +1,143 @@
+#include "Misc/AutomationTest.h"
+#include "GameMechanics/UnitTestWorld.h"
+#include "GameMechanics/Units/BattleEffects/BattleEffectComponent.h"
+#include "GameMechanics/Units/BattleEffects/StatModBattleEffect.h"
+#include "GameMechanics/Units/BattleEffects/StatModBattleEffectDataAsset.h"
+#include "GameMechanics/Units/BattleEffects/TargetDOTBattleEffect.h"
+#include "GameMechanics/Units/BattleEffects/DOTBattleEffectDataAsset.h"
+
+namespace
+{
+    UStatModBattleEffect* MakeStatMod(FName StackingId, EEffectStackPolicy Policy, int32 MaxStacks = 1)
+    {
+        UStatModBattleEffectDataAsset* Config = NewObject<UStatModBattleEffectDataAsset>();
+        Config->Duration = 2;
+        Config->MaxHealthModifier = 20;
+        Config->AccuracyModifier = -10;
+        Config->ArmourModifiers.Add(EDamageSource::Fire, 30);
+        Config->StackingId = StackingId;
+        Config->StackPolicy = Policy;
+        Config->MaxStacks = MaxStacks;
+        UStatModBattleEffect* Effect = NewObject<UStatModBattleEffect>();
+        Effect->Initialize(Config);
+        return Effect;
+    }
+
+    UTargetDOTBattleEffect* MakeDot(float Magnitude, int32 Duration)
+    {
+        UDOTBattleEffectDataAsset* Config = NewObject<UDOTBattleEffectDataAsset>();
+        Config->Duration = Duration;
+        Config->EffectMagnitude = Magnitude;
+        Config->DamageSource = EDamageSource::Fire;
+        Config->StackingId = TEXT("Burn");
+        Config->StackPolicy = EEffectStackPolicy::RefreshOrReplace;
+        UTargetDOTBattleEffect* Effect = NewObject<UTargetDOTBattleEffect>();
+        Effect->Initialize(Config);
+        return Effect;
+    }
+}
+
+// Test: Stat modifiers come and go with their application, stacks keep separate handles, and expiry
+// on turn end removes exactly the expired application's modifiers
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleEffectStatModTest,
+    "KBS.Effects.Component.StatMod",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleEffectStatModTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    AUnit* Unit = World.SpawnUnit(ETeamSide::Attacker, 100);
+    Unit->GetStats().Accuracy = FUnitStatPercent(80);
+    UBattleEffectComponent* Effects = Unit->EffectManager;
+    const FUnitCoreStats& Stats = Unit->GetStats();
+
+    UStatModBattleEffect* Buff = MakeStatMod(TEXT("Blessing"), EEffectStackPolicy::Stack, 2);
+    FActiveBattleEffect First;
+    TestTrue("Applies", Effects->AddEffect(Buff, Unit, &First));
+    TestFalse("Stateless effects share the descriptor's object", First.Instance != nullptr);
+    TestTrue("Reported application carries what OnApplied stored",
+        First.StatModifiers.Accuracy.IsValid() && First.StatModifiers.MaxHealth.IsValid());
+    TestEqual("Max health raised", Stats.Health.GetMaximum(), 120);
+    TestEqual("Accuracy lowered", Stats.Accuracy.GetValue(), 70);
+    TestEqual("Armour raised", Stats.Defense.Armour.GetValue(EDamageSource::Fire), 30);
+
+    FActiveBattleEffect Second;
+    TestTrue("Second stack applies", Effects->AddEffect(Buff, Unit, &Second));
+    TestFalse("Third stack is over the limit", Effects->AddEffect(Buff, Unit));
+    TestEqual("Two applications", Effects->GetActiveEffects().Num(), 2);
+    TestNotEqual("Each application has its own id", First.EffectId, Second.EffectId);
+    TestEqual("Stacks add up", Stats.Accuracy.GetValue(), 60);
+
+    Effects->RemoveEffect(First.EffectId);
+    TestEqual("Removing one stack keeps the other's accuracy", Stats.Accuracy.GetValue(), 70);
+    TestEqual("Removing one stack keeps the other's max health", Stats.Health.GetMaximum(), 120);
+    TestEqual("Removing one stack keeps the other's armour", Stats.Defense.Armour.GetValue(EDamageSource::Fire), 30);
+    TestTrue("Removed application is gone", Effects->FindEffect(First.EffectId) == nullptr);
+
+    Unit->HandleTurnEnd();
+    TestEqual("Turn end ticks the duration", Effects->FindEffect(Second.EffectId)->Duration, 1);
+    Unit->HandleTurnEnd();
+    TestEqual("Expired application is removed", Effects->GetActiveEffects().Num(), 0);
+    TestEqual("Accuracy restored", Stats.Accuracy.GetValue(), 80);
+    TestEqual("Max health restored", Stats.Health.GetMaximum(), 100);
+    TestEqual("Armour restored", Stats.Defense.Armour.GetValue(EDamageSource::Fire), 0);
+
+    UStatModBattleEffect* Refreshing = MakeStatMod(TEXT("Haste"), EEffectStackPolicy::RefreshOld);
+    FActiveBattleEffect Original;
+    Effects->AddEffect(Refreshing, Unit, &Original);
+    Unit->HandleTurnEnd();
+    TestFalse("Refresh does not add an application", Effects->AddEffect(Refreshing, Unit));
+    TestEqual("Still one application", Effects->GetActiveEffects().Num(), 1);
+    TestEqual("Refresh restores the duration", Effects->FindEffect(Original.EffectId)->Duration, 2);
+    TestEqual("Refresh does not stack the modifiers", Stats.Accuracy.GetValue(), 70);
+    Effects->RemoveEffect(TEXT("Haste"));
+    TestEqual("Removal by stacking id restores the stat", Stats.Accuracy.GetValue(), 80);
+
+    return true;
+}
+
+// Test: DOTs deal their damage on turn end, a stronger reapplication replaces a weaker one and a
+// weaker one only refreshes the duration
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBattleEffectDotTest,
+    "KBS.Effects.Component.DOT",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FBattleEffectDotTest::RunTest(const FString& Parameters)
+{
+    FUnitTestWorld World;
+    AUnit* Unit = World.SpawnUnit(ETeamSide::Defender, 100);
+    UBattleEffectComponent* Effects = Unit->EffectManager;
+
+    UTargetDOTBattleEffect* Weak = MakeDot(5.f, 3);
+    UTargetDOTBattleEffect* Strong = MakeDot(10.f, 2);
+
+    FActiveBattleEffect Burn;
+    TestTrue("Applies", Effects->AddEffect(Weak, Unit, &Burn));
+    TestEqual("Starts with the configured duration", Burn.Duration, 3);
+    Unit->HandleTurnEnd();
+    TestEqual("Turn end deals the damage", Unit->GetStats().Health.GetCurrent(), 95);
+    TestEqual("and ticks the duration", Effects->FindEffect(Burn.EffectId)->Duration, 2);
+
+    FActiveBattleEffect Replaced;
+    TestTrue("Stronger reapplication replaces", Effects->AddEffect(Strong, Unit, &Replaced));
+    TestTrue("Old application is gone", Effects->FindEffect(Burn.EffectId) == nullptr);
+    TestEqual("One application", Effects->GetActiveEffects().Num(), 1);
+    Unit->HandleTurnEnd();
+    TestEqual("Stronger damage", Unit->GetStats().Health.GetCurrent(), 85);
+
+    TestFalse("Weaker reapplication does not add", Effects->AddEffect(Weak, Unit));
+    TestEqual("but extends to the longer duration", Effects->FindEffect(Replaced.EffectId)->Duration, 3);
+    Unit->HandleTurnEnd();
+    TestEqual("The stronger DOT keeps ticking", Unit->GetStats().Health.GetCurrent(), 75);
+
+    Effects->RemoveEffect(Replaced.EffectId);
+    TestEqual("Removed", Effects->GetActiveEffects().Num(), 0);
+    Unit->HandleTurnEnd();
+    TestEqual("No damage once removed", Unit->GetStats().Health.GetCurrent(), 75);
+
+    return true;
+}
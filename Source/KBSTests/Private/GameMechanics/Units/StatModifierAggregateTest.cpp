@@ -0,0 +1,93 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "GameMechanics/Units/Stats/BaseUnitStatTypes.h"
+#include "GameMechanics/Units/Stats/UnitHealth.h"
+
+// Test: Handles add and remove flats and multipliers in any order; stale handles are ignored
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FStatModifierAggregateTest,
+    "KBS.Stats.ModifierAggregate.AddRemove",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FStatModifierAggregateTest::RunTest(const FString& Parameters)
+{
+    FUnitStatPositive Magnitude(40);
+    const FStatModifierHandle Flat = Magnitude.AddFlatModifier(10);
+    const FStatModifierHandle Mult = Magnitude.AddMultiplier(50);
+    const FStatModifierHandle Mult2 = Magnitude.AddMultiplier(-20);
+    TestTrue("Handles are valid", Flat.IsValid() && Mult.IsValid() && Mult2.IsValid());
+    TestEqual("(40 + 10) x (1 + 0.5 - 0.2)", Magnitude.GetValue(), 65);
+
+    Magnitude.RemoveModifier(Mult);
+    TestEqual("Removing one multiplier keeps the rest", Magnitude.GetValue(), 40);
+    Magnitude.RemoveModifier(Mult);
+    TestEqual("Removing twice is a no-op", Magnitude.GetValue(), 40);
+
+    const FStatModifierHandle Reused = Magnitude.AddFlatModifier(5);
+    TestEqual("Freed slot is reused", Reused.Index, Mult.Index);
+    Magnitude.RemoveModifier(Mult);
+    TestEqual("Stale handle does not remove the slot's new modifier", Magnitude.GetValue(), 44);
+
+    Magnitude.RemoveModifier(Flat);
+    Magnitude.RemoveModifier(Mult2);
+    Magnitude.RemoveModifier(Reused);
+    TestEqual("All removed restores the base", Magnitude.GetValue(), 40);
+    Magnitude.RemoveModifier(FStatModifierHandle());
+    TestEqual("Invalid handle is ignored", Magnitude.GetValue(), 40);
+
+    FUnitStatPercent Accuracy(75);
+    const FStatModifierHandle Buff = Accuracy.AddFlatModifier(50);
+    TestEqual("Percent stats clamp at 100", Accuracy.GetValue(), 100);
+    Accuracy.AddFlatModifier(-200);
+    TestEqual("Percent stats clamp at 0", Accuracy.GetValue(), 0);
+    Accuracy.InitFromBase(60);
+    TestEqual("InitFromBase drops every modifier", Accuracy.GetValue(), 60);
+    Accuracy.RemoveModifier(Buff);
+    TestEqual("Handles from before InitFromBase are stale", Accuracy.GetValue(), 60);
+
+    FUnitHealth Health(100);
+    const FStatModifierHandle MaxBuff = Health.AddMaxModifier(20);
+    TestEqual("Max HP buff heals by the increase", Health.GetCurrent(), 120);
+    Health.RemoveMaxModifier(MaxBuff);
+    TestEqual("Removing it clamps current HP", Health.GetCurrent(), 100);
+
+    return true;
+}
+
+// Benchmark: stacked buffs on one stat - interleaved add, read and remove as effects come and go
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FStatModifierAggregateBenchmark,
+    "KBS.Stats.Benchmark.ModifierAggregate",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FStatModifierAggregateBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr int32 Iterations = 20000;
+    constexpr int32 StackedBuffs = 32;
+
+    FUnitStatPercent Initiative(50);
+    TArray<FStatModifierHandle> Handles;
+    for (int32 i = 0; i < StackedBuffs; ++i)
+        Handles.Add(i % 2 ? Initiative.AddFlatModifier(1) : Initiative.AddMultiplier(1));
+
+    int64 Checksum = 0;
+    const double Start = FPlatformTime::Seconds();
+    for (int32 n = 0; n < Iterations; ++n)
+    {
+        // Oldest buff expires, a new one lands, and the turn order re-reads the stat
+        const int32 Slot = n % StackedBuffs;
+        Initiative.RemoveModifier(Handles[Slot]);
+        Checksum += Initiative.GetValue();
+        Handles[Slot] = Slot % 2 ? Initiative.AddFlatModifier(1) : Initiative.AddMultiplier(1);
+        Checksum += Initiative.GetValue();
+    }
+    const double Seconds = FPlatformTime::Seconds() - Start;
+
+    TestTrue("Stat stayed in range", Checksum > 0 && Checksum <= int64(Iterations) * 2 * 100);
+    AddInfo(FString::Printf(TEXT("%d buffs stacked, %d remove/add/read cycles: %.3f ms"),
+        StackedBuffs, Iterations, Seconds * 1000.0));
+
+    return true;
+}